@@ -389,6 +389,7 @@ HEADERS += $$PWD/sourceCode/sceneObjects/jointObject.h \
 
 HEADERS += $$PWD/sourceCode/sceneObjects/graphObjectRelated/graphCurve.h \
     $$PWD/sourceCode/sceneObjects/graphObjectRelated/graphDataStream.h \
+    $$PWD/sourceCode/sceneObjects/graphObjectRelated/graphRecorder.h \
     $$PWD/sourceCode/sceneObjects/graphObjectRelated/graphingRoutines_old.h \
     $$PWD/sourceCode/sceneObjects/graphObjectRelated/graphDataComb_old.h \
     $$PWD/sourceCode/sceneObjects/graphObjectRelated/graphData_old.h \
@@ -454,6 +455,7 @@ HEADERS += $$PWD/sourceCode/mainContainers/applicationContainers/copyBuffer.h \
     $$PWD/sourceCode/mainContainers/applicationContainers/persistentDataContainer.h \
     $$PWD/sourceCode/mainContainers/applicationContainers/simulatorMessageQueue.h \
     $$PWD/sourceCode/mainContainers/applicationContainers/calculationInfo.h \
+    $$PWD/sourceCode/mainContainers/applicationContainers/stepProfiler.h \
     $$PWD/sourceCode/mainContainers/applicationContainers/interfaceStackContainer.h \
     $$PWD/sourceCode/mainContainers/applicationContainers/addOnScriptContainer.h \
 
@@ -484,6 +486,7 @@ HEADERS += $$PWD/sourceCode/textures/textureObject.h \
 HEADERS += $$PWD/sourceCode/serialization/ser.h \
     $$PWD/sourceCode/serialization/extIkSer.h \
     $$PWD/sourceCode/serialization/huffman.h \
+    $$PWD/sourceCode/serialization/lzBlock.h \
     $$PWD/sourceCode/serialization/tinyxml2.cpp \
 
 HEADERS += $$PWD/sourceCode/strings/simStringTable.h \
@@ -516,12 +519,14 @@ HEADERS += $$PWD/sourceCode/geometricAlgorithms/linMotionRoutines.h \
     $$PWD/sourceCode/geometricAlgorithms/meshManip.h \
     $$PWD/sourceCode/geometricAlgorithms/edgeElement.h \
     $$PWD/sourceCode/geometricAlgorithms/algos.h \
+    $$PWD/sourceCode/geometricAlgorithms/calculationStructureBuilder.h \
 
 HEADERS += $$PWD/sourceCode/various/simConfig.h \
     $$PWD/sourceCode/various/gV.h \
     $$PWD/sourceCode/various/global.h \
     $$PWD/sourceCode/various/embeddedFonts.h \
     $$PWD/sourceCode/various/userSettings.h \
+    $$PWD/sourceCode/various/benchmarks.h \
     $$PWD/sourceCode/various/memorizedConf.h \
     $$PWD/sourceCode/various/uiThread.h \
     $$PWD/sourceCode/various/simThread.h \
@@ -537,6 +542,7 @@ HEADERS += $$PWD/sourceCode/various/simConfig.h \
 HEADERS += $$PWD/sourceCode/undoRedo/undoBufferArrays.h \
     $$PWD/sourceCode/undoRedo/undoBuffer.h \
     $$PWD/sourceCode/undoRedo/undoBufferCameras.h \
+    $$PWD/sourceCode/undoRedo/undoBufferBlocks.h \
 
 HEADERS += $$PWD/sourceCode/rendering/rendering.h \
     $$PWD/sourceCode/rendering/cameraRendering.h \
@@ -575,6 +581,7 @@ HEADERS += $$PWD/sourceCode/displ/colorObject.h \
     $$PWD/sourceCode/shared/displ/_colorObject_.h \
 
 HEADERS += $$PWD/sourceCode/utils/threadPool.h \
+    $$PWD/sourceCode/utils/workerPool.h \
     $$PWD/sourceCode/utils/tt.h \
     $$PWD/sourceCode/utils/ttUtil.h \
     $$PWD/sourceCode/utils/confReaderAndWriter.h \
@@ -818,6 +825,7 @@ SOURCES += $$PWD/sourceCode/sceneObjects/jointObject.cpp \
 
 SOURCES += $$PWD/sourceCode/sceneObjects/graphObjectRelated/graphCurve.cpp \
     $$PWD/sourceCode/sceneObjects/graphObjectRelated/graphDataStream.cpp \
+    $$PWD/sourceCode/sceneObjects/graphObjectRelated/graphRecorder.cpp \
     $$PWD/sourceCode/sceneObjects/graphObjectRelated/graphingRoutines_old.cpp \
     $$PWD/sourceCode/sceneObjects/graphObjectRelated/graphDataComb_old.cpp \
     $$PWD/sourceCode/sceneObjects/graphObjectRelated/graphData_old.cpp \
@@ -886,6 +894,7 @@ SOURCES += $$PWD/sourceCode/mainContainers/applicationContainers/copyBuffer.cpp
     $$PWD/sourceCode/mainContainers/applicationContainers/persistentDataContainer.cpp \
     $$PWD/sourceCode/mainContainers/applicationContainers/simulatorMessageQueue.cpp \
     $$PWD/sourceCode/mainContainers/applicationContainers/calculationInfo.cpp \
+    $$PWD/sourceCode/mainContainers/applicationContainers/stepProfiler.cpp \
     $$PWD/sourceCode/mainContainers/applicationContainers/interfaceStackContainer.cpp \
     $$PWD/sourceCode/mainContainers/applicationContainers/addOnScriptContainer.cpp \
 
@@ -916,6 +925,7 @@ SOURCES += $$PWD/sourceCode/textures/textureObject.cpp \
 SOURCES += $$PWD/sourceCode/serialization/ser.cpp \
     $$PWD/sourceCode/serialization/extIkSer.cpp \
     $$PWD/sourceCode/serialization/huffman.c \
+    $$PWD/sourceCode/serialization/lzBlock.c \
     $$PWD/sourceCode/serialization/tinyxml2.cpp \
 
 SOURCES += $$PWD/sourceCode/interfaces/sim.cpp \
@@ -946,10 +956,12 @@ SOURCES += $$PWD/sourceCode/geometricAlgorithms/linMotionRoutines.cpp \
     $$PWD/sourceCode/geometricAlgorithms/meshManip.cpp \
     $$PWD/sourceCode/geometricAlgorithms/edgeElement.cpp \
     $$PWD/sourceCode/geometricAlgorithms/algos.cpp \
+    $$PWD/sourceCode/geometricAlgorithms/calculationStructureBuilder.cpp \
 
 SOURCES += $$PWD/sourceCode/various/gV.cpp \
     $$PWD/sourceCode/various/memorizedConf.cpp \
     $$PWD/sourceCode/various/userSettings.cpp \
+    $$PWD/sourceCode/various/benchmarks.cpp \
     $$PWD/sourceCode/various/folderSystem.cpp \
     $$PWD/sourceCode/various/uiThread.cpp \
     $$PWD/sourceCode/various/simThread.cpp \
@@ -964,6 +976,7 @@ SOURCES += $$PWD/sourceCode/various/gV.cpp \
 SOURCES += $$PWD/sourceCode/undoRedo/undoBufferArrays.cpp \
     $$PWD/sourceCode/undoRedo/undoBuffer.cpp \
     $$PWD/sourceCode/undoRedo/undoBufferCameras.cpp \
+    $$PWD/sourceCode/undoRedo/undoBufferBlocks.cpp \
 
 SOURCES += $$PWD/sourceCode/rendering/rendering.cpp \
     $$PWD/sourceCode/rendering/cameraRendering.cpp \
@@ -1002,6 +1015,7 @@ SOURCES += $$PWD/sourceCode/displ/colorObject.cpp \
 SOURCES += $$PWD/sourceCode/visual/thumbnail.cpp \
 
 SOURCES += $$PWD/sourceCode/utils/threadPool.cpp \
+    $$PWD/sourceCode/utils/workerPool.cpp \
     $$PWD/sourceCode/utils/ttUtil.cpp \
     $$PWD/sourceCode/utils/tt.cpp \
     $$PWD/sourceCode/utils/confReaderAndWriter.cpp \
@@ -8,6 +8,7 @@
 #include "app.h"
 #include "simStrings.h"
 #include "vDateTime.h"
+#include "stepProfiler.h"
 #include "pluginContainer.h"
 #include "collisionContourRendering.h"
 #include "base64.h"
@@ -255,6 +256,9 @@ bool CCollisionObject::setContourWidth(int w)
 
 bool CCollisionObject::handleCollision()
 {   // Return value true means there was a collision
+    CStepProfilerScope profilerScope("collision");
+    if (profilerScope.isActive())
+        profilerScope.setName(getObjectName().c_str());
     clearCollisionResult();
     if (!App::currentWorld->mainSettings->collisionDetectionEnabled)
         return(false);
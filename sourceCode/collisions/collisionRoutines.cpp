@@ -2,6 +2,8 @@
 #include "distanceRoutines.h"
 #include "pluginContainer.h"
 #include "app.h"
+#include <algorithm>
+#include <unordered_set>
 
 //---------------------------- GENERAL COLLISION QUERIES ---------------------------
 
@@ -140,6 +142,8 @@ bool CCollisionRoutine::_doesShapeCollideWithShape(CShape* shape1,CShape* shape2
         return(false);
 
     // Before building collision nodes, check if the shape's bounding boxes collide (new since 9/7/2014):
+    shape1->adoptBuiltMeshCalculationStructure();
+    shape2->adoptBuiltMeshCalculationStructure();
     if ( (!shape1->isMeshCalculationStructureInitialized())||(!shape2->isMeshCalculationStructureInitialized()) )
     {
         if (!CPluginContainer::geomPlugin_getBoxBoxCollision(shape1->getFullCumulativeTransformation(),shape1->getBoundingBoxHalfSizes(),shape2->getFullCumulativeTransformation(),shape2->getBoundingBoxHalfSizes(),true))
@@ -193,50 +197,141 @@ bool CCollisionRoutine::_doesGroupCollideWithGroup(const std::vector<CSceneObjec
 {   // if intersections is different from nullptr we check for all collisions and
     // append intersection segments to the vector.
     bool returnValue=false;
-    std::vector<CSceneObject*> checkedPairs;
-    for (size_t i=0;i<group1.size();i++)
+    std::vector<CSceneObject*> objPairs; // pairs with overlapping bounding boxes, never twice the same pair
+    _getBroadPhasePairs(group1,&group2,objPairs);
+    for (size_t i=0;i<objPairs.size()/2;i++)
     {
-        for (size_t j=0;j<group2.size();j++)
+        CSceneObject* obj1=objPairs[2*i+0];
+        CSceneObject* obj2=objPairs[2*i+1];
+        bool doIt=(!returnValue);
+        if ( (!doIt)&&(intersections!=nullptr) )
+        { // we still might have to do it if we have shape-shape colldetection (for the contour)
+            doIt=(obj1->getObjectType()==sim_object_shape_type)&&(obj2->getObjectType()==sim_object_shape_type);
+        }
+
+        if (doIt)
         {
-            if (group1[i]!=group2[j])
-            { // never check an object against itself
-                // Never check twice the same pair:
-                bool present=false;
-                for (size_t k=0;k<checkedPairs.size()/2;k++)
-                {
-                    if ((group2[j]==checkedPairs[2*k+0])&&(group1[i]==checkedPairs[2*k+1]))
-                    {
-                        present=true;
-                        break;
-                    }
-                }
-                if (!present)
-                {
-                    checkedPairs.push_back(group1[i]);
-                    checkedPairs.push_back(group2[j]);
+            if (_doesObjectCollideWithObject(obj1,obj2,true,true,intersections))
+            {
+                collidingGroupObjects[0]=obj1->getObjectHandle();
+                collidingGroupObjects[1]=obj2->getObjectHandle();
+                if (intersections==nullptr)
+                    return(true);
+                returnValue=true;
+            }
+        }
+    }
+    return(returnValue);
+}
 
-                    bool doIt=(!returnValue);
-                    if ( (!doIt)&&(intersections!=nullptr) )
-                    { // we still might have to do it if we have shape-shape colldetection (for the contour)
-                        doIt=(group1[i]->getObjectType()==sim_object_shape_type)&&(group2[j]->getObjectType()==sim_object_shape_type);
-                    }
+unsigned long long int CCollisionRoutine::getUnorderedPairKey(const CSceneObject* obj1,const CSceneObject* obj2)
+{
+    unsigned long long int h1=(unsigned int)obj1->getObjectHandle();
+    unsigned long long int h2=(unsigned int)obj2->getObjectHandle();
+    if (h1>h2)
+        return((h2<<32)|h1);
+    return((h1<<32)|h2);
+}
 
-                    if (doIt)
-                    {
-                        if (_doesObjectCollideWithObject(group1[i],group2[j],true,true,intersections))
-                        {
-                            collidingGroupObjects[0]=group1[i]->getObjectHandle();
-                            collidingGroupObjects[1]=group2[j]->getObjectHandle();
-                            if (intersections==nullptr)
-                                return(true);
-                            returnValue=true;
-                        }
-                    }
-                }
+void CCollisionRoutine::_getObjectWorldAabb(CSceneObject* obj,C3Vector& minV,C3Vector& maxV)
+{ // axis-aligned box enclosing the object's bounding box, in world coordinates
+    C3Vector halfSizes(0.0001f,0.0001f,0.0001f);
+    C7Vector tr;
+    if (obj->getObjectType()==sim_object_shape_type)
+    {
+        halfSizes=((CShape*)obj)->getBoundingBoxHalfSizes();
+        tr=obj->getFullCumulativeTransformation();
+    }
+    else if (obj->getObjectType()==sim_object_octree_type)
+        ((COctree*)obj)->getTransfAndHalfSizeOfBoundingBox(tr,halfSizes);
+    else if (obj->getObjectType()==sim_object_pointcloud_type)
+        ((CPointCloud*)obj)->getTransfAndHalfSizeOfBoundingBox(tr,halfSizes);
+    else
+        tr=obj->getFullCumulativeTransformation();
+    C4X4Matrix m(tr.getMatrix());
+    for (size_t k=0;k<3;k++)
+    {
+        float e=0.0001f; // small tolerance
+        for (size_t l=0;l<3;l++)
+            e+=fabs(m.M.axis[l](k))*halfSizes(l);
+        minV(k)=m.X(k)-e;
+        maxV(k)=m.X(k)+e;
+    }
+}
+
+void CCollisionRoutine::_getBroadPhasePairs(const std::vector<CSceneObject*>& group1,const std::vector<CSceneObject*>* group2,std::vector<CSceneObject*>& pairs)
+{   // Sweep and prune along x over the world bounding boxes. If group2 is nullptr, group1 is checked against itself
+    // (respecting the collection self-collision indicators). Pairs are returned in the same order as a nested
+    // loop over group1, then group2, would produce them, and never twice the same (unordered) pair
+    std::vector<SBroadPhaseItem> items;
+    for (int g=0;g<2;g++)
+    {
+        const std::vector<CSceneObject*>* group=&group1;
+        if (g==1)
+            group=group2;
+        if (group==nullptr)
+            break;
+        for (size_t i=0;i<group->size();i++)
+        {
+            SBroadPhaseItem item;
+            _getObjectWorldAabb(group->at(i),item.minV,item.maxV);
+            item.index=int(i);
+            item.group=g;
+            items.push_back(item);
+        }
+    }
+    std::sort(items.begin(),items.end()); // along x
+
+    std::vector<std::pair<int,int>> candidates; // group1 index, group2 (or group1) index
+    std::vector<const SBroadPhaseItem*> active;
+    for (size_t i=0;i<items.size();i++)
+    {
+        const SBroadPhaseItem* it=&items[i];
+        size_t j=0;
+        while (j<active.size())
+        {
+            const SBroadPhaseItem* other=active[j];
+            if (other->maxV(0)<it->minV(0))
+            { // this one can't overlap anymore
+                active[j]=active[active.size()-1];
+                active.pop_back();
+                continue;
+            }
+            j++;
+            if ( (group2!=nullptr)&&(other->group==it->group) )
+                continue;
+            if ( (other->maxV(1)<it->minV(1))||(it->maxV(1)<other->minV(1))||(other->maxV(2)<it->minV(2))||(it->maxV(2)<other->minV(2)) )
+                continue;
+            if (group2==nullptr)
+                candidates.push_back(std::make_pair(std::min<int>(it->index,other->index),std::max<int>(it->index,other->index)));
+            else
+            {
+                if (it->group==0)
+                    candidates.push_back(std::make_pair(it->index,other->index));
+                else
+                    candidates.push_back(std::make_pair(other->index,it->index));
             }
         }
+        active.push_back(it);
+    }
+    std::sort(candidates.begin(),candidates.end());
+
+    const std::vector<CSceneObject*>& grp2=(group2!=nullptr)?group2[0]:group1;
+    std::unordered_set<unsigned long long int> checkedPairs;
+    for (size_t i=0;i<candidates.size();i++)
+    {
+        CSceneObject* obj1=group1[candidates[i].first];
+        CSceneObject* obj2=grp2[candidates[i].second];
+        if (obj1==obj2)
+            continue; // We never check an object against itself!
+        if ( (group2==nullptr)&&(abs(obj1->getCollectionSelfCollisionIndicator()-obj2->getCollectionSelfCollisionIndicator())==1) )
+            continue; // the collection self collision indicators differences is 1
+        if (checkedPairs.insert(getUnorderedPairKey(obj1,obj2)).second)
+        {
+            pairs.push_back(obj1);
+            pairs.push_back(obj2);
+        }
     }
-    return(returnValue);
 }
 
 bool CCollisionRoutine::_areObjectBoundingBoxesOverlapping(CSceneObject* obj1,CSceneObject* obj2)
@@ -275,6 +370,7 @@ bool CCollisionRoutine::_doesOctreeCollideWithShape(COctree* octree,CShape* shap
         return(false);
 
     // Before building collision nodes, check if the shape's bounding boxes collide (new since 9/7/2014):
+    shape->adoptBuiltMeshCalculationStructure();
     if (!shape->isMeshCalculationStructureInitialized())
     {
         if (!_areObjectBoundingBoxesOverlapping(octree,shape))
@@ -455,37 +551,7 @@ bool CCollisionRoutine::_doesGroupCollideWithItself(const std::vector<CSceneObje
     // append intersection segments to the vector.
 
     std::vector<CSceneObject*> objPairs; // Object pairs we need to check
-    for (size_t i=0;i<group.size();i++)
-    {
-        CSceneObject* obj1=group[i];
-        int csci1=obj1->getCollectionSelfCollisionIndicator();
-        for (size_t j=0;j<group.size();j++)
-        {
-            CSceneObject* obj2=group[j];
-            int csci2=obj2->getCollectionSelfCollisionIndicator();
-            if (obj1!=obj2)
-            { // We never check an object against itself!
-                if (abs(csci1-csci2)!=1)
-                { // the collection self collision indicators differences is not 1
-                    // We now check if these partners are already present in objPairs
-                    bool absent=true;
-                    for (size_t k=0;k<objPairs.size()/2;k++)
-                    {
-                        if ( ( (objPairs[2*k+0]==obj1)&&(objPairs[2*k+1]==obj2) ) || ( (objPairs[2*k+0]==obj2)&&(objPairs[2*k+1]==obj1) ) )
-                        {
-                            absent=false;
-                            break;
-                        }
-                    }
-                    if (absent)
-                    {
-                        objPairs.push_back(obj1);
-                        objPairs.push_back(obj2);
-                    }
-                }
-            }
-        }
-    }
+    _getBroadPhasePairs(group,nullptr,objPairs);
 
     // Here we check all objects from the two groups against each other
     bool returnValue=false;
@@ -7,6 +7,14 @@
 #include "pointCloud.h"
 #include <vector>
 
+struct SBroadPhaseItem {
+    C3Vector minV;
+    C3Vector maxV;
+    int index;
+    int group;
+    bool operator<(const SBroadPhaseItem& other) const { return(minV(0)<other.minV(0)); }
+};
+
 
 //FULLY STATIC CLASS
 class CCollisionRoutine  
@@ -17,6 +25,8 @@ public:
 
     static bool doEntitiesCollide(int entity1ID,int entity2ID,std::vector<float>* intersections,bool overrideCollidableFlagIfObject1,bool overrideCollidableFlagIfObject2,int collidingObjectIDs[2]);
 
+    static unsigned long long int getUnorderedPairKey(const CSceneObject* obj1,const CSceneObject* obj2);
+
 private:
     static bool _doesObjectCollideWithObject(CSceneObject* object1,CSceneObject* object2,bool overrideObject1CollidableFlag,bool overrideObject2CollidableFlag,std::vector<float>* intersections);
     static bool _doesShapeCollideWithShape(CShape* shape1,CShape* shape2,std::vector<float>* intersections,bool overrideShape1CollidableFlag,bool overrideShape2CollidableFlag);
@@ -34,4 +44,6 @@ private:
     static bool _doesGroupCollideWithGroup(const std::vector<CSceneObject*>& group1,const std::vector<CSceneObject*>& group2,std::vector<float>* intersections,int collidingGroupObjects[2]);
 
     static bool _areObjectBoundingBoxesOverlapping(CSceneObject* obj1,CSceneObject* obj2);
+    static void _getObjectWorldAabb(CSceneObject* obj,C3Vector& minV,C3Vector& maxV);
+    static void _getBroadPhasePairs(const std::vector<CSceneObject*>& group1,const std::vector<CSceneObject*>* group2,std::vector<CSceneObject*>& pairs);
 };
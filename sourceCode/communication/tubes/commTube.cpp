@@ -1,8 +1,9 @@
 #include "commTube.h"
 #include "tt.h"
+#include <algorithm>
 
 
-CCommTube::CCommTube(int header,const char* identifier,int firstPartner,bool killAtSimulationEnd,int readBufferSize)
+CCommTube::CCommTube(int header,const char* identifier,int firstPartner,bool killAtSimulationEnd,int readBufferSize,bool overwriteOldest)
 {
     _header=header;
     _identifier=identifier;
@@ -10,7 +11,8 @@ CCommTube::CCommTube(int header,const char* identifier,int firstPartner,bool kil
     _partner[1]=-1; // Not yet connected
     _killPartnerAtSimulationEnd[0]=killAtSimulationEnd;
     _killPartnerAtSimulationEnd[1]=true;
-    _readBufferSizes[0]=tt::getLimitedInt(1,10000,readBufferSize);
+    _setBufferSize(0,readBufferSize,overwriteOldest);
+    _setBufferSize(1,1,true);
 }
 
 CCommTube::~CCommTube()
@@ -22,11 +24,21 @@ bool CCommTube::isConnected()
     return(_partner[1]!=-1);
 }
 
-void CCommTube::connectPartner(int secondPartner,bool killAtSimulationEnd,int readBufferSize)
+void CCommTube::connectPartner(int secondPartner,bool killAtSimulationEnd,int readBufferSize,bool overwriteOldest)
 {
     _partner[1]=secondPartner;
     _killPartnerAtSimulationEnd[1]=killAtSimulationEnd;
-    _readBufferSizes[1]=tt::getLimitedInt(1,10000,readBufferSize);
+    _setBufferSize(1,readBufferSize,overwriteOldest);
+}
+
+void CCommTube::_setBufferSize(int partnerIndex,int readBufferSize,bool overwriteOldest)
+{ // slots are created lazily, when first written to
+    SCommTubeBuffer& buff=_packets[partnerIndex];
+    buff.slots.clear();
+    buff.capacity=tt::getLimitedInt(1,10000,readBufferSize);
+    buff.start=0;
+    buff.count=0;
+    buff.overwriteOldest=overwriteOldest;
 }
 
 bool CCommTube::disconnectPartner(int partner)
@@ -80,10 +92,8 @@ void CCommTube::_removeAllPackets()
 
 void CCommTube::_removePacketsOfPartner(int partnerIndex)
 {
-    for (int i=0;i<int(_packets[partnerIndex].size());i++)
-        delete[] _packets[partnerIndex][i];
-    _packets[partnerIndex].clear();
-    _packetSizes[partnerIndex].clear();
+    _packets[partnerIndex].start=0;
+    _packets[partnerIndex].count=0;
 }
 
 void CCommTube::_swapPartners()
@@ -96,53 +106,87 @@ void CCommTube::_swapPartners()
     _killPartnerAtSimulationEnd[0]=_killPartnerAtSimulationEnd[1];
     _killPartnerAtSimulationEnd[1]=p99Save;
 
-    p0Save=_readBufferSizes[0];
-    _readBufferSizes[0]=_readBufferSizes[1];
-    _readBufferSizes[1]=p0Save;
-
-    _packets[0].swap(_packets[1]);
-    _packetSizes[0].swap(_packetSizes[1]);
+    std::swap(_packets[0],_packets[1]);
 }
 
-bool CCommTube::writeData(int partner,char* data,int dataSize)
-{ // data is not copied!
+bool CCommTube::writeData(int partner,const char* data,int dataSize)
+{ // data is copied
     for (int i=0;i<2;i++)
     {
         if (_partner[i]==partner)
         {
-            int j=1-i;
-            _packets[j].push_back(data);
-            _packetSizes[j].push_back(dataSize);
-            if (int(_packets[j].size())>_readBufferSizes[j])
-            { // We remove the first element
-                delete[] _packets[j][0];
-                _packets[j].erase(_packets[j].begin());
-                _packetSizes[j].erase(_packetSizes[j].begin());
+            SCommTubeBuffer& buff=_packets[1-i];
+            if (buff.count>=buff.capacity)
+            {
+                if (!buff.overwriteOldest)
+                    return(false);
+                // We drop the oldest packet:
+                buff.start=(buff.start+1)%buff.capacity;
+                buff.count--;
             }
+            size_t slot=size_t((buff.start+buff.count)%buff.capacity);
+            if (slot>=buff.slots.size())
+                buff.slots.resize(slot+1);
+            buff.slots[slot].assign(data,data+dataSize);
+            buff.count++;
             return(true);
         }
     }
     return(false);
 }
 
+const char* CCommTube::_popPacket(int partnerIndex,int& dataSize)
+{ // returned pointer stays valid until the slot is written again
+    SCommTubeBuffer& buff=_packets[partnerIndex];
+    if (buff.count==0)
+        return(nullptr);
+    std::vector<char>& packet=buff.slots[size_t(buff.start)];
+    buff.start=(buff.start+1)%buff.capacity;
+    buff.count--;
+    dataSize=int(packet.size());
+    return(packet.data());
+}
+
 char* CCommTube::readData(int partner,int& dataSize)
-{ // data is not copied!
+{ // returned buffer has to be released with delete[]
+    const char* view=readDataView(partner,dataSize);
+    if (view==nullptr)
+        return(nullptr);
+    char* retVal=new char[dataSize];
+    for (int i=0;i<dataSize;i++)
+        retVal[i]=view[i];
+    return(retVal);
+}
+
+const char* CCommTube::readDataView(int partner,int& dataSize)
+{ // view is valid until the next write to this tube
+    for (int j=0;j<2;j++)
+    {
+        if (_partner[j]==partner)
+            return(_popPacket(j,dataSize));
+    }
+    return(nullptr);
+}
+
+int CCommTube::readAllDataViews(int partner,std::vector<const char*>& data,std::vector<int>& dataSizes)
+{ // views are valid until the next write to this tube. Returns the number of packets read
+    data.clear();
+    dataSizes.clear();
     for (int j=0;j<2;j++)
     {
         if (_partner[j]==partner)
         {
-            if (_packets[j].size()!=0)
+            int dataSize;
+            const char* packet;
+            while ((packet=_popPacket(j,dataSize))!=nullptr)
             {
-                char* retVal=_packets[j][0];
-                dataSize=_packetSizes[j][0];
-                _packets[j].erase(_packets[j].begin());
-                _packetSizes[j].erase(_packetSizes[j].begin());
-                return(retVal);
+                data.push_back(packet);
+                dataSizes.push_back(dataSize);
             }
-            return(nullptr);
+            break;
         }
     }
-    return(nullptr);
+    return(int(data.size()));
 }
 
 bool CCommTube::isPartnerThere(int partner)
@@ -167,21 +211,21 @@ int CCommTube::getTubeStatus(int tubeHandle,int& readBufferFill,int& writeBuffer
         retVal=1;
         if (tubeHandle==_partner[0])
         {
-            writeBufferFill=(int)_packets[1].size();
-            readBufferFill=(int)_packets[0].size();
+            writeBufferFill=_packets[1].count;
+            readBufferFill=_packets[0].count;
         }
         else
         {
-            writeBufferFill=(int)_packets[0].size();
-            readBufferFill=(int)_packets[1].size();
+            writeBufferFill=_packets[0].count;
+            readBufferFill=_packets[1].count;
         }
     }
     else
     {
         if (tubeHandle==_partner[0])
-            readBufferFill=(int)_packets[0].size();
+            readBufferFill=_packets[0].count;
         else
-            readBufferFill=(int)_packets[1].size();
+            readBufferFill=_packets[1].count;
     }
     return(retVal);
 }
@@ -3,19 +3,31 @@
 #include <string>
 #include <vector>
 
+struct SCommTubeBuffer
+{ // fixed-capacity ring buffer of packets. Slot storage is kept and reused, so that
+  // in steady state writing a packet does not allocate
+    std::vector<std::vector<char> > slots;
+    int capacity;
+    int start;
+    int count;
+    bool overwriteOldest; // when full: drop the oldest packet (true), or reject the new one (false)
+};
+
 class CCommTube
 {
 
 public:
-    CCommTube(int header,const char* identifier,int firstPartner,bool killAtSimulationEnd,int readBufferSize);
+    CCommTube(int header,const char* identifier,int firstPartner,bool killAtSimulationEnd,int readBufferSize,bool overwriteOldest);
     ~CCommTube();
 
     bool isConnected();
-    void connectPartner(int secondPartner,bool killAtSimulationEnd,int readBufferSize);
+    void connectPartner(int secondPartner,bool killAtSimulationEnd,int readBufferSize,bool overwriteOldest);
     bool disconnectPartner(int partner); // return value true means this object needs destruction
     bool simulationEnded(); // return value true means this object needs destruction
-    bool writeData(int partner,char* data,int dataSize); // data is not copied!
-    char* readData(int partner,int& dataSize); // data is not copied!
+    bool writeData(int partner,const char* data,int dataSize); // data is copied
+    char* readData(int partner,int& dataSize); // returned buffer has to be released with delete[]
+    const char* readDataView(int partner,int& dataSize); // view is valid until the next write to this tube
+    int readAllDataViews(int partner,std::vector<const char*>& data,std::vector<int>& dataSizes); // views are valid until the next write to this tube
     bool isPartnerThere(int partner);
     bool isSameHeaderAndIdentifier(int header,const char* identifier);
     int getTubeStatus(int tubeHandle,int& readBufferFill,int& writeBufferFill); // -1: not existant, 0: not connected, 1: connected
@@ -25,12 +37,12 @@ protected:
     void _removeAllPackets();
     void _removePacketsOfPartner(int partnerIndex);
     void _swapPartners();
+    void _setBufferSize(int partnerIndex,int readBufferSize,bool overwriteOldest);
+    const char* _popPacket(int partnerIndex,int& dataSize);
 
     int _header;
     std::string _identifier;
     int _partner[2];
     bool _killPartnerAtSimulationEnd[2]; // false --> don't kill
-    int _readBufferSizes[2];
-    std::vector<char*> _packets[2]; // _packets[0] is from partner2 to partner1, packets[1] is from partner1 to partner2
-    std::vector<int> _packetSizes[2];
+    SCommTubeBuffer _packets[2]; // _packets[0] is from partner2 to partner1, packets[1] is from partner1 to partner2
 };
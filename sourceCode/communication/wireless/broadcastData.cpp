@@ -13,6 +13,7 @@ CBroadcastData::CBroadcastData(int emitterID,int targetID,int dataHeader,std::st
     _antennaHandle=antennaHandle;
     _emissionAngle1=emissionAngle1;
     _emissionAngle2=emissionAngle2;
+    _sequence=0;
     _data=new char[dataLength];
     _dataLength=dataLength;
     for (int i=0;i<dataLength;i++)
@@ -44,6 +45,36 @@ int CBroadcastData::getAntennaHandle()
     return(_antennaHandle);
 }
 
+int CBroadcastData::getDataHeader() const
+{
+    return(_dataHeader);
+}
+
+const std::string& CBroadcastData::getDataName() const
+{
+    return(_dataName);
+}
+
+float CBroadcastData::getActionRadius() const
+{
+    return(_actionRadius);
+}
+
+float CBroadcastData::getTimeOutSimulationTime() const
+{
+    return(_timeOutSimulationTime);
+}
+
+void CBroadcastData::setSequence(unsigned int s)
+{
+    _sequence=s;
+}
+
+unsigned int CBroadcastData::getSequence() const
+{
+    return(_sequence);
+}
+
 char* CBroadcastData::receiveData(int receiverID,float simulationTime,int dataHeader,std::string& dataName,int antennaHandle,int& dataLength,int& senderID,int& dataHeaderR,std::string& dataNameR,bool removeMessageForThisReceiver)
 {
     C7Vector antennaConf1;
@@ -11,6 +11,12 @@ public:
     bool doesRequireDestruction(float simulationTime);
     bool receiverPresent(int receiverID);
     int getAntennaHandle();
+    int getDataHeader() const;
+    const std::string& getDataName() const;
+    float getActionRadius() const;
+    float getTimeOutSimulationTime() const;
+    void setSequence(unsigned int s);
+    unsigned int getSequence() const;
 
 protected:
     int _emitterID;
@@ -25,4 +31,5 @@ protected:
     char* _data;
     int _dataLength;
     std::vector<int> _receivedReceivers;
+    unsigned int _sequence; // order of emission
 };
@@ -3,6 +3,10 @@
 #include "broadcastDataContainer.h"
 #include "app.h"
 #include "vDateTime.h"
+#include <algorithm>
+#include <unordered_set>
+
+#define SPATIAL_GRID_CELL_PADDING 1.5f // emitters may move by half their action radius between two samplings
 
 bool CBroadcastDataContainer::_wirelessForceShow_emission=false;
 bool CBroadcastDataContainer::_wirelessForceShow_reception=false;
@@ -30,7 +34,11 @@ void CBroadcastDataContainer::setWirelessForceShow_reception(bool f)
 
 CBroadcastDataContainer::CBroadcastDataContainer()
 {
-    
+    _nextSequence=0;
+    _spatialGridCellSize=1.0f;
+    _spatialGridPoseChangeCounter=0;
+    _spatialGridSimulationTime=0.0f;
+    _spatialGridValid=false;
 }
 
 CBroadcastDataContainer::~CBroadcastDataContainer()
@@ -52,7 +60,9 @@ void CBroadcastDataContainer::broadcastData(int emitterID,int targetID,int dataH
 { // Called by the SIM or UI thread
     EASYLOCK(_objectMutex);
     CBroadcastData* it=new CBroadcastData(emitterID,targetID,dataHeader,dataName,timeOutSimulationTime,actionRadius,antennaHandle,emissionAngle1,emissionAngle2,data,dataLength);
+    it->setSequence(_nextSequence++);
     _allObjects.push_back(it);
+    _addToIndices(it);
     if (App::currentWorld->environment->getVisualizeWirelessEmitters()||_wirelessForceShow_emission)
     {
         bool err=false;
@@ -79,9 +89,11 @@ char* CBroadcastDataContainer::receiveData(int receiverID,float simulationTime,i
     EASYLOCK(_objectMutex);
     int originalIndex=index;
     char* retVal=nullptr;
-    for (size_t i=0;i<_allObjects.size();i++)
+    std::vector<CBroadcastData*> candidates; // in emission order
+    _getCandidates(simulationTime,dataHeader,dataName,antennaHandle,candidates);
+    for (size_t i=0;i<candidates.size();i++)
     {
-        retVal=_allObjects[i]->receiveData(receiverID,simulationTime,dataHeader,dataName,antennaHandle,dataLength,senderID,dataHeaderR,dataNameR,originalIndex==-1);
+        retVal=candidates[i]->receiveData(receiverID,simulationTime,dataHeader,dataName,antennaHandle,dataLength,senderID,dataHeaderR,dataNameR,originalIndex==-1);
         if (retVal!=nullptr)
         {
             if (originalIndex==-1)
@@ -91,9 +103,9 @@ char* CBroadcastDataContainer::receiveData(int receiverID,float simulationTime,i
                     bool err=false;
                     C3Vector antennaPos1;
                     antennaPos1.clear();
-                    if (_allObjects[i]->getAntennaHandle()!=sim_handle_default)
+                    if (candidates[i]->getAntennaHandle()!=sim_handle_default)
                     {
-                        CSceneObject* it=App::currentWorld->sceneObjects->getObjectFromHandle(_allObjects[i]->getAntennaHandle());
+                        CSceneObject* it=App::currentWorld->sceneObjects->getObjectFromHandle(candidates[i]->getAntennaHandle());
                         if (it!=nullptr)
                             antennaPos1=it->getCumulativeTransformation().X;
                         else
@@ -132,6 +144,7 @@ void CBroadcastDataContainer::removeAllObjects()
     for (size_t i=0;i<_allObjects.size();i++)
         delete _allObjects[i];
     _allObjects.clear();
+    _rebuildIndices();
     for (size_t i=0;i<_allVisualObjects.size();i++)
         delete _allVisualObjects[i];
     _allVisualObjects.clear();
@@ -142,18 +155,31 @@ void CBroadcastDataContainer::removeObject(int index)
     EASYLOCK(_objectMutex);
     delete _allObjects[index];
     _allObjects.erase(_allObjects.begin()+index);
+    _rebuildIndices();
 }
 
 void CBroadcastDataContainer::removeTimedOutObjects(float simulationTime)
 {
     EASYLOCK(_objectMutex);
-    for (int i=0;i<int(_allObjects.size());i++)
+    std::unordered_set<CBroadcastData*> timedOut;
+    while ( (_timeOuts.size()>0)&&_timeOuts[0].object->doesRequireDestruction(simulationTime) )
     {
-        if (_allObjects[i]->doesRequireDestruction(simulationTime))
+        timedOut.insert(_timeOuts[0].object);
+        std::pop_heap(_timeOuts.begin(),_timeOuts.end(),_isTimeOutLater);
+        _timeOuts.pop_back();
+    }
+    if (timedOut.size()>0)
+    { // remove them in one pass, keeping the emission order:
+        size_t j=0;
+        for (size_t i=0;i<_allObjects.size();i++)
         {
-            removeObject(i);
-            i--;
+            if (timedOut.find(_allObjects[i])!=timedOut.end())
+                delete _allObjects[i];
+            else
+                _allObjects[j++]=_allObjects[i];
         }
+        _allObjects.resize(j);
+        _rebuildIndices();
     }
 
     for (int i=0;i<int(_allVisualObjects.size());i++)
@@ -173,3 +199,169 @@ void CBroadcastDataContainer::visualizeCommunications(int pcTimeInMs)
     for (size_t i=0;i<_allVisualObjects.size();i++)
         _allVisualObjects[i]->visualize();
 }
+
+bool CBroadcastDataContainer::_isTimeOutLater(const SBroadcastDataTimeOut& a,const SBroadcastDataTimeOut& b)
+{ // used with std::push_heap/pop_heap, so that the first object to time out is on top
+    return(a.timeOut>b.timeOut);
+}
+
+bool CBroadcastDataContainer::_isEmittedBefore(const CBroadcastData* a,const CBroadcastData* b)
+{
+    return(a->getSequence()<b->getSequence());
+}
+
+unsigned long long int CBroadcastDataContainer::_getHeaderAndNameKey(int dataHeader,const std::string& dataName)
+{ // collisions are harmless, the exact check happens later
+    return( (((unsigned long long int)(unsigned int)dataHeader)<<32)^(unsigned long long int)std::hash<std::string>()(dataName) );
+}
+
+unsigned long long int CBroadcastDataContainer::_getGridKey(long long int x,long long int y,long long int z) const
+{ // 21 bits per axis. Collisions are harmless, the exact check happens later
+    return( ((unsigned long long int)(x&0x1fffff)<<42)|((unsigned long long int)(y&0x1fffff)<<21)|(unsigned long long int)(z&0x1fffff) );
+}
+
+void CBroadcastDataContainer::_getGridCell(const C3Vector& pos,long long int cell[3]) const
+{
+    for (size_t i=0;i<3;i++)
+    {
+        double c=floor(double(pos(i))/double(_spatialGridCellSize));
+        c=std::max<double>(-1.0e15,std::min<double>(1.0e15,c)); // also handles infinite values
+        cell[i]=(long long int)c;
+    }
+}
+
+bool CBroadcastDataContainer::_getAntennaPosition(int antennaHandle,C3Vector& pos) const
+{ // returns false if the antenna doesn't exist anymore
+    pos.clear();
+    if (antennaHandle!=sim_handle_default)
+    {
+        CSceneObject* it=App::currentWorld->sceneObjects->getObjectFromHandle(antennaHandle);
+        if (it==nullptr)
+            return(false);
+        pos=it->getCumulativeTransformation().X;
+    }
+    return(true);
+}
+
+void CBroadcastDataContainer::_addToIndices(CBroadcastData* it)
+{
+    _objectsFromHeader[it->getDataHeader()].push_back(it);
+    _objectsFromHeaderAndName[_getHeaderAndNameKey(it->getDataHeader(),it->getDataName())].push_back(it);
+    SBroadcastDataTimeOut t;
+    t.timeOut=it->getTimeOutSimulationTime();
+    t.object=it;
+    _timeOuts.push_back(t);
+    std::push_heap(_timeOuts.begin(),_timeOuts.end(),_isTimeOutLater);
+    if (_spatialGridValid)
+    {
+        if (it->getActionRadius()*SPATIAL_GRID_CELL_PADDING<=_spatialGridCellSize)
+        {
+            C3Vector pos;
+            if (_getAntennaPosition(it->getAntennaHandle(),pos))
+            {
+                long long int cell[3];
+                _getGridCell(pos,cell);
+                _spatialGrid[_getGridKey(cell[0],cell[1],cell[2])].push_back(it);
+            }
+        }
+        else
+            _spatialGridValid=false; // cell size has to grow
+    }
+}
+
+void CBroadcastDataContainer::_rebuildIndices()
+{
+    _objectsFromHeader.clear();
+    _objectsFromHeaderAndName.clear();
+    _timeOuts.clear();
+    _spatialGrid.clear();
+    _spatialGridValid=false;
+    for (size_t i=0;i<_allObjects.size();i++)
+        _addToIndices(_allObjects[i]);
+}
+
+void CBroadcastDataContainer::_updateSpatialGridIfNeeded(float simulationTime)
+{ // Emitter antennas can move. During simulation, positions are sampled at most once per simulation step, since
+  // receivers typically move in-between receptions. The cell size is padded, so that emitters that moved a bit
+  // since sampling are still found. While the simulation is stopped or paused, positions are sampled again after any pose change
+    if (_spatialGridValid)
+    {
+        if (App::currentWorld->simulation->isSimulationRunning())
+        {
+            if (simulationTime==_spatialGridSimulationTime)
+                return;
+        }
+        else
+        {
+            if (CSceneObject::getPoseChangeCounter()==_spatialGridPoseChangeCounter)
+                return;
+        }
+    }
+    _spatialGrid.clear();
+    float maxActionRadius=0.001f;
+    for (size_t i=0;i<_allObjects.size();i++)
+        maxActionRadius=std::max<float>(maxActionRadius,_allObjects[i]->getActionRadius());
+    _spatialGridCellSize=maxActionRadius*SPATIAL_GRID_CELL_PADDING;
+    for (size_t i=0;i<_allObjects.size();i++)
+    {
+        C3Vector pos;
+        if (_getAntennaPosition(_allObjects[i]->getAntennaHandle(),pos))
+        { // objects with a destroyed antenna cannot be received anyway
+            long long int cell[3];
+            _getGridCell(pos,cell);
+            _spatialGrid[_getGridKey(cell[0],cell[1],cell[2])].push_back(_allObjects[i]);
+        }
+    }
+    _spatialGridPoseChangeCounter=CSceneObject::getPoseChangeCounter();
+    _spatialGridSimulationTime=simulationTime;
+    _spatialGridValid=true;
+}
+
+void CBroadcastDataContainer::_getCandidates(float simulationTime,int dataHeader,const std::string& dataName,int antennaHandle,std::vector<CBroadcastData*>& candidates)
+{ // returns a superset of the receivable objects, in emission order
+    candidates.clear();
+    if (dataHeader!=-1)
+    { // header (and name) are selective enough
+        std::vector<CBroadcastData*>* bucket=nullptr;
+        if (dataName.length()!=0)
+        {
+            auto it=_objectsFromHeaderAndName.find(_getHeaderAndNameKey(dataHeader,dataName));
+            if (it!=_objectsFromHeaderAndName.end())
+                bucket=&it->second;
+        }
+        else
+        {
+            auto it=_objectsFromHeader.find(dataHeader);
+            if (it!=_objectsFromHeader.end())
+                bucket=&it->second;
+        }
+        if (bucket!=nullptr)
+            candidates.assign(bucket->begin(),bucket->end());
+        return;
+    }
+    C3Vector pos;
+    if (!_getAntennaPosition(antennaHandle,pos))
+        return; // that shouldn't happen!
+    _updateSpatialGridIfNeeded(simulationTime);
+    // The cell size is at least the largest action radius: only the 27 neighbouring cells need to be checked
+    long long int cell[3];
+    _getGridCell(pos,cell);
+    std::unordered_set<unsigned long long int> visitedKeys; // keys could collide
+    for (long long int x=cell[0]-1;x<=cell[0]+1;x++)
+    {
+        for (long long int y=cell[1]-1;y<=cell[1]+1;y++)
+        {
+            for (long long int z=cell[2]-1;z<=cell[2]+1;z++)
+            {
+                unsigned long long int key=_getGridKey(x,y,z);
+                if (visitedKeys.insert(key).second)
+                {
+                    auto it=_spatialGrid.find(key);
+                    if (it!=_spatialGrid.end())
+                        candidates.insert(candidates.end(),it->second.begin(),it->second.end());
+                }
+            }
+        }
+    }
+    std::sort(candidates.begin(),candidates.end(),_isEmittedBefore);
+}
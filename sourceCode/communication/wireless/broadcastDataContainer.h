@@ -3,6 +3,13 @@
 #include "broadcastData.h"
 #include "vMutex.h"
 #include "broadcastDataVisual.h"
+#include <unordered_map>
+
+struct SBroadcastDataTimeOut
+{
+    float timeOut;
+    CBroadcastData* object;
+};
 
 class CBroadcastDataContainer
 {
@@ -25,9 +32,31 @@ public:
     static void setWirelessForceShow_reception(bool f);
 
 private:
+    void _addToIndices(CBroadcastData* it);
+    void _rebuildIndices();
+    void _updateSpatialGridIfNeeded(float simulationTime);
+    bool _getAntennaPosition(int antennaHandle,C3Vector& pos) const;
+    void _getGridCell(const C3Vector& pos,long long int cell[3]) const;
+    unsigned long long int _getGridKey(long long int x,long long int y,long long int z) const;
+    static unsigned long long int _getHeaderAndNameKey(int dataHeader,const std::string& dataName);
+    static bool _isTimeOutLater(const SBroadcastDataTimeOut& a,const SBroadcastDataTimeOut& b);
+    static bool _isEmittedBefore(const CBroadcastData* a,const CBroadcastData* b);
+    void _getCandidates(float simulationTime,int dataHeader,const std::string& dataName,int antennaHandle,std::vector<CBroadcastData*>& candidates);
+
     VMutex _objectMutex;
 
-    std::vector<CBroadcastData*> _allObjects;
+    std::vector<CBroadcastData*> _allObjects; // in emission order
+    unsigned int _nextSequence;
+
+    // Indices. All are only used to preselect candidates, the exact checks happen in CBroadcastData::receiveData:
+    std::unordered_map<int,std::vector<CBroadcastData*> > _objectsFromHeader;
+    std::unordered_map<unsigned long long int,std::vector<CBroadcastData*> > _objectsFromHeaderAndName;
+    std::unordered_map<unsigned long long int,std::vector<CBroadcastData*> > _spatialGrid; // emitter positions, cell size is the padded largest action radius
+    float _spatialGridCellSize;
+    unsigned int _spatialGridPoseChangeCounter; // while not running, emitter positions are sampled again after any pose change
+    float _spatialGridSimulationTime; // while running, emitter positions are sampled once per simulation step
+    bool _spatialGridValid;
+    std::vector<SBroadcastDataTimeOut> _timeOuts; // min-heap on time out
     std::vector<CBroadcastDataVisual*> _allVisualObjects;
     static bool _wirelessForceShow_emission;
     static bool _wirelessForceShow_reception;
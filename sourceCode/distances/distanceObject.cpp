@@ -9,6 +9,7 @@
 #include "gV.h"
 #include "simStrings.h"
 #include "vDateTime.h"
+#include "stepProfiler.h"
 #include "pluginContainer.h"
 #include "distanceRendering.h"
 #include "base64.h"
@@ -208,6 +209,9 @@ void CDistanceObject::clearDistanceResult()
 
 float CDistanceObject::handleDistance()
 {
+    CStepProfilerScope profilerScope("distance");
+    if (profilerScope.isActive())
+        profilerScope.setName(getObjectName().c_str());
     clearDistanceResult();
     if (!App::currentWorld->mainSettings->distanceCalculationEnabled)
         return(-1.0);
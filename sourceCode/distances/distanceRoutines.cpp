@@ -1,7 +1,9 @@
 #include "distanceRoutines.h"
+#include "collisionRoutines.h"
 #include "pluginContainer.h"
 #include "tt.h"
 #include "app.h"
+#include <unordered_set>
 
 bool CDistanceRoutine::_distanceCachingOff=false;
 std::vector<SExtCache> CDistanceRoutine::_extendedCacheBuffer;
@@ -771,6 +773,7 @@ void CDistanceRoutine::_generateValidPairsFromGroupObject(const std::vector<CSce
 
 void CDistanceRoutine::_generateValidPairsFromGroupGroup(const std::vector<CSceneObject*>& group1,const std::vector<CSceneObject*>& group2,std::vector<CSceneObject*>& pairs,bool collectionSelfDistanceCheck)
 {
+    std::unordered_set<unsigned long long int> presentPairs;
     for (size_t i=0;i<group1.size();i++)
     {
         CSceneObject* obj1=group1[i];
@@ -783,17 +786,8 @@ void CDistanceRoutine::_generateValidPairsFromGroupGroup(const std::vector<CScen
             { // We never check an object against itself!
                 if ( (abs(csci1-csci2)!=1)||(!collectionSelfDistanceCheck) )
                 { // the collection self collision indicators differences is not 1
-                    // We now check if these partners are already present in objPairs
-                    bool absent=true;
-                    for (size_t k=0;k<pairs.size()/2;k++)
-                    {
-                        if ( (pairs[2*k+0]==obj2)&&(pairs[2*k+1]==obj1) )
-                        {
-                            absent=false;
-                            break;
-                        }
-                    }
-                    if (absent)
+                    // We now check if these partners are already present in pairs
+                    if (presentPairs.insert(CCollisionRoutine::getUnorderedPairKey(obj1,obj2)).second)
                     {
                         pairs.push_back(obj1);
                         pairs.push_back(obj2);
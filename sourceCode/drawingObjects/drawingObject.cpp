@@ -4,6 +4,7 @@
 #include "tt.h"
 #include "easyLock.h"
 #include "drawingObjectRendering.h"
+#include <algorithm>
 
 float CDrawingObject::getSize() const
 {
@@ -54,6 +55,7 @@ CDrawingObject::CDrawingObject(int theObjectType,float size,float duplicateToler
     maxItemCount=tt::getLimitedInt(1,10000000,maxItemCount);
     _maxItemCount=maxItemCount;
     _startItem=0;
+    _duplicateGridValid=true;
     int tmp=theObjectType&0x001f;
     if (theObjectType&sim_drawing_vertexcolors)
     {
@@ -112,6 +114,7 @@ int CDrawingObject::getObjectID() const
 
 void CDrawingObject::adjustForFrameChange(const C7Vector& preCorrection)
 {
+    _duplicateGridValid=false;
     for (int i=0;i<int(_data.size())/floatsPerItem;i++)
     {
         for (int j=0;j<verticesPerItem;j++)
@@ -132,6 +135,7 @@ void CDrawingObject::adjustForFrameChange(const C7Vector& preCorrection)
 
 void CDrawingObject::adjustForScaling(float xScale,float yScale,float zScale)
 {
+    _duplicateGridValid=false;
     float avgScaling=(xScale+yScale+zScale)/3.0f;
     int tmp=_objectType&0x001f;
     if ((tmp!=sim_drawing_points)&&(tmp!=sim_drawing_lines)&&(tmp!=sim_drawing_linestrip))
@@ -164,10 +168,23 @@ void CDrawingObject::adjustForScaling(float xScale,float yScale,float zScale)
 
 void CDrawingObject::setItems(const float* itemData,size_t itemCnt)
 {
-    addItem(nullptr);
-    size_t off=size_t(verticesPerItem*3+normalsPerItem*3+otherFloatsPerItem);
-    for (size_t i=0;i<itemCnt;i++)
-        addItem(itemData+off*i);
+    EASYLOCK(_objectMutex);
+    _data.clear();
+    _startItem=0;
+    _duplicateGrid.clear();
+    _duplicateGridValid=true;
+    C7Vector trInv;
+    if (_getInverseParentTransformation(trInv))
+        _addItems(itemData,itemCnt,trInv);
+}
+
+int CDrawingObject::addItems(const float* itemData,size_t itemCnt)
+{ // returns the number of items that were added
+    EASYLOCK(_objectMutex);
+    C7Vector trInv;
+    if (!_getInverseParentTransformation(trInv))
+        return(0);
+    return(_addItems(itemData,itemCnt,trInv));
 }
 
 bool CDrawingObject::addItem(const float* itemData)
@@ -177,22 +194,18 @@ bool CDrawingObject::addItem(const float* itemData)
     {
         _data.clear();
         _startItem=0;
+        _duplicateGrid.clear();
+        _duplicateGridValid=true;
         return(false);
     }
-    int newPos=_startItem;
-    if (int(_data.size())/floatsPerItem>=_maxItemCount)
-    { // the buffer is full
-        if (_objectType&sim_drawing_cyclic)
-        {
-            _startItem++;
-            if (_startItem>=_maxItemCount)
-                _startItem=0;
-        }
-        else
-            return(false); // saturated
-    }
-
     C7Vector trInv;
+    if (!_getInverseParentTransformation(trInv))
+        return(false);
+    return(_addItems(itemData,1,trInv)==1);
+}
+
+bool CDrawingObject::_getInverseParentTransformation(C7Vector& trInv)
+{ // returns false if the object we are attached to was removed
     trInv.setIdentity();
     if (_sceneObjectID>=0)
     {
@@ -202,52 +215,193 @@ bool CDrawingObject::addItem(const float* itemData)
         else
             trInv=it->getCumulativeTransformation().getInverse();
     }
+    return(_sceneObjectID!=-2);
+}
 
+int CDrawingObject::_addItems(const float* itemData,size_t itemCnt,const C7Vector& trInv)
+{ // _objectMutex should be locked. Returns the number of items that were added
+    int currentCnt=int(_data.size())/floatsPerItem;
+    bool cyclic=((_objectType&sim_drawing_cyclic)!=0);
     if ( (_duplicateTolerance>0.0f)&&(verticesPerItem==1) )
-    { // Check for duplicates
-        C3Vector v(itemData);
-        v*=trInv;
-        for (int i=0;i<int(_data.size())/floatsPerItem;i++)
+    { // Duplicates have to be checked item per item (also against the items of this batch)
+        if (!_duplicateGridValid)
+            _rebuildDuplicateGrid();
+        int retVal=0;
+        for (size_t i=0;i<itemCnt;i++)
         {
-            C3Vector w(&_data[floatsPerItem*i+0]);
-            if ((w-v).getLength()<=_duplicateTolerance)
-                return(false); // point already there!
+            const float* item=itemData+size_t(floatsPerItem)*i;
+            C3Vector v(item);
+            v*=trInv;
+            if (_isDuplicate(v))
+                continue; // point already there!
+            int newPos;
+            if (currentCnt<_maxItemCount)
+            { // The buffer is not yet full!
+                newPos=currentCnt++;
+                _data.resize(_data.size()+floatsPerItem);
+            }
+            else
+            {
+                if (!cyclic)
+                    break; // saturated
+                newPos=_startItem;
+                _removeFromDuplicateGrid(newPos);
+                _startItem++;
+                if (_startItem>=_maxItemCount)
+                    _startItem=0;
+            }
+            _writeItem(newPos,item,trInv);
+            _addToDuplicateGrid(newPos);
+            retVal++;
         }
+        return(retVal);
     }
 
-    if (int(_data.size())/floatsPerItem<_maxItemCount)
-    { // The buffer is not yet full!
-        newPos=int(_data.size())/floatsPerItem;
-        for (int i=0;i<floatsPerItem;i++)
-            _data.push_back(0.0f);
+    // No duplicate check: we copy whole blocks into the ring buffer, then transform them in place
+    bool transform=(_sceneObjectID>=0);
+    size_t appendCnt=std::min<size_t>(itemCnt,size_t(_maxItemCount-currentCnt));
+    if (appendCnt>0)
+    {
+        _data.insert(_data.end(),itemData,itemData+appendCnt*floatsPerItem);
+        if (transform)
+            _transformItems(currentCnt,int(appendCnt),trInv);
+    }
+    if ( (appendCnt==itemCnt)||(!cyclic) )
+        return(int(appendCnt));
+
+    // Cyclic buffer is full: the remaining items overwrite the oldest ones
+    size_t overwriteCnt=itemCnt-appendCnt;
+    const float* src=itemData+appendCnt*floatsPerItem;
+    if (overwriteCnt>size_t(_maxItemCount))
+    { // only the last _maxItemCount items would survive anyway
+        size_t skip=overwriteCnt-size_t(_maxItemCount);
+        _startItem=int((size_t(_startItem)+skip)%size_t(_maxItemCount));
+        src+=skip*floatsPerItem;
+        overwriteCnt=size_t(_maxItemCount);
+    }
+    size_t firstCnt=std::min<size_t>(overwriteCnt,size_t(_maxItemCount-_startItem));
+    std::copy(src,src+firstCnt*floatsPerItem,_data.begin()+size_t(_startItem)*floatsPerItem);
+    if (transform)
+        _transformItems(_startItem,int(firstCnt),trInv);
+    if (overwriteCnt>firstCnt)
+    { // wrap around
+        std::copy(src+firstCnt*floatsPerItem,src+overwriteCnt*floatsPerItem,_data.begin());
+        if (transform)
+            _transformItems(0,int(overwriteCnt-firstCnt),trInv);
     }
+    _startItem=int((size_t(_startItem)+overwriteCnt)%size_t(_maxItemCount));
+    return(int(itemCnt));
+}
 
+void CDrawingObject::_writeItem(int pos,const float* itemData,const C7Vector& trInv)
+{
+    float* dest=&_data[size_t(pos)*floatsPerItem];
+    for (int i=0;i<floatsPerItem;i++)
+        dest[i]=itemData[i];
+    if (_sceneObjectID>=0)
+        _transformItems(pos,1,trInv);
+}
 
-    if (_sceneObjectID!=-2)
+void CDrawingObject::_transformItems(int firstItem,int itemCnt,const C7Vector& trInv)
+{
+    for (int i=firstItem;i<firstItem+itemCnt;i++)
     {
+        float* item=&_data[size_t(i)*floatsPerItem];
         int off=0;
-        for (int i=0;i<verticesPerItem;i++)
+        for (int j=0;j<verticesPerItem;j++)
         {
-            C3Vector v(itemData+off);
+            C3Vector v(item+off);
             v*=trInv;
-            _data[newPos*floatsPerItem+off+0]=v(0);
-            _data[newPos*floatsPerItem+off+1]=v(1);
-            _data[newPos*floatsPerItem+off+2]=v(2);
+            v.copyTo(item+off);
             off+=3;
         }
-        for (int i=0;i<normalsPerItem;i++)
+        for (int j=0;j<normalsPerItem;j++)
         {
-            C3Vector v(itemData+off);
-            v=trInv.Q*v; // no translational part!
-            _data[newPos*floatsPerItem+off+0]=v(0);
-            _data[newPos*floatsPerItem+off+1]=v(1);
-            _data[newPos*floatsPerItem+off+2]=v(2);
+            C3Vector n(item+off);
+            n=trInv.Q*n; // no translational part!
+            n.copyTo(item+off);
             off+=3;
         }
-        for (int i=0;i<otherFloatsPerItem;i++)
-            _data[newPos*floatsPerItem+off+i]=itemData[off+i];
     }
-    return(true);
+}
+
+unsigned long long int CDrawingObject::_getDuplicateGridKey(long long int x,long long int y,long long int z) const
+{ // 21 bits per axis. Collisions are harmless, since we always check the real distance
+    return( ((unsigned long long int)(x&0x1fffff)<<42)|((unsigned long long int)(y&0x1fffff)<<21)|(unsigned long long int)(z&0x1fffff) );
+}
+
+void CDrawingObject::_getDuplicateGridCell(const C3Vector& v,long long int cell[3]) const
+{
+    for (size_t i=0;i<3;i++)
+    {
+        double c=floor(double(v(i))/double(_duplicateTolerance));
+        c=std::max<double>(-1.0e15,std::min<double>(1.0e15,c)); // also handles infinite values
+        cell[i]=(long long int)c;
+    }
+}
+
+bool CDrawingObject::_isDuplicate(const C3Vector& v) const
+{ // cell size is the tolerance: only the 27 neighbouring cells need to be checked
+    long long int cell[3];
+    _getDuplicateGridCell(v,cell);
+    for (long long int x=cell[0]-1;x<=cell[0]+1;x++)
+    {
+        for (long long int y=cell[1]-1;y<=cell[1]+1;y++)
+        {
+            for (long long int z=cell[2]-1;z<=cell[2]+1;z++)
+            {
+                auto it=_duplicateGrid.find(_getDuplicateGridKey(x,y,z));
+                if (it!=_duplicateGrid.end())
+                {
+                    const std::vector<int>& items=it->second;
+                    for (size_t i=0;i<items.size();i++)
+                    {
+                        C3Vector w(&_data[size_t(items[i])*floatsPerItem]);
+                        if ((w-v).getLength()<=_duplicateTolerance)
+                            return(true);
+                    }
+                }
+            }
+        }
+    }
+    return(false);
+}
+
+void CDrawingObject::_addToDuplicateGrid(int itemIndex)
+{
+    long long int cell[3];
+    _getDuplicateGridCell(C3Vector(&_data[size_t(itemIndex)*floatsPerItem]),cell);
+    _duplicateGrid[_getDuplicateGridKey(cell[0],cell[1],cell[2])].push_back(itemIndex);
+}
+
+void CDrawingObject::_removeFromDuplicateGrid(int itemIndex)
+{
+    long long int cell[3];
+    _getDuplicateGridCell(C3Vector(&_data[size_t(itemIndex)*floatsPerItem]),cell);
+    auto it=_duplicateGrid.find(_getDuplicateGridKey(cell[0],cell[1],cell[2]));
+    if (it!=_duplicateGrid.end())
+    {
+        std::vector<int>& items=it->second;
+        for (size_t i=0;i<items.size();i++)
+        {
+            if (items[i]==itemIndex)
+            {
+                items[i]=items[items.size()-1];
+                items.pop_back();
+                break;
+            }
+        }
+        if (items.size()==0)
+            _duplicateGrid.erase(it);
+    }
+}
+
+void CDrawingObject::_rebuildDuplicateGrid()
+{ // e.g. after a frame change or a scaling operation
+    _duplicateGrid.clear();
+    for (int i=0;i<int(_data.size())/floatsPerItem;i++)
+        _addToDuplicateGrid(i);
+    _duplicateGridValid=true;
 }
 
 void CDrawingObject::_setItemSizes()
@@ -4,6 +4,7 @@
 #include "colorObject.h"
 #include "4X4Matrix.h"
 #include "vMutex.h"
+#include <unordered_map>
 
 class CDrawingObject  
 {
@@ -16,6 +17,7 @@ public:
     int getObjectID() const;
     bool addItem(const float* itemData);
     void setItems(const float* itemData,size_t itemCnt);
+    int addItems(const float* itemData,size_t itemCnt);
     int getObjectType() const;
     bool announceObjectWillBeErased(int objID);
     bool announceScriptStateWillBeErased(int scriptHandle,bool simulationScript,bool sceneSwitchPersistentScript);
@@ -50,6 +52,17 @@ protected:
     void _exportTriOrQuad(C7Vector& tr,C3Vector* v0,C3Vector* v1,C3Vector* v2,C3Vector* v3,std::vector<float>& vertices,std::vector<int>& indices,int& nextIndex) const;
 
     void _setItemSizes();
+    bool _getInverseParentTransformation(C7Vector& trInv);
+    int _addItems(const float* itemData,size_t itemCnt,const C7Vector& trInv);
+    void _writeItem(int pos,const float* itemData,const C7Vector& trInv);
+    void _transformItems(int firstItem,int itemCnt,const C7Vector& trInv);
+
+    unsigned long long int _getDuplicateGridKey(long long int x,long long int y,long long int z) const;
+    void _getDuplicateGridCell(const C3Vector& v,long long int cell[3]) const;
+    bool _isDuplicate(const C3Vector& v) const;
+    void _addToDuplicateGrid(int itemIndex);
+    void _removeFromDuplicateGrid(int itemIndex);
+    void _rebuildDuplicateGrid();
 
     int _objectID;
     int _sceneObjectID;
@@ -63,4 +76,8 @@ protected:
     VMutex _objectMutex;
 
     std::vector<float> _data;
+
+    // Voxel hash (cell size = _duplicateTolerance) of item indices, for point-type items only:
+    std::unordered_map<unsigned long long int,std::vector<int> > _duplicateGrid;
+    bool _duplicateGridValid;
 };
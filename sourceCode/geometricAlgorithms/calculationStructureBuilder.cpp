@@ -0,0 +1,242 @@
+#include "calculationStructureBuilder.h"
+#include "pluginContainer.h"
+#include "workerPool.h"
+#include "vFile.h"
+#include "vThread.h"
+#include "vVarious.h"
+#include "vDateTime.h"
+#include "app.h"
+#include <cstdio>
+#include <cstring>
+
+#define CALC_STRUCT_CACHE_FILE_VERSION 2
+
+void* CCalculationStructureBuilder::buildMesh(const std::vector<float>& vertices,const std::vector<int>& indices,float maxTriSize,int triCountInObb)
+{ // synchronous
+    std::string cacheFilename;
+    std::string cacheHeader;
+    _getCacheFilename(vertices,indices,maxTriSize,triCountInObb,cacheFilename,cacheHeader);
+    return(_build(vertices,indices,maxTriSize,triCountInObb,cacheFilename,cacheHeader));
+}
+
+SCalculationStructureJob* CCalculationStructureBuilder::launchJob(const std::vector<float>& vertices,const std::vector<int>& indices,float maxTriSize,int triCountInObb)
+{ // the caller owns one reference to the returned job, and must release it with finishJob or abandonJob
+    SCalculationStructureJob* job=new SCalculationStructureJob;
+    job->vertices.assign(vertices.begin(),vertices.end());
+    job->indices.assign(indices.begin(),indices.end());
+    job->maxTriSize=maxTriSize;
+    job->triCountInObb=triCountInObb;
+    _getCacheFilename(vertices,indices,maxTriSize,triCountInObb,job->cacheFilename,job->cacheHeader); // here, since the worker should not access App
+    job->result=nullptr;
+    job->state=CALC_STRUCT_JOB_QUEUED;
+    job->refCount=2; // the caller and the worker task
+    CWorkerPool::addBackgroundTask(_jobTask,job,_cancelJobTask);
+    return(job);
+}
+
+bool CCalculationStructureBuilder::isJobDone(SCalculationStructureJob* job)
+{
+    return(job->state.load()==CALC_STRUCT_JOB_BUILT);
+}
+
+void* CCalculationStructureBuilder::finishJob(SCalculationStructureJob* job)
+{
+    void* retVal=nullptr;
+    int expected=CALC_STRUCT_JOB_QUEUED;
+    if (job->state.compare_exchange_strong(expected,CALC_STRUCT_JOB_ABANDONED))
+    { // the worker did not start yet: we build it here (the worker will skip it)
+        retVal=_build(job->vertices,job->indices,job->maxTriSize,job->triCountInObb,job->cacheFilename,job->cacheHeader);
+    }
+    else
+    {
+        while (job->state.load()==CALC_STRUCT_JOB_BUILDING)
+            VThread::switchThread();
+        retVal=job->result;
+        job->result=nullptr;
+    }
+    _releaseJob(job);
+    return(retVal);
+}
+
+void CCalculationStructureBuilder::abandonJob(SCalculationStructureJob* job)
+{
+    if (job->state.exchange(CALC_STRUCT_JOB_ABANDONED)==CALC_STRUCT_JOB_BUILT)
+    { // the result is ours
+        if (job->result!=nullptr)
+            CPluginContainer::geomPlugin_destroyMesh(job->result);
+        job->result=nullptr;
+    }
+    _releaseJob(job);
+}
+
+void CCalculationStructureBuilder::_jobTask(void* data)
+{ // runs on a worker thread
+    SCalculationStructureJob* job=(SCalculationStructureJob*)data;
+    int expected=CALC_STRUCT_JOB_QUEUED;
+    if (job->state.compare_exchange_strong(expected,CALC_STRUCT_JOB_BUILDING))
+    {
+        job->result=_build(job->vertices,job->indices,job->maxTriSize,job->triCountInObb,job->cacheFilename,job->cacheHeader);
+        expected=CALC_STRUCT_JOB_BUILDING;
+        if (!job->state.compare_exchange_strong(expected,CALC_STRUCT_JOB_BUILT))
+        { // the shape doesn't need it anymore
+            if (job->result!=nullptr)
+                CPluginContainer::geomPlugin_destroyMesh(job->result);
+            job->result=nullptr;
+        }
+    }
+    _releaseJob(job);
+}
+
+void CCalculationStructureBuilder::_cancelJobTask(void* data)
+{ // the worker pool dropped the task. The job stays queued, so that the shape builds it in finishJob if still needed
+    _releaseJob((SCalculationStructureJob*)data);
+}
+
+void CCalculationStructureBuilder::_releaseJob(SCalculationStructureJob* job)
+{
+    if (job->refCount.fetch_sub(1)==1)
+    {
+        if (job->result!=nullptr)
+            CPluginContainer::geomPlugin_destroyMesh(job->result);
+        delete job;
+    }
+}
+
+void* CCalculationStructureBuilder::_build(const std::vector<float>& vertices,const std::vector<int>& indices,float maxTriSize,int triCountInObb,const std::string& cacheFilename,const std::string& cacheHeader)
+{ // can run on any thread
+    void* retVal=nullptr;
+    if (cacheFilename.size()>0)
+        retVal=_loadFromCache(cacheFilename,cacheHeader);
+    if ( (retVal==nullptr)&&(vertices.size()>0)&&(indices.size()>0) )
+    {
+        retVal=CPluginContainer::geomPlugin_createMesh(&vertices[0],(int)vertices.size(),&indices[0],(int)indices.size(),nullptr,maxTriSize,triCountInObb);
+        if ( (retVal!=nullptr)&&(cacheFilename.size()>0) )
+            _saveToCache(cacheFilename,cacheHeader,retVal);
+    }
+    return(retVal);
+}
+
+bool CCalculationStructureBuilder::_getCacheFilename(const std::vector<float>& vertices,const std::vector<int>& indices,float maxTriSize,int triCountInObb,std::string& filename,std::string& header)
+{ // the file name is the content hash. The header is also checked when loading, and covers everything the structure depends on
+    filename.clear();
+    header.clear();
+    std::string folder(App::userSettings->calcStructCacheFolder);
+    if ( (folder.size()==0)||(CPluginContainer::currentGeomPlugin==nullptr)||(vertices.size()==0)||(indices.size()==0) )
+        return(false);
+    VVarious::removePathFinalSlashOrBackslash(folder);
+    if (!VFile::doesFolderExist(folder.c_str()))
+    {
+        if (!VFile::createFolder(folder.c_str()))
+            return(false);
+    }
+    unsigned long long int vh=_getHash(14695981039346656037ULL,(const char*)&vertices[0],vertices.size()*sizeof(float));
+    unsigned long long int ih=_getHash(14695981039346656037ULL,(const char*)&indices[0],indices.size()*sizeof(int));
+    std::string pluginName(CPluginContainer::currentGeomPlugin->getName());
+
+    header="SIMCALCSTRUCT";
+    header.push_back(char(CALC_STRUCT_CACHE_FILE_VERSION));
+    header.push_back(char(CPluginContainer::currentGeomPlugin->pluginVersion));
+    int extVersion=CPluginContainer::currentGeomPlugin->extendedVersionInt;
+    header.append((const char*)&extVersion,sizeof(extVersion));
+    header+=pluginName;
+    header.push_back(0);
+    unsigned int vc=(unsigned int)vertices.size();
+    unsigned int ic=(unsigned int)indices.size();
+    header.append((const char*)&vc,sizeof(vc));
+    header.append((const char*)&ic,sizeof(ic));
+    header.append((const char*)&vh,sizeof(vh));
+    header.append((const char*)&ih,sizeof(ih));
+    header.append((const char*)&maxTriSize,sizeof(maxTriSize));
+    header.append((const char*)&triCountInObb,sizeof(triCountInObb));
+
+    unsigned long long int h=_getHash(vh^ih,header.c_str(),header.size());
+    char tmp[40];
+    snprintf(tmp,sizeof(tmp),"%016llx.obb",h);
+    filename=folder+"/"+tmp;
+    return(true);
+}
+
+void* CCalculationStructureBuilder::_loadFromCache(const std::string& filename,const std::string& header)
+{ // file layout: header, payload size (8 bytes), payload hash (8 bytes), payload. Invalid files are erased
+    void* retVal=nullptr;
+    if (VFile::doesFileExist(filename.c_str()))
+    {
+        bool valid=false;
+        std::vector<unsigned char> data;
+        try
+        {
+            VFile file(filename.c_str(),VFile::READ|VFile::SHARE_DENY_NONE);
+            quint64 l=file.getLength();
+            if (l>header.size()+2*sizeof(quint64))
+            {
+                data.resize((size_t)l);
+#ifdef SIM_WITH_QT
+                valid=(file.getFile()->read((char*)&data[0],l)==qint64(l));
+#else
+                file.getFile()->read((char*)&data[0],l);
+                valid=!file.getFile()->fail();
+#endif
+            }
+            file.close();
+        }
+        catch(VFILE_EXCEPTION_TYPE e)
+        { // silent: we simply rebuild
+            return(nullptr);
+        }
+        if (valid)
+            valid=(memcmp(&data[0],header.c_str(),header.size())==0);
+        size_t payloadPos=header.size()+2*sizeof(quint64);
+        if (valid)
+        {
+            quint64 payloadSize;
+            unsigned long long int payloadHash;
+            memcpy(&payloadSize,&data[header.size()],sizeof(payloadSize));
+            memcpy(&payloadHash,&data[header.size()+sizeof(quint64)],sizeof(payloadHash));
+            valid=( (payloadSize==quint64(data.size()-payloadPos))&&(payloadHash==_getHash(14695981039346656037ULL,(const char*)&data[payloadPos],data.size()-payloadPos)) );
+        }
+        if (valid)
+        {
+            retVal=CPluginContainer::geomPlugin_getMeshFromSerializationData(&data[payloadPos]);
+            valid=(retVal!=nullptr);
+        }
+        if (!valid)
+            VFile::eraseFile(filename.c_str()); // truncated, corrupt or stale. Rebuilt and saved again
+    }
+    return(retVal);
+}
+
+void CCalculationStructureBuilder::_saveToCache(const std::string& filename,const std::string& header,const void* mesh)
+{ // we write to a temp. file first, since another thread or process might read the same file at the same time
+    static std::atomic<int> tempCnt(0);
+    std::vector<unsigned char> data;
+    CPluginContainer::geomPlugin_getMeshSerializationData(mesh,data);
+    if (data.size()==0)
+        return;
+    std::string tempFilename(filename+".tmp"+std::to_string(VDateTime::getTimeInMs())+"_"+std::to_string(tempCnt++));
+    try
+    {
+        VFile file(tempFilename.c_str(),VFile::CREATE_WRITE|VFile::SHARE_EXCLUSIVE);
+        quint64 payloadSize=data.size();
+        unsigned long long int payloadHash=_getHash(14695981039346656037ULL,(const char*)&data[0],data.size());
+        file.getFile()->write(header.c_str(),header.size());
+        file.getFile()->write((const char*)&payloadSize,sizeof(payloadSize));
+        file.getFile()->write((const char*)&payloadHash,sizeof(payloadHash));
+        file.getFile()->write((const char*)&data[0],data.size());
+        file.close();
+        if (std::rename(tempFilename.c_str(),filename.c_str())!=0)
+            VFile::eraseFile(tempFilename.c_str()); // e.g. the file already exists (Windows)
+    }
+    catch(VFILE_EXCEPTION_TYPE e)
+    { // silent: the cache is optional
+    }
+}
+
+unsigned long long int CCalculationStructureBuilder::_getHash(unsigned long long int h,const char* data,size_t size)
+{ // FNV-1a
+    for (size_t i=0;i<size;i++)
+    {
+        h^=(unsigned char)data[i];
+        h*=1099511628211ULL;
+    }
+    return(h);
+}
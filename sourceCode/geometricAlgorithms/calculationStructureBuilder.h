@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <atomic>
+
+enum {  CALC_STRUCT_JOB_QUEUED=0,
+        CALC_STRUCT_JOB_BUILDING,
+        CALC_STRUCT_JOB_BUILT,
+        CALC_STRUCT_JOB_ABANDONED
+};
+
+struct SCalculationStructureJob
+{ // owned by the shape and by the worker task. The last one to release it deletes it
+    std::vector<float> vertices;
+    std::vector<int> indices;
+    float maxTriSize;
+    int triCountInObb;
+    std::string cacheFilename; // empty if the cache is not used
+    std::string cacheHeader;
+    void* result;
+    std::atomic<int> state;
+    std::atomic<int> refCount;
+};
+
+// FULLY STATIC CLASS
+class CCalculationStructureBuilder
+{ // Builds the mesh calculation structures (OBB trees) via the geom plugin, on the worker pool if needed,
+  // and keeps their serialized data in an on-disk cache, keyed by content (see user setting calcStructCacheFolder)
+public:
+    static void* buildMesh(const std::vector<float>& vertices,const std::vector<int>& indices,float maxTriSize,int triCountInObb);
+
+    static SCalculationStructureJob* launchJob(const std::vector<float>& vertices,const std::vector<int>& indices,float maxTriSize,int triCountInObb);
+    static bool isJobDone(SCalculationStructureJob* job);
+    static void* finishJob(SCalculationStructureJob* job); // blocks if the job is being built. Builds it here if not yet started. Releases the job
+    static void abandonJob(SCalculationStructureJob* job); // releases the job
+
+private:
+    static void _jobTask(void* data);
+    static void _cancelJobTask(void* data);
+    static void _releaseJob(SCalculationStructureJob* job);
+    static bool _getCacheFilename(const std::vector<float>& vertices,const std::vector<int>& indices,float maxTriSize,int triCountInObb,std::string& filename,std::string& header);
+    static void* _build(const std::vector<float>& vertices,const std::vector<int>& indices,float maxTriSize,int triCountInObb,const std::string& cacheFilename,const std::string& cacheHeader);
+    static void* _loadFromCache(const std::string& filename,const std::string& header);
+    static void _saveToCache(const std::string& filename,const std::string& header,const void* mesh);
+    static unsigned long long int _getHash(unsigned long long int h,const char* data,size_t size);
+};
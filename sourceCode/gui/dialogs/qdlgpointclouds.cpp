@@ -62,7 +62,7 @@ void CQDlgPointclouds::refresh()
         ui->qqShowOctree->setChecked(it->getShowOctree());
         ui->qqRandomColors->setChecked(it->getUseRandomColors());
         ui->qqPointSize->setText(tt::getIString(false,it->getPointSize()).c_str());
-        ui->qqPointCount->setText(tt::getIString(false,(int)it->getPoints()->size()/3).c_str());
+        ui->qqPointCount->setText(tt::getIString(false,it->getPointCount()).c_str());
         if (it->getAveragePointCountInCell()<0.0)
             ui->qqAveragePoints->setText("-"); // empty point cloud or point cloud doesn't use octree struct.
         else
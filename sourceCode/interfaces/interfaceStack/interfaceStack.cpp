@@ -311,7 +311,8 @@ CInterfaceStackTable* CInterfaceStack::_generateTableArrayFromLuaStack(luaWrap_l
 { // there must be a table at the given index.
     CInterfaceStackTable* table=new CInterfaceStackTable();
     int arraySize=int(luaWrap_lua_rawlen(L,index));
-    for (int i=0;i<arraySize;i++)
+    int i=_generatePackedTableArrayFromLuaStack(L,index,arraySize,table);
+    for (;i<arraySize;i++)
     {
         // Push the element i+1 of the table to the top of Lua's stack:
         luaWrap_lua_rawgeti(L,index,i+1);
@@ -322,6 +323,50 @@ CInterfaceStackTable* CInterfaceStack::_generateTableArrayFromLuaStack(luaWrap_l
     return(table);
 }
 
+int CInterfaceStack::_generatePackedTableArrayFromLuaStack(luaWrap_lua_State* L,int index,int arraySize,CInterfaceStackTable* table)
+{ // arrays that only contain numbers, or only integers, are stored as packed tables. Returns the number of items handled here
+    if (arraySize==0)
+        return(0);
+    luaWrap_lua_rawgeti(L,index,1);
+    int t=luaWrap_lua_stype(L,-1);
+    luaWrap_lua_pop(L,1);
+    if ( (t!=STACK_OBJECT_NUMBER)&&(t!=STACK_OBJECT_INTEGER) )
+        return(0);
+    std::vector<double> numbers;
+    std::vector<luaWrap_lua_Integer> integers;
+    int i=0;
+    for (;i<arraySize;i++)
+    {
+        luaWrap_lua_rawgeti(L,index,i+1);
+        bool same=(luaWrap_lua_stype(L,-1)==t);
+        if (same)
+        {
+            if (t==STACK_OBJECT_NUMBER)
+                numbers.push_back(luaWrap_lua_tonumber(L,-1));
+            else
+                integers.push_back(luaWrap_lua_tointeger(L,-1));
+        }
+        luaWrap_lua_pop(L,1);
+        if (!same)
+            break;
+    }
+    if (i==arraySize)
+    {
+        if (t==STACK_OBJECT_NUMBER)
+            table->setDoubleArray(&numbers[0],arraySize);
+        else
+            table->setInt64Array(&integers[0],arraySize);
+    }
+    else
+    { // mixed content. What we read so far becomes individual objects
+        for (size_t j=0;j<numbers.size();j++)
+            table->appendArrayObject(new CInterfaceStackNumber(numbers[j]));
+        for (size_t j=0;j<integers.size();j++)
+            table->appendArrayObject(new CInterfaceStackInteger(integers[j]));
+    }
+    return(i);
+}
+
 CInterfaceStackObject* CInterfaceStack::_generateObjectFromLuaStack(luaWrap_lua_State* L,int index,std::map<void*,bool>& visitedTables)
 { // generates just one object at the given index
     int t=luaWrap_lua_stype(L,index);
@@ -453,8 +498,45 @@ void CInterfaceStack::_pushOntoLuaStack(luaWrap_lua_State* L,CInterfaceStackObje
     }
     else if (t==STACK_OBJECT_TABLE)
     {
-        luaWrap_lua_newtable(L);
         CInterfaceStackTable* table=(CInterfaceStackTable*)obj;
+        int packedType=table->getPackedArrayType();
+        if (packedType!=STACK_TABLE_PACKED_NONE)
+        { // packed array-type table. We don't need individual objects here
+            int n=table->getArraySize();
+            luaWrap_lua_createtable(L,n,0);
+            if ( (packedType==STACK_TABLE_PACKED_FLOAT)||(packedType==STACK_TABLE_PACKED_DOUBLE) )
+            {
+                std::vector<double> v(n);
+                if (n>0)
+                    table->getDoubleArray(&v[0],n);
+                for (int i=0;i<n;i++)
+                {
+#ifdef LUA_STACK_COMPATIBILITY_MODE
+                    luaWrap_lua_Integer w=(luaWrap_lua_Integer)v[i];
+                    if (v[i]==(double)w)
+                        luaWrap_lua_pushinteger(L,w);
+                    else
+                        luaWrap_lua_pushnumber(L,v[i]);
+#else
+                    luaWrap_lua_pushnumber(L,v[i]);
+#endif
+                    luaWrap_lua_rawseti(L,-2,i+1);
+                }
+            }
+            else
+            {
+                std::vector<luaWrap_lua_Integer> v(n);
+                if (n>0)
+                    table->getInt64Array(&v[0],n);
+                for (int i=0;i<n;i++)
+                {
+                    luaWrap_lua_pushinteger(L,v[i]);
+                    luaWrap_lua_rawseti(L,-2,i+1);
+                }
+            }
+            return;
+        }
+        luaWrap_lua_newtable(L);
         if (table->isTableArray())
         { // array-type table
             for (int i=0;i<table->getArraySize();i++)
@@ -562,6 +644,21 @@ bool CInterfaceStack::getStackDoubleArray(double* array,int count) const
     return(table->getDoubleArray(array,count));
 }
 
+const void* CInterfaceStack::getStackPackedArray(int& arrayType,int& count) const
+{ // no copy. Valid until the stack is modified. Returns nullptr if the top item is not a packed table
+    if (_stackObjects.size()==0)
+        return(nullptr);
+    CInterfaceStackObject* obj=_stackObjects[_stackObjects.size()-1];
+    if (obj->getObjectType()!=STACK_OBJECT_TABLE)
+        return(nullptr);
+    CInterfaceStackTable* table=(CInterfaceStackTable*)obj;
+    arrayType=table->getPackedArrayType();
+    count=table->getArraySize();
+    if (arrayType==STACK_TABLE_PACKED_NONE)
+        return(nullptr);
+    return(table->getPackedArrayData());
+}
+
 bool CInterfaceStack::getStackMapFloatArray(const char* fieldName,float* array,int count) const
 {
     const CInterfaceStackObject* obj=getStackMapObject(fieldName);
@@ -57,6 +57,7 @@ public:
     bool getStackInt64Array(luaWrap_lua_Integer* array,int count) const;
     bool getStackFloatArray(float* array,int count) const;
     bool getStackDoubleArray(double* array,int count) const;
+    const void* getStackPackedArray(int& arrayType,int& count) const;
     bool unfoldStackTable();
     CInterfaceStackObject* getStackMapObject(const char* fieldName) const;
     bool getStackMapBoolValue(const char* fieldName,bool& val) const;
@@ -76,6 +77,7 @@ protected:
     CInterfaceStackObject* _generateObjectFromLuaStack(luaWrap_lua_State* L,int index,std::map<void*,bool>& visitedTables);
     CInterfaceStackTable* _generateTableArrayFromLuaStack(luaWrap_lua_State* L,int index,std::map<void*,bool>& visitedTables);
     CInterfaceStackTable* _generateTableMapFromLuaStack(luaWrap_lua_State* L,int index,std::map<void*,bool>& visitedTables);
+    int _generatePackedTableArrayFromLuaStack(luaWrap_lua_State* L,int index,int arraySize,CInterfaceStackTable* table);
     int _countLuaStackTableEntries(luaWrap_lua_State* L,int index);
 
     void _pushOntoLuaStack(luaWrap_lua_State* L,CInterfaceStackObject* obj) const;
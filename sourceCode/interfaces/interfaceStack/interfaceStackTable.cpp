@@ -6,12 +6,15 @@
 #include "interfaceStackString.h"
 #include "interfaceStackTable.h"
 #include <algorithm> // std::sort, etc.
+#include <cstring>
 
 CInterfaceStackTable::CInterfaceStackTable()
 {
     _objectType=STACK_OBJECT_TABLE;
     _isTableArray=true;
     _isCircularRef=false;
+    _packedCount=0;
+    _packedType=STACK_TABLE_PACKED_NONE;
 }
 
 CInterfaceStackTable::~CInterfaceStackTable()
@@ -29,6 +32,8 @@ int CInterfaceStackTable::getArraySize() const
 {
     if (!_isTableArray)
         return(0);
+    if (_packedType!=STACK_TABLE_PACKED_NONE)
+        return((int)_packedCount);
     return((int)_tableObjects.size());
 }
 
@@ -50,10 +55,56 @@ void CInterfaceStackTable::setCircularRef()
 }
 
 
+template<class T>
+bool CInterfaceStackTable::_getPackedArray(T* array,int count,int arrayType) const
+{ // a packed table only contains numbers, i.e. this always succeeds
+    size_t c=std::min<size_t>((size_t)count,_packedCount);
+    if (c>0)
+    {
+        if (arrayType==_packedType)
+            memcpy(array,&_packedData[0],c*sizeof(T));
+        else if (_packedType==STACK_TABLE_PACKED_UCHAR)
+        {
+            const unsigned char* d=&_packedData[0];
+            for (size_t i=0;i<c;i++)
+                array[i]=(T)d[i];
+        }
+        else if (_packedType==STACK_TABLE_PACKED_INT32)
+        {
+            const int* d=(const int*)&_packedData[0];
+            for (size_t i=0;i<c;i++)
+                array[i]=(T)d[i];
+        }
+        else if (_packedType==STACK_TABLE_PACKED_INT64)
+        {
+            const luaWrap_lua_Integer* d=(const luaWrap_lua_Integer*)&_packedData[0];
+            for (size_t i=0;i<c;i++)
+                array[i]=(T)d[i];
+        }
+        else if (_packedType==STACK_TABLE_PACKED_FLOAT)
+        {
+            const float* d=(const float*)&_packedData[0];
+            for (size_t i=0;i<c;i++)
+                array[i]=(T)d[i];
+        }
+        else if (_packedType==STACK_TABLE_PACKED_DOUBLE)
+        {
+            const double* d=(const double*)&_packedData[0];
+            for (size_t i=0;i<c;i++)
+                array[i]=(T)d[i];
+        }
+    }
+    for (size_t i=c;i<(size_t)count;i++)
+        array[i]=0; // fill with zeros
+    return(true);
+}
+
 bool CInterfaceStackTable::getUCharArray(unsigned char* array,int count) const
 {
     if (!_isTableArray)
         return(false);
+    if (_packedType!=STACK_TABLE_PACKED_NONE)
+        return(_getPackedArray(array,count,STACK_TABLE_PACKED_UCHAR));
     bool retVal=true;
     size_t c=(size_t)count;
     if (c>_tableObjects.size())
@@ -80,6 +131,8 @@ bool CInterfaceStackTable::getInt32Array(int* array,int count) const
 {
     if (!_isTableArray)
         return(false);
+    if (_packedType!=STACK_TABLE_PACKED_NONE)
+        return(_getPackedArray(array,count,STACK_TABLE_PACKED_INT32));
     bool retVal=true;
     size_t c=(size_t)count;
     if (c>_tableObjects.size())
@@ -106,6 +159,8 @@ bool CInterfaceStackTable::getInt64Array(luaWrap_lua_Integer* array,int count) c
 {
     if (!_isTableArray)
         return(false);
+    if (_packedType!=STACK_TABLE_PACKED_NONE)
+        return(_getPackedArray(array,count,STACK_TABLE_PACKED_INT64));
     bool retVal=true;
     size_t c=(size_t)count;
     if (c>_tableObjects.size())
@@ -132,6 +187,8 @@ bool CInterfaceStackTable::getFloatArray(float* array,int count) const
 {
     if (!_isTableArray)
         return(false);
+    if (_packedType!=STACK_TABLE_PACKED_NONE)
+        return(_getPackedArray(array,count,STACK_TABLE_PACKED_FLOAT));
     bool retVal=true;
     size_t c=(size_t)count;
     if (c>_tableObjects.size())
@@ -158,6 +215,8 @@ bool CInterfaceStackTable::getDoubleArray(double* array,int count) const
 {
     if (!_isTableArray)
         return(false);
+    if (_packedType!=STACK_TABLE_PACKED_NONE)
+        return(_getPackedArray(array,count,STACK_TABLE_PACKED_DOUBLE));
     bool retVal=true;
     size_t c=(size_t)count;
     if (c>_tableObjects.size())
@@ -180,6 +239,18 @@ bool CInterfaceStackTable::getDoubleArray(double* array,int count) const
     return(retVal);
 }
 
+int CInterfaceStackTable::getPackedArrayType() const
+{
+    return(_packedType);
+}
+
+const void* CInterfaceStackTable::getPackedArrayData() const
+{ // valid until the table is modified or one of its items is accessed individually
+    if ( (_packedType==STACK_TABLE_PACKED_NONE)||(_packedCount==0) )
+        return(nullptr);
+    return(&_packedData[0]);
+}
+
 CInterfaceStackObject* CInterfaceStackTable::getMapObject(const char* fieldName) const
 {
     if (_isTableArray)
@@ -284,11 +355,13 @@ bool CInterfaceStackTable::removeFromKey(const CInterfaceStackObject* keyToRemov
 
 void CInterfaceStackTable::appendArrayObject(CInterfaceStackObject* obj)
 {
+    _unpack();
     _tableObjects.push_back(obj);
 }
 
 void CInterfaceStackTable::appendMapObject(CInterfaceStackObject* obj,const char* key,size_t l)
 {
+    _unpack();
     _isTableArray=false;
     _tableObjects.push_back(new CInterfaceStackString(key,l));
     _tableObjects.push_back(obj);
@@ -296,6 +369,7 @@ void CInterfaceStackTable::appendMapObject(CInterfaceStackObject* obj,const char
 
 void CInterfaceStackTable::appendMapObject(CInterfaceStackObject* obj,double key)
 {
+    _unpack();
     _isTableArray=false;
     _tableObjects.push_back(new CInterfaceStackNumber(key));
     _tableObjects.push_back(obj);
@@ -303,6 +377,7 @@ void CInterfaceStackTable::appendMapObject(CInterfaceStackObject* obj,double key
 
 void CInterfaceStackTable::appendMapObject(CInterfaceStackObject* obj,luaWrap_lua_Integer key)
 {
+    _unpack();
     _isTableArray=false;
     _tableObjects.push_back(new CInterfaceStackInteger(key));
     _tableObjects.push_back(obj);
@@ -310,6 +385,7 @@ void CInterfaceStackTable::appendMapObject(CInterfaceStackObject* obj,luaWrap_lu
 
 void CInterfaceStackTable::appendMapObject(CInterfaceStackObject* obj,bool key)
 {
+    _unpack();
     _isTableArray=false;
     _tableObjects.push_back(new CInterfaceStackBool(key));
     _tableObjects.push_back(obj);
@@ -319,6 +395,7 @@ void CInterfaceStackTable::appendArrayOrMapObject(CInterfaceStackObject* obj,CIn
 {   // here we basically treat this table as an array, until the key is:
     // 1) not a number, 2) not consecutive, 3) does not start at 1.
     // In that case, we then convert that table from array to map representation
+    _unpack();
     bool valueInserted=false;
     if (_isTableArray)
     {
@@ -358,8 +435,9 @@ void CInterfaceStackTable::appendArrayOrMapObject(CInterfaceStackObject* obj,CIn
 
 CInterfaceStackObject* CInterfaceStackTable::getArrayItemAtIndex(int ind) const
 {
-    if ( (!_isTableArray)||(ind>=(int)_tableObjects.size()) )
+    if ( (!_isTableArray)||(ind>=getArraySize()) )
         return(nullptr);
+    _unpack();
     return(_tableObjects[ind]);
 }
 
@@ -399,6 +477,9 @@ CInterfaceStackObject* CInterfaceStackTable::copyYourself() const
     CInterfaceStackTable* retVal=new CInterfaceStackTable();
     for (size_t i=0;i<_tableObjects.size();i++)
         retVal->_tableObjects.push_back(_tableObjects[i]->copyYourself());
+    retVal->_packedData.assign(_packedData.begin(),_packedData.end());
+    retVal->_packedCount=_packedCount;
+    retVal->_packedType=_packedType;
     retVal->_isTableArray=_isTableArray;
     retVal->_isCircularRef=_isCircularRef;
     return(retVal);
@@ -406,6 +487,7 @@ CInterfaceStackObject* CInterfaceStackTable::copyYourself() const
 
 void CInterfaceStackTable::getAllObjectsAndClearTable(std::vector<CInterfaceStackObject*>& allObjs)
 {
+    _unpack();
     allObjs.clear();
     allObjs.assign(_tableObjects.begin(),_tableObjects.end());
     _tableObjects.clear();
@@ -414,42 +496,69 @@ void CInterfaceStackTable::getAllObjectsAndClearTable(std::vector<CInterfaceStac
 
 void CInterfaceStackTable::setUCharArray(const unsigned char* array,int l)
 {
-    _tableObjects.clear();
-    _isTableArray=true;
-    for (int i=0;i<l;i++)
-        _tableObjects.push_back(new CInterfaceStackInteger(array[i]));
+    _setPackedArray(STACK_TABLE_PACKED_UCHAR,array,sizeof(unsigned char),l);
 }
 
 void CInterfaceStackTable::setInt32Array(const int* array,int l)
 {
-    _tableObjects.clear();
-    _isTableArray=true;
-    for (int i=0;i<l;i++)
-        _tableObjects.push_back(new CInterfaceStackInteger(array[i]));
+    _setPackedArray(STACK_TABLE_PACKED_INT32,array,sizeof(int),l);
 }
 
 void CInterfaceStackTable::setInt64Array(const luaWrap_lua_Integer* array,int l)
 {
-    _tableObjects.clear();
-    _isTableArray=true;
-    for (int i=0;i<l;i++)
-        _tableObjects.push_back(new CInterfaceStackInteger(array[i]));
+    _setPackedArray(STACK_TABLE_PACKED_INT64,array,sizeof(luaWrap_lua_Integer),l);
 }
 
 void CInterfaceStackTable::setFloatArray(const float* array,int l)
 {
-    _tableObjects.clear();
-    _isTableArray=true;
-    for (int i=0;i<l;i++)
-        _tableObjects.push_back(new CInterfaceStackNumber((float)array[i]));
+    _setPackedArray(STACK_TABLE_PACKED_FLOAT,array,sizeof(float),l);
 }
 
 void CInterfaceStackTable::setDoubleArray(const double* array,int l)
 {
+    _setPackedArray(STACK_TABLE_PACKED_DOUBLE,array,sizeof(double),l);
+}
+
+void CInterfaceStackTable::_setPackedArray(int packedType,const void* array,size_t itemSize,int l)
+{ // one copy, instead of one object per item
+    for (size_t i=0;i<_tableObjects.size();i++)
+        delete _tableObjects[i];
     _tableObjects.clear();
     _isTableArray=true;
-    for (int i=0;i<l;i++)
-        _tableObjects.push_back(new CInterfaceStackNumber(array[i]));
+    _packedType=packedType;
+    _packedCount=0;
+    _packedData.clear();
+    if (l>0)
+    {
+        _packedCount=(size_t)l;
+        _packedData.assign((const unsigned char*)array,((const unsigned char*)array)+_packedCount*itemSize);
+    }
+}
+
+void CInterfaceStackTable::_unpack() const
+{ // converts a packed table into individual objects. Integer types become integers, float types numbers (as before)
+    if (_packedType==STACK_TABLE_PACKED_NONE)
+        return;
+    _tableObjects.reserve(_tableObjects.size()+_packedCount);
+    const unsigned char* d=nullptr;
+    if (_packedCount>0)
+        d=&_packedData[0];
+    for (size_t i=0;i<_packedCount;i++)
+    {
+        if (_packedType==STACK_TABLE_PACKED_UCHAR)
+            _tableObjects.push_back(new CInterfaceStackInteger(d[i]));
+        else if (_packedType==STACK_TABLE_PACKED_INT32)
+            _tableObjects.push_back(new CInterfaceStackInteger(((const int*)d)[i]));
+        else if (_packedType==STACK_TABLE_PACKED_INT64)
+            _tableObjects.push_back(new CInterfaceStackInteger(((const luaWrap_lua_Integer*)d)[i]));
+        else if (_packedType==STACK_TABLE_PACKED_FLOAT)
+            _tableObjects.push_back(new CInterfaceStackNumber((double)((const float*)d)[i]));
+        else
+            _tableObjects.push_back(new CInterfaceStackNumber(((const double*)d)[i]));
+    }
+    _packedType=STACK_TABLE_PACKED_NONE;
+    _packedCount=0;
+    _packedData.clear();
 }
 
 int CInterfaceStackTable::getTableInfo(int infoType) const
@@ -478,6 +587,17 @@ int CInterfaceStackTable::getTableInfo(int infoType) const
 
 bool CInterfaceStackTable::_areAllValueThis(int what,bool integerAndDoubleTolerant) const
 {
+    if (_packedType!=STACK_TABLE_PACKED_NONE)
+    {
+        if (_packedCount==0)
+            return(true);
+        if ( integerAndDoubleTolerant&&((what==STACK_OBJECT_NUMBER)||(what==STACK_OBJECT_INTEGER)) )
+            return(true);
+        bool integers=( (_packedType==STACK_TABLE_PACKED_UCHAR)||(_packedType==STACK_TABLE_PACKED_INT32)||(_packedType==STACK_TABLE_PACKED_INT64) );
+        if (integers)
+            return(what==STACK_OBJECT_INTEGER);
+        return(what==STACK_OBJECT_NUMBER);
+    }
     if (_tableObjects.size()==0)
         return(true);
     if (_isTableArray)
@@ -517,6 +637,7 @@ bool CInterfaceStackTable::_areAllValueThis(int what,bool integerAndDoubleTolera
 
 void CInterfaceStackTable::printContent(int spaces,std::string& buffer) const
 {
+    _unpack();
     for (int i=0;i<spaces;i++)
         buffer+=" ";
     if (_isCircularRef)
@@ -550,6 +671,8 @@ void CInterfaceStackTable::printContent(int spaces,std::string& buffer) const
 std::string CInterfaceStackTable::getObjectData() const
 {
     std::string retVal;
+    if (_packedType!=STACK_TABLE_PACKED_NONE)
+        return(_getPackedObjectData());
 
     if (_isCircularRef)
         retVal=char(2);
@@ -707,6 +830,45 @@ std::string CInterfaceStackTable::getObjectData() const
     return(retVal);
 }
 
+std::string CInterfaceStackTable::_getPackedObjectData() const
+{ // same format as for an array of individual objects, but without intermediate objects and strings
+    std::string retVal;
+    unsigned int l=(unsigned int)_packedCount;
+    retVal.reserve(1+sizeof(l)+_packedCount*(1+sizeof(double)));
+    retVal.push_back(char(1));
+    retVal.append((const char*)&l,sizeof(l));
+    bool integers=( (_packedType==STACK_TABLE_PACKED_UCHAR)||(_packedType==STACK_TABLE_PACKED_INT32)||(_packedType==STACK_TABLE_PACKED_INT64) );
+    if (integers)
+    {
+        std::vector<luaWrap_lua_Integer> v(_packedCount);
+        if (_packedCount>0)
+            _getPackedArray(&v[0],int(_packedCount),STACK_TABLE_PACKED_INT64);
+        for (size_t i=0;i<_packedCount;i++)
+        {
+#ifdef LUA_STACK_COMPATIBILITY_MODE
+            double w=(double)v[i];
+            retVal.push_back((char)STACK_OBJECT_NUMBER);
+            retVal.append((const char*)&w,sizeof(w));
+#else
+            retVal.push_back((char)STACK_OBJECT_INTEGER);
+            retVal.append((const char*)&v[i],sizeof(v[i]));
+#endif
+        }
+    }
+    else
+    {
+        std::vector<double> v(_packedCount);
+        if (_packedCount>0)
+            _getPackedArray(&v[0],int(_packedCount),STACK_TABLE_PACKED_DOUBLE);
+        for (size_t i=0;i<_packedCount;i++)
+        {
+            retVal.push_back((char)STACK_OBJECT_NUMBER);
+            retVal.append((const char*)&v[i],sizeof(v[i]));
+        }
+    }
+    return(retVal);
+}
+
 unsigned int CInterfaceStackTable::createFromData(const char* data)
 {
     unsigned int retVal=0;
@@ -718,6 +880,28 @@ unsigned int CInterfaceStackTable::createFromData(const char* data)
     for (size_t i=0;i<sizeof(l);i++)
         tmp[i]=data[retVal+i];
     retVal+=sizeof(l);
+    if ( _isTableArray&&(l>0)&&((data[retVal]==STACK_OBJECT_NUMBER)||(data[retVal]==STACK_OBJECT_INTEGER)) )
+    { // we store an array that only contains numbers, or only integers, as a packed table:
+        char t=data[retVal];
+        size_t itemSize=sizeof(double);
+        if (t==STACK_OBJECT_INTEGER)
+            itemSize=sizeof(luaWrap_lua_Integer);
+        size_t itemCnt=0;
+        while ( (itemCnt<l)&&(data[retVal+itemCnt*(1+itemSize)]==t) )
+            itemCnt++;
+        if (itemCnt==l)
+        {
+            _packedType=STACK_TABLE_PACKED_DOUBLE;
+            if (t==STACK_OBJECT_INTEGER)
+                _packedType=STACK_TABLE_PACKED_INT64;
+            _packedCount=l;
+            _packedData.resize(l*itemSize);
+            for (size_t i=0;i<l;i++)
+                memcpy(&_packedData[i*itemSize],data+retVal+i*(1+itemSize)+1,itemSize);
+            retVal+=(unsigned int)(l*(1+itemSize));
+            return(retVal);
+        }
+    }
     for (size_t i=0;i<l;i++)
     {
         unsigned int r=0;
@@ -3,6 +3,14 @@
 #include "interfaceStackObject.h"
 #include <vector>
 
+enum {  STACK_TABLE_PACKED_NONE=0, // items are individual objects
+        STACK_TABLE_PACKED_UCHAR,
+        STACK_TABLE_PACKED_INT32,
+        STACK_TABLE_PACKED_INT64,
+        STACK_TABLE_PACKED_FLOAT,
+        STACK_TABLE_PACKED_DOUBLE
+};
+
 class CInterfaceStackTable : public CInterfaceStackObject
 {
 public:
@@ -43,6 +51,8 @@ public:
     bool getInt64Array(luaWrap_lua_Integer* array,int count) const;
     bool getFloatArray(float* array,int count) const;
     bool getDoubleArray(double* array,int count) const;
+    int getPackedArrayType() const;
+    const void* getPackedArrayData() const;
     CInterfaceStackObject* getMapObject(const char* fieldName) const;
 
     bool removeFromKey(const CInterfaceStackObject* keyToRemove);
@@ -51,8 +61,17 @@ public:
 
 protected:
     bool _areAllValueThis(int what,bool integerAndDoubleTolerant) const;
+    void _setPackedArray(int packedType,const void* array,size_t itemSize,int l);
+    void _unpack() const;
+    std::string _getPackedObjectData() const;
+    template<class T> bool _getPackedArray(T* array,int count,int arrayType) const;
 
-    std::vector<CInterfaceStackObject*> _tableObjects;
+    // Numeric arrays are stored contiguously in _packedData, and only converted to
+    // individual objects (_unpack) when an item is accessed or the table is modified:
+    mutable std::vector<CInterfaceStackObject*> _tableObjects;
+    mutable std::vector<unsigned char> _packedData;
+    mutable size_t _packedCount;
+    mutable int _packedType;
     bool _isTableArray;
     bool _isCircularRef;
 };
@@ -9,11 +9,14 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include "vVarious.h"
 #include "vDateTime.h"
+#include "stepProfiler.h"
 #include "app.h"
 #include "apiErrors.h"
 #include "interfaceStack.h"
 #include "fileOperations.h"
 #include "ttUtil.h"
+#include "vFile.h"
+#include "vArchive.h"
 #include "imgLoaderSaver.h"
 #include "sceneObjectOperations.h"
 #include "collisionRoutines.h"
@@ -21,21 +24,21 @@
 
 #define LUA_START(funcName) \
     CApiErrors::clearThreadBasedFirstCapiErrorAndWarning(); \
-    std::string functionName(funcName); \
+    const char* functionName=funcName; \
     std::string errorString; \
     std::string warningString; \
     bool cSideErrorOrWarningReporting=true;
 
 #define LUA_START_NO_CSIDE_ERROR(funcName) \
     CApiErrors::clearThreadBasedFirstCapiErrorAndWarning(); \
-    std::string functionName(funcName); \
+    const char* functionName=funcName; \
     std::string errorString; \
     std::string warningString; \
     bool cSideErrorOrWarningReporting=false;
 
 #define LUA_END(p) \
     do { \
-        _reportWarningsIfNeeded(L,functionName.c_str(),warningString.c_str(),cSideErrorOrWarningReporting); \
+        _reportWarningsIfNeeded(L,functionName,warningString.c_str(),cSideErrorOrWarningReporting); \
         return(p); \
     } while(0)
 
@@ -95,7 +98,7 @@ void _raiseErrorOrYieldIfNeeded(luaWrap_lua_State* L,const char* functionName,co
     luaWrap_lua_error(L); // does a long jump and never returns
 }
 
-#define LUA_RAISE_ERROR_OR_YIELD_IF_NEEDED() _raiseErrorOrYieldIfNeeded(L,functionName.c_str(),errorString.c_str(),cSideErrorOrWarningReporting)
+#define LUA_RAISE_ERROR_OR_YIELD_IF_NEEDED() _raiseErrorOrYieldIfNeeded(L,functionName,errorString.c_str(),cSideErrorOrWarningReporting)
 
 std::vector<int> serialPortHandles;
 std::vector<std::string> serialPortLeftOverData;
@@ -131,11 +134,15 @@ const SLuaCommands simLuaCommands[]=
     {"sim.getJointTargetPosition",_simGetJointTargetPosition,    "int result,float targetPosition=sim.getJointTargetPosition(int objectHandle)",true},
     {"sim.setJointMaxForce",_simSetJointMaxForce,                "sim.setJointMaxForce(int objectHandle,float forceOrTorque)",true},
     {"sim.setJointTargetVelocity",_simSetJointTargetVelocity,    "sim.setJointTargetVelocity(int objectHandle,float targetVelocity)",true},
+    {"sim.setJointBatchControl",_simSetJointBatchControl,        "int result=sim.setJointBatchControl(int jointHandle,bool enable)",true},
     {"sim.getJointTargetVelocity",_simGetJointTargetVelocity,    "float targetVelocity=sim.getJointTargetVelocity(int objectHandle)",true},
     {"sim.getObjectName",_simGetObjectName,                      "string objectName=sim.getObjectName(int objectHandle)",true},
     {"sim.removeObject",_simRemoveObject,                        "int result=sim.removeObject(int objectHandle)",true},
     {"sim.removeModel",_simRemoveModel,                          "int removedObjects=sim.removeModel(int objectHandle)",true},
     {"sim.getSimulationTime",_simGetSimulationTime,              "float simulationTime=sim.getSimulationTime()",true},
+    {"sim.setStepProfilerEnabled",_simSetStepProfilerEnabled,    "int result=sim.setStepProfilerEnabled(bool enabled)",true},
+    {"sim.saveStepProfilerTrace",_simSaveStepProfilerTrace,      "int eventCount=sim.saveStepProfilerTrace(string filename,bool clearEvents=false)",true},
+    {"sim.getSimulationThreadCommandStats",_simGetSimulationThreadCommandStats,"table[6] stats=sim.getSimulationThreadCommandStats()",true},
     {"sim.getSimulationState",_simGetSimulationState,            "int simulationState=sim.getSimulationState()",true},
     {"sim.getSystemTime",_simGetSystemTime,                      "float systemTime=sim.getSystemTime()",true},
     {"sim.getSystemTimeInMs",_simGetSystemTimeInMs,              "int systemTimeOrTimeDiff=sim.getSystemTimeInMs(int previousTime)",true},
@@ -152,6 +159,8 @@ const SLuaCommands simLuaCommands[]=
     {"sim.handleGraph",_simHandleGraph,                          "sim.handleGraph(int objectHandle,float simulationTime)",true},
     {"sim.getGraphCurve",_simGetGraphCurve,                      "string label,int attributes,table[3] curveColor,table[] xData,table[] yData,table[6] minMax,\nint curveId,int curveWidth=sim.getGraphCurve(int graphHandle,int graphType,int curveIndex)",true},
     {"sim.getGraphInfo",_simGetGraphInfo,                        "int bitCoded,table[3] bgColor,table[3] fgColor,int bufferSize=sim.getGraphInfo(int graphHandle)",true},
+    {"sim.getGraphRecordedData",_simGetGraphRecordedData,        "table[] times,table[] minVals,table[] maxVals,table[] meanVals=sim.getGraphRecordedData(int graphHandle,\nint streamId,float fromTime,float toTime,int maxPointCount)",true},
+    {"sim.exportGraphRecording",_simExportGraphRecording,        "int rowCount=sim.exportGraphRecording(int graphHandle,string filename,float fromTime,float toTime,int maxRowCount)",true},
     {"sim.addGraphStream",_simAddGraphStream,                    "int streamId=sim.addGraphStream(int graphHandle,string streamName,\nstring unit,int options=0,table[3] color={1,0,0},float cyclicRange=pi)",true},
     {"sim.destroyGraphCurve",_simDestroyGraphCurve,              "sim.destroyGraphCurve(int graphHandle,int curveId)",true},
     {"sim.setGraphStreamTransformation",_simSetGraphStreamTransformation, "sim.setGraphStreamTransformation(int graphHandle,int streamId,\nint trType,float mult=1.0,float off=0.0,int movAvgPeriod=1)",true},
@@ -250,6 +259,7 @@ const SLuaCommands simLuaCommands[]=
     {"sim.addDrawingObject",_simAddDrawingObject,                "int drawingObjectHandle=sim.addDrawingObject(int objectType,float size,float duplicateTolerance,\nint parentObjectHandle,int maxItemCount,table[3] ambient_diffuse=nil,nil,table[3] specular=nil,\ntable[3] emission=nil)",true},
     {"sim.removeDrawingObject",_simRemoveDrawingObject,          "sim.removeDrawingObject(int drawingObjectHandle)",true},
     {"sim.addDrawingObjectItem",_simAddDrawingObjectItem,        "int result=sim.addDrawingObjectItem(int drawingObjectHandle,table[] itemData)",true},
+    {"sim.addDrawingObjectItems",_simAddDrawingObjectItems,      "int addedCount=sim.addDrawingObjectItems(int drawingObjectHandle,string packedItemData)",true},
     {"sim.addParticleObject",_simAddParticleObject,              "int particleObjectHandle=sim.addParticleObject(int objectType,float size,float density,table[] params,float lifeTime,\nint maxItemCount,table[3] ambient_diffuse=nil,nil,table[3] specular=nil,table[3] emission=nil)",true},
     {"sim.removeParticleObject",_simRemoveParticleObject,        "sim.removeParticleObject(int particleObjectHandle)",true},
     {"sim.addParticleObjectItem",_simAddParticleObjectItem,      "sim.addParticleObjectItem(int particleObjectHandle,table[] itemData)",true},
@@ -438,6 +448,8 @@ const SLuaCommands simLuaCommands[]=
     {"sim.isDynamicallyEnabled",_simIsDynamicallyEnabled,        "boolean enabled=sim.isDynamicallyEnabled(int objectHandle)",true},
     {"sim.generateShapeFromPath",_simGenerateShapeFromPath,      "int shapeHandle=sim.generateShapeFromPath(table[] path,table[] section,int options=0,table[3] upVector={0.0,0.0,1.0})",true},
     {"sim.initScript",_simInitScript,                            "bool result=sim.initScript(int scriptHandle)",true},
+    {"sim.setSignals",_simSetSignals,                            "int count=sim.setSignals(int signalType,table signalNames,table signalValues)",true},
+    {"sim.getSignals",_simGetSignals,                            "table signalValues=sim.getSignals(int signalType,table signalNames)",true},
 
     {"sim.test",_simTest,                                        "test function - shouldn't be used",true},
 
@@ -475,6 +487,7 @@ const SLuaCommands simLuaCommands[]=
     {"sim.setThreadIsFree",_simSetThreadIsFree,                  "Deprecated. Has no effect.",false},
     {"sim._tubeRead",_simTubeRead,                               "",false},
     {"sim.tubeOpen",_simTubeOpen,                                "Deprecated. Use signals or custom data blocks instead",false},
+    {"sim.tubeReadAll",_simTubeReadAll,                          "table[] data=sim.tubeReadAll(int tubeHandle)",true},
     {"sim.tubeClose",_simTubeClose,                              "Deprecated. Use signals or custom data blocks instead",false},
     {"sim.tubeWrite",_simTubeWrite,                              "Deprecated. Use signals or custom data blocks instead",false},
     {"sim.tubeStatus",_simTubeStatus,                            "Deprecated. Use signals or custom data blocks instead",false},
@@ -1669,6 +1682,7 @@ const SLuaVariables simLuaVariables[]=
     {"sim.visionintparam_pov_blur_sampled",sim_visionintparam_pov_blur_sampled,true},
     {"sim.visionintparam_render_mode",sim_visionintparam_render_mode,true},
     {"sim.visionintparam_perspective_operation",sim_visionintparam_perspective_operation,true},
+    {"sim.visionintparam_pipelined_readback",sim_visionintparam_pipelined_readback,true},
     // joints
     {"sim.jointintparam_motor_enabled",sim_jointintparam_motor_enabled,true},
     {"sim.jointintparam_ctrl_enabled",sim_jointintparam_ctrl_enabled,true},
@@ -1773,6 +1787,7 @@ const SLuaVariables simLuaVariables[]=
     {"sim.dummyfloatparam_size",sim_dummyfloatparam_size,true},
     // graph
     {"sim.graphintparam_needs_refresh",sim_graphintparam_needs_refresh,true},
+    {"sim.graphintparam_recording",sim_graphintparam_recording,true},
     // mills
     {"sim.millintparam_volume_type",sim_millintparam_volume_type,true},
     // mirrors
@@ -3588,6 +3603,25 @@ void getFloatsFromTable(luaWrap_lua_State* L,int tablePos,int floatCount,float*
     }
 }
 
+void getLStringsFromTable(luaWrap_lua_State* L,int tablePos,int stringCount,std::vector<std::string>& strings,std::vector<const char*>& stringPtrs)
+{
+    strings.resize(stringCount);
+    stringPtrs.resize(stringCount);
+    for (int i=0;i<stringCount;i++)
+    {
+        luaWrap_lua_rawgeti(L,tablePos,i+1);
+        size_t l;
+        const char* str=luaWrap_lua_tolstring(L,-1,&l);
+        if (str!=nullptr)
+            strings[i].assign(str,l);
+        else
+            strings[i].clear(); // not a string. Callers should check the table content first
+        luaWrap_lua_pop(L,1); // we pop one element from the stack;
+    }
+    for (int i=0;i<stringCount;i++)
+        stringPtrs[i]=strings[i].c_str();
+}
+
 void getDoublesFromTable(luaWrap_lua_State* L,int tablePos,int doubleCount,double* arrayField)
 {
     for (int i=0;i<doubleCount;i++)
@@ -4347,21 +4381,24 @@ int _simGenericFunctionHandler(luaWrap_lua_State* L)
     int id=luaWrap_lua_tointeger(L,-1)-1;
     luaWrap_lua_pop(L,1); // we have to pop the pushed value to get the original stack state
     int outputArgCount=0;
+    std::string pluginFunctionName;
     for (size_t j=0;j<App::worldContainer->luaCustomFuncAndVarContainer->allCustomFunctions.size();j++)
     { // we now search for the callback to call:
         CLuaCustomFunction* it=App::worldContainer->luaCustomFuncAndVarContainer->allCustomFunctions[j];
         if (it->getFunctionID()==id)
         { // we have the right one! Now we need to prepare the input and output argument arrays:
-            functionName=it->getFunctionName();
-            App::logMsg(sim_verbosity_debug,(std::string("sim.genericFunctionHandler: ")+functionName).c_str());
+            pluginFunctionName=it->getFunctionName();
+            App::logMsg(sim_verbosity_debug,(std::string("sim.genericFunctionHandler: ")+pluginFunctionName).c_str());
             if (it->getPluginName().size()!=0)
             {
-                functionName+="@simExt";
-                functionName+=it->getPluginName();
+                pluginFunctionName+="@simExt";
+                pluginFunctionName+=it->getPluginName();
             }
             else
-                functionName+="@plugin";
+                pluginFunctionName+="@plugin";
+            functionName=pluginFunctionName.c_str();
 
+            CStepProfilerScope profilerScope("plugin",functionName);
             if (it->getUsesStackToExchangeData())
                 outputArgCount=_genericFunctionHandler_new(L,it,errorString);
             else
@@ -5689,6 +5726,25 @@ int _simSetJointTargetVelocity(luaWrap_lua_State* L)
     LUA_END(1);
 }
 
+int _simSetJointBatchControl(luaWrap_lua_State* L)
+{ // the calling script's sysCall_jointCallbackBatch will control the joint
+    TRACE_LUA_API;
+    LUA_START("sim.setJointBatchControl");
+
+    int retVal=-1; // means error
+    if (checkInputArguments(L,&errorString,lua_arg_number,0,lua_arg_bool,0))
+    {
+        int scriptHandle=-1;
+        if (luaToBool(L,2))
+            scriptHandle=CLuaScriptObject::getScriptHandleFromLuaState(L);
+        retVal=simSetJointBatchControl_internal(luaToInt(L,1),scriptHandle);
+    }
+
+    LUA_RAISE_ERROR_OR_YIELD_IF_NEEDED(); // we might never return from this!
+    luaWrap_lua_pushinteger(L,retVal);
+    LUA_END(1);
+}
+
 int _simGetJointTargetVelocity(luaWrap_lua_State* L)
 {
     TRACE_LUA_API;
@@ -5781,6 +5837,59 @@ int _simGetSimulationTime(luaWrap_lua_State* L)
     LUA_END(1);
 }
 
+int _simSetStepProfilerEnabled(luaWrap_lua_State* L)
+{
+    TRACE_LUA_API;
+    LUA_START("sim.setStepProfilerEnabled");
+
+    int retVal=-1;
+    if (checkInputArguments(L,&errorString,lua_arg_bool,0))
+        retVal=simSetStepProfilerEnabled_internal(luaToBool(L,1));
+
+    LUA_RAISE_ERROR_OR_YIELD_IF_NEEDED(); // we might never return from this!
+    luaWrap_lua_pushinteger(L,retVal);
+    LUA_END(1);
+}
+
+int _simSaveStepProfilerTrace(luaWrap_lua_State* L)
+{
+    TRACE_LUA_API;
+    LUA_START("sim.saveStepProfilerTrace");
+
+    int retVal=-1;
+    if (checkInputArguments(L,&errorString,lua_arg_string,0))
+    {
+        std::string filename(luaWrap_lua_tostring(L,1));
+        bool clearEvents=false;
+        int res=checkOneGeneralInputArgument(L,2,lua_arg_bool,0,true,false,&errorString);
+        if (res>=0)
+        {
+            if (res==2)
+                clearEvents=luaToBool(L,2);
+            retVal=simSaveStepProfilerTrace_internal(filename.c_str(),clearEvents);
+        }
+    }
+
+    LUA_RAISE_ERROR_OR_YIELD_IF_NEEDED(); // we might never return from this!
+    luaWrap_lua_pushinteger(L,retVal);
+    LUA_END(1);
+}
+
+int _simGetSimulationThreadCommandStats(luaWrap_lua_State* L)
+{ // queued count, delayed count, max. queued count, executed count, last latency (ms), max. latency (ms)
+    TRACE_LUA_API;
+    LUA_START("sim.getSimulationThreadCommandStats");
+
+    int stats[6];
+    unsigned int executedCount;
+    App::simThread->getSimulationThreadCommandStats(stats[0],stats[1],stats[2],executedCount,stats[4],stats[5]);
+    stats[3]=int(executedCount);
+
+    LUA_RAISE_ERROR_OR_YIELD_IF_NEEDED(); // we might never return from this!
+    pushIntTableOntoStack(L,6,stats);
+    LUA_END(1);
+}
+
 int _simGetSimulationState(luaWrap_lua_State* L)
 {
     // In case we copy-paste a script during execution, the new script doesn't get the sim_simulation_starting message,
@@ -10341,6 +10450,40 @@ int _simAddDrawingObjectItem(luaWrap_lua_State* L)
     LUA_END(1);
 }
 
+int _simAddDrawingObjectItems(luaWrap_lua_State* L)
+{ // itemData is a packed float buffer (e.g. from sim.packFloatTable), containing several items
+    TRACE_LUA_API;
+    LUA_START("sim.addDrawingObjectItems");
+
+    int retVal=-1; // means error
+    if (checkInputArguments(L,&errorString,lua_arg_number,0,lua_arg_string,0))
+    {
+        int h=luaToInt(L,1);
+        CDrawingObject* it=App::currentWorld->drawingCont->getObject(h);
+        if (it!=nullptr)
+        {
+            size_t dataLength;
+            const char* data=luaWrap_lua_tolstring(L,2,&dataLength);
+            size_t itemCnt=dataLength/(sizeof(float)*size_t(it->floatsPerItem));
+            if (itemCnt*sizeof(float)*size_t(it->floatsPerItem)==dataLength)
+            {
+                std::vector<float> items(itemCnt*size_t(it->floatsPerItem));
+                if (itemCnt>0)
+                    memcpy(&items[0],data,dataLength); // Lua strings are not necessarily aligned for floats
+                retVal=simAddDrawingObjectItems_internal(h,items.data(),int(itemCnt));
+            }
+            else
+                errorString=SIM_ERROR_ONE_STRING_SIZE_IS_WRONG;
+        }
+        else
+            errorString=SIM_ERROR_OBJECT_INEXISTANT;
+    }
+
+    LUA_RAISE_ERROR_OR_YIELD_IF_NEEDED(); // we might never return from this!
+    luaWrap_lua_pushinteger(L,retVal);
+    LUA_END(1);
+}
+
 int _simAddParticleObject(luaWrap_lua_State* L)
 {
     TRACE_LUA_API;
@@ -13060,6 +13203,146 @@ int _simInitScript(luaWrap_lua_State* L)
     LUA_END(0);
 }
 
+int _simSetSignals(luaWrap_lua_State* L)
+{
+    TRACE_LUA_API;
+    LUA_START("sim.setSignals");
+
+    int retVal=-1; //error
+    if (checkInputArguments(L,&errorString,lua_arg_number,0,lua_arg_string,1))
+    {
+        int signalType=luaToInt(L,1);
+        int cnt=int(luaWrap_lua_rawlen(L,2));
+        int valType=lua_arg_number;
+        if (signalType==2)
+            valType=lua_arg_string;
+        int res=2;
+        if (cnt>0)
+        { // all names and values need to be checked, not just the first ones
+            res=checkOneGeneralInputArgument(L,2,lua_arg_string,cnt,false,false,&errorString);
+            if (res==2)
+                res=checkOneGeneralInputArgument(L,3,valType,cnt,false,false,&errorString);
+        }
+        else
+            retVal=0;
+        if ( (res==2)&&(cnt>0) )
+        {
+            std::vector<std::string> names;
+            std::vector<const char*> namePtrs;
+            getLStringsFromTable(L,2,cnt,names,namePtrs);
+            setCurrentScriptInfo_cSide(CLuaScriptObject::getScriptHandleFromLuaState(L),CLuaScriptObject::getScriptNameIndexFromLuaState(L)); // for transmitting to the master function additional info (e.g.for autom. name adjustment, or for autom. object deletion when script ends)
+            if (signalType==0)
+            {
+                std::vector<int> vals(cnt);
+                getIntsFromTable(L,3,cnt,&vals[0]);
+                retVal=simSetSignals_internal(signalType,cnt,&namePtrs[0],&vals[0],nullptr);
+            }
+            else if (signalType==1)
+            {
+                std::vector<float> vals(cnt);
+                getFloatsFromTable(L,3,cnt,&vals[0]);
+                retVal=simSetSignals_internal(signalType,cnt,&namePtrs[0],&vals[0],nullptr);
+            }
+            else if (signalType==3)
+            {
+                std::vector<double> vals(cnt);
+                getDoublesFromTable(L,3,cnt,&vals[0]);
+                retVal=simSetSignals_internal(signalType,cnt,&namePtrs[0],&vals[0],nullptr);
+            }
+            else if (signalType==2)
+            {
+                std::vector<std::string> vals;
+                std::vector<const char*> valPtrs;
+                getLStringsFromTable(L,3,cnt,vals,valPtrs);
+                std::vector<int> lengths(cnt);
+                for (int i=0;i<cnt;i++)
+                    lengths[i]=int(vals[i].size());
+                retVal=simSetSignals_internal(signalType,cnt,&namePtrs[0],&valPtrs[0],&lengths[0]);
+            }
+            else
+                retVal=simSetSignals_internal(signalType,cnt,&namePtrs[0],nullptr,nullptr); // will generate an error
+            setCurrentScriptInfo_cSide(-1,-1);
+        }
+    }
+
+    LUA_RAISE_ERROR_OR_YIELD_IF_NEEDED(); // we might never return from this!
+    luaWrap_lua_pushinteger(L,retVal);
+    LUA_END(1);
+}
+
+int _simGetSignals(luaWrap_lua_State* L)
+{ // signals that do not exist leave a nil at their position in the returned table
+    TRACE_LUA_API;
+    LUA_START("sim.getSignals");
+
+    if (checkInputArguments(L,&errorString,lua_arg_number,0,lua_arg_string,1))
+    {
+        int signalType=luaToInt(L,1);
+        int cnt=int(luaWrap_lua_rawlen(L,2));
+        if (cnt==0)
+        {
+            luaWrap_lua_newtable(L);
+            LUA_END(1);
+        }
+        if (checkOneGeneralInputArgument(L,2,lua_arg_string,cnt,false,false,&errorString)!=2)
+        { // all names need to be checked, not just the first one
+            LUA_RAISE_ERROR_OR_YIELD_IF_NEEDED(); // we might never return from this!
+            LUA_END(0);
+        }
+        std::vector<std::string> names;
+        std::vector<const char*> namePtrs;
+        getLStringsFromTable(L,2,cnt,names,namePtrs);
+        std::vector<char> present(cnt);
+        std::vector<double> numVals(cnt);
+        std::vector<char*> strVals(cnt);
+        std::vector<int> strLengths(cnt);
+        int res=-1;
+        if (signalType==0)
+        {
+            std::vector<int> vals(cnt);
+            res=simGetSignals_internal(signalType,cnt,&namePtrs[0],&vals[0],nullptr,&present[0]);
+            for (int i=0;i<cnt;i++)
+                numVals[i]=double(vals[i]);
+        }
+        else if (signalType==1)
+        {
+            std::vector<float> vals(cnt);
+            res=simGetSignals_internal(signalType,cnt,&namePtrs[0],&vals[0],nullptr,&present[0]);
+            for (int i=0;i<cnt;i++)
+                numVals[i]=double(vals[i]);
+        }
+        else if (signalType==3)
+            res=simGetSignals_internal(signalType,cnt,&namePtrs[0],&numVals[0],nullptr,&present[0]);
+        else
+            res=simGetSignals_internal(signalType,cnt,&namePtrs[0],&strVals[0],&strLengths[0],&present[0]);
+        if (res>=0)
+        {
+            luaWrap_lua_newtable(L);
+            int newTablePos=luaWrap_lua_gettop(L);
+            for (int i=0;i<cnt;i++)
+            {
+                if (present[i]!=0)
+                {
+                    if (signalType==0)
+                        luaWrap_lua_pushinteger(L,int(numVals[i]));
+                    else if (signalType==2)
+                    {
+                        luaWrap_lua_pushlstring(L,strVals[i],strLengths[i]);
+                        simReleaseBuffer_internal(strVals[i]);
+                    }
+                    else
+                        luaWrap_lua_pushnumber(L,numVals[i]);
+                    luaWrap_lua_rawseti(L,newTablePos,i+1);
+                }
+            }
+            LUA_END(1);
+        }
+    }
+
+    LUA_RAISE_ERROR_OR_YIELD_IF_NEEDED(); // we might never return from this!
+    LUA_END(0);
+}
+
 int _simGroupShapes(luaWrap_lua_State* L)
 {
     TRACE_LUA_API;
@@ -15075,6 +15358,110 @@ int _simGetGraphInfo(luaWrap_lua_State* L)
     LUA_END(0);
 }
 
+int _simGetGraphRecordedData(luaWrap_lua_State* L)
+{ // data recorded to disk (see sim.graphintparam_recording), decimated to at most maxPointCount points
+    TRACE_LUA_API;
+    LUA_START("sim.getGraphRecordedData");
+
+    if (checkInputArguments(L,&errorString,lua_arg_number,0,lua_arg_number,0,lua_arg_number,0,lua_arg_number,0,lua_arg_number,0))
+    {
+        int graphHandle=luaWrap_lua_tointeger(L,1);
+        int streamId=luaWrap_lua_tointeger(L,2);
+        float fromTime=(float)luaWrap_lua_tonumber(L,3);
+        float toTime=(float)luaWrap_lua_tonumber(L,4);
+        int maxPointCnt=luaWrap_lua_tointeger(L,5);
+        CGraph* graph=App::currentWorld->sceneObjects->getGraphFromHandle(graphHandle);
+        if (graph!=nullptr)
+        {
+            if (maxPointCnt>0)
+            {
+                std::vector<float> times;
+                std::vector<std::vector<float> > minVals;
+                std::vector<std::vector<float> > maxVals;
+                std::vector<std::vector<float> > meanVals;
+                bool ok=true;
+                if (graph->getRecorder()!=nullptr)
+                {
+                    std::vector<int> streamIds;
+                    streamIds.push_back(streamId);
+                    ok=graph->getRecorder()->getDecimatedData(streamIds,fromTime,toTime,maxPointCnt,times,minVals,maxVals,meanVals);
+                }
+                if (ok)
+                {
+                    if (times.size()>0)
+                    {
+                        pushFloatTableOntoStack(L,(int)times.size(),&times[0]);
+                        pushFloatTableOntoStack(L,(int)times.size(),&minVals[0][0]);
+                        pushFloatTableOntoStack(L,(int)times.size(),&maxVals[0][0]);
+                        pushFloatTableOntoStack(L,(int)times.size(),&meanVals[0][0]);
+                    }
+                    else
+                    {
+                        for (size_t i=0;i<4;i++)
+                            pushFloatTableOntoStack(L,0,nullptr);
+                    }
+                    LUA_END(4);
+                }
+                else
+                    errorString=SIM_ERROR_OPERATION_FAILED;
+            }
+            else
+                errorString=SIM_ERROR_INVALID_ARGUMENT;
+        }
+        else
+            errorString=SIM_ERROR_OBJECT_NOT_GRAPH;
+    }
+    LUA_RAISE_ERROR_OR_YIELD_IF_NEEDED(); // we might never return from this!
+    LUA_END(0);
+}
+
+int _simExportGraphRecording(luaWrap_lua_State* L)
+{
+    TRACE_LUA_API;
+    LUA_START("sim.exportGraphRecording");
+
+    if (checkInputArguments(L,&errorString,lua_arg_number,0,lua_arg_string,0,lua_arg_number,0,lua_arg_number,0,lua_arg_number,0))
+    {
+        int graphHandle=luaWrap_lua_tointeger(L,1);
+        std::string filename(luaWrap_lua_tostring(L,2));
+        float fromTime=(float)luaWrap_lua_tonumber(L,3);
+        float toTime=(float)luaWrap_lua_tonumber(L,4);
+        int maxRowCnt=luaWrap_lua_tointeger(L,5);
+        CGraph* graph=App::currentWorld->sceneObjects->getGraphFromHandle(graphHandle);
+        if (graph!=nullptr)
+        {
+            if (maxRowCnt>0)
+            {
+                int rowCnt=-1;
+                try
+                {
+                    VFile myFile(filename.c_str(),VFile::CREATE_WRITE|VFile::SHARE_EXCLUSIVE);
+                    VArchive ar(&myFile,VArchive::STORE);
+                    rowCnt=graph->exportRecordedData(ar,fromTime,toTime,maxRowCnt);
+                    ar.close();
+                    myFile.close();
+                }
+                catch(VFILE_EXCEPTION_TYPE e)
+                {
+                    rowCnt=-1;
+                }
+                if (rowCnt>=0)
+                {
+                    luaWrap_lua_pushinteger(L,rowCnt);
+                    LUA_END(1);
+                }
+                errorString=SIM_ERROR_OPERATION_FAILED;
+            }
+            else
+                errorString=SIM_ERROR_INVALID_ARGUMENT;
+        }
+        else
+            errorString=SIM_ERROR_OBJECT_NOT_GRAPH;
+    }
+    LUA_RAISE_ERROR_OR_YIELD_IF_NEEDED(); // we might never return from this!
+    LUA_END(0);
+}
+
 int _simGetShapeViz(luaWrap_lua_State* L)
 {
     TRACE_LUA_API;
@@ -18398,13 +18785,38 @@ int _simTubeRead(luaWrap_lua_State* L)
     LUA_START("sim._tubeRead");
 
     if (checkInputArguments(L,&errorString,lua_arg_number,0))
-    {
+    { // we read directly from the tube's ring buffer, without intermediate copy
         int dataLength;
-        char* data=simTubeRead_internal(luaToInt(L,1),&dataLength);
-        if (data)
+        const char* data=App::currentWorld->commTubeContainer->readFromTube_view(luaToInt(L,1),dataLength);
+        if (data!=nullptr)
         {
-            luaWrap_lua_pushlstring(L,(const char*)data,dataLength);
-            delete[] data;
+            luaWrap_lua_pushlstring(L,data,dataLength);
+            LUA_END(1);
+        }
+    }
+
+    LUA_RAISE_ERROR_OR_YIELD_IF_NEEDED(); // we might never return from this!
+    LUA_END(0);
+}
+
+int _simTubeReadAll(luaWrap_lua_State* L)
+{ // returns all pending packets at once
+    TRACE_LUA_API;
+    LUA_START("sim.tubeReadAll");
+
+    if (checkInputArguments(L,&errorString,lua_arg_number,0))
+    {
+        std::vector<const char*> data;
+        std::vector<int> dataLengths;
+        if (App::currentWorld->commTubeContainer->readAllFromTube_views(luaToInt(L,1),data,dataLengths)>=0)
+        {
+            luaWrap_lua_newtable(L);
+            int newTablePos=luaWrap_lua_gettop(L);
+            for (size_t i=0;i<data.size();i++)
+            {
+                luaWrap_lua_pushlstring(L,data[i],dataLengths[i]);
+                luaWrap_lua_rawseti(L,newTablePos,int(i)+1);
+            }
             LUA_END(1);
         }
     }
@@ -18421,10 +18833,17 @@ int _simTubeOpen(luaWrap_lua_State* L)
     int retVal=-1; // Error
     if (checkInputArguments(L,&errorString,lua_arg_number,0,lua_arg_string,0,lua_arg_number,0))
     {
-        std::string strTmp=luaWrap_lua_tostring(L,2);
-        int currentScriptID=CLuaScriptObject::getScriptHandleFromLuaState(L);
-        CLuaScriptObject* it=App::worldContainer->getScriptFromHandle(currentScriptID);
-        retVal=App::currentWorld->commTubeContainer->openTube(luaToInt(L,1),strTmp.c_str(),(it->getScriptType()==sim_scripttype_mainscript)||(it->getScriptType()==sim_scripttype_childscript),luaToInt(L,3));
+        bool overwriteOldest=true;
+        int res=checkOneGeneralInputArgument(L,4,lua_arg_bool,0,true,false,&errorString);
+        if ((res==0)||(res==2))
+        {
+            if (res==2)
+                overwriteOldest=luaToBool(L,4);
+            std::string strTmp=luaWrap_lua_tostring(L,2);
+            int currentScriptID=CLuaScriptObject::getScriptHandleFromLuaState(L);
+            CLuaScriptObject* it=App::worldContainer->getScriptFromHandle(currentScriptID);
+            retVal=App::currentWorld->commTubeContainer->openTube(luaToInt(L,1),strTmp.c_str(),(it->getScriptType()==sim_scripttype_mainscript)||(it->getScriptType()==sim_scripttype_childscript),luaToInt(L,3),overwriteOldest);
+        }
     }
 
     LUA_RAISE_ERROR_OR_YIELD_IF_NEEDED(); // we might never return from this!
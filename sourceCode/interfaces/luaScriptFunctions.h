@@ -56,6 +56,7 @@ void writeCustomFunctionDataOntoStack(luaWrap_lua_State* L,int dataType,int data
 
 void getFloatsFromTable(luaWrap_lua_State* L,int tablePos,int floatCount,float* arrayField);
 void getDoublesFromTable(luaWrap_lua_State* L,int tablePos,int doubleCount,double* arrayField);
+void getLStringsFromTable(luaWrap_lua_State* L,int tablePos,int stringCount,std::vector<std::string>& strings,std::vector<const char*>& stringPtrs);
 bool getIntsFromTable(luaWrap_lua_State* L,int tablePos,int intCount,int* arrayField);
 bool getUIntsFromTable(luaWrap_lua_State* L,int tablePos,int intCount,unsigned int* arrayField);
 bool getUCharsFromTable(luaWrap_lua_State* L,int tablePos,int intCount,unsigned char* arrayField);
@@ -151,12 +152,16 @@ extern int _simSetJointTargetPosition(luaWrap_lua_State* L);
 extern int _simGetJointTargetPosition(luaWrap_lua_State* L);
 extern int _simSetJointMaxForce(luaWrap_lua_State* L);
 extern int _simSetJointTargetVelocity(luaWrap_lua_State* L);
+extern int _simSetJointBatchControl(luaWrap_lua_State* L);
 extern int _simGetJointTargetVelocity(luaWrap_lua_State* L);
 extern int _simGetObjectName(luaWrap_lua_State* L);
 extern int _simSetObjectName(luaWrap_lua_State* L);
 extern int _simRemoveObject(luaWrap_lua_State* L);
 extern int _simRemoveModel(luaWrap_lua_State* L);
 extern int _simGetSimulationTime(luaWrap_lua_State* L);
+extern int _simSetStepProfilerEnabled(luaWrap_lua_State* L);
+extern int _simSaveStepProfilerTrace(luaWrap_lua_State* L);
+extern int _simGetSimulationThreadCommandStats(luaWrap_lua_State* L);
 extern int _simGetSimulationState(luaWrap_lua_State* L);
 extern int _simGetSystemTime(luaWrap_lua_State* L);
 extern int _simGetSystemTimeInMs(luaWrap_lua_State* L);
@@ -282,6 +287,7 @@ extern int _simSetLinkDummy(luaWrap_lua_State* L);
 extern int _simAddDrawingObject(luaWrap_lua_State* L);
 extern int _simRemoveDrawingObject(luaWrap_lua_State* L);
 extern int _simAddDrawingObjectItem(luaWrap_lua_State* L);
+extern int _simAddDrawingObjectItems(luaWrap_lua_State* L);
 extern int _simAddParticleObject(luaWrap_lua_State* L);
 extern int _simRemoveParticleObject(luaWrap_lua_State* L);
 extern int _simAddParticleObjectItem(luaWrap_lua_State* L);
@@ -445,6 +451,8 @@ extern int _simSetReferencedHandles(luaWrap_lua_State* L);
 extern int _simGetReferencedHandles(luaWrap_lua_State* L);
 extern int _simGetGraphCurve(luaWrap_lua_State* L);
 extern int _simGetGraphInfo(luaWrap_lua_State* L);
+extern int _simGetGraphRecordedData(luaWrap_lua_State* L);
+extern int _simExportGraphRecording(luaWrap_lua_State* L);
 extern int _simGetShapeViz(luaWrap_lua_State* L);
 extern int _simExecuteScriptString(luaWrap_lua_State* L);
 extern int _simGetApiFunc(luaWrap_lua_State* L);
@@ -474,6 +482,8 @@ extern int _simSetShapeInertia(luaWrap_lua_State* L);
 extern int _simIsDynamicallyEnabled(luaWrap_lua_State* L);
 extern int _simGenerateShapeFromPath(luaWrap_lua_State* L);
 extern int _simInitScript(luaWrap_lua_State* L);
+extern int _simSetSignals(luaWrap_lua_State* L);
+extern int _simGetSignals(luaWrap_lua_State* L);
 
 // DEPRECATED
 int _genericFunctionHandler_old(luaWrap_lua_State* L,CLuaCustomFunction* func);
@@ -556,6 +566,7 @@ extern int _simHandleIkGroup(luaWrap_lua_State* L);
 extern int _simSetIkGroupProperties(luaWrap_lua_State* L);
 extern int _simSetIkElementProperties(luaWrap_lua_State* L);
 extern int _simSetThreadIsFree(luaWrap_lua_State* L);
+extern int _simTubeReadAll(luaWrap_lua_State* L);
 extern int _simTubeOpen(luaWrap_lua_State* L);
 extern int _simTubeClose(luaWrap_lua_State* L);
 extern int _simTubeWrite(luaWrap_lua_State* L);
@@ -233,6 +233,14 @@ SIM_DLLEXPORT simFloat simGetSimulationTime()
 {
     return(simGetSimulationTime_internal());
 }
+SIM_DLLEXPORT simInt simSetStepProfilerEnabled(simBool enabled)
+{
+    return(simSetStepProfilerEnabled_internal(enabled));
+}
+SIM_DLLEXPORT simInt simSaveStepProfilerTrace(const simChar* filename,simBool clearEvents)
+{
+    return(simSaveStepProfilerTrace_internal(filename,clearEvents));
+}
 SIM_DLLEXPORT simInt simGetSimulationState()
 {
     return(simGetSimulationState_internal());
@@ -585,6 +593,10 @@ SIM_DLLEXPORT simInt simSetJointTargetVelocity(simInt objectHandle,simFloat targ
 {
     return(simSetJointTargetVelocity_internal(objectHandle,targetVelocity));
 }
+SIM_DLLEXPORT simInt simSetJointBatchControl(simInt objectHandle,simInt scriptHandle)
+{
+    return(simSetJointBatchControl_internal(objectHandle,scriptHandle));
+}
 SIM_DLLEXPORT simInt simGetJointTargetVelocity(simInt objectHandle,simFloat* targetVelocity)
 {
     return(simGetJointTargetVelocity_internal(objectHandle,targetVelocity));
@@ -625,6 +637,10 @@ SIM_DLLEXPORT simInt simAddDrawingObjectItem(simInt objectHandle,const simFloat*
 {
     return(simAddDrawingObjectItem_internal(objectHandle,itemData));
 }
+SIM_DLLEXPORT simInt simAddDrawingObjectItems(simInt objectHandle,const simFloat* itemData,simInt itemCount)
+{
+    return(simAddDrawingObjectItems_internal(objectHandle,itemData,itemCount));
+}
 SIM_DLLEXPORT simInt simAddParticleObject(simInt objectType,simFloat size,simFloat density,const simVoid* params,simFloat lifeTime,simInt maxItemCount,const simFloat* ambient_diffuse,const simFloat* setToNULL,const simFloat* specular,const simFloat* emission)
 {
     return(simAddParticleObject_internal(objectType,size,density,params,lifeTime,maxItemCount,ambient_diffuse,setToNULL,specular,emission));
@@ -1179,6 +1195,14 @@ SIM_DLLEXPORT simInt simCallScriptFunctionEx(simInt scriptHandleOrType,const sim
 {
     return(simCallScriptFunctionEx_internal(scriptHandleOrType,functionNameAtScriptName,stackId));
 }
+SIM_DLLEXPORT simInt simGetScriptFunctionHandle(simInt scriptHandle,const simChar* functionName)
+{
+    return(simGetScriptFunctionHandle_internal(scriptHandle,functionName));
+}
+SIM_DLLEXPORT simInt simCallScriptFunctionFromHandle(simInt scriptHandle,simInt functionHandle,simInt stackId)
+{
+    return(simCallScriptFunctionFromHandle_internal(scriptHandle,functionHandle,stackId));
+}
 SIM_DLLEXPORT simChar* simGetExtensionString(simInt objectHandle,simInt index,const char* key)
 {
     return(simGetExtensionString_internal(objectHandle,index,key));
@@ -1319,6 +1343,10 @@ SIM_DLLEXPORT simInt simGetStackDoubleTable(simInt stackHandle,simDouble* array,
 {
     return(simGetStackDoubleTable_internal(stackHandle,array,count));
 }
+SIM_DLLEXPORT const simVoid* simGetStackPackedTable(simInt stackHandle,simInt* arrayType,simInt* count)
+{
+    return(simGetStackPackedTable_internal(stackHandle,arrayType,count));
+}
 SIM_DLLEXPORT simInt simUnfoldStackTable(simInt stackHandle)
 {
     return(simUnfoldStackTable_internal(stackHandle));
@@ -1528,6 +1556,14 @@ SIM_DLLEXPORT simInt simInitScript(simInt scriptHandle)
 {
     return(simInitScript_internal(scriptHandle));
 }
+SIM_DLLEXPORT simInt simSetSignals(simInt signalType,simInt signalCount,const simChar* const* signalNames,const simVoid* signalValues,const simInt* stringLengths)
+{
+    return(simSetSignals_internal(signalType,signalCount,signalNames,signalValues,stringLengths));
+}
+SIM_DLLEXPORT simInt simGetSignals(simInt signalType,simInt signalCount,const simChar* const* signalNames,simVoid* signalValues,simInt* stringLengths,simChar* present)
+{
+    return(simGetSignals_internal(signalType,signalCount,signalNames,signalValues,stringLengths,present));
+}
 SIM_DLLEXPORT simInt _simGetContactCallbackCount()
 {
     return(_simGetContactCallbackCount_internal());
@@ -1856,6 +1892,10 @@ SIM_DLLEXPORT simInt _simHandleJointControl(const simVoid* joint,simInt auxV,con
 {
     return(_simHandleJointControl_internal(joint,auxV,inputValuesInt,inputValuesFloat,outputValues));
 }
+SIM_DLLEXPORT simInt _simHandleJointControls(const simVoid** joints,simInt jointCount,simInt auxV,const simInt* inputValuesInt,const simFloat* inputValuesFloat,simFloat* outputValues)
+{
+    return(_simHandleJointControls_internal(joints,jointCount,auxV,inputValuesInt,inputValuesFloat,outputValues));
+}
 SIM_DLLEXPORT simInt _simHandleCustomContact(simInt objHandle1,simInt objHandle2,simInt engine,simInt* dataInt,simFloat* dataFloat)
 {
     return(_simHandleCustomContact_internal(objHandle1,objHandle2,engine,dataInt,dataFloat));
@@ -2214,6 +2254,10 @@ SIM_DLLEXPORT simInt simRegisterJointCtrlCallback(simInt(*callBack)(simInt,simIn
 {
     return(simRegisterJointCtrlCallback_internal(callBack));
 }
+SIM_DLLEXPORT simInt simRegisterJointCtrlBatchCallback(simInt(*callBack)(simInt,simInt,const simInt*,const simFloat*,simFloat*,simInt*))
+{
+    return(simRegisterJointCtrlBatchCallback_internal(callBack));
+}
 SIM_DLLEXPORT simInt simGetMechanismHandle(const simChar* mechanismName)
 {
     return(simGetMechanismHandle_internal(mechanismName));
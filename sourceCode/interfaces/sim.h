@@ -74,6 +74,8 @@ SIM_DLLEXPORT simInt simInterpolateMatrices(const simFloat* matrixIn1,const simF
 SIM_DLLEXPORT simInt simTransformVector(const simFloat* matrix,simFloat* vect);
 SIM_DLLEXPORT simInt simReservedCommand(simInt v,simInt w);
 SIM_DLLEXPORT simFloat simGetSimulationTime();
+SIM_DLLEXPORT simInt simSetStepProfilerEnabled(simBool enabled);
+SIM_DLLEXPORT simInt simSaveStepProfilerTrace(const simChar* filename,simBool clearEvents);
 SIM_DLLEXPORT simInt simGetSimulationState();
 SIM_DLLEXPORT simFloat simGetSystemTime();
 SIM_DLLEXPORT simInt simGetSystemTimeInMilliseconds(); // deprecated
@@ -162,6 +164,7 @@ SIM_DLLEXPORT simInt simEndDialog(simInt genericDialogHandle);
 SIM_DLLEXPORT simInt simRegisterScriptCallbackFunction(const simChar* funcNameAtPluginName,const simChar* callTips,simVoid(*callBack)(struct SScriptCallBack* cb));
 SIM_DLLEXPORT simInt simRegisterScriptVariable(const simChar* varNameAtPluginName,const simChar* varValue,simInt stackHandle);
 SIM_DLLEXPORT simInt simSetJointTargetVelocity(simInt objectHandle,simFloat targetVelocity);
+SIM_DLLEXPORT simInt simSetJointBatchControl(simInt objectHandle,simInt scriptHandle);
 SIM_DLLEXPORT simInt simGetJointTargetVelocity(simInt objectHandle,simFloat* targetVelocity);
 SIM_DLLEXPORT simInt simCopyPasteObjects(simInt* objectHandles,simInt objectCount,simInt options);
 SIM_DLLEXPORT simInt simScaleSelectedObjects(simFloat scalingFactor,simBool scalePositionsToo);
@@ -171,6 +174,7 @@ SIM_DLLEXPORT simInt simGetObjectUniqueIdentifier(simInt objectHandle,simInt* un
 SIM_DLLEXPORT simInt simAddDrawingObject(simInt objectType,simFloat size,simFloat duplicateTolerance,simInt parentObjectHandle,simInt maxItemCount,const simFloat* ambient_diffuse,const simFloat* setToNULL,const simFloat* specular,const simFloat* emission);
 SIM_DLLEXPORT simInt simRemoveDrawingObject(simInt objectHandle);
 SIM_DLLEXPORT simInt simAddDrawingObjectItem(simInt objectHandle,const simFloat* itemData);
+SIM_DLLEXPORT simInt simAddDrawingObjectItems(simInt objectHandle,const simFloat* itemData,simInt itemCount);
 SIM_DLLEXPORT simInt simAddParticleObject(simInt objectType,simFloat size,simFloat density,const simVoid* params,simFloat lifeTime,simInt maxItemCount,const simFloat* ambient_diffuse,const simFloat* setToNULL,const simFloat* specular,const simFloat* emission);
 SIM_DLLEXPORT simInt simRemoveParticleObject(simInt objectHandle);
 SIM_DLLEXPORT simInt simAddParticleObjectItem(simInt objectHandle,const simFloat* itemData);
@@ -309,6 +313,8 @@ SIM_DLLEXPORT simInt simTransformImage(simUChar* image,const simInt* resolution,
 SIM_DLLEXPORT simInt simGetQHull(const simFloat* inVertices,simInt inVerticesL,simFloat** verticesOut,simInt* verticesOutL,simInt** indicesOut,simInt* indicesOutL,simInt reserved1,const simFloat* reserved2);
 SIM_DLLEXPORT simInt simGetDecimatedMesh(const simFloat* inVertices,simInt inVerticesL,const simInt* inIndices,simInt inIndicesL,simFloat** verticesOut,simInt* verticesOutL,simInt** indicesOut,simInt* indicesOutL,simFloat decimationPercent,simInt reserved1,const simFloat* reserved2);
 SIM_DLLEXPORT simInt simCallScriptFunctionEx(simInt scriptHandleOrType,const simChar* functionNameAtScriptName,simInt stackId);
+SIM_DLLEXPORT simInt simGetScriptFunctionHandle(simInt scriptHandle,const simChar* functionName);
+SIM_DLLEXPORT simInt simCallScriptFunctionFromHandle(simInt scriptHandle,simInt functionHandle,simInt stackId);
 SIM_DLLEXPORT simChar* simGetExtensionString(simInt objectHandle,simInt index,const char* key);
 SIM_DLLEXPORT simInt simComputeMassAndInertia(simInt shapeHandle,simFloat density);
 SIM_DLLEXPORT simInt simCreateStack();
@@ -344,6 +350,7 @@ SIM_DLLEXPORT simInt simGetStackInt32Table(simInt stackHandle,simInt* array,simI
 SIM_DLLEXPORT simInt simGetStackInt64Table(simInt stackHandle,simInt64* array,simInt count);
 SIM_DLLEXPORT simInt simGetStackFloatTable(simInt stackHandle,simFloat* array,simInt count);
 SIM_DLLEXPORT simInt simGetStackDoubleTable(simInt stackHandle,simDouble* array,simInt count);
+SIM_DLLEXPORT const simVoid* simGetStackPackedTable(simInt stackHandle,simInt* arrayType,simInt* count);
 SIM_DLLEXPORT simInt simUnfoldStackTable(simInt stackHandle);
 SIM_DLLEXPORT simInt simDebugStack(simInt stackHandle,simInt cIndex);
 SIM_DLLEXPORT simInt simSetScriptVariable(simInt scriptHandleOrType,const simChar* variableNameAtScriptName,simInt stackHandle);
@@ -396,6 +403,8 @@ SIM_DLLEXPORT simInt simSetShapeInertia(simInt shapeHandle,const simFloat* inert
 SIM_DLLEXPORT simInt simIsDynamicallyEnabled(simInt objectHandle);
 SIM_DLLEXPORT simInt simGenerateShapeFromPath(const simFloat* path,simInt pathSize,const simFloat* section,simInt sectionSize,simInt options,const simFloat* upVector,simFloat reserved);
 SIM_DLLEXPORT simInt simInitScript(simInt scriptHandle);
+SIM_DLLEXPORT simInt simSetSignals(simInt signalType,simInt signalCount,const simChar* const* signalNames,const simVoid* signalValues,const simInt* stringLengths);
+SIM_DLLEXPORT simInt simGetSignals(simInt signalType,simInt signalCount,const simChar* const* signalNames,simVoid* signalValues,simInt* stringLengths,simChar* present);
 
 
 SIM_DLLEXPORT simInt _simGetContactCallbackCount();
@@ -480,6 +489,7 @@ SIM_DLLEXPORT simInt _simGetTimeDiffInMs(simInt previousTime);
 SIM_DLLEXPORT simBool _simDoEntitiesCollide(simInt entity1ID,simInt entity2ID,simInt* cacheBuffer,simBool overrideCollidableFlagIfShape1,simBool overrideCollidableFlagIfShape2,simBool pathOrMotionPlanningRoutineCalling);
 SIM_DLLEXPORT simBool _simGetDistanceBetweenEntitiesIfSmaller(simInt entity1ID,simInt entity2ID,simFloat* distance,simFloat* ray,simInt* cacheBuffer,simBool overrideMeasurableFlagIfNonCollection1,simBool overrideMeasurableFlagIfNonCollection2,simBool pathPlanningRoutineCalling);
 SIM_DLLEXPORT simInt _simHandleJointControl(const simVoid* joint,simInt auxV,const simInt* inputValuesInt,const simFloat* inputValuesFloat,simFloat* outputValues);
+SIM_DLLEXPORT simInt _simHandleJointControls(const simVoid** joints,simInt jointCount,simInt auxV,const simInt* inputValuesInt,const simFloat* inputValuesFloat,simFloat* outputValues);
 SIM_DLLEXPORT simInt _simHandleCustomContact(simInt objHandle1,simInt objHandle2,simInt engine,simInt* dataInt,simFloat* dataFloat);
 SIM_DLLEXPORT const simVoid* _simGetIkGroupObject(int ikGroupID);
 SIM_DLLEXPORT simInt _simMpHandleIkGroupObject(const simVoid* ikGroup);
@@ -580,6 +590,7 @@ SIM_DLLEXPORT simInt simRegisterCustomLuaFunction(const simChar* funcName,const
 SIM_DLLEXPORT simInt simRegisterCustomLuaVariable(const simChar* varName,const simChar* varValue);
 SIM_DLLEXPORT simInt simRegisterContactCallback(simInt(*callBack)(simInt,simInt,simInt,simInt*,simFloat*));
 SIM_DLLEXPORT simInt simRegisterJointCtrlCallback(simInt(*callBack)(simInt,simInt,simInt,const simInt*,const simFloat*,simFloat*));
+SIM_DLLEXPORT simInt simRegisterJointCtrlBatchCallback(simInt(*callBack)(simInt,simInt,const simInt*,const simFloat*,simFloat*,simInt*));
 SIM_DLLEXPORT simInt simGetMechanismHandle(const simChar* mechanismName);
 SIM_DLLEXPORT simInt simHandleMechanism(simInt mechanismHandle);
 SIM_DLLEXPORT simInt simHandleCustomizationScripts(simInt callType);
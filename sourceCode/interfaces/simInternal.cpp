@@ -16,6 +16,7 @@
 #include "pluginContainer.h"
 #include "mesh.h"
 #include "vDateTime.h"
+#include "stepProfiler.h"
 #include "ttUtil.h"
 #include "vVarious.h"
 #include "volInt.h"
@@ -62,6 +63,7 @@ bool doNotRunMainScriptFromRosInterface=false;
 
 std::vector<contactCallback> allContactCallbacks;
 std::vector<jointCtrlCallback> allJointCtrlCallbacks;
+std::vector<jointCtrlBatchCallback> allJointCtrlBatchCallbacks;
 
 
 std::vector<int> pluginHandles;
@@ -496,6 +498,11 @@ std::vector<jointCtrlCallback>& getAllJointCtrlCallbacks()
     return(allJointCtrlCallbacks);
 }
 
+std::vector<jointCtrlBatchCallback>& getAllJointCtrlBatchCallbacks()
+{
+    return(allJointCtrlBatchCallbacks);
+}
+
 std::string getIndexAdjustedObjectName(const char* nm)
 {
     std::string retVal;
@@ -1951,6 +1958,41 @@ simInt simSetJointTargetVelocity_internal(simInt objectHandle,simFloat targetVel
     return(-1);
 }
 
+simInt simSetJointBatchControl_internal(simInt objectHandle,simInt scriptHandle)
+{ // scriptHandle: the script whose JOINT_BATCH_CALLBACK_FUNCTION will control the joint, or -1 to disable
+    TRACE_C_API;
+
+    if (!isSimulatorInitialized(__func__))
+        return(-1);
+
+    IF_C_API_SIM_OR_UI_THREAD_CAN_WRITE_DATA
+    {
+        if (!doesObjectExist(__func__,objectHandle))
+            return(-1);
+        if (!isJoint(__func__,objectHandle))
+            return(-1);
+        CJoint* it=App::currentWorld->sceneObjects->getJointFromHandle(objectHandle);
+        if (scriptHandle!=-1)
+        {
+            CLuaScriptObject* script=App::worldContainer->getScriptFromHandle(scriptHandle);
+            if (script==nullptr)
+            {
+                CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_SCRIPT_INEXISTANT);
+                return(-1);
+            }
+            if (script->getThreadedExecution_oldThreads())
+            { // old threads run outside of the dyn. substeps
+                CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_CB_NOT_APPLICABLE_WITH_CURRENT_SCRIPT);
+                return(-1);
+            }
+        }
+        it->setBatchControlScriptHandle(scriptHandle);
+        return(1);
+    }
+    CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_COULD_NOT_LOCK_RESOURCES_FOR_WRITE);
+    return(-1);
+}
+
 simInt simGetJointTargetVelocity_internal(simInt objectHandle,simFloat* targetVelocity)
 {
     TRACE_C_API;
@@ -4403,6 +4445,35 @@ simFloat simGetSimulationTime_internal()
     return(-1.0f);
 }
 
+simInt simSetStepProfilerEnabled_internal(simBool enabled)
+{ // the profiler has its own synchronization
+    TRACE_C_API;
+
+    if (!isSimulatorInitialized(__func__))
+        return(-1);
+
+    CStepProfiler::setEnabled(enabled!=0);
+    return(1);
+}
+
+simInt simSaveStepProfilerTrace_internal(const simChar* filename,simBool clearEvents)
+{ // the profiler has its own synchronization. Returns the number of saved events
+    TRACE_C_API;
+
+    if (!isSimulatorInitialized(__func__))
+        return(-1);
+
+    int retVal=CStepProfiler::saveChromeTrace(filename);
+    if (retVal<0)
+    {
+        CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_TRACE_COULD_NOT_BE_SAVED);
+        return(-1);
+    }
+    if (clearEvents)
+        CStepProfiler::clearEvents();
+    return(retVal);
+}
+
 simInt simGetSimulationState_internal()
 {
     TRACE_C_API;
@@ -7057,6 +7128,29 @@ simInt simAddDrawingObjectItem_internal(simInt objectHandle,const simFloat* item
     CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_COULD_NOT_LOCK_RESOURCES_FOR_READ);
     return(-1);
 }
+
+simInt simAddDrawingObjectItems_internal(simInt objectHandle,const simFloat* itemData,simInt itemCount)
+{
+    TRACE_C_API;
+
+    if (!isSimulatorInitialized(__func__))
+       return(-1);
+
+    IF_C_API_SIM_OR_UI_THREAD_CAN_READ_DATA
+    { // protected with an additional mutex in CDrawingObject
+        CDrawingObject* it=App::currentWorld->drawingCont->getObject(objectHandle);
+        if (it==nullptr)
+        {
+            CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_OBJECT_INEXISTANT);
+            return(-1);
+        }
+        if ( (itemData==nullptr)||(itemCount<=0) )
+            return(0);
+        return(it->addItems(itemData,size_t(itemCount)));
+    }
+    CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_COULD_NOT_LOCK_RESOURCES_FOR_READ);
+    return(-1);
+}
 simInt simAddParticleObject_internal(simInt objectType,simFloat size,simFloat massOverVolume,const simVoid* params,simFloat lifeTime,simInt maxItemCount,const simFloat* ambient_diffuse,const simFloat* setToNULL,const simFloat* specular,const simFloat* emission)
 {
     TRACE_C_API;
@@ -7445,6 +7539,91 @@ simChar* simGetSignalName_internal(simInt signalIndex,simInt signalType)
     return(nullptr);
 }
 
+simInt simSetSignals_internal(simInt signalType,simInt signalCount,const simChar* const* signalNames,const simVoid* signalValues,const simInt* stringLengths)
+{
+    TRACE_C_API;
+
+    if (!isSimulatorInitialized(__func__))
+        return(-1);
+
+    IF_C_API_SIM_OR_UI_THREAD_CAN_READ_DATA
+    {
+        if ( ((signalType!=0)&&(signalType!=1)&&(signalType!=2)&&(signalType!=3))||(signalCount<0)||((signalCount>0)&&(signalNames==nullptr)) )
+        {
+            CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_INVALID_ARGUMENT);
+            return(-1);
+        }
+        for (int i=0;i<signalCount;i++)
+        {
+            if (signalNames[i]==nullptr)
+            {
+                CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_INVALID_ARGUMENT);
+                return(-1);
+            }
+        }
+        return(App::currentWorld->signalContainer->setSignals(signalType,signalCount,signalNames,signalValues,stringLengths,_currentScriptHandle));
+    }
+    CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_COULD_NOT_LOCK_RESOURCES_FOR_READ);
+    return(-1);
+}
+
+simInt simGetSignals_internal(simInt signalType,simInt signalCount,const simChar* const* signalNames,simVoid* signalValues,simInt* stringLengths,simChar* present)
+{ // for string signals, signalValues is a simChar** that receives buffers to be released with simReleaseBuffer (or nullptr if not present)
+    TRACE_C_API;
+
+    if (!isSimulatorInitialized(__func__))
+        return(-1);
+
+    IF_C_API_SIM_OR_UI_THREAD_CAN_READ_DATA
+    {
+        if ( ((signalType!=0)&&(signalType!=1)&&(signalType!=2)&&(signalType!=3))||(signalCount<0)||((signalType==2)&&(stringLengths==nullptr)) )
+        {
+            CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_INVALID_ARGUMENT);
+            return(-1);
+        }
+        if (signalCount==0)
+            return(0);
+        if (signalNames==nullptr)
+        {
+            CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_INVALID_ARGUMENT);
+            return(-1);
+        }
+        for (int i=0;i<signalCount;i++)
+        {
+            if (signalNames[i]==nullptr)
+            {
+                CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_INVALID_ARGUMENT);
+                return(-1);
+            }
+        }
+        if (signalType!=2)
+            return(App::currentWorld->signalContainer->getSignals(signalType,signalCount,signalNames,signalValues,present));
+
+        std::vector<std::string> vals(signalCount);
+        std::vector<char> found(signalCount);
+        int retVal=App::currentWorld->signalContainer->getSignals(signalType,signalCount,signalNames,&vals[0],&found[0]);
+        for (int i=0;i<signalCount;i++)
+        {
+            char* buff=nullptr;
+            stringLengths[i]=0;
+            if (found[i]!=0)
+            {
+                buff=new char[vals[i].length()+1];
+                for (size_t j=0;j<vals[i].length();j++)
+                    buff[j]=vals[i][j];
+                buff[vals[i].length()]=0;
+                stringLengths[i]=int(vals[i].length());
+            }
+            ((simChar**)signalValues)[i]=buff;
+            if (present!=nullptr)
+                present[i]=found[i];
+        }
+        return(retVal);
+    }
+    CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_COULD_NOT_LOCK_RESOURCES_FOR_READ);
+    return(-1);
+}
+
 simInt simSetObjectProperty_internal(simInt objectHandle,simInt prop)
 {
     TRACE_C_API;
@@ -9599,6 +9778,13 @@ simInt simGetObjectInt32Parameter_internal(simInt objectHandle,simInt parameterI
                     parameter[0]=1;
                 retVal=1;
             }
+            if (parameterID==sim_visionintparam_pipelined_readback)
+            {
+                parameter[0]=0;
+                if (rendSens->getPipelinedReadback())
+                    parameter[0]=1;
+                retVal=1;
+            }
         }
         if (proximitySensor!=nullptr)
         {
@@ -9706,6 +9892,11 @@ simInt simGetObjectInt32Parameter_internal(simInt objectHandle,simInt parameterI
                 parameter[0]=graph->getNeedsRefresh();
                 retVal=1;
             }
+            if (parameterID==sim_graphintparam_recording)
+            {
+                parameter[0]=graph->getRecordToDisk();
+                retVal=1;
+            }
         }
         if (joint!=nullptr)
         {
@@ -9844,6 +10035,7 @@ simInt simSetObjectInt32Parameter_internal(simInt objectHandle,simInt parameterI
         CCamera* camera=App::currentWorld->sceneObjects->getCameraFromHandle(objectHandle);
         CLight* light=App::currentWorld->sceneObjects->getLightFromHandle(objectHandle);
         CProxSensor* proximitySensor=App::currentWorld->sceneObjects->getProximitySensorFromHandle(objectHandle);
+        CGraph* graph=App::currentWorld->sceneObjects->getGraphFromHandle(objectHandle);
         if (parameterID<sim_objparam_end)
         { // for all scene objects
             CSceneObject* it=App::currentWorld->sceneObjects->getObjectFromHandle(objectHandle);
@@ -9958,6 +10150,11 @@ simInt simSetObjectInt32Parameter_internal(simInt objectHandle,simInt parameterI
                 rendSens->setPerspectiveOperation(parameter!=0);
                 retVal=1;
             }
+            if (parameterID==sim_visionintparam_pipelined_readback)
+            {
+                rendSens->setPipelinedReadback(parameter!=0);
+                retVal=1;
+            }
         }
         if (proximitySensor!=nullptr)
         {
@@ -10030,6 +10227,14 @@ simInt simSetObjectInt32Parameter_internal(simInt objectHandle,simInt parameterI
                 retVal=1;
             }
         }
+        if (graph!=nullptr)
+        {
+            if (parameterID==sim_graphintparam_recording)
+            {
+                graph->setRecordToDisk(parameter!=0);
+                retVal=1;
+            }
+        }
         if (joint!=nullptr)
         {
             if (parameterID==sim_jointintparam_motor_enabled)
@@ -14506,6 +14711,76 @@ simInt simCallScriptFunctionEx_internal(simInt scriptHandleOrType,const simChar*
     return(-1);
 }
 
+simInt simGetScriptFunctionHandle_internal(simInt scriptHandle,const simChar* functionName)
+{ // the handle is valid until the script is reset. Same thread restrictions as for simCallScriptFunctionEx
+    TRACE_C_API;
+
+    if (!isSimulatorInitialized(__func__))
+        return(-1);
+
+    CLuaScriptObject* script=App::worldContainer->getScriptFromHandle(scriptHandle);
+    if (script==nullptr)
+    {
+        CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_SCRIPT_INEXISTANT);
+        return(-1);
+    }
+    bool canCall;
+    if (script->getThreadedExecutionIsUnderWay_oldThreads())
+        canCall=VThread::areThreadIDsSame(script->getThreadedScriptThreadId(),VThread::getCurrentThreadId());
+    else
+        canCall=VThread::isCurrentThreadTheMainSimulationThread();
+    if (!canCall)
+    {
+        CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_FAILED_CALLING_SCRIPT_FUNCTION);
+        return(-1);
+    }
+    int retVal=script->getScriptFunctionHandle(functionName);
+    if (retVal==-1)
+        CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_SCRIPT_FUNCTION_INEXISTANT);
+    return(retVal);
+}
+
+simInt simCallScriptFunctionFromHandle_internal(simInt scriptHandle,simInt functionHandle,simInt stackId)
+{ // same as simCallScriptFunctionEx, but the function was resolved with simGetScriptFunctionHandle
+    TRACE_C_API;
+
+    if (!isSimulatorInitialized(__func__))
+        return(-1);
+
+    CLuaScriptObject* script=App::worldContainer->getScriptFromHandle(scriptHandle);
+    if (script==nullptr)
+    {
+        CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_SCRIPT_INEXISTANT);
+        return(-1);
+    }
+    CInterfaceStack* stack=App::worldContainer->interfaceStackContainer->getStack(stackId);
+    if (stack==nullptr)
+    {
+        CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_INVALID_HANDLE);
+        return(-1);
+    }
+    int retVal=-3;
+    if (script->getThreadedExecutionIsUnderWay_oldThreads())
+    { // calls from other threads are not supported here (use simCallScriptFunctionEx instead)
+        if (VThread::areThreadIDsSame(script->getThreadedScriptThreadId(),VThread::getCurrentThreadId()))
+            retVal=script->callScriptFunctionFromHandle(functionHandle,stack);
+    }
+    else
+    {
+        if (VThread::isCurrentThreadTheMainSimulationThread())
+            retVal=script->callScriptFunctionFromHandle(functionHandle,stack);
+    }
+    if (retVal==-3)
+        CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_FAILED_CALLING_SCRIPT_FUNCTION);
+    if (retVal==-2)
+        CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_SCRIPT_FUNCTION_INEXISTANT);
+    if (retVal==-1)
+        CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_ERROR_IN_SCRIPT_FUNCTION);
+    if (retVal<-1)
+        retVal=-1;
+    return(retVal);
+}
+
 simChar* simGetExtensionString_internal(simInt objectHandle,simInt index,const char* key)
 {
     TRACE_C_API;
@@ -15464,6 +15739,41 @@ simInt simGetStackDoubleTable_internal(simInt stackHandle,simDouble* array,simIn
     return(-1);
 }
 
+const simVoid* simGetStackPackedTable_internal(simInt stackHandle,simInt* arrayType,simInt* count)
+{ // returns a pointer to the items of the packed table on top of the stack (no copy), or nullptr if the table is not packed.
+  // arrayType: 1=uchar, 2=int32, 3=int64, 4=float, 5=double. The pointer is valid until the stack is modified
+    TRACE_C_API;
+
+    if (!isSimulatorInitialized(__func__))
+        return(nullptr);
+
+    IF_C_API_SIM_OR_UI_THREAD_CAN_WRITE_DATA
+    {
+        CInterfaceStack* stack=App::worldContainer->interfaceStackContainer->getStack(stackHandle);
+        if (stack!=nullptr)
+        {
+            if (stack->getStackSize()>0)
+            {
+                int t=STACK_TABLE_PACKED_NONE;
+                int c=0;
+                const void* retVal=stack->getStackPackedArray(t,c);
+                if (arrayType!=nullptr)
+                    arrayType[0]=t;
+                if (count!=nullptr)
+                    count[0]=c;
+                return(retVal);
+            }
+            CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_INVALID_STACK_CONTENT);
+            return(nullptr);
+        }
+        CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_INVALID_HANDLE);
+        return(nullptr);
+    }
+
+    CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_COULD_NOT_LOCK_RESOURCES_FOR_READ);
+    return(nullptr);
+}
+
 simInt simUnfoldStackTable_internal(simInt stackHandle)
 {
     TRACE_C_API;
@@ -15978,6 +16288,7 @@ simInt simCreatePointCloud_internal(simFloat maxVoxelSize,simInt maxPtCntPerVoxe
         it->setShowOctree(options&2);
         it->setDoNotUseCalculationStructure(options&8);
         it->setColorIsEmissive(options&16);
+        it->setQuantizePositions(options&32);
         App::currentWorld->sceneObjects->addObjectToScene(it,false,true);
         int retVal=it->getObjectHandle();
         return(retVal);
@@ -16009,6 +16320,7 @@ simInt simSetPointCloudOptions_internal(simInt pointCloudHandle,simFloat maxVoxe
         it->setShowOctree(options&2);
         it->setDoNotUseCalculationStructure(options&8);
         it->setColorIsEmissive(options&16);
+        it->setQuantizePositions(options&32);
         return(1);
     }
     CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_COULD_NOT_LOCK_RESOURCES_FOR_WRITE);
@@ -16043,6 +16355,8 @@ simInt simGetPointCloudOptions_internal(simInt pointCloudHandle,simFloat* maxVox
             options[0]|=8;
         if (it->getColorIsEmissive())
             options[0]|=16;
+        if (it->getQuantizePositions())
+            options[0]|=32;
         return(1);
     }
     CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_COULD_NOT_LOCK_RESOURCES_FOR_READ);
@@ -16131,7 +16445,7 @@ simInt simInsertPointsIntoPointCloud_internal(simInt pointCloudHandle,simInt opt
             it->setInsertionDistanceTolerance(((float*)optionalValues)[1]);
         it->insertPoints(pts,ptCnt,options&1,color,options&2);
         it->setInsertionDistanceTolerance(insertionToleranceSaved);
-        int retVal=int(it->getPoints()->size())/3;
+        int retVal=it->getPointCount();
         return(retVal);
     }
     CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_COULD_NOT_LOCK_RESOURCES_FOR_WRITE);
@@ -16158,7 +16472,7 @@ simInt simRemovePointsFromPointCloud_internal(simInt pointCloudHandle,simInt opt
             it->clear();
         else
             it->removePoints(pts,ptCnt,options&1,tolerance);
-        int retVal=int(it->getPoints()->size())/3;
+        int retVal=it->getPointCount();
         return(retVal);
     }
     CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_COULD_NOT_LOCK_RESOURCES_FOR_WRITE);
@@ -16181,7 +16495,7 @@ simInt simIntersectPointsWithPointCloud_internal(simInt pointCloudHandle,simInt
             it->clear();
         else
             it->intersectPoints(pts,ptCnt,options&1,tolerance);
-        int retVal=int(it->getPoints()->size())/3;
+        int retVal=it->getPointCount();
         return(retVal);
     }
     CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_COULD_NOT_LOCK_RESOURCES_FOR_WRITE);
@@ -16331,7 +16645,7 @@ simInt simInsertObjectIntoPointCloud_internal(simInt pointCloudHandle,simInt obj
         it->getColor()->getColorsPtr()[0]=savedCols[0];
         it->getColor()->getColorsPtr()[1]=savedCols[1];
         it->getColor()->getColorsPtr()[2]=savedCols[2];
-        int retVal=int(it->getPoints()->size())/3;
+        int retVal=it->getPointCount();
         return(retVal);
     }
     CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_COULD_NOT_LOCK_RESOURCES_FOR_WRITE);
@@ -16353,7 +16667,7 @@ simInt simSubtractObjectFromPointCloud_internal(simInt pointCloudHandle,simInt o
             return(-1);
         CPointCloud* it=App::currentWorld->sceneObjects->getPointCloudFromHandle(pointCloudHandle);
         it->subtractObject(App::currentWorld->sceneObjects->getObjectFromHandle(objectHandle),tolerance);
-        int retVal=int(it->getPoints()->size())/3;
+        int retVal=it->getPointCount();
         return(retVal);
     }
     CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_COULD_NOT_LOCK_RESOURCES_FOR_WRITE);
@@ -17886,6 +18200,16 @@ simInt _simHandleJointControl_internal(const simVoid* joint,simInt auxV,const si
     return(2);
 }
 
+simInt _simHandleJointControls_internal(const simVoid** joints,simInt jointCount,simInt auxV,const simInt* inputValuesInt,const simFloat* inputValuesFloat,simFloat* outputValues)
+{ // same as _simHandleJointControl, but for all joints of a dyn. substep at once. inputValuesFloat: currentPos,effort,dynStepSize,errorValue for each joint. outputValues: velocity,force for each joint
+    TRACE_C_API;
+    std::vector<CJoint*> allJoints;
+    for (int i=0;i<jointCount;i++)
+        allJoints.push_back((CJoint*)joints[i]);
+    CJoint::handleDynJointControls(allJoints,(auxV&1)!=0,inputValuesInt[0],inputValuesInt[1],inputValuesFloat,outputValues);
+    return(jointCount*2);
+}
+
 simInt _simHandleCustomContact_internal(simInt objHandle1,simInt objHandle2,simInt engine,simInt* dataInt,simFloat* dataFloat)
 { // Careful with this function: it can also be called from any other thread (e.g. generated by the physics engine)
     TRACE_C_API;
@@ -19732,6 +20056,28 @@ simInt simRegisterJointCtrlCallback_internal(simInt(*callBack)(simInt,simInt,sim
     return(-1);
 }
 
+simInt simRegisterJointCtrlBatchCallback_internal(simInt(*callBack)(simInt,simInt,const simInt*,const simFloat*,simFloat*,simInt*))
+{ // the callback sees all joints of a dyn. substep at once, see CJoint::handleDynJointControls
+    TRACE_C_API;
+
+    IF_C_API_SIM_OR_UI_THREAD_CAN_WRITE_DATA
+    {
+        for (int i=0;i<int(allJointCtrlBatchCallbacks.size());i++)
+        {
+            if (allJointCtrlBatchCallbacks[i]==callBack)
+            { // We unregister that callback
+                allJointCtrlBatchCallbacks.erase(allJointCtrlBatchCallbacks.begin()+i);
+                return(0);
+            }
+        }
+        // We register that callback:
+        allJointCtrlBatchCallbacks.push_back(callBack);
+        return(1);
+    }
+    CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_COULD_NOT_LOCK_RESOURCES_FOR_WRITE);
+    return(-1);
+}
+
 simInt simGetMechanismHandle_internal(const simChar* mechanismName)
 { // deprecated
     TRACE_C_API;
@@ -20746,7 +21092,7 @@ simChar* simTubeRead_internal(simInt tubeHandle,simInt* dataLength)
     IF_C_API_SIM_OR_UI_THREAD_CAN_READ_DATA
     {
         char* retVal;
-        retVal=App::currentWorld->commTubeContainer->readFromTube_bufferNotCopied(tubeHandle,dataLength[0]);
+        retVal=App::currentWorld->commTubeContainer->readFromTube_bufferCopied(tubeHandle,dataLength[0]);
         return(retVal);
     }
     CApiErrors::setCapiCallErrorMessage(__func__,SIM_ERROR_COULD_NOT_LOCK_RESOURCES_FOR_READ);
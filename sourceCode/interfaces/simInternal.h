@@ -8,6 +8,8 @@
 
 std::vector<contactCallback>& getAllContactCallbacks();
 std::vector<jointCtrlCallback>& getAllJointCtrlCallbacks();
+typedef simInt (*jointCtrlBatchCallback)(simInt,simInt,const simInt*,const simFloat*,simFloat*,simInt*);
+std::vector<jointCtrlBatchCallback>& getAllJointCtrlBatchCallbacks();
 
 void setCurrentScriptInfo_cSide(int scriptHandle,int scriptNameIndex);
 int getCurrentScriptNameIndex_cSide();
@@ -65,6 +67,8 @@ simInt simInterpolateMatrices_internal(const simFloat* matrixIn1,const simFloat*
 simInt simTransformVector_internal(const simFloat* matrix,simFloat* vect);
 simInt simReservedCommand_internal(simInt v,simInt w);
 simFloat simGetSimulationTime_internal();
+simInt simSetStepProfilerEnabled_internal(simBool enabled);
+simInt simSaveStepProfilerTrace_internal(const simChar* filename,simBool clearEvents);
 simInt simGetSimulationState_internal();
 simFloat simGetSystemTime_internal();
 simInt simGetSystemTimeInMilliseconds_internal();
@@ -153,6 +157,7 @@ simInt simEndDialog_internal(simInt genericDialogHandle);
 simInt simRegisterScriptCallbackFunction_internal(const simChar* funcNameAtPluginName,const simChar* callTips,simVoid(*callBack)(struct SScriptCallBack* cb));
 simInt simRegisterScriptVariable_internal(const simChar* varNameAtPluginName,const simChar* varValue,simInt stackHandle);
 simInt simSetJointTargetVelocity_internal(simInt objectHandle,simFloat targetVelocity);
+simInt simSetJointBatchControl_internal(simInt objectHandle,simInt scriptHandle);
 simInt simGetJointTargetVelocity_internal(simInt objectHandle,simFloat* targetVelocity);
 simInt simCopyPasteObjects_internal(simInt* objectHandles,simInt objectCount,simInt options);
 simInt simScaleSelectedObjects_internal(simFloat scalingFactor,simBool scalePositionsToo);
@@ -162,6 +167,7 @@ simInt simGetObjectUniqueIdentifier_internal(simInt objectHandle,simInt* uniqueI
 simInt simAddDrawingObject_internal(simInt objectType,simFloat size,simFloat duplicateTolerance,simInt parentObjectHandle,simInt maxItemCount,const simFloat* ambient_diffuse,const simFloat* setToNULL,const simFloat* specular,const simFloat* emission);
 simInt simRemoveDrawingObject_internal(simInt objectHandle);
 simInt simAddDrawingObjectItem_internal(simInt objectHandle,const simFloat* itemData);
+simInt simAddDrawingObjectItems_internal(simInt objectHandle,const simFloat* itemData,simInt itemCount);
 simInt simAddParticleObject_internal(simInt objectType,simFloat size,simFloat density,const simVoid* params,simFloat lifeTime,simInt maxItemCount,const simFloat* ambient_diffuse,const simFloat* setToNULL,const simFloat* specular,const simFloat* emission);
 simInt simRemoveParticleObject_internal(simInt objectHandle);
 simInt simAddParticleObjectItem_internal(simInt objectHandle,const simFloat* itemData);
@@ -298,6 +304,8 @@ simInt simTransformImage_internal(simUChar* image,const simInt* resolution,simIn
 simInt simGetQHull_internal(const simFloat* inVertices,simInt inVerticesL,simFloat** verticesOut,simInt* verticesOutL,simInt** indicesOut,simInt* indicesOutL,simInt reserved1,const simFloat* reserved2);
 simInt simGetDecimatedMesh_internal(const simFloat* inVertices,simInt inVerticesL,const simInt* inIndices,simInt inIndicesL,simFloat** verticesOut,simInt* verticesOutL,simInt** indicesOut,simInt* indicesOutL,simFloat decimationPercent,simInt reserved1,const simFloat* reserved2);
 simInt simCallScriptFunctionEx_internal(simInt scriptHandleOrType,const simChar* functionNameAtScriptName,simInt stackId);
+simInt simGetScriptFunctionHandle_internal(simInt scriptHandle,const simChar* functionName);
+simInt simCallScriptFunctionFromHandle_internal(simInt scriptHandle,simInt functionHandle,simInt stackId);
 simChar* simGetExtensionString_internal(simInt objectHandle,simInt index,const char* key);
 simInt simComputeMassAndInertia_internal(simInt shapeHandle,simFloat density);
 simInt simCreateStack_internal();
@@ -333,6 +341,7 @@ simInt simGetStackInt32Table_internal(simInt stackHandle,simInt* array,simInt co
 simInt simGetStackInt64Table_internal(simInt stackHandle,simInt64* array,simInt count);
 simInt simGetStackFloatTable_internal(simInt stackHandle,simFloat* array,simInt count);
 simInt simGetStackDoubleTable_internal(simInt stackHandle,simDouble* array,simInt count);
+const simVoid* simGetStackPackedTable_internal(simInt stackHandle,simInt* arrayType,simInt* count);
 simInt simUnfoldStackTable_internal(simInt stackHandle);
 simInt simDebugStack_internal(simInt stackHandle,simInt cIndex);
 simInt simSetScriptVariable_internal(simInt scriptHandleOrType,const simChar* variableNameAtScriptName,simInt stackHandle);
@@ -385,6 +394,8 @@ simInt simSetShapeInertia_internal(simInt shapeHandle,const simFloat* inertiaMat
 simInt simIsDynamicallyEnabled_internal(simInt objectHandle);
 simInt simGenerateShapeFromPath_internal(const simFloat* path,simInt pathSize,const simFloat* section,simInt sectionSize,simInt options,const simFloat* upVector,simFloat reserved);
 simInt simInitScript_internal(simInt scriptHandle);
+simInt simSetSignals_internal(simInt signalType,simInt signalCount,const simChar* const* signalNames,const simVoid* signalValues,const simInt* stringLengths);
+simInt simGetSignals_internal(simInt signalType,simInt signalCount,const simChar* const* signalNames,simVoid* signalValues,simInt* stringLengths,simChar* present);
 
 
 simInt _simGetContactCallbackCount_internal();
@@ -469,6 +480,7 @@ simInt _simGetTimeDiffInMs_internal(simInt previousTime);
 simBool _simDoEntitiesCollide_internal(simInt entity1ID,simInt entity2ID,simInt* cacheBuffer,simBool overrideCollidableFlagIfShape1,simBool overrideCollidableFlagIfShape2,simBool pathOrMotionPlanningRoutineCalling);
 simBool _simGetDistanceBetweenEntitiesIfSmaller_internal(simInt entity1ID,simInt entity2ID,simFloat* distance,simFloat* ray,simInt* cacheBuffer,simBool overrideMeasurableFlagIfNonCollection1,simBool overrideMeasurableFlagIfNonCollection2,simBool pathPlanningRoutineCalling);
 simInt _simHandleJointControl_internal(const simVoid* joint,simInt auxV,const simInt* inputValuesInt,const simFloat* inputValuesFloat,simFloat* outputValues);
+simInt _simHandleJointControls_internal(const simVoid** joints,simInt jointCount,simInt auxV,const simInt* inputValuesInt,const simFloat* inputValuesFloat,simFloat* outputValues);
 simInt _simHandleCustomContact_internal(simInt objHandle1,simInt objHandle2,simInt engine,simInt* dataInt,simFloat* dataFloat);
 const simVoid* _simGetIkGroupObject_internal(int ikGroupID);
 simInt _simMpHandleIkGroupObject_internal(const simVoid* ikGroup);
@@ -565,6 +577,7 @@ simInt simHandleGeneralCallbackScript_internal(simInt callbackId,simInt callback
 simInt simRegisterCustomLuaFunction_internal(const simChar* funcName,const simChar* callTips,const simInt* inputArgumentTypes,simVoid(*callBack)(struct SLuaCallBack* p));
 simInt simRegisterContactCallback_internal(simInt(*callBack)(simInt,simInt,simInt,simInt*,simFloat*));
 simInt simRegisterJointCtrlCallback_internal(simInt(*callBack)(simInt,simInt,simInt,const simInt*,const simFloat*,simFloat*));
+simInt simRegisterJointCtrlBatchCallback_internal(simInt(*callBack)(simInt,simInt,const simInt*,const simFloat*,simFloat*,simInt*));
 simInt simGetMechanismHandle_internal(const simChar* mechanismName);
 simInt simHandleMechanism_internal(simInt mechanismHandle);
 simInt simHandleCustomizationScripts_internal(simInt callType);
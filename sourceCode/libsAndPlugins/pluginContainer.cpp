@@ -7,6 +7,7 @@
 #include "ttUtil.h"
 #include "apiErrors.h"
 #include "collisionRoutines.h"
+#include "stepProfiler.h"
 #include <algorithm>
 
 CPlugin::CPlugin(const char* filename,const char* pluginName)
@@ -563,6 +564,9 @@ void* CPluginContainer::sendEventCallbackMessageToAllPlugins(int msg,int* auxVal
             retVals[2]=-1;
             retVals[3]=-1;
         }
+        CStepProfilerScope profilerScope("plugin");
+        if (profilerScope.isActive())
+            profilerScope.setName(_allPlugins[i]->getName().c_str());
         void* returnData=_allPlugins[i]->messageAddress(msg,auxVals,data,retVals);
         if ( (returnData!=nullptr)||((retVals!=nullptr)&&((retVals[0]!=-1)||(retVals[1]!=-1)||(retVals[2]!=-1)||(retVals[3]!=-1))) )
         {
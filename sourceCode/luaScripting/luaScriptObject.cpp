@@ -6,6 +6,7 @@
 #include "tt.h"
 #include <boost/lexical_cast.hpp>
 #include "vDateTime.h"
+#include "stepProfiler.h"
 #include "app.h"
 #include "apiErrors.h"
 #include "pluginContainer.h"
@@ -13,6 +14,7 @@
 #include "ttUtil.h"
 
 int CLuaScriptObject::_scriptUniqueCounter=-1;
+unsigned int CLuaScriptObject::_objectAttachments_generation=0;
 //bool CLuaScriptObject::emergencyStopButtonPressed=false;
 int CLuaScriptObject::_nextIdForExternalScriptEditor=-1;
 VMutex CLuaScriptObject::_globalMutex_oldThreads;
@@ -1958,6 +1960,7 @@ CLuaScriptObject::CLuaScriptObject(int scriptTypeOrMinusOneForSerialization)
     _outsideCommandQueue=new COutsideCommandQueueForScript();
 
     _scriptType=scriptTypeOrMinusOneForSerialization;
+    _scriptFunctionRefGeneration=0;
     _compatibilityModeOrFirstTimeCall_sysCallbacks=true;
     _containsJointCallbackFunction=false;
     _containsContactCallbackFunction=false;
@@ -2742,6 +2745,7 @@ bool CLuaScriptObject::getCustomizationScriptCleanupBeforeSave_DEPRECATED() cons
 void CLuaScriptObject::setExecutionPriority(int order)
 {
     _executionPriority=tt::getLimitedInt(sim_scriptexecorder_first,sim_scriptexecorder_last,order);
+    CEmbeddedScriptContainer::invalidateAllScriptExecutionOrders();
 }
 
 int CLuaScriptObject::getExecutionPriority() const
@@ -2762,6 +2766,7 @@ int CLuaScriptObject::getDebugLevel() const
 void CLuaScriptObject::setTreeTraversalDirection(int dir)
 {
     _treeTraversalDirection=tt::getLimitedInt(sim_scripttreetraversal_reverse,sim_scripttreetraversal_parent,dir);
+    CEmbeddedScriptContainer::invalidateAllScriptExecutionOrders();
 }
 
 int CLuaScriptObject::getTreeTraversalDirection() const
@@ -2989,6 +2994,7 @@ void CLuaScriptObject::setThreadedExecution_oldThreads(bool threadedExec)
     }
     else
         _threadedExecution_oldThreads=false;
+    CEmbeddedScriptContainer::invalidateAllScriptExecutionOrders();
 }
 
 bool CLuaScriptObject::getThreadedExecution_oldThreads() const
@@ -3004,7 +3010,10 @@ bool CLuaScriptObject::getThreadedExecutionIsUnderWay_oldThreads() const
 void CLuaScriptObject::performSceneObjectLoadingMapping(const std::vector<int>* map)
 {
     if (App::currentWorld->sceneObjects!=nullptr)
+    {
         _objectHandleAttachedTo=CWorld::getLoadingMapping(map,_objectHandleAttachedTo);
+        _objectAttachments_generation++;
+    }
 }
 
 bool CLuaScriptObject::announceSceneObjectWillBeErased(int objectHandle,bool copyBuffer)
@@ -3023,6 +3032,7 @@ bool CLuaScriptObject::announceSceneObjectWillBeErased(int objectHandle,bool cop
                 if (!App::currentWorld->simulation->isSimulationStopped()) // Removed the if(_threadedExecution()) thing on 2008/12/08
                 { // threaded scripts cannot be directly erased, since the Lua state needs to be cleared in the thread that created it
                     _objectHandleAttachedTo=-1; // This is for a potential threaded simulation running
+                    _objectAttachments_generation++;
                     _flaggedForDestruction=true;
                     retVal=!_inExecutionNow; // from false to !_inExecutionNow on 8/9/2016
                 }
@@ -3095,6 +3105,12 @@ void CLuaScriptObject::setObjectHandleThatScriptIsAttachedTo(int newObjectHandle
     }
     else
         _objectHandleAttachedTo=-1;
+    _objectAttachments_generation++;
+}
+
+unsigned int CLuaScriptObject::getObjectAttachmentsGeneration()
+{
+    return(_objectAttachments_generation);
 }
 
 int CLuaScriptObject::getNumberOfPasses() const
@@ -3145,7 +3161,7 @@ int CLuaScriptObject::_callMainScript(int optionalCallType,const CInterfaceStack
     if (optionalCallType==-1)
     {
         App::currentWorld->embeddedScriptContainer->resetScriptFlagCalledInThisSimulationStep();
-        int startT=VDateTime::getTimeInMs();
+        unsigned long long int startT=CStepProfiler::getTimeInUs();
 
         if (App::currentWorld->simulation->getSimulationState()==sim_simulation_advancing_firstafterstop)
             retVal|=_callMainScriptNow(sim_syscb_init,inStack,outStack,nullptr);
@@ -3161,7 +3177,7 @@ int CLuaScriptObject::_callMainScript(int optionalCallType,const CInterfaceStack
         if (App::currentWorld->simulation->getSimulationState()==sim_simulation_advancing_lastbeforestop)
             retVal|=_callMainScriptNow(sim_syscb_cleanup,inStack,outStack,nullptr);
 
-        App::worldContainer->calcInfo->setMainScriptExecutionTime(VDateTime::getTimeInMs()-startT);
+        App::worldContainer->calcInfo->setMainScriptExecutionTime(CStepProfiler::getTimeInUs()-startT);
         App::worldContainer->calcInfo->setSimulationScriptExecCount(App::currentWorld->embeddedScriptContainer->getCalledScriptsCountInThisSimulationStep(true));
     }
     else
@@ -3258,7 +3274,7 @@ void CLuaScriptObject::_launchThreadedChildScriptNow_oldThreads()
     }
     int oldTop=luaWrap_lua_gettop(L);   // We store lua's stack
 
-    luaWrap_luaL_dostring(L,"sim_call_type=-1"); // for backward compatibility
+    _setCallTypeForBackwardCompatibility(-1);
 
     if (_luaLoadBuffer(L,_scriptTextExec.c_str(),_scriptTextExec.size(),getShortDescriptiveName().c_str()))
     {
@@ -3401,6 +3417,9 @@ void CLuaScriptObject::_handleSimpleSysExCalls(int callType)
 
 int CLuaScriptObject::_callScriptFunction(int callType,const CInterfaceStack* inStack,CInterfaceStack* outStack)
 { // retval: -2: compil error, -1: runtimeError, 0: function not there, 1: ok
+    CStepProfilerScope profilerScope("script");
+    if (profilerScope.isActive())
+        profilerScope.setName(getShortDescriptiveName().c_str());
 
     _timeForNextAutoYielding=VDateTime::getTimeInMs()+_delayForAutoYielding;
     _forbidOverallYieldingLevel=0;
@@ -3452,9 +3471,7 @@ int CLuaScriptObject::_callScriptFunction(int callType,const CInterfaceStack* in
     int oldTop=luaWrap_lua_gettop(L);   // We store lua's stack
     if (_compatibilityModeOrFirstTimeCall_sysCallbacks)
     {
-        std::string tmp("sim_call_type="); // for backward compatibility
-        tmp+=boost::lexical_cast<std::string>(callType);
-        luaWrap_luaL_dostring(L,tmp.c_str());
+        _setCallTypeForBackwardCompatibility(callType);
         if (_luaLoadBuffer(L,_scriptTextExec.c_str(),_scriptTextExec.size(),getShortDescriptiveName().c_str()))
         {
             int inputArgs=0;
@@ -3495,7 +3512,10 @@ int CLuaScriptObject::_callScriptFunction(int callType,const CInterfaceStack* in
                     _compatibilityModeOrFirstTimeCall_sysCallbacks=!(luaWrap_lua_isfunction(L,-1));
                     luaWrap_lua_pop(L,1);
                     if (!_compatibilityModeOrFirstTimeCall_sysCallbacks)
-                        luaWrap_luaL_dostring(L,"sim_call_type=nil");
+                    {
+                        luaWrap_lua_pushnil(L);
+                        luaWrap_lua_setglobal(L,"sim_call_type");
+                    }
                 }
                 else
                 { // for backward compatibility:
@@ -3539,6 +3559,7 @@ int CLuaScriptObject::_callScriptFunction(int callType,const CInterfaceStack* in
             luaWrap_lua_getglobal(L,getSystemCallbackString(sim_syscb_userconfig,false).c_str());
             _containsUserConfigCallbackFunction=luaWrap_lua_isfunction(L,-1);
             luaWrap_lua_pop(L,6);
+            CEmbeddedScriptContainer::invalidateAllScriptExecutionOrders(); // callback membership might have changed
         }
         // Push the function name onto the stack (will be automatically popped from stack after _luaPCall):
         std::string funcName(getSystemCallbackString(callType,false));
@@ -3737,7 +3758,7 @@ int CLuaScriptObject::callScriptFunction_DEPRECATED(const char* functionName,SLu
     changeOverallYieldingForbidLevel(1,false);
     int oldTop=luaWrap_lua_gettop(L);   // We store lua's stack
 
-    luaWrap_luaL_dostring(L,"sim_call_type=-1"); // for backward compatibility
+    _setCallTypeForBackwardCompatibility(-1);
 
     // Push the function name onto the stack (will be automatically popped from stack after _luaPCall):
     std::string func(functionName);
@@ -3890,85 +3911,69 @@ int CLuaScriptObject::callScriptFunction(const char* functionName,CInterfaceStac
 
         int oldTop=luaWrap_lua_gettop(L);   // We store lua's stack
 
-        luaWrap_luaL_dostring(L,"sim_call_type=-1"); // for backward compatibility
+        _setCallTypeForBackwardCompatibility(-1);
 
-        // Push the function name onto the stack (will be automatically popped from stack after _luaPCall):
-        std::string func(functionName);
-        size_t ppos=func.find('.');
-        bool notFunction=false;
-        if (ppos==std::string::npos)
-            luaWrap_lua_getglobal(L,func.c_str()); // in case we have a global function:
-        else
-        { // in case we have a function that is not global
-            std::string globalVar(func.begin(),func.begin()+ppos);
-            luaWrap_lua_getglobal(L,globalVar.c_str());
-            if (luaWrap_lua_istable(L,-1))
+        // Push the function onto the stack (will be automatically popped from stack after _luaPCall):
+        if (_pushScriptFunction(functionName))
+            retVal=_callPushedScriptFunction(functionName,oldTop,stack);
+
+        luaWrap_lua_settop(L,oldTop);       // We restore lua's stack
+    }
+    changeOverallYieldingForbidLevel(-1,false);
+    if ((_scriptState&scriptState_error)!=0)
+        _killLuaState();
+    return(retVal);
+}
+
+int CLuaScriptObject::getScriptFunctionHandle(const char* functionName)
+{ // The function is resolved only once. The handle stays valid until the Lua state is killed. retVal: -1 if the function does not exist
+    int retVal=-1;
+    if (_scriptState==scriptState_initialized)
+    {
+        std::map<std::string,int>::iterator it=_scriptFunctionHandles.find(functionName);
+        if (it!=_scriptFunctionHandles.end())
+            retVal=it->second;
+        else if (_scriptFunctionRefNames.size()<0xffff)
+        {
+            int oldTop=luaWrap_lua_gettop(L);
+            if (_pushScriptFunction(functionName))
             {
-                func.assign(func.begin()+ppos+1,func.end());
-                size_t ppos=func.find('.');
-                while (ppos!=std::string::npos)
-                {
-                    std::string var(func.begin(),func.begin()+ppos);
-                    luaWrap_lua_getfield(L,-1,var.c_str());
-                    luaWrap_lua_remove(L,-2);
-                    func.erase(func.begin(),func.begin()+ppos+1);
-                    ppos=func.find('.');
-                    if (!luaWrap_lua_istable(L,-1))
-                    {
-                        notFunction=true;
-                        break;
-                    }
-                }
-                if (!notFunction)
-                {
-                    luaWrap_lua_getfield(L,-1,func.c_str());
-                    luaWrap_lua_remove(L,-2);
-                }
+                _pushScriptFunctionRefTable();
+                luaWrap_lua_pushvalue(L,-2);
+                _scriptFunctionRefNames.push_back(functionName);
+                int slot=int(_scriptFunctionRefNames.size());
+                luaWrap_lua_rawseti(L,-2,slot);
+                retVal=((_scriptFunctionRefGeneration&0x7fff)<<16)|slot;
+                _scriptFunctionHandles[functionName]=retVal;
             }
-            else
-                notFunction=true;
+            luaWrap_lua_settop(L,oldTop);
         }
+    }
+    return(retVal);
+}
 
-        if ( (!notFunction)&&luaWrap_lua_isfunction(L,-1) )
+int CLuaScriptObject::callScriptFunctionFromHandle(int functionHandle,CInterfaceStack* stack)
+{ // same as callScriptFunction, but without name resolution. A stale handle returns -2
+    int retVal=-3;
+    changeOverallYieldingForbidLevel(1,false);
+    if (_scriptState==scriptState_initialized)
+    {
+        retVal=-2;
+        int slot=functionHandle&0xffff;
+        if ( (functionHandle>0)&&(((functionHandle>>16)&0x7fff)==(_scriptFunctionRefGeneration&0x7fff))&&(slot>=1)&&(slot<=int(_scriptFunctionRefNames.size())) )
         {
-            retVal=-1;
-            // Push the arguments onto the stack (will be automatically popped from stack after _luaPCall):
-            int inputArgs=stack->getStackSize();
-
-            if (inputArgs!=0)
-                stack->buildOntoLuaStack(L,false);
+            int oldTop=luaWrap_lua_gettop(L);   // We store lua's stack
 
-            stack->clear();
+            _setCallTypeForBackwardCompatibility(-1);
 
-            luaWrap_lua_getglobal(L,"debug");
-            luaWrap_lua_getfield(L,-1,"traceback");
+            _pushScriptFunctionRefTable();
+            luaWrap_lua_rawgeti(L,-1,slot);
             luaWrap_lua_remove(L,-2);
-            int argCnt=inputArgs;
-            int errindex=-argCnt-2;
-            luaWrap_lua_insert(L,errindex);
+            if (luaWrap_lua_isfunction(L,-1))
+                retVal=_callPushedScriptFunction(_scriptFunctionRefNames[slot-1].c_str(),oldTop,stack);
 
-            if (_luaPCall(L,argCnt,luaWrapGet_LUA_MULTRET(),errindex,functionName)!=0)
-            { // a runtime error occurred!
-                _scriptState|=scriptState_error;
-                std::string errMsg;
-                if (luaWrap_lua_isstring(L,-1))
-                    errMsg=std::string(luaWrap_lua_tostring(L,-1));
-                else
-                    errMsg="(error unknown)";
-                luaWrap_lua_pop(L,1); // pop error from stack
-                _announceErrorWasRaisedAndDisableScript(errMsg.c_str(),true);
-            }
-            else
-            { // return values:
-                int currentTop=luaWrap_lua_gettop(L);
-
-                int numberOfArgs=currentTop-oldTop-1; // the first arg is linked to the debug mechanism
-                stack->buildFromLuaStack(L,oldTop+1+1,numberOfArgs); // the first arg is linked to the debug mechanism
-                retVal=0;
-            }
+            luaWrap_lua_settop(L,oldTop);       // We restore lua's stack
         }
-
-        luaWrap_lua_settop(L,oldTop);       // We restore lua's stack
     }
     changeOverallYieldingForbidLevel(-1,false);
     if ((_scriptState&scriptState_error)!=0)
@@ -3976,6 +3981,98 @@ int CLuaScriptObject::callScriptFunction(const char* functionName,CInterfaceStac
     return(retVal);
 }
 
+bool CLuaScriptObject::_pushScriptFunction(const char* functionName)
+{ // e.g. "myFunc" or "simAssimp.importShapesDlg". Returns true if a function was pushed
+    const char* dot=strchr(functionName,'.');
+    if (dot==nullptr)
+        luaWrap_lua_getglobal(L,functionName); // in case we have a global function
+    else
+    { // in case we have a function that is not global
+        _functionNameBuffer.assign(functionName,dot);
+        luaWrap_lua_getglobal(L,_functionNameBuffer.c_str());
+        while (dot!=nullptr)
+        {
+            if (!luaWrap_lua_istable(L,-1))
+                return(false);
+            const char* field=dot+1;
+            dot=strchr(field,'.');
+            if (dot==nullptr)
+                _functionNameBuffer.assign(field);
+            else
+                _functionNameBuffer.assign(field,dot);
+            luaWrap_lua_getfield(L,-1,_functionNameBuffer.c_str());
+            luaWrap_lua_remove(L,-2);
+        }
+    }
+    return(luaWrap_lua_isfunction(L,-1));
+}
+
+void CLuaScriptObject::_pushScriptFunctionRefTable()
+{ // the table lives in the Lua state, and disappears with it
+#ifdef OLD_LUA51
+    luaWrap_lua_getglobal(L,SIM_SCRIPT_FUNCTION_REFS);
+#else
+    luaWrap_lua_getfield(L,luaWrapGet_LUA_REGISTRYINDEX(),SIM_SCRIPT_FUNCTION_REFS);
+#endif
+    if (!luaWrap_lua_istable(L,-1))
+    {
+        luaWrap_lua_pop(L,1);
+        luaWrap_lua_newtable(L);
+        luaWrap_lua_pushvalue(L,-1);
+#ifdef OLD_LUA51
+        luaWrap_lua_setglobal(L,SIM_SCRIPT_FUNCTION_REFS);
+#else
+        luaWrap_lua_setfield(L,luaWrapGet_LUA_REGISTRYINDEX(),SIM_SCRIPT_FUNCTION_REFS);
+#endif
+    }
+}
+
+int CLuaScriptObject::_callPushedScriptFunction(const char* functionName,int oldTop,CInterfaceStack* stack)
+{ // the function is on top of the stack. retVal: -1: error in function, 0:ok
+    int retVal=-1;
+    // Push the arguments onto the stack (will be automatically popped from stack after _luaPCall):
+    int inputArgs=stack->getStackSize();
+
+    if (inputArgs!=0)
+        stack->buildOntoLuaStack(L,false);
+
+    stack->clear();
+
+    luaWrap_lua_getglobal(L,"debug");
+    luaWrap_lua_getfield(L,-1,"traceback");
+    luaWrap_lua_remove(L,-2);
+    int argCnt=inputArgs;
+    int errindex=-argCnt-2;
+    luaWrap_lua_insert(L,errindex);
+
+    if (_luaPCall(L,argCnt,luaWrapGet_LUA_MULTRET(),errindex,functionName)!=0)
+    { // a runtime error occurred!
+        _scriptState|=scriptState_error;
+        std::string errMsg;
+        if (luaWrap_lua_isstring(L,-1))
+            errMsg=std::string(luaWrap_lua_tostring(L,-1));
+        else
+            errMsg="(error unknown)";
+        luaWrap_lua_pop(L,1); // pop error from stack
+        _announceErrorWasRaisedAndDisableScript(errMsg.c_str(),true);
+    }
+    else
+    { // return values:
+        int currentTop=luaWrap_lua_gettop(L);
+
+        int numberOfArgs=currentTop-oldTop-1; // the first arg is linked to the debug mechanism
+        stack->buildFromLuaStack(L,oldTop+1+1,numberOfArgs); // the first arg is linked to the debug mechanism
+        retVal=0;
+    }
+    return(retVal);
+}
+
+void CLuaScriptObject::_setCallTypeForBackwardCompatibility(int callType)
+{ // same as running "sim_call_type=callType", but without compiling a chunk each time
+    luaWrap_lua_pushinteger(L,callType);
+    luaWrap_lua_setglobal(L,"sim_call_type");
+}
+
 int CLuaScriptObject::setScriptVariable(const char* variableName,CInterfaceStack* stack)
 {
     int retVal=-1;
@@ -4238,6 +4335,10 @@ bool CLuaScriptObject::_killLuaState()
         _numberOfPasses=0;
     _addOn_executionState=sim_syscb_init;
     _compatibilityModeOrFirstTimeCall_sysCallbacks=true;
+    _scriptFunctionHandles.clear();
+    _scriptFunctionRefNames.clear();
+    _scriptFunctionRefGeneration++;
+    CEmbeddedScriptContainer::invalidateAllScriptExecutionOrders();
     _containsJointCallbackFunction=false;
     _containsContactCallbackFunction=false;
     _containsDynCallbackFunction=false;
@@ -4342,6 +4443,21 @@ void CLuaScriptObject::_announceErrorWasRaisedAndDisableScript(const char* errMs
     }
 }
 
+CLuaScriptObject* CLuaScriptObject::getScriptFromLuaState(luaWrap_lua_State* L)
+{ // no lookup when the Lua state has an extra space (coroutines inherit it from the main thread)
+    void** extraSpace=(void**)luaWrap_lua_getextraspace(L);
+    if (extraSpace!=nullptr)
+        return((CLuaScriptObject*)extraSpace[0]);
+    return(App::worldContainer->getScriptFromHandle(getScriptHandleFromLuaState(L)));
+}
+
+void CLuaScriptObject::_setScriptToLuaState(luaWrap_lua_State* L,CLuaScriptObject* script)
+{
+    void** extraSpace=(void**)luaWrap_lua_getextraspace(L);
+    if (extraSpace!=nullptr)
+        extraSpace[0]=script;
+}
+
 int CLuaScriptObject::getScriptHandleFromLuaState(luaWrap_lua_State* L)
 {
     int retVal=-1;
@@ -4405,6 +4521,7 @@ std::string CLuaScriptObject::_getAdditionalLuaSearchPath()
 void CLuaScriptObject::_initLuaState()
 {
     L=luaWrap_luaL_newstate();
+    _setScriptToLuaState(L,this);
     luaWrap_luaL_openlibs(L);
     luaWrap_luaL_dostring(L,"os.setlocale'C'");
 
@@ -4441,7 +4558,7 @@ void CLuaScriptObject::_initLuaState()
 void CLuaScriptObject::_luaHookFunc(luaWrap_lua_State* L,luaWrap_lua_Debug* ar)
 {
     TRACE_INTERNAL;
-    CLuaScriptObject* it=App::worldContainer->getScriptFromHandle(getScriptHandleFromLuaState(L));
+    CLuaScriptObject* it=getScriptFromLuaState(L);
     if (it==nullptr)
         return;
 
@@ -4521,6 +4638,8 @@ void CLuaScriptObject::_luaHookFunc(luaWrap_lua_State* L,luaWrap_lua_Debug* ar)
 
 void CLuaScriptObject::serialize(CSer& ar)
 {
+    if (!ar.isStoring())
+        _objectAttachments_generation++; // handle, type and attached object might change
     if (ar.isBinary())
     {
         if (ar.isStoring())
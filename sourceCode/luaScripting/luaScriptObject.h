@@ -18,6 +18,7 @@
 
 #define SIM_SCRIPT_NAME_INDEX "sim_script_name_index" // keep this global, e.g. not _S.sim_script_name_index
 #define SIM_SCRIPT_HANDLE "sim_script_handle" // keep this global, e.g. not _S.sim_script_handle
+#define SIM_SCRIPT_FUNCTION_REFS "sim_script_function_refs" // in the registry, or global with Lua 5.1
 
 class CLuaScriptObject
 {
@@ -57,6 +58,7 @@ public:
     int getObjectHandleThatScriptIsAttachedTo() const;
     int getObjectHandleThatScriptIsAttachedTo_child() const; // for child scripts
     int getObjectHandleThatScriptIsAttachedTo_customization() const; // for customization scripts
+    static unsigned int getObjectAttachmentsGeneration(); // changes each time a script might have been attached/detached
 
     void setScriptText(const char* scriptTxt);
     bool setScriptTextFromFile(const char* filename);
@@ -73,6 +75,8 @@ public:
     bool callSandboxScript_beforeMainScript();
 
     int callScriptFunction(const char* functionName,CInterfaceStack* stack);
+    int getScriptFunctionHandle(const char* functionName);
+    int callScriptFunctionFromHandle(int functionHandle,CInterfaceStack* stack);
     int setScriptVariable(const char* variableName,CInterfaceStack* stack);
     int executeScriptString(const char* scriptString,CInterfaceStack* stack);
 
@@ -168,6 +172,7 @@ public:
     static std::vector<std::string> getAllSystemCallbackStrings(int scriptType,bool threaded,bool callTips);
 
     static int getScriptHandleFromLuaState(luaWrap_lua_State* L);
+    static CLuaScriptObject* getScriptFromLuaState(luaWrap_lua_State* L);
     static void setScriptNameIndexToLuaState(luaWrap_lua_State* L,int index);
     static int getScriptNameIndexFromLuaState(luaWrap_lua_State* L);
 
@@ -191,6 +196,7 @@ protected:
     static void _luaHookFunc(luaWrap_lua_State* L,luaWrap_lua_Debug* ar);
     static std::string _getAdditionalLuaSearchPath();
     static void _setScriptHandleToLuaState(luaWrap_lua_State* L,int h);
+    static void _setScriptToLuaState(luaWrap_lua_State* L,CLuaScriptObject* script);
 
     void _initLuaState();
 
@@ -204,6 +210,10 @@ protected:
     int _callAddOn(int callType,const CInterfaceStack* inStack,CInterfaceStack* outStack);
     int _callScriptFunction(int callType,const CInterfaceStack* inStack,CInterfaceStack* outStack);
     void _handleSimpleSysExCalls(int callType);
+    bool _pushScriptFunction(const char* functionName);
+    void _pushScriptFunctionRefTable();
+    int _callPushedScriptFunction(const char* functionName,int oldTop,CInterfaceStack* stack);
+    void _setCallTypeForBackwardCompatibility(int callType);
 
     bool _checkIfMixingOldAndNewCallMethods();
 
@@ -281,6 +291,10 @@ protected:
     bool _containsVisionCallbackFunction;
     bool _containsTriggerCallbackFunction;
     bool _containsUserConfigCallbackFunction;
+    std::map<std::string,int> _scriptFunctionHandles; // functions resolved via getScriptFunctionHandle
+    std::vector<std::string> _scriptFunctionRefNames; // index is the slot in the ref table - 1
+    int _scriptFunctionRefGeneration; // incremented when the Lua state is killed: old handles become invalid
+    std::string _functionNameBuffer;
     void _printContext(const char* str,size_t p);
 
     std::string _addOnName;
@@ -295,6 +309,7 @@ protected:
 
     static int _nextIdForExternalScriptEditor;
     static int _scriptUniqueCounter;
+    static unsigned int _objectAttachments_generation;
     static std::map<std::string,std::string> _newApiMap;
 
 
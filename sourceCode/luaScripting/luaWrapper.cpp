@@ -453,6 +453,17 @@ void luaWrap_lua_close(luaWrap_lua_State* L)
         lua_close((lua_State*)L);
 }
 
+void* luaWrap_lua_getextraspace(luaWrap_lua_State* L)
+{ // an external library might have been compiled with a different LUA_EXTRASPACE
+#ifdef OLD_LUA51
+    return(nullptr);
+#else
+    if ( (lib!=nullptr)||(LUA_EXTRASPACE<int(sizeof(void*))) )
+        return(nullptr);
+    return(lua_getextraspace((lua_State*)L));
+#endif
+}
+
 void luaWrap_luaL_openlibs(luaWrap_lua_State* L)
 {
     if (lib!=nullptr)
@@ -63,6 +63,7 @@ int luaWrapGet_LUA_RIDX_GLOBALS();
 
 luaWrap_lua_State* luaWrap_luaL_newstate();
 void luaWrap_lua_close(luaWrap_lua_State* L);
+void* luaWrap_lua_getextraspace(luaWrap_lua_State* L); // nullptr if not available
 void luaWrap_luaL_openlibs(luaWrap_lua_State* L);
 void luaWrap_lua_sethook(luaWrap_lua_State* L,luaWrap_lua_Hook func,int mask,int cnt);
 void luaWrap_lua_register(luaWrap_lua_State* L,const char* name,luaWrap_lua_CFunction func);
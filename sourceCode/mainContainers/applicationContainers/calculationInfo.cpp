@@ -6,7 +6,7 @@
 #include "threadPool.h"
 #include <boost/lexical_cast.hpp>
 #include "simStrings.h"
-#include "vDateTime.h"
+#include "stepProfiler.h"
 
 CCalculationInfo::CCalculationInfo()
 {
@@ -68,7 +68,7 @@ void CCalculationInfo::formatInfo()
     _scriptTxt[0]="Simulation scripts called";
     _scriptTxt[1]=boost::lexical_cast<std::string>(_simulationScriptExecCount);
     _scriptTxt[1]+=" (";
-    _scriptTxt[1]+=boost::lexical_cast<std::string>(_mainScriptDuration);
+    _scriptTxt[1]+=_getDurationStr(_mainScriptDuration);
     _scriptTxt[1]+=" ms)";
 
     // Proximity sensor calculation:
@@ -85,7 +85,7 @@ void CCalculationInfo::formatInfo()
     _sensTxt[1]="Calculations: ";
     _sensTxt[1]+=boost::lexical_cast<std::string>(_sensCalcCount)+", detections: ";
     _sensTxt[1]+=boost::lexical_cast<std::string>(_sensDetectCount)+" (";
-    _sensTxt[1]+=boost::lexical_cast<std::string>(_sensCalcDuration)+" ms)";
+    _sensTxt[1]+=_getDurationStr(_sensCalcDuration)+" ms)";
 
     // Vision sensor calculation:
     if (!App::currentWorld->mainSettings->visionSensorsEnabled)
@@ -95,7 +95,7 @@ void CCalculationInfo::formatInfo()
     _visionSensTxt[1]="Calculations: ";
     _visionSensTxt[1]+=boost::lexical_cast<std::string>(_rendSensCalcCount)+", detections: ";
     _visionSensTxt[1]+=boost::lexical_cast<std::string>(_rendSensDetectCount)+" (";
-    _visionSensTxt[1]+=boost::lexical_cast<std::string>(_rendSensCalcDuration)+" ms)";
+    _visionSensTxt[1]+=_getDurationStr(_rendSensCalcDuration)+" ms)";
 
     // Dynamics calculation:
     if (!App::currentWorld->dynamicsContainer->getDynamicsEnabled())
@@ -127,7 +127,7 @@ void CCalculationInfo::formatInfo()
     if (_dynamicsContentAvailable)
     {
         _dynamicsTxt[1]+=boost::lexical_cast<std::string>(_dynamicsCalcPasses)+" (";
-        _dynamicsTxt[1]+=boost::lexical_cast<std::string>(_dynamicsCalcDuration)+" ms)";
+        _dynamicsTxt[1]+=_getDurationStr(_dynamicsCalcDuration)+" ms)";
     }
     else
         _dynamicsTxt[1]+="0 (no dynamic content)";
@@ -135,35 +135,40 @@ void CCalculationInfo::formatInfo()
 
 float CCalculationInfo::getProximitySensorCalculationTime()
 {
-    return(float(_sensCalcDuration)*0.001f);
+    return(float(_sensCalcDuration)*0.000001f);
 }
 
 float CCalculationInfo::getVisionSensorCalculationTime()
 {
-    return(float(_rendSensCalcDuration)*0.001f);
+    return(float(_rendSensCalcDuration)*0.000001f);
 }
 
 float CCalculationInfo::getMainScriptExecutionTime()
 {
-    return(float(_mainScriptDuration)*0.001f);
+    return(float(_mainScriptDuration)*0.000001f);
 }
 
 float CCalculationInfo::getDynamicsCalculationTime()
 {
-    return(float(_dynamicsCalcDuration)*0.001f);
+    return(float(_dynamicsCalcDuration)*0.000001f);
 }
 
 float CCalculationInfo::getSimulationPassExecutionTime()
 {
-    return(float(VDateTime::getTimeDiffInMs(_simulationPassStartTime))*0.001f);
+    return(float(CStepProfiler::getTimeInUs()-_simulationPassStartTime)*0.000001f);
 }
 
 float CCalculationInfo::getRenderingDuration()
 {
-    return(float(_renderingDuration)*0.001f);
+    return(float(_renderingDuration)*0.000001f);
 }
 
-void CCalculationInfo::setMainScriptExecutionTime(int duration)
+std::string CCalculationInfo::_getDurationStr(unsigned long long int duration)
+{
+    return(tt::getFString(false,float(duration)*0.001f,2));
+}
+
+void CCalculationInfo::setMainScriptExecutionTime(unsigned long long int duration)
 {
     _mainScriptDuration=duration;
 }
@@ -175,17 +180,20 @@ void CCalculationInfo::setSimulationScriptExecCount(int cnt)
 
 void CCalculationInfo::simulationPassStart()
 {
-    _simulationPassStartTime=VDateTime::getTimeInMs();
+    _simulationPassStartTime=CStepProfiler::getTimeInUs();
 }
 
 void CCalculationInfo::simulationPassEnd()
 {
-    _simulationPassDuration+=VDateTime::getTimeDiffInMs(_simulationPassStartTime);
+    unsigned long long int d=CStepProfiler::getTimeInUs()-_simulationPassStartTime;
+    _simulationPassDuration+=d;
+    if (CStepProfiler::getEnabled())
+        CStepProfiler::addEvent("step","simulation pass",_simulationPassStartTime,d);
 }
 
 void CCalculationInfo::proximitySensorSimulationStart()
 {
-    _sensStartTime=VDateTime::getTimeInMs();
+    _sensStartTime=CStepProfiler::getTimeInUs();
 }
 
 void CCalculationInfo::proximitySensorSimulationEnd(bool detected)
@@ -193,12 +201,12 @@ void CCalculationInfo::proximitySensorSimulationEnd(bool detected)
     _sensCalcCount++;
     if (detected)
         _sensDetectCount++;
-    _sensCalcDuration+=VDateTime::getTimeDiffInMs(_sensStartTime);
+    _sensCalcDuration+=CStepProfiler::getTimeInUs()-_sensStartTime;
 }
 
 void CCalculationInfo::visionSensorSimulationStart()
 {
-    _rendSensStartTime=VDateTime::getTimeInMs();
+    _rendSensStartTime=CStepProfiler::getTimeInUs();
 }
 
 void CCalculationInfo::visionSensorSimulationEnd(bool detected)
@@ -206,17 +214,20 @@ void CCalculationInfo::visionSensorSimulationEnd(bool detected)
     _rendSensCalcCount++;
     if (detected)
         _rendSensDetectCount++;
-    _rendSensCalcDuration+=VDateTime::getTimeDiffInMs(_rendSensStartTime);
+    _rendSensCalcDuration+=CStepProfiler::getTimeInUs()-_rendSensStartTime;
 }
 
 void CCalculationInfo::renderingStart()
 {
-    _renderingStartTime=VDateTime::getTimeInMs();
+    _renderingStartTime=CStepProfiler::getTimeInUs();
 }
 
 void CCalculationInfo::renderingEnd()
 {
-    _renderingDuration+=VDateTime::getTimeDiffInMs(_renderingStartTime);
+    unsigned long long int d=CStepProfiler::getTimeInUs()-_renderingStartTime;
+    _renderingDuration+=d;
+    if (CStepProfiler::getEnabled())
+        CStepProfiler::addEvent("step","rendering",_renderingStartTime,d);
 }
 
 void CCalculationInfo::clearRenderingTime()
@@ -226,13 +237,16 @@ void CCalculationInfo::clearRenderingTime()
 
 void CCalculationInfo::dynamicsStart()
 {
-    _dynamicsStartTime=VDateTime::getTimeInMs();
+    _dynamicsStartTime=CStepProfiler::getTimeInUs();
 }
 
 void CCalculationInfo::dynamicsEnd(int calcPasses,bool dynamicContent)
 {
     _dynamicsCalcPasses=calcPasses;
-    _dynamicsCalcDuration+=VDateTime::getTimeDiffInMs(_dynamicsStartTime);
+    unsigned long long int d=CStepProfiler::getTimeInUs()-_dynamicsStartTime;
+    _dynamicsCalcDuration+=d;
+    if (CStepProfiler::getEnabled())
+        CStepProfiler::addEvent("step","dynamics",_dynamicsStartTime,d);
     _dynamicsContentAvailable=dynamicContent;
 }
 
@@ -15,7 +15,7 @@ public:
     void resetInfo(bool clearDisp);
     void formatInfo();
 
-    void setMainScriptExecutionTime(int duration);
+    void setMainScriptExecutionTime(unsigned long long int duration); // in us
     void setSimulationScriptExecCount(int cnt);
 
     void proximitySensorSimulationStart();
@@ -46,27 +46,30 @@ public:
 #endif
 
 private:
-    int _mainScriptDuration;
+    static std::string _getDurationStr(unsigned long long int duration);
+
+    // All times and durations in us (see CStepProfiler::getTimeInUs):
+    unsigned long long int _mainScriptDuration;
     int _simulationScriptExecCount;
 
-    int _simulationPassStartTime;
-    int _simulationPassDuration;
+    unsigned long long int _simulationPassStartTime;
+    unsigned long long int _simulationPassDuration;
 
-    int _renderingStartTime;
-    int _renderingDuration;
+    unsigned long long int _renderingStartTime;
+    unsigned long long int _renderingDuration;
 
     int _sensCalcCount;
     int _sensDetectCount;
-    int _sensStartTime;
-    int _sensCalcDuration;
+    unsigned long long int _sensStartTime;
+    unsigned long long int _sensCalcDuration;
 
     int _rendSensCalcCount;
     int _rendSensDetectCount;
-    int _rendSensStartTime;
-    int _rendSensCalcDuration;
+    unsigned long long int _rendSensStartTime;
+    unsigned long long int _rendSensCalcDuration;
 
-    int _dynamicsStartTime;
-    int _dynamicsCalcDuration;
+    unsigned long long int _dynamicsStartTime;
+    unsigned long long int _dynamicsCalcDuration;
     int _dynamicsCalcPasses;
     bool _dynamicsContentAvailable;
 
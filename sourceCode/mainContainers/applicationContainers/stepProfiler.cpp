@@ -0,0 +1,204 @@
+#include "stepProfiler.h"
+#include "easyLock.h"
+#include "vFile.h"
+#include "vArchive.h"
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+
+std::atomic<bool> CStepProfiler::_enabled(false);
+VMutex CStepProfiler::_buffersMutex;
+std::vector<SStepProfilerThreadBuffer*> CStepProfiler::_buffers;
+
+struct SStepProfilerThreadBufferHolder
+{ // releases the buffer when the thread ends, so that another thread can reuse it
+    SStepProfilerThreadBuffer* buffer=nullptr;
+    ~SStepProfilerThreadBufferHolder()
+    {
+        if (buffer!=nullptr)
+            CStepProfiler::releaseThreadBuffer(buffer);
+    }
+};
+static thread_local SStepProfilerThreadBufferHolder _threadBufferHolder;
+
+void CStepProfiler::setEnabled(bool e)
+{
+    _enabled.store(e,std::memory_order_relaxed);
+}
+
+unsigned long long int CStepProfiler::getTimeInUs()
+{
+    static const std::chrono::steady_clock::time_point startTime=std::chrono::steady_clock::now();
+    return((unsigned long long int)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-startTime).count());
+}
+
+void CStepProfiler::addEvent(const char* category,const char* name,unsigned long long int startTime,unsigned long long int duration)
+{ // lock-free, except the very first time a thread records something
+    SStepProfilerThreadBuffer* buffer=_getThreadBuffer();
+    unsigned long long int w=buffer->writeCount.load(std::memory_order_relaxed);
+    SStepProfilerEvent& ev=buffer->events[w%STEP_PROFILER_EVENTS_PER_THREAD];
+    ev.startTime=startTime;
+    ev.duration=duration;
+    _copyName(ev.category,category,STEP_PROFILER_CATEGORY_SIZE);
+    _copyName(ev.name,name,STEP_PROFILER_NAME_SIZE);
+    buffer->writeCount.store(w+1,std::memory_order_release);
+}
+
+void CStepProfiler::clearEvents()
+{ // only readers look at clearCount, the owner threads keep on writing undisturbed
+    EASYLOCK(_buffersMutex);
+    for (size_t i=0;i<_buffers.size();i++)
+        _buffers[i]->clearCount.store(_buffers[i]->writeCount.load(std::memory_order_acquire));
+}
+
+int CStepProfiler::saveChromeTrace(const char* filename)
+{ // Chrome trace event format (chrome://tracing or Perfetto), 'complete' events
+    std::vector<SStepProfilerEvent> events;
+    std::vector<int> threadIndices;
+    {
+        EASYLOCK(_buffersMutex);
+        for (size_t i=0;i<_buffers.size();i++)
+        {
+            SStepProfilerThreadBuffer* buffer=_buffers[i];
+            unsigned long long int end=buffer->writeCount.load(std::memory_order_acquire);
+            unsigned long long int start=0;
+            if (end>STEP_PROFILER_EVENTS_PER_THREAD)
+                start=end-STEP_PROFILER_EVENTS_PER_THREAD;
+            start=std::max<unsigned long long int>(start,buffer->clearCount.load());
+            size_t first=events.size();
+            for (unsigned long long int j=start;j<end;j++)
+                events.push_back(buffer->events[j%STEP_PROFILER_EVENTS_PER_THREAD]);
+            // The owner thread kept on writing, and might have overwritten the oldest slots:
+            unsigned long long int after=buffer->writeCount.load(std::memory_order_acquire);
+            if (after+1>start+STEP_PROFILER_EVENTS_PER_THREAD)
+            {
+                size_t overwritten=size_t(std::min<unsigned long long int>(end-start,after+1-start-STEP_PROFILER_EVENTS_PER_THREAD));
+                events.erase(events.begin()+first,events.begin()+first+overwritten);
+            }
+            threadIndices.resize(events.size(),buffer->threadIndex);
+        }
+    }
+
+    std::string txt("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    char tmp[128];
+    for (size_t i=0;i<events.size();i++)
+    {
+        if (i!=0)
+            txt+=",\n";
+        txt+="{\"name\":";
+        _appendJsonString(txt,events[i].name);
+        txt+=",\"cat\":";
+        _appendJsonString(txt,events[i].category);
+        snprintf(tmp,sizeof(tmp),",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":1,\"tid\":%i}",events[i].startTime,events[i].duration,threadIndices[i]);
+        txt+=tmp;
+    }
+    txt+="\n]}\n";
+
+    try
+    {
+        VFile myFile(filename,VFile::CREATE_WRITE|VFile::SHARE_EXCLUSIVE);
+        VArchive archive(&myFile,VArchive::STORE);
+        archive.writeString(txt);
+        archive.close();
+        myFile.close();
+    }
+    catch(VFILE_EXCEPTION_TYPE e)
+    {
+        return(-1);
+    }
+    return(int(events.size()));
+}
+
+void CStepProfiler::releaseThreadBuffer(SStepProfilerThreadBuffer* buffer)
+{
+    buffer->inUse.store(false);
+}
+
+SStepProfilerThreadBuffer* CStepProfiler::_getThreadBuffer()
+{
+    if (_threadBufferHolder.buffer==nullptr)
+    {
+        EASYLOCK(_buffersMutex);
+        for (size_t i=0;i<_buffers.size();i++)
+        { // reuse the buffer of a thread that ended (keeps its events)
+            if (!_buffers[i]->inUse.load())
+            {
+                _buffers[i]->inUse.store(true);
+                _threadBufferHolder.buffer=_buffers[i];
+                break;
+            }
+        }
+        if (_threadBufferHolder.buffer==nullptr)
+        {
+            SStepProfilerThreadBuffer* buffer=new SStepProfilerThreadBuffer;
+            buffer->threadIndex=int(_buffers.size());
+            buffer->inUse.store(true);
+            buffer->writeCount.store(0);
+            buffer->clearCount.store(0);
+            _buffers.push_back(buffer);
+            _threadBufferHolder.buffer=buffer;
+        }
+    }
+    return(_threadBufferHolder.buffer);
+}
+
+void CStepProfiler::_copyName(char* dest,const char* src,size_t destSize)
+{
+    size_t l=0;
+    if (src!=nullptr)
+    {
+        l=strlen(src);
+        if (l>destSize-1)
+            l=destSize-1;
+        memcpy(dest,src,l);
+    }
+    dest[l]=0;
+}
+
+void CStepProfiler::_appendJsonString(std::string& str,const char* txt)
+{
+    str+='"';
+    for (size_t i=0;txt[i]!=0;i++)
+    {
+        unsigned char c=(unsigned char)txt[i];
+        if ( (c=='"')||(c=='\\') )
+        {
+            str+='\\';
+            str+=char(c);
+        }
+        else if (c<32)
+        {
+            char tmp[8];
+            snprintf(tmp,sizeof(tmp),"\\u%04x",c);
+            str+=tmp;
+        }
+        else
+            str+=char(c);
+    }
+    str+='"';
+}
+
+CStepProfilerScope::CStepProfilerScope(const char* category,const char* name/*=nullptr*/)
+{
+    _active=CStepProfiler::getEnabled();
+    if (_active)
+    {
+        _category=category;
+        if (name!=nullptr)
+            _name=name;
+        _startTime=CStepProfiler::getTimeInUs();
+    }
+}
+
+CStepProfilerScope::~CStepProfilerScope()
+{
+    if (_active)
+        CStepProfiler::addEvent(_category,_name.c_str(),_startTime,CStepProfiler::getTimeInUs()-_startTime);
+}
+
+void CStepProfilerScope::setName(const char* name)
+{
+    if (_active)
+        _name=name;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include "vMutex.h"
+
+#define STEP_PROFILER_EVENTS_PER_THREAD 16384
+#define STEP_PROFILER_NAME_SIZE 48
+#define STEP_PROFILER_CATEGORY_SIZE 16
+
+struct SStepProfilerEvent
+{
+    unsigned long long int startTime; // in us
+    unsigned long long int duration; // in us
+    char category[STEP_PROFILER_CATEGORY_SIZE];
+    char name[STEP_PROFILER_NAME_SIZE];
+};
+
+struct SStepProfilerThreadBuffer
+{ // written only by its owning thread. Readers use writeCount to detect overwritten slots
+    int threadIndex;
+    std::atomic<bool> inUse;
+    std::atomic<unsigned long long int> writeCount;
+    std::atomic<unsigned long long int> clearCount; // events before that one were cleared
+    SStepProfilerEvent events[STEP_PROFILER_EVENTS_PER_THREAD];
+};
+
+// FULLY STATIC CLASS
+class CStepProfiler
+{
+public:
+    static void setEnabled(bool e);
+    static bool getEnabled() { return(_enabled.load(std::memory_order_relaxed)); }
+    static unsigned long long int getTimeInUs();
+
+    static void addEvent(const char* category,const char* name,unsigned long long int startTime,unsigned long long int duration);
+    static void clearEvents();
+    static int saveChromeTrace(const char* filename); // returns the number of saved events, or -1
+
+    static void releaseThreadBuffer(SStepProfilerThreadBuffer* buffer);
+
+private:
+    static SStepProfilerThreadBuffer* _getThreadBuffer();
+    static void _copyName(char* dest,const char* src,size_t destSize);
+    static void _appendJsonString(std::string& str,const char* txt);
+
+    static std::atomic<bool> _enabled;
+    static VMutex _buffersMutex; // only used when a thread gets its buffer, and when dumping
+    static std::vector<SStepProfilerThreadBuffer*> _buffers;
+};
+
+class CStepProfilerScope
+{ // measures the time until it goes out of scope. Almost no cost when the profiler is disabled
+public:
+    CStepProfilerScope(const char* category,const char* name=nullptr);
+    virtual ~CStepProfilerScope();
+
+    bool isActive() const { return(_active); }
+    void setName(const char* name);
+
+private:
+    bool _active;
+    unsigned long long int _startTime;
+    const char* _category;
+    std::string _name;
+};
@@ -7,9 +7,8 @@
 #include <iostream>
 
 std::string CApiErrors::_c_lastError;
-VMutex _threadBasedFirstCapiErrorAndWarningMutex;
-std::vector<SThreadAndMsg> CApiErrors::_threadBasedFirstCapiWarning;
-std::vector<SThreadAndMsg> CApiErrors::_threadBasedFirstCapiError;
+thread_local SThreadFirstMsg CApiErrors::_threadBasedFirstCapiWarning={false,std::string()};
+thread_local SThreadFirstMsg CApiErrors::_threadBasedFirstCapiError={false,std::string()};
 
 CApiErrors::CApiErrors()
 {
@@ -71,63 +70,31 @@ std::string CApiErrors::getAndClearThreadBasedFirstCapiError()
     return(_getAndClearThreadBasedFirstCapiMsg(_threadBasedFirstCapiError));
 }
 
-void CApiErrors::_clearThreadBasedFirstCapiMsg(std::vector<SThreadAndMsg>& vect)
-{
-    VTHREAD_ID_TYPE threadId=VThread::getCurrentThreadId();
-    _threadBasedFirstCapiErrorAndWarningMutex.lock("");
-    for (size_t i=0;i<vect.size();i++)
+void CApiErrors::_clearThreadBasedFirstCapiMsg(SThreadFirstMsg& msgSlot)
+{ // called for every Lua API call: no lock and no allocation needed here
+    if (msgSlot.isSet)
     {
-        if (vect[i].threadId==threadId)
-        {
-            vect.erase(vect.begin()+i);
-            break;
-        }
+        msgSlot.isSet=false;
+        msgSlot.message.clear();
     }
-    _threadBasedFirstCapiErrorAndWarningMutex.unlock();
 }
 
-void CApiErrors::_setThreadBasedFirstCapiMsg(std::vector<SThreadAndMsg>& vect,const char* msg)
+void CApiErrors::_setThreadBasedFirstCapiMsg(SThreadFirstMsg& msgSlot,const char* msg)
 {
-    VTHREAD_ID_TYPE threadId=VThread::getCurrentThreadId();
-    int index=-1;
-    _threadBasedFirstCapiErrorAndWarningMutex.lock("");
-    for (size_t i=0;i<vect.size();i++)
-    {
-        if (vect[i].threadId==threadId)
-        {
-            index=int(i);
-            break;
-        }
-    }
-    if (index==-1)
+    if (!msgSlot.isSet)
     {
-        SThreadAndMsg v;
-        v.threadId=threadId;
-        v.message=msg;
-        vect.push_back(v);
+        msgSlot.isSet=true;
+        msgSlot.message=msg;
     }
-    _threadBasedFirstCapiErrorAndWarningMutex.unlock();
 }
 
-std::string CApiErrors::_getAndClearThreadBasedFirstCapiMsg(std::vector<SThreadAndMsg>& vect)
+std::string CApiErrors::_getAndClearThreadBasedFirstCapiMsg(SThreadFirstMsg& msgSlot)
 {
     std::string retVal;
-    VTHREAD_ID_TYPE threadId=VThread::getCurrentThreadId();
-    int index=-1;
-    _threadBasedFirstCapiErrorAndWarningMutex.lock("");
-    for (size_t i=0;i<vect.size();i++)
-    {
-        if (vect[i].threadId==threadId)
-        {
-            index=int(i);
-            break;
-        }
-    }
-    if (index!=-1)
+    if (msgSlot.isSet)
     {
-        retVal=vect[size_t(index)].message;
-        vect.erase(vect.begin()+size_t(index));
+        retVal.swap(msgSlot.message);
+        msgSlot.isSet=false;
     }
-    _threadBasedFirstCapiErrorAndWarningMutex.unlock();
     return(retVal);
 }
@@ -67,6 +67,7 @@
 #define SIM_ERROR_THREADED_SCRIPT_DESTROYING_OBJECTS_WITH_ACTIVE_SCRIPTS "Threaded scripts cannot destroy objects that are linked to initialized scripts other that the calling script."
 #define SIM_ERROR_MODEL_COULD_NOT_BE_SAVED          "Model could not be saved."
 #define SIM_ERROR_UI_COULD_NOT_BE_SAVED             "UI could not be saved."
+#define SIM_ERROR_TRACE_COULD_NOT_BE_SAVED          "Trace could not be saved."
 #define SIM_ERROR_TOO_MANY_TEMP_OBJECTS             "Too many temporary path search objects."
 #define SIM_ERROR_PATH_PLANNING_OBJECT_NOT_CONSISTENT           "Path planning object is not consistent."
 #define SIM_ERROR_PATH_PLANNING_OBJECT_NOT_CONSISTENT_ANYMORE "Path planning object is not consistent anymore."
@@ -161,9 +162,9 @@
 #define SIM_ERROR_COULD_NOT_SET_PARAMETER "Could not set parameter."
 
 
-struct SThreadAndMsg
-{
-    VTHREAD_ID_TYPE threadId;
+struct SThreadFirstMsg
+{ // one per thread (thread-local). The string only allocates once a message is set
+    bool isSet;
     std::string message;
 };
 
@@ -186,11 +187,11 @@ public:
     static std::string getAndClearThreadBasedFirstCapiError();
 
 private:
-    static void _clearThreadBasedFirstCapiMsg(std::vector<SThreadAndMsg>& vect);
-    static void _setThreadBasedFirstCapiMsg(std::vector<SThreadAndMsg>& vect,const char* msg);
-    static std::string _getAndClearThreadBasedFirstCapiMsg(std::vector<SThreadAndMsg>& vect);
+    static void _clearThreadBasedFirstCapiMsg(SThreadFirstMsg& msgSlot);
+    static void _setThreadBasedFirstCapiMsg(SThreadFirstMsg& msgSlot,const char* msg);
+    static std::string _getAndClearThreadBasedFirstCapiMsg(SThreadFirstMsg& msgSlot);
 
     static std::string _c_lastError;
-    static std::vector<SThreadAndMsg> _threadBasedFirstCapiWarning;
-    static std::vector<SThreadAndMsg> _threadBasedFirstCapiError;
+    static thread_local SThreadFirstMsg _threadBasedFirstCapiWarning;
+    static thread_local SThreadFirstMsg _threadBasedFirstCapiError;
 };
@@ -34,7 +34,7 @@ void CCommTubeContainer::simulationEnded()
     }
 }
 
-int CCommTubeContainer::openTube(int header,const char* identifier,bool killAtSimulationEnd,int readBufferSize)
+int CCommTubeContainer::openTube(int header,const char* identifier,bool killAtSimulationEnd,int readBufferSize,bool overwriteOldest/*=true*/)
 { // return value is the tube handle for this partner
     // 1. Check if a related tube exists:
     int tubeIndex=-1;
@@ -56,7 +56,7 @@ int CCommTubeContainer::openTube(int header,const char* identifier,bool killAtSi
             int retVal;
             retVal=2*_nextPartnerID+0;
             _nextPartnerID++;
-            _allTubes[tubeIndex]->connectPartner(retVal,killAtSimulationEnd,readBufferSize);
+            _allTubes[tubeIndex]->connectPartner(retVal,killAtSimulationEnd,readBufferSize,overwriteOldest);
             return(retVal);
         }
     }
@@ -65,7 +65,7 @@ int CCommTubeContainer::openTube(int header,const char* identifier,bool killAtSi
         int retVal;
         retVal=2*_nextPartnerID+0;
         _nextPartnerID++;
-        CCommTube* it=new CCommTube(header,identifier,retVal,killAtSimulationEnd,readBufferSize);
+        CCommTube* it=new CCommTube(header,identifier,retVal,killAtSimulationEnd,readBufferSize,overwriteOldest);
         _allTubes.push_back(it);
         return(retVal);
     }
@@ -103,16 +103,10 @@ bool CCommTubeContainer::writeToTube_copyBuffer(int tubeHandle,const char* data,
         return(false);
     if (!_allTubes[index]->isConnected()) // Added on 2011/01/06 (writing to a non-connected tube will otherwise result in memory leak)
         return(false);
-    char* data2=new char[dataLength];
-    for (int i=0;i<dataLength;i++)
-        data2[i]=data[i];
-    bool retVal=_allTubes[index]->writeData(tubeHandle,data2,dataLength);
-    if (!retVal) // Following two lines added on 22/11/2011 because of some memory leak
-        delete[] data2;
-    return(retVal);
+    return(_allTubes[index]->writeData(tubeHandle,data,dataLength));
 }
 
-char* CCommTubeContainer::readFromTube_bufferNotCopied(int tubeHandle,int& dataLength)
+char* CCommTubeContainer::readFromTube_bufferCopied(int tubeHandle,int& dataLength)
 {
     int index=_getTubeIndexForHandle(tubeHandle);
     if (index==-1)
@@ -121,6 +115,24 @@ char* CCommTubeContainer::readFromTube_bufferNotCopied(int tubeHandle,int& dataL
     return(retVal);
 }
 
+const char* CCommTubeContainer::readFromTube_view(int tubeHandle,int& dataLength)
+{
+    int index=_getTubeIndexForHandle(tubeHandle);
+    if (index==-1)
+        return(nullptr);
+    return(_allTubes[index]->readDataView(tubeHandle,dataLength));
+}
+
+int CCommTubeContainer::readAllFromTube_views(int tubeHandle,std::vector<const char*>& data,std::vector<int>& dataLengths)
+{
+    data.clear();
+    dataLengths.clear();
+    int index=_getTubeIndexForHandle(tubeHandle);
+    if (index==-1)
+        return(-1);
+    return(_allTubes[index]->readAllDataViews(tubeHandle,data,dataLengths));
+}
+
 int CCommTubeContainer::getTubeStatus(int tubeHandle,int& readBufferFill,int& writeBufferFill)
 {
     int index=_getTubeIndexForHandle(tubeHandle);
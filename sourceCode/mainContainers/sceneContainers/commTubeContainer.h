@@ -9,11 +9,13 @@ public:
     virtual ~CCommTubeContainer();
     void simulationEnded();
 
-    int openTube(int header,const char* identifier,bool killAtSimulationEnd,int readBufferSize); // return value is the tube handle for this partner
+    int openTube(int header,const char* identifier,bool killAtSimulationEnd,int readBufferSize,bool overwriteOldest=true); // return value is the tube handle for this partner
     bool closeTube(int tubeHandle); // returns true if tube could be closed
 
     bool writeToTube_copyBuffer(int tubeHandle,const char* data,int dataLength);
-    char* readFromTube_bufferNotCopied(int tubeHandle,int& dataLength);
+    char* readFromTube_bufferCopied(int tubeHandle,int& dataLength); // release with delete[]
+    const char* readFromTube_view(int tubeHandle,int& dataLength); // valid until the next write to that tube
+    int readAllFromTube_views(int tubeHandle,std::vector<const char*>& data,std::vector<int>& dataLengths); // valid until the next write to that tube
     int getTubeStatus(int tubeHandle,int& readBufferFill,int& writeBufferFill); // -1: not existant, 0: not connected, 1: connected
 
     void removeAllTubes();
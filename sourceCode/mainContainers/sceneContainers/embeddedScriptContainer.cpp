@@ -8,8 +8,16 @@
 #include "app.h"
 #include "vDateTime.h"
 
+unsigned int CEmbeddedScriptContainer::_scriptExecutionOrders_generation=0;
+
 CEmbeddedScriptContainer::CEmbeddedScriptContainer()
 {
+    _objectAttachmentIndices_cacheValid=false;
+    _objectAttachmentIndices_cacheGeneration=0;
+    _scriptExecutionOrders_cacheValid=false;
+    _scriptExecutionOrders_cacheGeneration=0;
+    _scriptExecutionOrders_cacheAttachmentsGeneration=0;
+    _scriptExecutionOrders_cacheRunCustomizationScripts=false;
     insertDefaultScript_mainAndChildScriptsOnly(sim_scripttype_mainscript,false,false);
 }
 
@@ -107,6 +115,7 @@ int CEmbeddedScriptContainer::removeDestroyedScripts(int scriptType)
                 retVal++;
                 CLuaScriptObject* it=allScripts[i];
                 it->resetScript(); // should not be done in the destructor!
+                _removeFromIndices(it);
                 allScripts.erase(allScripts.begin()+i);
                 i--;
                 delete it;
@@ -145,6 +154,7 @@ void CEmbeddedScriptContainer::removeAllScripts()
     {
         CLuaScriptObject* it=allScripts[0];
         it->resetScript(); // should not be done in the destructor!
+        _removeFromIndices(it);
         allScripts.erase(allScripts.begin());
         delete it;
     }
@@ -198,6 +208,7 @@ bool CEmbeddedScriptContainer::removeScript(int scriptHandle)
         {
             CLuaScriptObject* it=allScripts[i];
             it->resetScript(); // should not be done in the destructor!
+            _removeFromIndices(it);
             allScripts.erase(allScripts.begin()+i);
             delete it;
             App::worldContainer->setModificationFlag(16384);
@@ -210,37 +221,29 @@ bool CEmbeddedScriptContainer::removeScript(int scriptHandle)
 
 CLuaScriptObject* CEmbeddedScriptContainer::getScriptFromHandle(int scriptHandle) const
 {
-    CLuaScriptObject* retVal=nullptr;
-    for (size_t i=0;i<allScripts.size();i++)
-    {
-        if (allScripts[i]->getScriptHandle()==scriptHandle)
-        {
-            retVal=allScripts[i];
-            break;
-        }
-    }
-    return(retVal);
+    std::unordered_map<int,CLuaScriptObject*>::const_iterator it=_scriptsFromHandle.find(scriptHandle);
+    if (it!=_scriptsFromHandle.end())
+        return(it->second);
+    return(nullptr);
 }
 
 CLuaScriptObject* CEmbeddedScriptContainer::getScriptFromObjectAttachedTo_child(int objectHandle) const
 { // used for child scripts
     if (objectHandle<0)
         return(nullptr); // 10/1/2016
-    for (size_t i=0;i<allScripts.size();i++)
-    {
-        if (allScripts[i]->getObjectHandleThatScriptIsAttachedTo_child()==objectHandle)
-            return(allScripts[i]);
-    }
+    _updateObjectAttachmentIndicesIfNeeded();
+    std::unordered_map<int,CLuaScriptObject*>::const_iterator it=_childScriptsFromObject.find(objectHandle);
+    if (it!=_childScriptsFromObject.end())
+        return(it->second);
     return(nullptr);
 }
 
 CLuaScriptObject* CEmbeddedScriptContainer::getScriptFromObjectAttachedTo_customization(int objectHandle) const
 { // used for customization scripts
-    for (size_t i=0;i<allScripts.size();i++)
-    {
-        if (allScripts[i]->getObjectHandleThatScriptIsAttachedTo_customization()==objectHandle)
-            return(allScripts[i]);
-    }
+    _updateObjectAttachmentIndicesIfNeeded();
+    std::unordered_map<int,CLuaScriptObject*>::const_iterator it=_customizationScriptsFromObject.find(objectHandle);
+    if (it!=_customizationScriptsFromObject.end())
+        return(it->second);
     return(nullptr);
 }
 
@@ -274,6 +277,7 @@ int CEmbeddedScriptContainer::insertScript(CLuaScriptObject* script)
         newHandle++;
     script->setScriptHandle(newHandle);
     allScripts.push_back(script);
+    _addToIndices(script);
     App::worldContainer->setModificationFlag(8192);
     return(newHandle);
 }
@@ -436,14 +440,84 @@ int CEmbeddedScriptContainer::_getScriptsToExecute(int scriptType,std::vector<CL
     return(int(scripts.size()));
 }
 
+void CEmbeddedScriptContainer::invalidateAllScriptExecutionOrders()
+{ // static
+    _scriptExecutionOrders_generation++;
+}
+
+const SScriptExecutionOrder* CEmbeddedScriptContainer::_getScriptExecutionOrder(int scriptType)
+{ // walking the scene tree is expensive: the result is cached until something relevant changes
+    if ( (!_scriptExecutionOrders_cacheValid)||(_scriptExecutionOrders_cacheGeneration!=_scriptExecutionOrders_generation)||(_scriptExecutionOrders_cacheAttachmentsGeneration!=CLuaScriptObject::getObjectAttachmentsGeneration())||(_scriptExecutionOrders_cacheRunCustomizationScripts!=App::userSettings->runCustomizationScripts) )
+    {
+        _scriptExecutionOrders.clear();
+        _scriptExecutionOrders_cacheValid=true;
+        _scriptExecutionOrders_cacheGeneration=_scriptExecutionOrders_generation;
+        _scriptExecutionOrders_cacheAttachmentsGeneration=CLuaScriptObject::getObjectAttachmentsGeneration();
+        _scriptExecutionOrders_cacheRunCustomizationScripts=App::userSettings->runCustomizationScripts;
+    }
+    std::map<int,SScriptExecutionOrder>::iterator it=_scriptExecutionOrders.find(scriptType);
+    if (it==_scriptExecutionOrders.end())
+    {
+        SScriptExecutionOrder& order=_scriptExecutionOrders[scriptType];
+        _getScriptsToExecute(scriptType,order.scripts,order.uniqueIds);
+        for (size_t i=0;i<order.scripts.size();i++)
+        {
+            CLuaScriptObject* script=order.scripts[i];
+            if (script->getContainsDynCallbackFunction())
+            {
+                order.scriptsWithDynCallback.push_back(script);
+                order.uniqueIdsWithDynCallback.push_back(order.uniqueIds[i]);
+            }
+            if (script->getContainsContactCallbackFunction())
+            {
+                order.scriptsWithContactCallback.push_back(script);
+                order.uniqueIdsWithContactCallback.push_back(order.uniqueIds[i]);
+            }
+        }
+        return(&order);
+    }
+    return(&it->second);
+}
+
 bool CEmbeddedScriptContainer::doesScriptWithUniqueIdExist(int id) const
 {
-    for (size_t i=0;i<allScripts.size();i++)
+    return(_scriptsFromUniqueId.find(id)!=_scriptsFromUniqueId.end());
+}
+
+void CEmbeddedScriptContainer::_addToIndices(CLuaScriptObject* script)
+{
+    _scriptsFromHandle[script->getScriptHandle()]=script;
+    _scriptsFromUniqueId[script->getScriptUniqueID()]=script;
+    _objectAttachmentIndices_cacheValid=false;
+    _scriptExecutionOrders_cacheValid=false;
+}
+
+void CEmbeddedScriptContainer::_removeFromIndices(CLuaScriptObject* script)
+{
+    _scriptsFromHandle.erase(script->getScriptHandle());
+    _scriptsFromUniqueId.erase(script->getScriptUniqueID());
+    _objectAttachmentIndices_cacheValid=false;
+    _scriptExecutionOrders_cacheValid=false;
+}
+
+void CEmbeddedScriptContainer::_updateObjectAttachmentIndicesIfNeeded() const
+{ // in case of duplicates, the first script in allScripts wins (same as with a linear search)
+    if ( (!_objectAttachmentIndices_cacheValid)||(_objectAttachmentIndices_cacheGeneration!=CLuaScriptObject::getObjectAttachmentsGeneration()) )
     {
-        if (allScripts[i]->getScriptUniqueID()==id)
-            return(true);
+        _childScriptsFromObject.clear();
+        _customizationScriptsFromObject.clear();
+        for (size_t i=0;i<allScripts.size();i++)
+        {
+            CLuaScriptObject* it=allScripts[i];
+            int h=it->getObjectHandleThatScriptIsAttachedTo_child();
+            if (h>=0)
+                _childScriptsFromObject.insert(std::make_pair(h,it));
+            if (it->getScriptType()==sim_scripttype_customizationscript)
+                _customizationScriptsFromObject.insert(std::make_pair(it->getObjectHandleThatScriptIsAttachedTo_customization(),it));
+        }
+        _objectAttachmentIndices_cacheValid=true;
+        _objectAttachmentIndices_cacheGeneration=CLuaScriptObject::getObjectAttachmentsGeneration();
     }
-    return(false);
 }
 
 
@@ -452,9 +526,23 @@ int CEmbeddedScriptContainer::handleCascadedScriptExecution(int scriptType,int c
     int cnt=0;
     if (retInfo!=nullptr)
         retInfo[0]=0;
-    std::vector<CLuaScriptObject*> scripts;
-    std::vector<int> uniqueIds;
-    _getScriptsToExecute(scriptType,scripts,uniqueIds);
+    const SScriptExecutionOrder* order=_getScriptExecutionOrder(scriptType);
+    const std::vector<CLuaScriptObject*>* orderedScripts=&order->scripts;
+    const std::vector<int>* orderedUniqueIds=&order->uniqueIds;
+    bool isSysCallback=((scriptType&sim_scripttype_threaded_old)==0); // otherwise a resume location
+    if ( isSysCallback&&(callTypeOrResumeLocation==sim_syscb_dyncallback) )
+    {
+        orderedScripts=&order->scriptsWithDynCallback;
+        orderedUniqueIds=&order->uniqueIdsWithDynCallback;
+    }
+    if ( isSysCallback&&(callTypeOrResumeLocation==sim_syscb_contactcallback) )
+    {
+        orderedScripts=&order->scriptsWithContactCallback;
+        orderedUniqueIds=&order->uniqueIdsWithContactCallback;
+    }
+    // Local copies, since the cached order might get invalidated by the scripts we call:
+    std::vector<CLuaScriptObject*> scripts(*orderedScripts);
+    std::vector<int> uniqueIds(*orderedUniqueIds);
     for (size_t i=0;i<scripts.size();i++)
     {
         if (doesScriptWithUniqueIdExist(uniqueIds[i]))
@@ -3,6 +3,18 @@
 #include "luaScriptObject.h"
 #include "broadcastDataContainer.h"
 #include "simInternal.h"
+#include <unordered_map>
+#include <map>
+
+struct SScriptExecutionOrder
+{ // scripts in execution order, for one script type
+    std::vector<CLuaScriptObject*> scripts;
+    std::vector<int> uniqueIds;
+    std::vector<CLuaScriptObject*> scriptsWithDynCallback; // same order
+    std::vector<int> uniqueIdsWithDynCallback;
+    std::vector<CLuaScriptObject*> scriptsWithContactCallback; // same order
+    std::vector<int> uniqueIdsWithContactCallback;
+};
 
 class CEmbeddedScriptContainer
 {
@@ -44,12 +56,35 @@ public:
     void callScripts(int callType,CInterfaceStack* inStack);
     void sceneOrModelAboutToBeSaved(int modelBase);
 
+    static void invalidateAllScriptExecutionOrders(); // hierarchy, model properties, execution order or callbacks changed
+
     std::vector<CLuaScriptObject*> allScripts;
 
     CBroadcastDataContainer broadcastDataContainer;
 
 protected:
     int _getScriptsToExecute(int scriptType,std::vector<CLuaScriptObject*>& scripts,std::vector<int>& uniqueIds) const;
+    const SScriptExecutionOrder* _getScriptExecutionOrder(int scriptType);
+    void _addToIndices(CLuaScriptObject* script);
+    void _removeFromIndices(CLuaScriptObject* script);
+    void _updateObjectAttachmentIndicesIfNeeded() const;
+
+    // Indices into allScripts. Handles and unique ids do not change while a script is in the container:
+    std::unordered_map<int,CLuaScriptObject*> _scriptsFromHandle;
+    std::unordered_map<int,CLuaScriptObject*> _scriptsFromUniqueId;
+    // Attached objects can change at any time. Rebuilt on demand:
+    mutable std::unordered_map<int,CLuaScriptObject*> _childScriptsFromObject;
+    mutable std::unordered_map<int,CLuaScriptObject*> _customizationScriptsFromObject;
+    mutable bool _objectAttachmentIndices_cacheValid;
+    mutable unsigned int _objectAttachmentIndices_cacheGeneration;
+
+    // Cached execution orders, per script type:
+    std::map<int,SScriptExecutionOrder> _scriptExecutionOrders;
+    bool _scriptExecutionOrders_cacheValid;
+    unsigned int _scriptExecutionOrders_cacheGeneration;
+    unsigned int _scriptExecutionOrders_cacheAttachmentsGeneration;
+    bool _scriptExecutionOrders_cacheRunCustomizationScripts;
+    static unsigned int _scriptExecutionOrders_generation;
 
     std::vector<SScriptCallBack*> _callbackStructureToDestroyAtEndOfSimulation_new;
     std::vector<SLuaCallBack*> _callbackStructureToDestroyAtEndOfSimulation_old;
@@ -84,39 +84,49 @@ bool CSceneObjectContainer::addObjectToScene(CSceneObject* newObject,bool object
 
 bool CSceneObjectContainer::addObjectToSceneWithSuffixOffset(CSceneObject* newObject,bool objectIsACopy,int suffixOffset,bool generateAfterCreateCallback)
 {
+    std::vector<CSceneObject*> newObjects;
+    newObjects.push_back(newObject);
+    return(addObjectsToSceneWithSuffixOffset(newObjects,objectIsACopy,suffixOffset,generateAfterCreateCallback));
+}
+
+bool CSceneObjectContainer::addObjectsToSceneWithSuffixOffset(const std::vector<CSceneObject*>& newObjects,bool objectIsACopy,int suffixOffset,bool generateAfterCreateCallback)
+{ // the object information is actualized only once, at the end
     App::currentWorld->environment->setSceneCanBeDiscardedWhenNewSceneOpened(false); // 4/3/2012
 
+    for (size_t i=0;i<newObjects.size();i++)
+        _addObjectToScene(newObjects[i],objectIsACopy,suffixOffset);
+
+    // Actualize the object information
+    actualizeObjectInformation();
+    if (generateAfterCreateCallback)
+    {
+        CInterfaceStack stack;
+        stack.pushTableOntoStack();
+        stack.pushStringOntoStack("objectHandles",0);
+        stack.pushTableOntoStack();
+        for (size_t i=0;i<newObjects.size();i++)
+        {
+            stack.pushNumberOntoStack(double(i+1)); // key or index
+            stack.pushNumberOntoStack(newObjects[i]->getObjectHandle());
+            stack.insertDataIntoStackTable();
+        }
+        stack.insertDataIntoStackTable();
+        App::worldContainer->callScripts(sim_syscb_aftercreate,&stack);
+    }
+    App::worldContainer->setModificationFlag(2); // object created
+
+    return(true);
+}
+
+void CSceneObjectContainer::_addObjectToScene(CSceneObject* newObject,bool objectIsACopy,int suffixOffset)
+{
     std::string newObjName=newObject->getObjectName();
     if (objectIsACopy)
         newObjName=tt::generateNewName_hash(newObjName.c_str(),suffixOffset);
     else
     {
         if (getObjectFromName(newObjName.c_str())!=nullptr)
-        {
-            // Following faster with many objects:
-            std::string baseName(tt::getNameWithoutSuffixNumber(newObjName.c_str(),false));
-            int initialSuffix=tt::getNameSuffixNumber(newObjName.c_str(),false);
-            std::vector<int> suffixes;
-            std::vector<int> dummyValues;
-            for (size_t i=0;i<getObjectCount();i++)
-            {
-                std::string baseNameIt(tt::getNameWithoutSuffixNumber(getObjectFromIndex(i)->getObjectName().c_str(),false));
-                if (baseName.compare(baseNameIt)==0)
-                {
-                    suffixes.push_back(tt::getNameSuffixNumber(getObjectFromIndex(i)->getObjectName().c_str(),false));
-                    dummyValues.push_back(0);
-                }
-            }
-            tt::orderAscending(suffixes,dummyValues);
-            int lastS=-1;
-            for (size_t i=0;i<suffixes.size();i++)
-            {
-                if ( (suffixes[i]>initialSuffix)&&(suffixes[i]>lastS+1) )
-                    break;
-                lastS=suffixes[i];
-            }
-            newObjName=tt::generateNewName_noHash(baseName.c_str(),lastS+1+1);
-        }
+            newObjName=_getFreeObjectName(newObjName,false);
         // Following was too slow with many objects:
         //      while (getObject(newObjName)!=nullptr)
         //          newObjName=tt::generateNewName_noHash(newObjName);
@@ -127,31 +137,7 @@ bool CSceneObjectContainer::addObjectToSceneWithSuffixOffset(CSceneObject* newOb
     // Same but with the alt object names:
     std::string newObjAltName=newObject->getObjectAltName();
     if (getObjectFromAltName(newObjAltName.c_str())!=nullptr)
-    {
-        // Following faster with many objects:
-        std::string baseAltName(tt::getNameWithoutSuffixNumber(newObjAltName.c_str(),false));
-        int initialSuffix=tt::getNameSuffixNumber(newObjAltName.c_str(),false);
-        std::vector<int> suffixes;
-        std::vector<int> dummyValues;
-        for (size_t i=0;i<getObjectCount();i++)
-        {
-            std::string baseAltNameIt(tt::getNameWithoutSuffixNumber(getObjectFromIndex(i)->getObjectAltName().c_str(),false));
-            if (baseAltName.compare(baseAltNameIt)==0)
-            {
-                suffixes.push_back(tt::getNameSuffixNumber(getObjectFromIndex(i)->getObjectAltName().c_str(),false));
-                dummyValues.push_back(0);
-            }
-        }
-        tt::orderAscending(suffixes,dummyValues);
-        int lastS=-1;
-        for (size_t i=0;i<suffixes.size();i++)
-        {
-            if ( (suffixes[i]>initialSuffix)&&(suffixes[i]>lastS+1) )
-                break;
-            lastS=suffixes[i];
-        }
-        newObjAltName=tt::generateNewName_noHash(baseAltName.c_str(),lastS+1+1);
-    }
+        newObjAltName=_getFreeObjectName(newObjAltName,true);
     // Following was too slow with many objects:
     //      while (getObjectFromAltName(newObjAltName)!=nullptr)
     //          newObjAltName=tt::generateNewName_noHash(newObjAltName);
@@ -177,6 +163,8 @@ bool CSceneObjectContainer::addObjectToSceneWithSuffixOffset(CSceneObject* newOb
     // Update the object name and alt name index:
     _objectNameMap[newObject->getObjectName()]=handle;
     _objectAltNameMap[newObject->getObjectAltName()]=handle;
+    _addToNameSuffixIndex(newObject->getObjectName(),false);
+    _addToNameSuffixIndex(newObject->getObjectAltName(),true);
 
     if (newObject->getObjectType()==sim_object_graph_type)
     { // If the simulation is running, we have to empty the buffer!!! (otherwise we might have old and new data mixed together (e.g. old data in future, new data in present!)
@@ -186,24 +174,64 @@ bool CSceneObjectContainer::addObjectToSceneWithSuffixOffset(CSceneObject* newOb
             graph->resetGraph();
         }
     }
+}
 
-    // Actualize the object information
-    actualizeObjectInformation();
-    if (generateAfterCreateCallback)
+std::string CSceneObjectContainer::_getFreeObjectName(const std::string& name,bool altName) const
+{ // Same result as scanning all objects for the same base name, but via the suffix index
+    std::string baseName(tt::getNameWithoutSuffixNumber(name.c_str(),false));
+    int initialSuffix=tt::getNameSuffixNumber(name.c_str(),false);
+    int lastS=-1;
+    const std::map<std::string,std::multiset<int> >* index=&_objectNameSuffixes;
+    if (altName)
+        index=&_objectAltNameSuffixes;
+    std::map<std::string,std::multiset<int> >::const_iterator it=index->find(baseName);
+    if (it!=index->end())
     {
-        CInterfaceStack stack;
-        stack.pushTableOntoStack();
-        stack.pushStringOntoStack("objectHandles",0);
-        stack.pushTableOntoStack();
-        stack.pushNumberOntoStack(double(1)); // key or index
-        stack.pushNumberOntoStack(newObject->getObjectHandle());
-        stack.insertDataIntoStackTable();
-        stack.insertDataIntoStackTable();
-        App::worldContainer->callScripts(sim_syscb_aftercreate,&stack);
+        const std::multiset<int>& suffixes=it->second;
+        // Suffixes up to the initial suffix never stop the search:
+        std::multiset<int>::const_iterator sIt=suffixes.upper_bound(initialSuffix);
+        if (sIt!=suffixes.begin())
+        {
+            std::multiset<int>::const_iterator prev=sIt;
+            --prev;
+            lastS=*prev;
+        }
+        // Then the first gap is free:
+        while ( (sIt!=suffixes.end())&&(*sIt<=lastS+1) )
+        {
+            lastS=*sIt;
+            ++sIt;
+        }
     }
-    App::worldContainer->setModificationFlag(2); // object created
+    return(tt::generateNewName_noHash(baseName.c_str(),lastS+1+1));
+}
 
-    return(true);
+void CSceneObjectContainer::_addToNameSuffixIndex(const std::string& name,bool altName)
+{
+    std::string baseName(tt::getNameWithoutSuffixNumber(name.c_str(),false));
+    int suffix=tt::getNameSuffixNumber(name.c_str(),false);
+    if (altName)
+        _objectAltNameSuffixes[baseName].insert(suffix);
+    else
+        _objectNameSuffixes[baseName].insert(suffix);
+}
+
+void CSceneObjectContainer::_removeFromNameSuffixIndex(const std::string& name,bool altName)
+{
+    std::string baseName(tt::getNameWithoutSuffixNumber(name.c_str(),false));
+    int suffix=tt::getNameSuffixNumber(name.c_str(),false);
+    std::map<std::string,std::multiset<int> >* index=&_objectNameSuffixes;
+    if (altName)
+        index=&_objectAltNameSuffixes;
+    std::map<std::string,std::multiset<int> >::iterator it=index->find(baseName);
+    if (it!=index->end())
+    {
+        std::multiset<int>::iterator sIt=it->second.find(suffix);
+        if (sIt!=it->second.end())
+            it->second.erase(sIt);
+        if (it->second.size()==0)
+            index->erase(it);
+    }
 }
 
 bool CSceneObjectContainer::eraseObject(CSceneObject* it,bool generateBeforeAfterDeleteCallback)
@@ -237,6 +265,8 @@ bool CSceneObjectContainer::eraseObject(CSceneObject* it,bool generateBeforeAfte
     _objectNameMap.erase(mapIt);
     mapIt=_objectAltNameMap.find(it->getObjectAltName());
     _objectAltNameMap.erase(mapIt);
+    _removeFromNameSuffixIndex(it->getObjectName(),false);
+    _removeFromNameSuffixIndex(it->getObjectAltName(),true);
 
     _removeObject(it->getObjectHandle());
 
@@ -409,23 +439,25 @@ void CSceneObjectContainer::actualizeObjectInformation()
                 _forceSensorList.push_back(getObjectFromIndex(i)->getObjectHandle());
         }
         // We actualize the direct linked joint list of each joint: (2009-01-27)
+        // Dependent joints are first grouped by master joint, in joint list order
+        std::map<int,std::vector<CJoint*> > dependentJoints;
         for (size_t i=0;i<_jointList.size();i++)
         {
-            CJoint* it=getJointFromHandle(_jointList[i]);
-            std::vector<CJoint*> joints;
-            for (size_t j=0;j<_jointList.size();j++)
+            CJoint* anAct=getJointFromHandle(_jointList[i]);
+            if ((anAct->getJointMode()==sim_jointmode_dependent)||(anAct->getJointMode()==sim_jointmode_reserved_previously_ikdependent))
             {
-                CJoint* anAct=getJointFromHandle(_jointList[j]);
-                if (anAct!=it)
-                {
-                    if ((anAct->getJointMode()==sim_jointmode_dependent)||(anAct->getJointMode()==sim_jointmode_reserved_previously_ikdependent))
-                    {
-                        if (anAct->getDependencyMasterJointHandle()==it->getObjectHandle())
-                            joints.push_back(anAct);
-                    }
-                }
+                if (anAct->getDependencyMasterJointHandle()!=anAct->getObjectHandle())
+                    dependentJoints[anAct->getDependencyMasterJointHandle()].push_back(anAct);
             }
-            it->setDirectDependentJoints(joints);
+        }
+        for (size_t i=0;i<_jointList.size();i++)
+        {
+            CJoint* it=getJointFromHandle(_jointList[i]);
+            std::map<int,std::vector<CJoint*> >::iterator depIt=dependentJoints.find(it->getObjectHandle());
+            if (depIt!=dependentJoints.end())
+                it->setDirectDependentJoints(depIt->second);
+            else
+                it->setDirectDependentJoints(std::vector<CJoint*>());
         }
 
         // We rebuild the collection information
@@ -1189,12 +1221,16 @@ void CSceneObjectContainer::objectWasRenamed(int objectHandle,const char* oldNam
         std::map<std::string,int>::iterator mapIt=_objectAltNameMap.find(oldName);
         _objectAltNameMap.erase(mapIt);
         _objectAltNameMap[newName]=objectHandle;
+        _removeFromNameSuffixIndex(oldName,true);
+        _addToNameSuffixIndex(newName,true);
     }
     else
     {
         std::map<std::string,int>::iterator mapIt=_objectNameMap.find(oldName);
         _objectNameMap.erase(mapIt);
         _objectNameMap[newName]=objectHandle;
+        _removeFromNameSuffixIndex(oldName,false);
+        _addToNameSuffixIndex(newName,false);
     }
 }
 
@@ -14,6 +14,7 @@
 #include "sceneObject.h"
 #include "jointObject.h"
 #include "_sceneObjectContainer_.h"
+#include <set>
 
 struct SSimpleXmlSceneObject
 {
@@ -47,6 +48,7 @@ public:
 
     bool addObjectToScene(CSceneObject* newObject,bool objectIsACopy,bool generateAfterCreateCallback);
     bool addObjectToSceneWithSuffixOffset(CSceneObject* newObject,bool objectIsACopy,int suffixOffset,bool generateAfterCreateCallback);
+    bool addObjectsToSceneWithSuffixOffset(const std::vector<CSceneObject*>& newObjects,bool objectIsACopy,int suffixOffset,bool generateAfterCreateCallback);
     bool eraseObject(CSceneObject* it,bool generateBeforeAfterDeleteCallback);
     void eraseSeveralObjects(const std::vector<CSceneObject*>& objects,bool generateBeforeAfterDeleteCallback);
     void eraseSeveralObjects(const std::vector<int>& objectHandles,bool generateBeforeAfterDeleteCallback);
@@ -215,11 +217,18 @@ private:
     void _writeSimpleXmlShape(CSer& ar,CShape* shape);
     void _writeSimpleXmlSimpleShape(CSer& ar,const char* originalShapeName,CShape* shape,const C7Vector& frame);
 
+    void _addObjectToScene(CSceneObject* newObject,bool objectIsACopy,int suffixOffset);
+    std::string _getFreeObjectName(const std::string& name,bool altName) const;
+    void _addToNameSuffixIndex(const std::string& name,bool altName);
+    void _removeFromNameSuffixIndex(const std::string& name,bool altName);
+
     bool _objectActualizationEnabled;
     int _nextObjectHandle;
 
     std::map<std::string,int> _objectNameMap;
     std::map<std::string,int> _objectAltNameMap;
+    std::map<std::string,std::multiset<int> > _objectNameSuffixes; // base name --> suffixes in use
+    std::map<std::string,std::multiset<int> > _objectAltNameSuffixes;
 
     std::vector<int> _orphanList;
 
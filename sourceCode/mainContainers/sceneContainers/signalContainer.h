@@ -1,6 +1,135 @@
 #pragma once
 
-class CSignalContainer 
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+template<class T>
+class CSignalMap
+{   // One hashed entry per signal name, plus a dense list (for index-based access) and
+    // a reverse index creatorHandle --> signals. All operations are O(1) (except clearAll)
+public:
+    CSignalMap() {}
+    virtual ~CSignalMap() {}
+
+    void set(const char* signalName,const T& value,int creatorHandle)
+    {
+        _key.assign(signalName);
+        auto it=_signals.find(_key);
+        if (it==_signals.end())
+        {
+            it=_signals.emplace(_key,SSignal()).first;
+            SSignal& sig=it->second;
+            sig.value=value;
+            sig.creatorHandle=creatorHandle;
+            sig.name=&it->first;
+            sig.orderedIndex=_ordered.size();
+            _ordered.push_back(&sig);
+            std::vector<SSignal*>& cr=_byCreator[creatorHandle];
+            sig.creatorIndex=cr.size();
+            cr.push_back(&sig);
+        }
+        else
+            it->second.value=value;
+    }
+
+    const T* get(const char* signalName)
+    {
+        _key.assign(signalName);
+        auto it=_signals.find(_key);
+        if (it==_signals.end())
+            return(nullptr);
+        return(&it->second.value);
+    }
+
+    bool getNameAtIndex(int index,std::string& signalName) const
+    {
+        if ( (index<0)||(index>=int(_ordered.size())) )
+            return(false);
+        signalName=_ordered[index]->name[0];
+        return(true);
+    }
+
+    int clear(const char* signalName)
+    {
+        _key.assign(signalName);
+        auto it=_signals.find(_key);
+        if (it==_signals.end())
+            return(0);
+        _unlink(it->second);
+        _signals.erase(it);
+        return(1);
+    }
+
+    int clearAll()
+    {
+        int retVal=int(_ordered.size());
+        _signals.clear();
+        _ordered.clear();
+        _byCreator.clear();
+        return(retVal);
+    }
+
+    int clearFromCreator(int creatorHandle)
+    {
+        auto cr=_byCreator.find(creatorHandle);
+        if (cr==_byCreator.end())
+            return(0);
+        std::vector<SSignal*> sigs;
+        sigs.swap(cr->second);
+        _byCreator.erase(cr);
+        for (size_t i=0;i<sigs.size();i++)
+        {
+            SSignal* sig=sigs[i];
+            _removeFromOrdered(sig);
+            _signals.erase(sig->name[0]); // sig is invalid from here on
+        }
+        return(int(sigs.size()));
+    }
+
+    size_t getCount() const
+    {
+        return(_ordered.size());
+    }
+
+private:
+    struct SSignal
+    {
+        T value;
+        int creatorHandle;
+        const std::string* name; // points to the key in _signals (node-based, thus stable)
+        size_t orderedIndex;
+        size_t creatorIndex;
+    };
+
+    void _removeFromOrdered(SSignal* sig)
+    {   // swap with last, then pop
+        SSignal* last=_ordered[_ordered.size()-1];
+        _ordered[sig->orderedIndex]=last;
+        last->orderedIndex=sig->orderedIndex;
+        _ordered.pop_back();
+    }
+
+    void _unlink(SSignal& sig)
+    {
+        _removeFromOrdered(&sig);
+        auto cr=_byCreator.find(sig.creatorHandle);
+        std::vector<SSignal*>& v=cr->second;
+        SSignal* last=v[v.size()-1];
+        v[sig.creatorIndex]=last;
+        last->creatorIndex=sig.creatorIndex;
+        v.pop_back();
+        if (v.size()==0)
+            _byCreator.erase(cr);
+    }
+
+    std::unordered_map<std::string,SSignal> _signals;
+    std::vector<SSignal*> _ordered;
+    std::unordered_map<int,std::vector<SSignal*> > _byCreator;
+    std::string _key; // reused for lookups, avoids an allocation per call
+};
+
+class CSignalContainer
 {
 public:
     CSignalContainer();
@@ -33,25 +162,14 @@ public:
     int clearStringSignal(const char* signalName);
     int clearAllStringSignals();
 
+    // Batched versions. signalType: 0=int, 1=float, 2=string, 3=double (same as for simGetSignalName)
+    // For strings, values is a const char* const* (set) or a std::string* (get). Lengths can be nullptr (set only)
+    int setSignals(int signalType,int signalCount,const char* const* signalNames,const void* values,const int* stringLengths,int creatorHandle);
+    int getSignals(int signalType,int signalCount,const char* const* signalNames,void* values,char* present);
+
 protected:
-    int _getIntegerSignalIndex(const char* signalName);
-    int _getFloatSignalIndex(const char* signalName);
-    int _getDoubleSignalIndex(const char* signalName);
-    int _getStringSignalIndex(const char* signalName);
-
-    std::vector<std::string> _intSignalNames;
-    std::vector<int> _intSignalValues;
-    std::vector<int> _intSignalCreatorHandles;
-
-    std::vector<std::string> _floatSignalNames;
-    std::vector<float> _floatSignalValues;
-    std::vector<int> _floatSignalCreatorHandles;
-
-    std::vector<std::string> _doubleSignalNames;
-    std::vector<double> _doubleSignalValues;
-    std::vector<int> _doubleSignalCreatorHandles;
-
-    std::vector<std::string> _stringSignalNames;
-    std::vector<std::string> _stringSignalValues;
-    std::vector<int> _stringSignalCreatorHandles;
+    CSignalMap<int> _intSignals;
+    CSignalMap<float> _floatSignals;
+    CSignalMap<double> _doubleSignals;
+    CSignalMap<std::string> _stringSignals;
 };
@@ -7,6 +7,7 @@
 
 CTextureContainer::CTextureContainer()
 {
+    _nextObjectId=SIM_IDSTART_TEXTURE;
 }
 
 CTextureContainer::~CTextureContainer()
@@ -16,21 +17,17 @@ CTextureContainer::~CTextureContainer()
 
 CTextureObject* CTextureContainer::getObject(int objectID)
 {
-    for (size_t i=0;i<_allTextureObjects.size();i++)
-    {
-        if (_allTextureObjects[i]->getObjectID()==objectID)
-            return(_allTextureObjects[i]);
-    }
+    std::unordered_map<int,CTextureObject*>::const_iterator it=_objectsFromId.find(objectID);
+    if (it!=_objectsFromId.end())
+        return(it->second);
     return(nullptr);
 }
 
 CTextureObject* CTextureContainer::getObject(const char* objectName)
 {
-    for (int i=0;i<int(_allTextureObjects.size());i++)
-    {
-        if (_allTextureObjects[i]->getObjectName()==objectName)
-            return(_allTextureObjects[i]);
-    }
+    std::unordered_map<std::string,CTextureObject*>::const_iterator it=_objectsFromName.find(objectName);
+    if (it!=_objectsFromName.end())
+        return(it->second);
     return(nullptr);
 }
 
@@ -97,6 +94,7 @@ void CTextureContainer::setSuffix1ToSuffix2(int suffix1,int suffix2)
             _allTextureObjects[i]->setObjectName(tt::generateNewName_hash(name1.c_str(),suffix2+1).c_str());
         }
     }
+    _rebuildNameIndex();
 }
 
 int CTextureContainer::addObject(CTextureObject* anObject,bool objectIsACopy)
@@ -118,37 +116,147 @@ int CTextureContainer::addObjectWithSuffixOffset(CTextureObject* anObject,bool o
         return(theOldData->getObjectID());
     }
 
-    int newID=SIM_IDSTART_TEXTURE;
-    while (getObject(newID)!=nullptr)
-        newID++;
+    int newID=_getFreeObjectId();
     anObject->setObjectID(newID);
-    std::string newName(anObject->getObjectName());
-    while (getObject(newName.c_str())!=nullptr)
-    {
-        // TEXTURE OBJECTS SHOULDn'T HAVE A HASHED NAME!!
-        newName=tt::generateNewName_noHash(newName.c_str());
-    }
-    anObject->setObjectName(newName.c_str());
+    // TEXTURE OBJECTS SHOULDn'T HAVE A HASHED NAME!!
+    anObject->setObjectName(_getFreeObjectName(anObject->getObjectName().c_str()).c_str());
     _allTextureObjects.push_back(anObject);
+    _addToIndices(anObject);
     return(newID);
 }
 
 CTextureObject* CTextureContainer::_getEquivalentTextureObject(CTextureObject *theData)
 {
-    for (size_t i=0;i<_allTextureObjects.size();i++)
+    _updateContentHashIndex();
+    unsigned long long int hash=theData->getContentHash();
+    std::pair<std::unordered_multimap<unsigned long long int,CTextureObject*>::const_iterator,std::unordered_multimap<unsigned long long int,CTextureObject*>::const_iterator> range=_objectsFromContentHash.equal_range(hash);
+    for (std::unordered_multimap<unsigned long long int,CTextureObject*>::const_iterator it=range.first;it!=range.second;it++)
     {
-        if (_allTextureObjects[i]->isSame(theData))
-            return(_allTextureObjects[i]);
+        if (it->second->isSame(theData))
+            return(it->second);
     }
     return(nullptr);
 }
 
+int CTextureContainer::_getFreeObjectId()
+{ // the smallest unused id
+    int retVal;
+    if (_freeObjectIds.size()>0)
+    {
+        retVal=*_freeObjectIds.begin();
+        _freeObjectIds.erase(_freeObjectIds.begin());
+    }
+    else
+        retVal=_nextObjectId++;
+    return(retVal);
+}
+
+std::string CTextureContainer::_getFreeObjectName(const char* desiredName)
+{ // same result as incrementing the suffix until the name is free
+    std::string retVal(desiredName);
+    if (getObject(retVal.c_str())!=nullptr)
+    {
+        std::string nameWithoutSuffix(tt::getNameWithoutSuffixNumber(desiredName,false));
+        int suffix=tt::getNameSuffixNumber(desiredName,false)+1;
+        std::unordered_map<std::string,int>::const_iterator it=_nameSuffixHints.find(nameWithoutSuffix);
+        if ( (it!=_nameSuffixHints.end())&&(suffix<it->second) )
+            suffix=it->second; // names in-between are all in use
+        retVal=tt::generateNewName_noHash(nameWithoutSuffix.c_str(),suffix+1);
+        while (getObject(retVal.c_str())!=nullptr)
+        {
+            suffix++;
+            retVal=tt::generateNewName_noHash(nameWithoutSuffix.c_str(),suffix+1);
+        }
+    }
+    return(retVal);
+}
+
+void CTextureContainer::_addToIndices(CTextureObject* it)
+{ // it was just added at the end of _allTextureObjects
+    _objectsFromId[it->getObjectID()]=it;
+    _objectsFromName[it->getObjectName()]=it;
+    unsigned long long int hash=it->getContentHash();
+    _objectsFromContentHash.insert(std::make_pair(hash,it));
+    _indexedContentIds.push_back(it->getCurrentTextureContentUniqueId());
+    _indexedContentHashes.push_back(hash);
+
+    std::string nameWithoutSuffix(tt::getNameWithoutSuffixNumber(it->getObjectName().c_str(),false));
+    int hint=-1;
+    std::unordered_map<std::string,int>::const_iterator hintIt=_nameSuffixHints.find(nameWithoutSuffix);
+    if (hintIt!=_nameSuffixHints.end())
+        hint=hintIt->second;
+    while (getObject(tt::generateNewName_noHash(nameWithoutSuffix.c_str(),hint+1).c_str())!=nullptr)
+        hint++;
+    _nameSuffixHints[nameWithoutSuffix]=hint;
+}
+
+void CTextureContainer::_removeFromIndices(size_t index)
+{
+    CTextureObject* it=_allTextureObjects[index];
+    int id=it->getObjectID();
+    _objectsFromId.erase(id);
+    if (id==_nextObjectId-1)
+        _nextObjectId--;
+    else
+        _freeObjectIds.insert(id);
+    while ( (_freeObjectIds.size()>0)&&(*_freeObjectIds.rbegin()==_nextObjectId-1) )
+    {
+        _freeObjectIds.erase(_nextObjectId-1);
+        _nextObjectId--;
+    }
+    _objectsFromName.erase(it->getObjectName());
+    std::string nameWithoutSuffix(tt::getNameWithoutSuffixNumber(it->getObjectName().c_str(),false));
+    std::unordered_map<std::string,int>::iterator hintIt=_nameSuffixHints.find(nameWithoutSuffix);
+    if (hintIt!=_nameSuffixHints.end())
+        hintIt->second=std::min<int>(hintIt->second,tt::getNameSuffixNumber(it->getObjectName().c_str(),false));
+    _removeFromContentHashIndex(_indexedContentHashes[index],it);
+    _indexedContentIds.erase(_indexedContentIds.begin()+index);
+    _indexedContentHashes.erase(_indexedContentHashes.begin()+index);
+}
+
+void CTextureContainer::_removeFromContentHashIndex(unsigned long long int hash,CTextureObject* it)
+{
+    std::pair<std::unordered_multimap<unsigned long long int,CTextureObject*>::iterator,std::unordered_multimap<unsigned long long int,CTextureObject*>::iterator> range=_objectsFromContentHash.equal_range(hash);
+    for (std::unordered_multimap<unsigned long long int,CTextureObject*>::iterator itr=range.first;itr!=range.second;itr++)
+    {
+        if (itr->second==it)
+        {
+            _objectsFromContentHash.erase(itr);
+            break;
+        }
+    }
+}
+
+void CTextureContainer::_updateContentHashIndex()
+{ // textures can be written to after insertion (e.g. simWriteTexture). Only those are rehashed
+    for (size_t i=0;i<_allTextureObjects.size();i++)
+    {
+        CTextureObject* it=_allTextureObjects[i];
+        if (it->getCurrentTextureContentUniqueId()!=_indexedContentIds[i])
+        {
+            _removeFromContentHashIndex(_indexedContentHashes[i],it);
+            _indexedContentHashes[i]=it->getContentHash();
+            _indexedContentIds[i]=it->getCurrentTextureContentUniqueId();
+            _objectsFromContentHash.insert(std::make_pair(_indexedContentHashes[i],it));
+        }
+    }
+}
+
+void CTextureContainer::_rebuildNameIndex()
+{
+    _objectsFromName.clear();
+    _nameSuffixHints.clear();
+    for (size_t i=0;i<_allTextureObjects.size();i++)
+        _objectsFromName[_allTextureObjects[i]->getObjectName()]=_allTextureObjects[i];
+}
+
 void CTextureContainer::removeObject(int objectID)
 {
     for (size_t i=0;i<_allTextureObjects.size();i++)
     {
         if (_allTextureObjects[i]->getObjectID()==objectID)
         {
+            _removeFromIndices(i);
             delete _allTextureObjects[i];
             _allTextureObjects.erase(_allTextureObjects.begin()+i);
             App::setFullDialogRefreshFlag();
@@ -192,11 +300,9 @@ void CTextureContainer::announceGeneralObjectWillBeErased(int generalObjectID,in
 
 int CTextureContainer::getSameObjectID(CTextureObject* anObject)
 {
-    for (int i=0;i<int(_allTextureObjects.size());i++)
-    {
-        if (_allTextureObjects[i]->isSame(anObject))
-            return(_allTextureObjects[i]->getObjectID());
-    }   
+    CTextureObject* it=_getEquivalentTextureObject(anObject);
+    if (it!=nullptr)
+        return(it->getObjectID());
     return(-1);
 }
 
@@ -205,6 +311,14 @@ void CTextureContainer::removeAllObjects()
     for (int i=0;i<int(_allTextureObjects.size());i++)
         delete _allTextureObjects[i];
     _allTextureObjects.clear();
+    _objectsFromId.clear();
+    _objectsFromName.clear();
+    _objectsFromContentHash.clear();
+    _indexedContentIds.clear();
+    _indexedContentHashes.clear();
+    _freeObjectIds.clear();
+    _nextObjectId=SIM_IDSTART_TEXTURE;
+    _nameSuffixHints.clear();
 }
 
 void CTextureContainer::storeTextureObject(CSer& ar,CTextureObject* it)
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "textureObject.h"
+#include <unordered_map>
+#include <set>
 
 class CTextureContainer 
 {
@@ -31,4 +33,20 @@ public:
     std::vector<CTextureObject*> _allTextureObjects;
 protected:
     CTextureObject* _getEquivalentTextureObject(CTextureObject* theData);
+    int _getFreeObjectId();
+    std::string _getFreeObjectName(const char* desiredName);
+    void _addToIndices(CTextureObject* it);
+    void _removeFromIndices(size_t index);
+    void _removeFromContentHashIndex(unsigned long long int hash,CTextureObject* it);
+    void _updateContentHashIndex();
+    void _rebuildNameIndex();
+
+    std::unordered_map<int,CTextureObject*> _objectsFromId;
+    std::unordered_map<std::string,CTextureObject*> _objectsFromName;
+    std::unordered_multimap<unsigned long long int,CTextureObject*> _objectsFromContentHash;
+    std::vector<unsigned int> _indexedContentIds; // same order as _allTextureObjects. Textures can be modified after insertion
+    std::vector<unsigned long long int> _indexedContentHashes; // same order as _allTextureObjects
+    std::set<int> _freeObjectIds; // unused ids below _nextObjectId
+    int _nextObjectId;
+    std::unordered_map<std::string,int> _nameSuffixHints; // for a name without suffix: all suffixes below that one are in use
 };
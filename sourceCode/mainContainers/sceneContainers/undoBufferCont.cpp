@@ -16,6 +16,7 @@ CUndoBufferCont::~CUndoBufferCont()
     for (size_t i=0;i<_buffers.size();i++)
         delete _buffers[i];
     undoBufferArrays.clearAll();
+    undoBufferBlocks.clearAll();
 }
 
 int CUndoBufferCont::getNextBufferId()
@@ -35,6 +36,7 @@ void CUndoBufferCont::_commonInit()
         delete _buffers[i];
     _buffers.clear();
     undoBufferArrays.clearAll();
+    undoBufferBlocks.clearAll();
     _announceChangeStartCalled=false;
     _announceChangeGradualCalledTime=-1;
     _sceneSaveMightBeNeeded=false;
@@ -122,8 +124,7 @@ void CUndoBufferCont::emptyRedoBuffer()
     TRACE_INTERNAL;
     while (int(_buffers.size())>_currentStateIndex+1)
     {
-        undoBufferArrays.removeDependenciesFromUndoBufferId(_buffers[_buffers.size()-1]->getBufferId());
-        delete _buffers[_buffers.size()-1];
+        _deleteBuffer(_buffers[_buffers.size()-1]);
         _buffers.pop_back();
         App::setToolbarRefreshFlag();
     }
@@ -160,6 +161,7 @@ bool CUndoBufferCont::memorizeState()
     std::vector<char> newBuff;
     CSer serObj(newBuff,CSer::filetype_csim_bin_scene_buff);
     serObj.disableCountingModeExceptForExceptions();
+    serObj.enableBlockMarks();
 
     serObj.writeOpenBinary(false); // we don't wanna compression
     _undoPointSavingOrRestoringUnderWay=true;
@@ -168,9 +170,25 @@ bool CUndoBufferCont::memorizeState()
     App::currentWorld->saveScene(serObj); // This takes the 90% of time of the whole routine
     cameraBuffers->releaseCameras();
     _undoPointSavingOrRestoringUnderWay=false;
+    std::vector<size_t> blockMarks(serObj.getBlockMarks()->begin(),serObj.getBlockMarks()->end());
+    size_t dataSize=serObj.getFileBuffer()->size();
     serObj.writeClose();
 
-    CUndoBuffer* it=new CUndoBuffer(newBuff,_nextBufferId++,cameraBuffers);
+    // Split the buffer into blocks (header, then one block per top-level item, e.g. per scene object).
+    // Blocks are content-addressed, i.e. unchanged items are shared with other undo points:
+    size_t headerSize=newBuff.size()-dataSize;
+    blockMarks.push_back(dataSize);
+    std::vector<int> blockIds;
+    size_t blockStart=0;
+    for (size_t i=0;i<blockMarks.size();i++)
+    {
+        size_t blockEnd=headerSize+blockMarks[i];
+        if (blockEnd>blockStart)
+            blockIds.push_back(undoBufferBlocks.addBlock(&newBuff[blockStart],blockEnd-blockStart));
+        blockStart=blockEnd;
+    }
+
+    CUndoBuffer* it=new CUndoBuffer(blockIds,_nextBufferId++,cameraBuffers);
     if (_currentStateIndex==-1)
     { // first buffer, we just add it
         _buffers.push_back(it);
@@ -178,14 +196,11 @@ bool CUndoBufferCont::memorizeState()
     }
     else
     { // We check with previous buffer:
-        std::vector<char> prevBuff;
-        _getFullBuffer(_currentStateIndex,prevBuff);
-        if (it->finalize(prevBuff))
+        if (!it->isSameAs(_buffers[_currentStateIndex]))
         { // different from previous, we remove forward buffers and add this one:
             while (int(_buffers.size())>_currentStateIndex+1)
             {
-                undoBufferArrays.removeDependenciesFromUndoBufferId(_buffers[_buffers.size()-1]->getBufferId());
-                delete _buffers[_buffers.size()-1];
+                _deleteBuffer(_buffers[_buffers.size()-1]);
                 _buffers.pop_back();
             }
             _buffers.push_back(it);
@@ -193,22 +208,16 @@ bool CUndoBufferCont::memorizeState()
         }
         else
         {
-            undoBufferArrays.removeDependenciesFromUndoBufferId(it->getBufferId());
-            delete it; // same as previous, we delete it
+            _deleteBuffer(it); // same as previous, we delete it
             retVal=false;
         }
     }
 
-    std::vector<char> fullBuff;
     while ( (_getUsedMemory()+undoBufferArrays.getMemorySizeInBytes()>App::userSettings->undoRedoMaxBufferSize)||(int(_buffers.size())>App::userSettings->undoRedoLevelCount) )
-    { // We have to remove a few states at the beginning
+    { // We have to remove a few states at the beginning. Blocks still used by later states are kept
         if (int(_buffers.size())<3)
             break; // at least 3 states!
-        _getFullBuffer(1,fullBuff);
-        CUndoBuffer* it=_buffers[1];
-        it->updateWithFullBuffer(fullBuff);
-        undoBufferArrays.removeDependenciesFromUndoBufferId(_buffers[0]->getBufferId());
-        delete _buffers[0];
+        _deleteBuffer(_buffers[0]);
         _buffers.erase(_buffers.begin());
         _currentStateIndex--;
     }
@@ -431,29 +440,26 @@ CUndoBufferCameras* CUndoBufferCont::_getFullBuffer(int index,std::vector<char>&
         fullBuff.clear();
         return(nullptr);
     }
-    CUndoBufferCameras* retVal=nullptr;
-    if (index==0)
-    { // the first one
-        retVal=_buffers[index]->getCameraBuffers();
-        _buffers[index]->getRestored(nullptr,fullBuff);
-    }
-    else
-    {
-        std::vector<char> prevBuff;
-        _getFullBuffer(index-1,prevBuff);
-        retVal=_buffers[index]->getCameraBuffers();
-        _buffers[index]->getRestored(&prevBuff,fullBuff);
-    }
-    return(retVal);
+    fullBuff.clear();
+    const std::vector<int>* blockIds=_buffers[index]->getBlockIds();
+    for (size_t i=0;i<blockIds->size();i++)
+        undoBufferBlocks.appendBlock(blockIds->at(i),fullBuff);
+    return(_buffers[index]->getCameraBuffers());
 }
 
 int CUndoBufferCont::_getUsedMemory()
 {
     TRACE_INTERNAL;
-    int retVal=0;
-    for (size_t i=0;i<_buffers.size();i++)
-        retVal+=int(_buffers[i]->buffer.size());
-    return (retVal);
+    return(undoBufferBlocks.getMemorySizeInBytes());
+}
+
+void CUndoBufferCont::_deleteBuffer(CUndoBuffer* buffer)
+{
+    undoBufferArrays.removeDependenciesFromUndoBufferId(buffer->getBufferId());
+    const std::vector<int>* blockIds=buffer->getBlockIds();
+    for (size_t i=0;i<blockIds->size();i++)
+        undoBufferBlocks.releaseBlock(blockIds->at(i));
+    delete buffer;
 }
 
 void CUndoBufferCont::_rememberSelectionState()
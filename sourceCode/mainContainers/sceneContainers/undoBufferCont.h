@@ -2,9 +2,12 @@
 
 #include "undoBuffer.h"
 #include "undoBufferArrays.h"
+#include "undoBufferBlocks.h"
 
 class CUndoBufferCont
-{
+{ // Each undo point is a full scene save, and undo/redo reload the full scene. Only the storage is incremental:
+  // the save is split into per-object blocks (see CUndoBufferBlocks), and unchanged blocks are shared by all undo points.
+  // Saving or restoring single objects is not possible, since objects are serialized against scene-wide state (shared meshes, handles)
 public:
     CUndoBufferCont();
     virtual ~CUndoBufferCont();
@@ -30,10 +33,12 @@ public:
     int getNextBufferId();
 
     CUndoBufferArrays undoBufferArrays;
+    CUndoBufferBlocks undoBufferBlocks;
 
 private:
     CUndoBufferCameras* _getFullBuffer(int index,std::vector<char>& fullBuff);
     int _getUsedMemory();
+    void _deleteBuffer(CUndoBuffer* buffer);
     bool _isGoodToMemorizeUndoOrRedo();
     void _commonInit();
     void _rememberSelectionState();
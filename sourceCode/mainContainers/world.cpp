@@ -210,6 +210,8 @@ bool CWorld::loadScene(CSer& ar,bool forUndoRedoOperation)
             delete[] (char*)returnVal;
             App::worldContainer->setModificationFlag(8); // scene loaded
             outsideCommandQueue->addCommand(sim_message_scene_loaded,0,0,0,0,nullptr,0);
+            if (App::userSettings->calcStructPrebuild>=2)
+                _launchCalculationStructureBuilds();
         }
     }
     return(retVal);
@@ -572,6 +574,8 @@ bool CWorld::loadModel(CSer& ar,bool justLoadThumbnail,bool forceModelAsCopy,C7V
 
         outsideCommandQueue->addCommand(sim_message_model_loaded,0,0,0,0,nullptr,0); // only for Lua
         App::worldContainer->setModificationFlag(4); // model loaded
+        if (App::userSettings->calcStructPrebuild>=2)
+            _launchCalculationStructureBuilds();
     }
     return(retVal);
 }
@@ -772,14 +776,17 @@ void CWorld::addGeneralObjectsToWorldAndPerformMappings(std::vector<CSceneObject
 
     setEnableRemoteWorldsSync(false); // do not trigger object creation in plugins, etc. when adding objects to world
 
-    // We add all sceneObjects:
-    sceneObjects->enableObjectActualization(false);
+    // We add all sceneObjects (in one batch, the object information is actualized only once):
     std::vector<int> objectMapping;
     for (size_t i=0;i<loadedObjectList->size();i++)
     {
         objectMapping.push_back(loadedObjectList->at(i)->getObjectHandle()); // Old ID
-        sceneObjects->addObjectToSceneWithSuffixOffset(loadedObjectList->at(i),objectIsACopy,suffixOffset,false);
-        objectMapping.push_back(loadedObjectList->at(i)->getObjectHandle()); // New ID
+        objectMapping.push_back(-1); // New ID, see below
+    }
+    sceneObjects->addObjectsToSceneWithSuffixOffset(*loadedObjectList,objectIsACopy,suffixOffset,false);
+    for (size_t i=0;i<loadedObjectList->size();i++)
+    {
+        objectMapping[2*i+1]=loadedObjectList->at(i)->getObjectHandle(); // New ID
 
         if (loadedObjectList->at(i)->getObjectType()==sim_object_shape_type)
         {
@@ -812,8 +819,6 @@ void CWorld::addGeneralObjectsToWorldAndPerformMappings(std::vector<CSceneObject
         }
     }
     _prepareFastLoadingMapping(objectMapping);
-    sceneObjects->enableObjectActualization(true);
-    sceneObjects->actualizeObjectInformation();
 
     // Remove any material that was loaded from a previous file version, where materials were still shared (until V3.3.2)
     for (size_t i=0;i<loadedDynMaterialObjectList.size();i++)
@@ -2084,6 +2089,14 @@ void CWorld::_simulationAboutToStart()
     ikGroups->simulationAboutToStart();
     pathPlanning->simulationAboutToStart();
     simulation->simulationAboutToStart();
+    if (App::userSettings->calcStructPrebuild>=1)
+        _launchCalculationStructureBuilds();
+}
+
+void CWorld::_launchCalculationStructureBuilds()
+{ // shapes already built or being built are skipped
+    for (size_t i=0;i<sceneObjects->getShapeCount();i++)
+        sceneObjects->getShapeFromIndex(i)->launchMeshCalculationStructureBuild();
 }
 
 void CWorld::_simulationPaused()
@@ -124,6 +124,7 @@ private:
     void _simulationAboutToStep();
     void _simulationAboutToEnd();
     void _simulationEnded();
+    void _launchCalculationStructureBuilds();
 
     void _getMinAndMaxNameSuffixes(int& smallestSuffix,int& biggestSuffix) const;
     int _getSuffixOffsetForGeneralObjectToAdd(bool tempNames,std::vector<CSceneObject*>* loadedObjectList,
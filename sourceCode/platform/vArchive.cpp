@@ -31,6 +31,28 @@ void VArchive::writeString(const std::string& str)
         (*this) << str[i];
 }
 
+void VArchive::writeBytes(const unsigned char* data,size_t size)
+{
+#ifndef SIM_WITH_QT
+    _theFile->getFile()->write((const char*)data,size);
+#else
+    _theArchive->writeRawData((const char*)data,int(size));
+#endif
+}
+
+size_t VArchive::readBytes(unsigned char* data,size_t size)
+{
+#ifndef SIM_WITH_QT
+    _theFile->getFile()->read((char*)data,size);
+    return(size_t(_theFile->getFile()->gcount()));
+#else
+    int r=_theArchive->readRawData((char*)data,int(size));
+    if (r<0)
+        r=0;
+    return(size_t(r));
+#endif
+}
+
 void VArchive::writeLine(const std::string& line)
 {
     writeString(line);
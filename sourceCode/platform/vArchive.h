@@ -13,6 +13,8 @@ public:
 
     void writeLine(const std::string& line); // Will add char(10) and char(13)
     void writeString(const std::string& str); // Will not add char(10) or char(13)
+    void writeBytes(const unsigned char* data,size_t size);
+    size_t readBytes(unsigned char* data,size_t size); // returns the number of bytes read
     bool readSingleLine(unsigned int& actualPosition,std::string& line,bool doNotReplaceTabsWithOneSpace);
     bool readMultiLine(unsigned int& actualPosition,std::string& line,bool doNotReplaceTabsWithOneSpace,const char* multilineSeparator);
 
@@ -18,12 +18,13 @@ unsigned short VFile::CREATE_WRITE      =1;
 unsigned short VFile::SHARE_EXCLUSIVE   =2;
 unsigned short VFile::READ              =4;
 unsigned short VFile::SHARE_DENY_NONE   =8;
+unsigned short VFile::APPEND            =16;
 
 VFile::VFile(const char* filename,unsigned short flags,bool dontThrow)
 {
     _pathAndFilename=filename;
 #ifndef SIM_WITH_QT
-    if (flags&CREATE_WRITE)
+    if (flags&(CREATE_WRITE|APPEND))
     { // Create the path directories if needed
         std::string f(VVarious::splitPath_path(filename));
         if (!doesFolderExist(f.c_str()))
@@ -33,6 +34,8 @@ VFile::VFile(const char* filename,unsigned short flags,bool dontThrow)
     std::ios_base::openmode openFlags=std::ios_base::binary;
     if (flags&CREATE_WRITE)
         openFlags|=std::ios_base::out|std::ios_base::trunc;
+    if (flags&APPEND)
+        openFlags|=std::ios_base::out|std::ios_base::app;
     if (flags&READ)
         openFlags|=std::ios_base::in;
     _theFile=new WFile(filename,openFlags);
@@ -60,11 +63,13 @@ VFile::VFile(const char* filename,unsigned short flags,bool dontThrow)
     QFlags<QIODevice::OpenModeFlag> openFlags=0;
     if (flags&CREATE_WRITE)
         openFlags|=QIODevice::Truncate|QIODevice::WriteOnly;
+    if (flags&APPEND)
+        openFlags|=QIODevice::Append|QIODevice::WriteOnly;
     if (flags&READ)
         openFlags|=QIODevice::ReadOnly;
 
     // Create the path directories if needed (added on 13/6/2012 because of a bug report of Matthias F�ller):
-    if (flags&CREATE_WRITE)
+    if (flags&(CREATE_WRITE|APPEND))
     {
         QFileInfo pathInfo(QString::fromLocal8Bit(filename));
         QDir dir("");
@@ -35,6 +35,7 @@ public:
     static unsigned short SHARE_EXCLUSIVE;
     static unsigned short READ;
     static unsigned short SHARE_DENY_NONE;
+    static unsigned short APPEND; // creates the file if needed
 
 private:
     static bool _doesFileOrFolderExist(const char* filenameOrFoldernameAndPath,bool checkForFolder);
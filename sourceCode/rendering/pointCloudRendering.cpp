@@ -3,6 +3,36 @@
 #ifdef SIM_WITH_OPENGL
 #include "pluginContainer.h"
 
+void _drawPointCloudPoints(const float* pts,size_t ptsCnt,const std::vector<unsigned char>* cols,size_t firstColor,bool setOtherColor,bool emissive)
+{ // to be called between glBegin(GL_POINTS) and glEnd(). Colors are RGB8
+    if ((cols->size()==0)||setOtherColor)
+    {
+        for (size_t i=0;i<ptsCnt;i++)
+            glVertex3fv(pts+3*i);
+    }
+    else
+    {
+        const unsigned char* c=&(cols[0])[3*firstColor];
+        float col[4]={0.0,0.0,0.0,0.0};
+        if (emissive)
+        {
+            const float blk[4]={0.0,0.0,0.0,0.0};
+            glMaterialfv(GL_FRONT_AND_BACK,GL_AMBIENT_AND_DIFFUSE,blk);
+        }
+        for (size_t i=0;i<ptsCnt;i++)
+        {
+            col[0]=float(c[3*i+0])/255.0f;
+            col[1]=float(c[3*i+1])/255.0f;
+            col[2]=float(c[3*i+2])/255.0f;
+            if (emissive)
+                glMaterialfv(GL_FRONT_AND_BACK,GL_EMISSION,col);
+            else
+                glMaterialfv(GL_FRONT_AND_BACK,GL_AMBIENT_AND_DIFFUSE,col);
+            glVertex3fv(pts+3*i);
+        }
+    }
+}
+
 void displayPointCloud(CPointCloud* pointCloud,CViewableBase* renderingObject,int displayAttrib)
 {
     // At the beginning of every 3DObject display routine:
@@ -42,8 +72,7 @@ void displayPointCloud(CPointCloud* pointCloud,CViewableBase* renderingObject,in
 //      ogl::drawBox(size,size,size,false,normalVectorForLinesAndPoints.data);
 //      ogl::drawSphere(size/2.0f,12,6,false);
 
-        std::vector<float>& _points=pointCloud->getPoints()[0];
-        if (_points.size()>0)
+        if (pointCloud->getPointCount()>0)
         {
             bool setOtherColor=(App::currentWorld->collisions->getCollisionColor(pointCloud->getObjectHandle())!=0);
             for (size_t i=0;i<App::currentWorld->collections->getObjectCount();i++)
@@ -105,46 +134,23 @@ void displayPointCloud(CPointCloud* pointCloud,CViewableBase* renderingObject,in
 
 
             glPointSize(float(pointCloud->getPointSize()));
-            std::vector<float>* pts=&_points;
-            std::vector<float>* cols=pointCloud->getColors();
-            if (pointCloud->getDisplayPoints()->size()>0)
-            {
-                pts=pointCloud->getDisplayPoints();
-                cols=pointCloud->getDisplayColors();
-            }
-
-            if ((cols->size()==0)||setOtherColor)
-            {
-                glBegin(GL_POINTS);
-                glNormal3fv(normalVectorForLinesAndPoints.data);
-                for (size_t i=0;i<pts->size()/3;i++)
-                    glVertex3fv(&(pts[0])[3*i]);
-                glEnd();
-            }
+            const std::vector<unsigned char>* cols=pointCloud->getColors();
+            const std::vector<float>* displayPts=pointCloud->getDisplayPoints();
+            glBegin(GL_POINTS);
+            glNormal3fv(normalVectorForLinesAndPoints.data);
+            if (displayPts->size()>0)
+                _drawPointCloudPoints(&(displayPts[0])[0],displayPts->size()/3,pointCloud->getDisplayColors(),0,setOtherColor,pointCloud->getColorIsEmissive());
             else
-            {
-                glBegin(GL_POINTS);
-                glNormal3fv(normalVectorForLinesAndPoints.data);
-                if (pointCloud->getColorIsEmissive())
+            { // visit the points chunk by chunk. With quantized positions, only one chunk is expanded at a time
+                std::vector<float> buffer;
+                for (size_t i=0;i<pointCloud->getPointChunkCount();i++)
                 {
-                    const float blk[4]={0.0,0.0,0.0,0.0};
-                    glMaterialfv(GL_FRONT_AND_BACK,GL_AMBIENT_AND_DIFFUSE,blk);
-                    for (size_t i=0;i<pts->size()/3;i++)
-                    {
-                        glMaterialfv(GL_FRONT_AND_BACK,GL_EMISSION,&(cols[0])[4*i]);
-                        glVertex3fv(&(pts[0])[3*i]);
-                    }
+                    size_t first,cnt;
+                    const float* pts=pointCloud->getPointChunk(i,buffer,first,cnt);
+                    _drawPointCloudPoints(pts,cnt,cols,first,setOtherColor,pointCloud->getColorIsEmissive());
                 }
-                else
-                {
-                    for (size_t i=0;i<pts->size()/3;i++)
-                    {
-                        glMaterialfv(GL_FRONT_AND_BACK,GL_AMBIENT_AND_DIFFUSE,&(cols[0])[4*i]);
-                        glVertex3fv(&(pts[0])[3*i]);
-                    }
-                }
-                glEnd();
             }
+            glEnd();
             glPointSize(1.0);
         }
 
@@ -3,3 +3,4 @@
 #include "rendering.h"
 
 void displayPointCloud(CPointCloud* pointCloud,CViewableBase* renderingObject,int displayAttrib);
+void _drawPointCloudPoints(const float* pts,size_t ptsCnt,const std::vector<unsigned char>* cols,size_t firstColor,bool setOtherColor,bool emissive);
@@ -283,14 +283,19 @@ void CCamera::frameSceneOrSelectedObjects(float windowWidthByHeight,bool forPers
                 done=true;
                 CPointCloud* ptCloud=(CPointCloud*)it;
                 C7Vector trr(camTrInv*ptCloud->getFullCumulativeTransformation());
-                std::vector<float>* wvert=ptCloud->getPoints();
-                for (int j=0;j<int(wvert->size())/3;j++)
+                std::vector<float> buffer;
+                for (size_t k=0;k<ptCloud->getPointChunkCount();k++)
                 {
-                    C3Vector vq(&(wvert[0])[3*j+0]);
-                    vq*=trr;
-                    pts.push_back(vq(0));
-                    pts.push_back(vq(1));
-                    pts.push_back(vq(2));
+                    size_t first,cnt;
+                    const float* wvert=ptCloud->getPointChunk(k,buffer,first,cnt);
+                    for (size_t j=0;j<cnt;j++)
+                    {
+                        C3Vector vq(wvert+3*j);
+                        vq*=trr;
+                        pts.push_back(vq(0));
+                        pts.push_back(vq(1));
+                        pts.push_back(vq(2));
+                    }
                 }
             }
             if (it->getObjectType()==sim_object_octree_type)
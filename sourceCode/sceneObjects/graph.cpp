@@ -10,12 +10,16 @@
 #include "easyLock.h"
 #include "app.h"
 #include "graphRendering.h"
+#include <limits>
+#include <cmath>
 
 CGraph::CGraph()
 {
     setObjectType(sim_object_graph_type);
     justDrawCurves=false;
     _needsRefresh=true;
+    _recordToDisk=false;
+    _recorder=nullptr;
     _explicitHandling=true; // changed to true on 29.11.2020: graphs are not handled anymore by the main script since CoppeliaSim V4.2.0 on
     bufferSize=1000;
     numberOfPoints=0;
@@ -54,6 +58,7 @@ CGraph::CGraph()
 
 CGraph::~CGraph()
 {
+    delete _recorder;
     removeAllStreamsAndCurves();
 
     // Old:
@@ -450,6 +455,8 @@ bool CGraph::removeGraphDataStream(int id)
         {
             delete _dataStreams[i];
             _dataStreams.erase(_dataStreams.begin()+i);
+            if (_recorder!=nullptr)
+                _recorder->removeStream(id);
             retVal=true;
             break;
         }
@@ -587,8 +594,8 @@ void CGraph::addNextPoint(float time)
     int nextEntryPosition;
     if (numberOfPoints>=bufferSize)
     { // We reached the maximum of points
-        if (!cyclic)
-            return; // The buffer is not cyclic, we leave here
+        if ( (!cyclic)&&(!_recordToDisk) )
+            return; // The buffer is not cyclic, we leave here. When recording, the buffer just holds the most recent points
         else
         { // The buffer is cyclic
             nextEntryPosition=startingPoint;
@@ -608,6 +615,31 @@ void CGraph::addNextPoint(float time)
     for (size_t i=0;i<_dataStreams.size();i++)
         _dataStreams[i]->insertNextValue(nextEntryPosition,nextEntryPosition==startingPoint,times);
 
+    if (_recordToDisk)
+    { // we record the values as displayed
+        if (_recorder==nullptr)
+        {
+            std::string folder(App::userSettings->graphRecordingFolder);
+            if (folder.size()==0)
+                folder=App::folders->getOtherFilesPath();
+            _recorder=new CGraphRecorder(folder.c_str(),getObjectHandle());
+        }
+        std::vector<int> streamIds;
+        std::vector<float> values;
+        for (size_t i=0;i<_dataStreams.size();i++)
+        {
+            if (!_dataStreams[i]->getIsStatic())
+            {
+                float v;
+                if (!_dataStreams[i]->getTransformedValue(startingPoint,nextEntryPosition,v))
+                    v=std::numeric_limits<float>::quiet_NaN();
+                streamIds.push_back(_dataStreams[i]->getId());
+                values.push_back(v);
+            }
+        }
+        _recorder->addSample(time,streamIds,values);
+    }
+
     // Old:
     C7Vector m(getCumulativeTransformation());
     for (size_t i=0;i<dataStreams_old.size();i++)
@@ -691,6 +723,7 @@ CSceneObject* CGraph::copyYourself()
     newGraph->graphGrid=graphGrid;
     newGraph->graphValues=graphValues;
     newGraph->setExplicitHandling(getExplicitHandling());
+    newGraph->_recordToDisk=_recordToDisk; // the recorded data is not copied
 
     newGraph->_initialValuesInitialized=_initialValuesInitialized;
     newGraph->_initialExplicitHandling=_initialExplicitHandling;
@@ -953,6 +986,21 @@ bool CGraph::getExplicitHandling() const
     return(_explicitHandling);
 }
 
+void CGraph::setRecordToDisk(bool record)
+{ // already recorded data stays available until the graph is reset
+    _recordToDisk=record;
+}
+
+bool CGraph::getRecordToDisk() const
+{
+    return(_recordToDisk);
+}
+
+CGraphRecorder* CGraph::getRecorder() const
+{
+    return(_recorder);
+}
+
 CColorObject* CGraph::getColor()
 {
     return(&color);
@@ -1063,6 +1111,60 @@ void CGraph::exportGraphData(VArchive &ar)
     ar << (unsigned char)10;
 }
 
+int CGraph::exportRecordedData(VArchive &ar,float fromTime,float toTime,int maxRowCnt)
+{ // exports the data recorded to disk, decimated to maxRowCnt rows. Each row has the time, then the min, max and mean value of each stream. Returns the row count, or -1
+    if (_recorder==nullptr)
+        return(0);
+    std::vector<CGraphDataStream*> streams;
+    std::vector<int> streamIds;
+    for (size_t i=0;i<_dataStreams.size();i++)
+    {
+        if (!_dataStreams[i]->getIsStatic())
+        {
+            streams.push_back(_dataStreams[i]);
+            streamIds.push_back(_dataStreams[i]->getId());
+        }
+    }
+    std::vector<float> recTimes;
+    std::vector<std::vector<float> > minVals;
+    std::vector<std::vector<float> > maxVals;
+    std::vector<std::vector<float> > meanVals;
+    if (!_recorder->getDecimatedData(streamIds,fromTime,toTime,maxRowCnt,recTimes,minVals,maxVals,meanVals))
+        return(-1);
+
+    // The graph name:
+    ar.writeString(getObjectName());
+    ar << (unsigned char)13;
+    ar << (unsigned char)10;
+    // The first line:
+    std::string tmp("Time ("+gv::getTimeUnitStr()+")");
+    for (size_t k=0;k<streams.size();k++)
+    {
+        std::string nm(streams[k]->getStreamName()+" ("+streams[k]->getUnitStr()+")");
+        tmp+=","+nm+" min,"+nm+" max,"+nm+" mean";
+    }
+    ar.writeString(tmp);
+    ar << (unsigned char)13;
+    ar << (unsigned char)10;
+
+    // Now the data:
+    for (size_t i=0;i<recTimes.size();i++)
+    {
+        tmp=tt::FNb(0,recTimes[i],6,false);
+        for (size_t k=0;k<streams.size();k++)
+        {
+            if (std::isnan(minVals[k][i]))
+                tmp+=",Null,Null,Null";
+            else
+                tmp+=","+tt::FNb(0,minVals[k][i],6,false)+","+tt::FNb(0,maxVals[k][i],6,false)+","+tt::FNb(0,meanVals[k][i],6,false);
+        }
+        ar.writeString(tmp);
+        ar << (unsigned char)13;
+        ar << (unsigned char)10;
+    }
+    return(int(recTimes.size()));
+}
+
 bool CGraph::getGraphCurveData(int graphType,int index,std::string& label,std::vector<float>& xVals,std::vector<float>& yVals,int& curveType,float col[3],float minMax[6],int& curveId,int& curveWidth) const
 {
     if (graphType==0)
@@ -2030,6 +2132,8 @@ void CGraph::resetGraph()
         times.push_back(0.0f);
     for (size_t i=0;i<_dataStreams.size();i++)
         _dataStreams[i]->reset(bufferSize);
+    delete _recorder;
+    _recorder=nullptr;
     // Old:
     for (int i=0;i<int(dataStreams_old.size());i++)
         dataStreams_old[i]->resetData(bufferSize);
@@ -2158,6 +2262,7 @@ void CGraph::serialize(CSer& ar)
             SIM_SET_CLEAR_BIT(nothing,2,graphGrid);
             SIM_SET_CLEAR_BIT(nothing,3,graphValues);
             SIM_SET_CLEAR_BIT(nothing,4,_explicitHandling);
+            SIM_SET_CLEAR_BIT(nothing,5,_recordToDisk);
             ar << nothing;
             ar.flush();
 
@@ -2284,6 +2389,7 @@ void CGraph::serialize(CSer& ar)
                         graphGrid=SIM_IS_BIT_SET(nothing,2);
                         graphValues=SIM_IS_BIT_SET(nothing,3);
                         _explicitHandling=SIM_IS_BIT_SET(nothing,4);
+                        _recordToDisk=SIM_IS_BIT_SET(nothing,5);
                     }
 
                     if (noHit)
@@ -2344,6 +2450,7 @@ void CGraph::serialize(CSer& ar)
             ar.xmlAddNode_bool("showGrid",graphGrid);
             ar.xmlAddNode_bool("showValues",graphValues);
             ar.xmlAddNode_bool("explicitHandling",_explicitHandling);
+            ar.xmlAddNode_bool("recordToDisk",_recordToDisk);
             ar.xmlPopNode();
 
             if (exhaustiveXml)
@@ -2448,6 +2555,7 @@ void CGraph::serialize(CSer& ar)
                 ar.xmlGetNode_bool("showGrid",graphGrid,exhaustiveXml);
                 ar.xmlGetNode_bool("showValues",graphValues,exhaustiveXml);
                 ar.xmlGetNode_bool("explicitHandling",_explicitHandling,exhaustiveXml);
+                ar.xmlGetNode_bool("recordToDisk",_recordToDisk,false);
                 ar.xmlPopNode();
             }
 
@@ -2,6 +2,11 @@
 
 #include "graphDataStream.h"
 #include "graphCurve.h"
+#include "graphRecorder.h"
+
+#ifndef sim_graphintparam_recording
+#define sim_graphintparam_recording 10501 // not yet in simConst.h
+#endif
 
 // Old:
 #include "sceneObject.h"
@@ -93,6 +98,11 @@ public:
     int getNumberOfPoints() const;
 
     void exportGraphData(VArchive &ar);
+    int exportRecordedData(VArchive &ar,float fromTime,float toTime,int maxRowCnt);
+
+    void setRecordToDisk(bool record);
+    bool getRecordToDisk() const;
+    CGraphRecorder* getRecorder() const;
 
     void setExplicitHandling(bool explicitHandl);
     bool getExplicitHandling() const;
@@ -153,6 +163,8 @@ protected:
     int startingPoint;
     std::vector <float> times;
     bool _needsRefresh;
+    bool _recordToDisk;
+    CGraphRecorder* _recorder; // created with the first recorded point
 
     bool _initialExplicitHandling;
 
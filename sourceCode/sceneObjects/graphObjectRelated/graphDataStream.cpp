@@ -6,6 +6,7 @@ CGraphDataStream::CGraphDataStream()
 {
     _nextValueToInsertIsValid=false;
     _scriptHandle=-1;
+    _clearAveragedValueWindow();
 }
 
 CGraphDataStream::CGraphDataStream(const char* streamName,const char* unitStr,int options,const float* color,float cyclicRange,int scriptHandle)
@@ -14,6 +15,7 @@ CGraphDataStream::CGraphDataStream(const char* streamName,const char* unitStr,in
     setBasics(unitStr,options,color,cyclicRange,scriptHandle);
     setTransformation(sim_stream_transf_raw,1.0f,0.0f,1);
     _nextValueToInsertIsValid=false;
+    _clearAveragedValueWindow();
 }
 
 CGraphDataStream::~CGraphDataStream()
@@ -70,6 +72,11 @@ void CGraphDataStream::reset(size_t bufferSize)
         _valuesValidityFlags.resize(1+bufferSize/8,0);
         _transformedValuesValidityFlags.clear();
         _transformedValuesValidityFlags.resize(1+bufferSize/8,0);
+        _averagedValues.clear();
+        _averagedValues.resize(bufferSize,0.0f);
+        _averagedValuesValidityFlags.clear();
+        _averagedValuesValidityFlags.resize(1+bufferSize/8,0);
+        _clearAveragedValueWindow();
     }
     _nextValueToInsertIsValid=false;
 }
@@ -254,37 +261,138 @@ void CGraphDataStream::insertNextValue(int absIndex,bool firstValue,const std::v
             _valuesValidityFlags[absIndex/8]&=255-(1<<(absIndex&7)); // invalid data
             _transformedValuesValidityFlags[absIndex/8]&=255-(1<<(absIndex&7)); // invalid data
         }
+        if (firstValue)
+            _clearAveragedValueWindow(); // previous values are not part of the curve anymore
+        _insertAveragedValue(absIndex);
     }
     _nextValueToInsertIsValid=false;
 }
 
-bool CGraphDataStream::getTransformedValue(int startPt,int pos,float& retVal) const
+void CGraphDataStream::_clearAveragedValueWindow()
 {
-    if (_static)
-        return(false);
-    float cumulativeValue=0.0f;
-    int cumulativeValueCount=0;
-    for (int i=0;i<_movingAveragePeriod;i++)
+    _averageWindowValues.clear();
+    _averageWindowValidity.clear();
+    _averageWindowSum=0.0;
+    _averageWindowValidCount=0;
+    _averageWindowInsertionsSinceSum=0;
+    _insertionCount=0;
+    _averagedMinima.clear();
+    _averagedMaxima.clear();
+}
+
+void CGraphDataStream::_insertAveragedValue(int absIndex)
+{ // O(1): running sum over the last _movingAveragePeriod values, and monotonic deques for the min/max of the averaged values
+    bool valid=((_transformedValuesValidityFlags[absIndex/8]&(1<<(absIndex&7)))!=0);
+    float v=0.0f;
+    if (valid)
+    {
+        v=_transformedValues[absIndex]*_transformationMult+_transformationOff;
+        _averageWindowSum+=v;
+        _averageWindowValidCount++;
+    }
+    _averageWindowValues.push_back(v);
+    _averageWindowValidity.push_back(valid);
+    while (int(_averageWindowValues.size())>_movingAveragePeriod)
     {
-        if ((_transformedValuesValidityFlags[pos/8]&(1<<(pos&7)))!=0)
+        if (_averageWindowValidity.front()!=0)
         {
-            cumulativeValue+=(_transformedValues[pos]*_transformationMult+_transformationOff);
-            cumulativeValueCount++;
+            _averageWindowSum-=_averageWindowValues.front();
+            _averageWindowValidCount--;
         }
-        if ((i==0)&&(cumulativeValueCount==0))
-            return(false); // not valid
-        if (i!=_movingAveragePeriod-1)
+        _averageWindowValues.pop_front();
+        _averageWindowValidity.pop_front();
+    }
+    _averageWindowInsertionsSinceSum++;
+    if (_averageWindowInsertionsSinceSum>=_movingAveragePeriod)
+    { // amortized O(1). Avoids drift, and recovers from inf values that left the window
+        _averageWindowSum=0.0;
+        for (size_t i=0;i<_averageWindowValues.size();i++)
         {
-            if (pos==startPt)
-                return(false); // not enough values from current point
-            pos--;
-            if (pos<0)
-                pos+=int(_transformedValues.size()); // i.e. bufferSize
+            if (_averageWindowValidity[i]!=0)
+                _averageWindowSum+=_averageWindowValues[i];
         }
+        _averageWindowInsertionsSinceSum=0;
+    }
+
+    unsigned long long int insertionIndex=_insertionCount++;
+    unsigned long long int bufferSize=_averagedValues.size();
+    while ( (_averagedMinima.size()>0)&&(_averagedMinima.front().insertionIndex+bufferSize<=insertionIndex) )
+        _averagedMinima.pop_front(); // that value was overwritten
+    while ( (_averagedMaxima.size()>0)&&(_averagedMaxima.front().insertionIndex+bufferSize<=insertionIndex) )
+        _averagedMaxima.pop_front(); // that value was overwritten
+
+    if (valid&&(_averageWindowValidCount>0))
+    {
+        float avg=float(_averageWindowSum/double(_averageWindowValidCount));
+        _averagedValues[absIndex]=avg;
+        _averagedValuesValidityFlags[absIndex/8]|=(1<<(absIndex&7)); // valid data
+        SGraphDataStreamExtremum e;
+        e.insertionIndex=insertionIndex;
+        e.value=avg;
+        while ( (_averagedMinima.size()>0)&&(_averagedMinima.back().value>=avg) )
+            _averagedMinima.pop_back();
+        _averagedMinima.push_back(e);
+        while ( (_averagedMaxima.size()>0)&&(_averagedMaxima.back().value<=avg) )
+            _averagedMaxima.pop_back();
+        _averagedMaxima.push_back(e);
+    }
+    else
+    {
+        _averagedValues[absIndex]=0.0f;
+        _averagedValuesValidityFlags[absIndex/8]&=255-(1<<(absIndex&7)); // invalid data
+    }
+}
+
+void CGraphDataStream::_rebuildAveragedValues(int ptCnt,int bufferSize)
+{ // after loading, values are at positions 0 to ptCnt-1
+    _averagedValues.clear();
+    _averagedValues.resize(bufferSize,0.0f);
+    _averagedValuesValidityFlags.clear();
+    _averagedValuesValidityFlags.resize(1+bufferSize/8,0);
+    _clearAveragedValueWindow();
+    for (int i=0;i<ptCnt;i++)
+    {
+        if ( (i<int(_transformedValues.size()))&&(i/8<int(_transformedValuesValidityFlags.size())) )
+            _insertAveragedValue(i);
     }
-    if (cumulativeValueCount>0)
-        retVal=cumulativeValue/float(cumulativeValueCount);
-    return(cumulativeValueCount>0);
+}
+
+bool CGraphDataStream::_getAveragedValueExtrema(int ptCnt,float& minV,float& maxV) const
+{ // min/max of the averaged values that are displayed, i.e. the ones that have enough values before them
+    if ( (_insertionCount==0)||(ptCnt<_movingAveragePeriod) )
+        return(false);
+    // The last inserted value is at curve position ptCnt-1:
+    unsigned long long int visibleCnt=(unsigned long long int)(ptCnt-_movingAveragePeriod+1);
+    unsigned long long int firstVisible=0;
+    if (_insertionCount>visibleCnt)
+        firstVisible=_insertionCount-visibleCnt;
+    // The first element from firstVisible is the extremum, since the deques are monotonic:
+    size_t i=0;
+    while ( (i<_averagedMinima.size())&&(_averagedMinima[i].insertionIndex<firstVisible) )
+        i++;
+    size_t j=0;
+    while ( (j<_averagedMaxima.size())&&(_averagedMaxima[j].insertionIndex<firstVisible) )
+        j++;
+    if ( (i>=_averagedMinima.size())||(j>=_averagedMaxima.size()) )
+        return(false);
+    minV=_averagedMinima[i].value;
+    maxV=_averagedMaxima[j].value;
+    return(true);
+}
+
+bool CGraphDataStream::getTransformedValue(int startPt,int pos,float& retVal) const
+{ // averaged values are maintained in insertNextValue
+    if (_static)
+        return(false);
+    int posFromStart=pos-startPt;
+    if (posFromStart<0)
+        posFromStart+=int(_averagedValues.size()); // i.e. bufferSize
+    if (posFromStart<_movingAveragePeriod-1)
+        return(false); // not enough values from current point
+    if ((_averagedValuesValidityFlags[pos/8]&(1<<(pos&7)))==0)
+        return(false); // not valid
+    retVal=_averagedValues[pos];
+    return(true);
 }
 
 bool CGraphDataStream::getCurveData(bool staticCurve,int* index,int startPt,int ptCnt,const std::vector<float>& times,std::string* label,std::vector<float>& xVals,std::vector<float>& yVals,int* curveType,float col[3],float minMax[6]) const
@@ -316,16 +424,26 @@ bool CGraphDataStream::getCurveData(bool staticCurve,int* index,int startPt,int
             }
             if (!_static)
             {
-                int cnt=0;
-                for (int cnt=0;cnt<ptCnt;cnt++)
+                size_t initialSize=xVals.size();
+                float yMin,yMax;
+                bool haveYExtrema=false;
+                if (minMax!=nullptr)
+                    haveYExtrema=_getAveragedValueExtrema(ptCnt,yMin,yMax);
+                xVals.reserve(initialSize+ptCnt);
+                yVals.reserve(yVals.size()+ptCnt);
+                int bufferSize=int(_averagedValues.size());
+                int firstCnt=_movingAveragePeriod-1; // the first points do not have enough values before them
+                if (firstCnt<0)
+                    firstCnt=0;
+                for (int cnt=firstCnt;cnt<ptCnt;cnt++)
                 {
                     int absIndex=startPt+cnt;
-                    if (absIndex>=int(_values.size())) // i.e. bufferSize
-                        absIndex-=int(_values.size());
-                    float yVal;
-                    if (getTransformedValue(startPt,absIndex,yVal))
+                    if (absIndex>=bufferSize)
+                        absIndex-=bufferSize;
+                    if ((_averagedValuesValidityFlags[absIndex/8]&(1<<(absIndex&7)))!=0)
                     {
                         float xVal=times[absIndex];
+                        float yVal=_averagedValues[absIndex];
                         xVals.push_back(xVal);
                         yVals.push_back(yVal);
                         if (minMax!=nullptr)
@@ -343,14 +461,24 @@ bool CGraphDataStream::getCurveData(bool staticCurve,int* index,int startPt,int
                                     minMax[0]=xVal;
                                 if (xVal>minMax[1])
                                     minMax[1]=xVal;
-                                if (yVal<minMax[2])
-                                    minMax[2]=yVal;
-                                if (yVal>minMax[3])
-                                    minMax[3]=yVal;
+                                if (!haveYExtrema)
+                                {
+                                    if (yVal<minMax[2])
+                                        minMax[2]=yVal;
+                                    if (yVal>minMax[3])
+                                        minMax[3]=yVal;
+                                }
                             }
                         }
                     }
                 }
+                if (haveYExtrema&&(xVals.size()>initialSize))
+                {
+                    if ( (initialSize==0)||(yMin<minMax[2]) )
+                        minMax[2]=yMin;
+                    if ( (initialSize==0)||(yMax>minMax[3]) )
+                        minMax[3]=yMax;
+                }
             }
             else
             { // static
@@ -411,6 +539,9 @@ void CGraphDataStream::makeStatic(int startPt,int ptCnt,const std::vector<float>
         _transformedValues.clear();
         _valuesValidityFlags.clear();
         _transformedValuesValidityFlags.clear();
+        _averagedValues.clear();
+        _averagedValuesValidityFlags.clear();
+        _clearAveragedValueWindow();
         _static=true;
     }
 }
@@ -554,6 +685,7 @@ void CGraphDataStream::serialize(CSer& ar,int startPt,int ptCnt,int bufferSize)
                             if (b!=0)
                                 _transformedValuesValidityFlags[i/8]|=(1<<(i&7));
                         }
+                        _rebuildAveragedValues(ptCnt,bufferSize);
                     }
                     if (theName.compare("Sps")==0)
                     {
@@ -691,6 +823,7 @@ void CGraphDataStream::serialize(CSer& ar,int startPt,int ptCnt,int bufferSize)
                     if (tmp[i])
                         _transformedValuesValidityFlags[i/8]|=(1<<(i&7));
                 }
+                _rebuildAveragedValues(ptCnt,bufferSize);
             }
             else
                 ar.xmlGetNode_floats("staticData",_staticCurveValues);
@@ -721,6 +854,16 @@ CGraphDataStream* CGraphDataStream::copyYourself() const
     newObj->_valuesValidityFlags.assign(_valuesValidityFlags.begin(),_valuesValidityFlags.end());
     newObj->_transformedValuesValidityFlags.assign(_transformedValuesValidityFlags.begin(),_transformedValuesValidityFlags.end());
     newObj->_staticCurveValues.assign(_staticCurveValues.begin(),_staticCurveValues.end());
+    newObj->_averagedValues.assign(_averagedValues.begin(),_averagedValues.end());
+    newObj->_averagedValuesValidityFlags.assign(_averagedValuesValidityFlags.begin(),_averagedValuesValidityFlags.end());
+    newObj->_averageWindowValues.assign(_averageWindowValues.begin(),_averageWindowValues.end());
+    newObj->_averageWindowValidity.assign(_averageWindowValidity.begin(),_averageWindowValidity.end());
+    newObj->_averageWindowSum=_averageWindowSum;
+    newObj->_averageWindowValidCount=_averageWindowValidCount;
+    newObj->_averageWindowInsertionsSinceSum=_averageWindowInsertionsSinceSum;
+    newObj->_insertionCount=_insertionCount;
+    newObj->_averagedMinima.assign(_averagedMinima.begin(),_averagedMinima.end());
+    newObj->_averagedMaxima.assign(_averagedMaxima.begin(),_averagedMaxima.end());
     return(newObj);
 }
 
@@ -1,6 +1,13 @@
 #pragma once
 
 #include "ser.h"
+#include <deque>
+
+struct SGraphDataStreamExtremum
+{
+    unsigned long long int insertionIndex;
+    float value;
+};
 
 class CGraphDataStream
 {
@@ -35,6 +42,11 @@ public:
 
 
 protected:
+    void _clearAveragedValueWindow();
+    void _insertAveragedValue(int absIndex);
+    void _rebuildAveragedValues(int ptCnt,int bufferSize);
+    bool _getAveragedValueExtrema(int ptCnt,float& minV,float& maxV) const;
+
     std::vector <float> _values;
     std::vector <float> _transformedValues;
     std::vector <unsigned char> _valuesValidityFlags;
@@ -42,6 +54,18 @@ protected:
 
     std::vector<float> _staticCurveValues;
 
+    // Transformed, scaled, offset and averaged values, maintained incrementally when a value is inserted:
+    std::vector<float> _averagedValues;
+    std::vector<unsigned char> _averagedValuesValidityFlags;
+    std::deque<float> _averageWindowValues; // the last _movingAveragePeriod transformed values (scaled and offset)
+    std::deque<unsigned char> _averageWindowValidity;
+    double _averageWindowSum;
+    int _averageWindowValidCount;
+    int _averageWindowInsertionsSinceSum; // the sum is periodically recomputed, to avoid drift
+    unsigned long long int _insertionCount;
+    std::deque<SGraphDataStreamExtremum> _averagedMinima; // increasing values, from oldest to newest
+    std::deque<SGraphDataStreamExtremum> _averagedMaxima; // decreasing values, from oldest to newest
+
     std::string _streamName;
     std::string _unitStr;
     int _scriptHandle;
@@ -0,0 +1,414 @@
+#include "graphRecorder.h"
+#include "vFile.h"
+#include "vVarious.h"
+#include "vDateTime.h"
+#include "app.h"
+#include <cstring>
+#include <cmath>
+#include <limits>
+
+CGraphRecorder::CGraphRecorder(const char* folder,int graphHandle)
+{
+    static int recorderCnt=0;
+    std::string f(folder);
+    VVarious::removePathFinalSlashOrBackslash(f);
+    _filePrefix=f+"/graphRecording_"+std::to_string(graphHandle)+"_"+std::to_string(VDateTime::getTimeInMs())+"_"+std::to_string(recorderCnt++);
+    _sampleCount=0;
+    _diskError=false;
+    _addColumn(-1); // the times
+}
+
+CGraphRecorder::~CGraphRecorder()
+{
+    while (_columns.size()>1)
+        removeStream(_columns[_columns.size()-1]->streamId);
+    for (size_t i=0;i<_columns[0]->levels.size();i++)
+    {
+        _closeReadFile(_columns[0]->levels[i]);
+        if (_columns[0]->levels[i].recordsOnDisk>0)
+            VFile::eraseFile(_columns[0]->levels[i].filename.c_str());
+    }
+    delete _columns[0];
+}
+
+void CGraphRecorder::addSample(float time,const std::vector<int>& streamIds,const std::vector<float>& values)
+{
+    if (_diskError)
+        return;
+    _addValue(_columns[0],time);
+    for (size_t i=0;i<streamIds.size();i++)
+    {
+        SGraphRecorderColumn* column=_getColumn(streamIds[i]);
+        if (column==nullptr)
+            column=_addColumn(streamIds[i]);
+        if (column->firstSample+column->levels[0].recordCount==_sampleCount)
+            _addValue(column,values[i]);
+    }
+    for (size_t i=1;i<_columns.size();i++)
+    { // streams that were not provided get an invalid value, so that all columns stay aligned
+        if (_columns[i]->firstSample+_columns[i]->levels[0].recordCount==_sampleCount)
+            _addValue(_columns[i],std::numeric_limits<float>::quiet_NaN());
+    }
+    _sampleCount++;
+}
+
+void CGraphRecorder::removeStream(int streamId)
+{
+    for (size_t i=1;i<_columns.size();i++)
+    {
+        if (_columns[i]->streamId==streamId)
+        {
+            for (size_t j=0;j<_columns[i]->levels.size();j++)
+            {
+                _closeReadFile(_columns[i]->levels[j]);
+                if (_columns[i]->levels[j].recordsOnDisk>0)
+                    VFile::eraseFile(_columns[i]->levels[j].filename.c_str());
+            }
+            delete _columns[i];
+            _columns.erase(_columns.begin()+i);
+            break;
+        }
+    }
+}
+
+unsigned long long int CGraphRecorder::getSampleCount() const
+{
+    return(_sampleCount);
+}
+
+bool CGraphRecorder::getDecimatedData(const std::vector<int>& streamIds,float fromTime,float toTime,int maxPointCnt,std::vector<float>& times,std::vector<std::vector<float> >& minVals,std::vector<std::vector<float> >& maxVals,std::vector<std::vector<float> >& meanVals)
+{ // returns at most maxPointCnt points (unless the range is larger than 2^GRAPH_RECORDER_MAX_LEVELS samples), each one covering 2^l samples
+    times.clear();
+    minVals.clear();
+    maxVals.clear();
+    meanVals.clear();
+    minVals.resize(streamIds.size());
+    maxVals.resize(streamIds.size());
+    meanVals.resize(streamIds.size());
+    if (_diskError)
+        return(false);
+    if ( (_sampleCount==0)||(maxPointCnt<1) )
+        return(true);
+    unsigned long long int firstSample=_findFirstSample(fromTime,false);
+    unsigned long long int endSample=_findFirstSample(toTime,true);
+    if (firstSample>=endSample)
+        return(true);
+
+    // Select the finest level that has at most maxPointCnt records in that range:
+    int level=0;
+    while ( (level+1<GRAPH_RECORDER_MAX_LEVELS)&&(((endSample-1)>>level)-(firstSample>>level)+1>(unsigned long long int)maxPointCnt) )
+        level++;
+    unsigned long long int firstRecord=firstSample>>level;
+    unsigned long long int recordCnt=((endSample-1)>>level)-firstRecord+1;
+
+    bool retVal=true;
+    std::vector<float> tMin(recordCnt);
+    std::vector<float> tMax(recordCnt);
+    times.resize(recordCnt);
+    retVal=_getRecords(_columns[0],level,firstRecord,recordCnt,&tMin[0],&tMax[0],&times[0]);
+    for (size_t i=0;i<streamIds.size();i++)
+    {
+        minVals[i].resize(recordCnt,std::numeric_limits<float>::quiet_NaN());
+        maxVals[i].resize(recordCnt,std::numeric_limits<float>::quiet_NaN());
+        meanVals[i].resize(recordCnt,std::numeric_limits<float>::quiet_NaN());
+        SGraphRecorderColumn* column=_getColumn(streamIds[i]);
+        if (column!=nullptr)
+            retVal=_getRecords(column,level,firstRecord,recordCnt,&minVals[i][0],&maxVals[i][0],&meanVals[i][0])&&retVal;
+    }
+    return(retVal);
+}
+
+SGraphRecorderColumn* CGraphRecorder::_getColumn(int streamId) const
+{
+    for (size_t i=1;i<_columns.size();i++)
+    {
+        if (_columns[i]->streamId==streamId)
+            return(_columns[i]);
+    }
+    return(nullptr);
+}
+
+SGraphRecorderColumn* CGraphRecorder::_addColumn(int streamId)
+{
+    SGraphRecorderColumn* column=new SGraphRecorderColumn;
+    column->streamId=streamId;
+    column->firstSample=_sampleCount;
+    _addLevel(column); // level 0
+    _columns.push_back(column);
+    return(column);
+}
+
+void CGraphRecorder::_addLevel(SGraphRecorderColumn* column)
+{
+    int l=int(column->levels.size());
+    SGraphRecorderLevel level;
+    std::string columnName("t");
+    if (column->streamId!=-1)
+        columnName="s"+std::to_string(column->streamId);
+    level.filename=_filePrefix+"_"+columnName+"_l"+std::to_string(l)+".bin";
+    level.firstRecord=column->firstSample>>l;
+    level.recordCount=0;
+    level.recordsOnDisk=0;
+    level.readFile=nullptr;
+    level.mapped=nullptr;
+    level.mappedSize=0;
+    level.accMin=0.0f;
+    level.accMax=0.0f;
+    level.accSum=0.0;
+    level.accValidCount=0;
+    column->levels.push_back(level);
+}
+
+void CGraphRecorder::_addValue(SGraphRecorderColumn* column,float value)
+{ // amortized O(1): a record of level l is complete when 2 records of level l-1 are complete
+    unsigned long long int sample=column->firstSample+column->levels[0].recordCount;
+    bool valid=!std::isnan(value);
+    float minV=value;
+    float maxV=value;
+    double sum=0.0;
+    unsigned long long int validCnt=0;
+    if (valid)
+    {
+        sum=value;
+        validCnt=1;
+    }
+    _appendRecord(column->levels[0],0,minV,maxV,sum,validCnt);
+    for (int l=1;l<GRAPH_RECORDER_MAX_LEVELS;l++)
+    {
+        if (int(column->levels.size())<=l)
+            _addLevel(column);
+        SGraphRecorderLevel& level=column->levels[l];
+        if (validCnt>0)
+        {
+            if ( (level.accValidCount==0)||(minV<level.accMin) )
+                level.accMin=minV;
+            if ( (level.accValidCount==0)||(maxV>level.accMax) )
+                level.accMax=maxV;
+            level.accSum+=sum;
+            level.accValidCount+=validCnt;
+        }
+        unsigned long long int mask=(1ULL<<l)-1;
+        if (((sample+1)&mask)!=0)
+            break; // the current record of that level is not yet complete
+        minV=level.accMin;
+        maxV=level.accMax;
+        sum=level.accSum;
+        validCnt=level.accValidCount;
+        _appendRecord(level,l,minV,maxV,sum,validCnt);
+        level.accSum=0.0;
+        level.accValidCount=0;
+    }
+}
+
+void CGraphRecorder::_appendRecord(SGraphRecorderLevel& level,int levelIndex,float minV,float maxV,double sum,unsigned long long int validCnt)
+{
+    if (levelIndex==0)
+        level.buffer.push_back(minV);
+    else
+    {
+        if (validCnt>0)
+        {
+            level.buffer.push_back(minV);
+            level.buffer.push_back(maxV);
+            level.buffer.push_back(float(sum/double(validCnt)));
+        }
+        else
+        {
+            for (int i=0;i<3;i++)
+                level.buffer.push_back(std::numeric_limits<float>::quiet_NaN());
+        }
+    }
+    level.recordCount++;
+    if (level.buffer.size()>=GRAPH_RECORDER_FLUSH_SIZE)
+        _flushLevel(level);
+}
+
+void CGraphRecorder::_flushLevel(SGraphRecorderLevel& level)
+{
+    if ( _diskError||(level.buffer.size()==0) )
+        return;
+    _closeReadFile(level); // the file grows. Mapped again with the next read
+    try
+    {
+        VFile file(level.filename.c_str(),VFile::APPEND|VFile::SHARE_EXCLUSIVE);
+        file.getFile()->write((const char*)&level.buffer[0],level.buffer.size()*sizeof(float));
+        file.close();
+        level.recordsOnDisk=level.recordCount;
+        level.buffer.clear();
+    }
+    catch(VFILE_EXCEPTION_TYPE e)
+    {
+        _diskError=true;
+        App::logMsg(sim_verbosity_errors,"graph recording stopped: cannot write to %s.",level.filename.c_str());
+    }
+}
+
+bool CGraphRecorder::_getRecords(SGraphRecorderColumn* column,int levelIndex,unsigned long long int firstRecord,unsigned long long int recordCnt,float* minVals,float* maxVals,float* meanVals)
+{ // records that do not exist (e.g. before the stream was added) are NaN. The last record might be incomplete
+    bool retVal=true;
+    for (unsigned long long int i=0;i<recordCnt;i++)
+    {
+        minVals[i]=std::numeric_limits<float>::quiet_NaN();
+        maxVals[i]=std::numeric_limits<float>::quiet_NaN();
+        meanVals[i]=std::numeric_limits<float>::quiet_NaN();
+    }
+    unsigned long long int endRecord=firstRecord+recordCnt;
+    unsigned long long int nextSample=column->firstSample+column->levels[0].recordCount;
+    unsigned long long int record=firstRecord;
+    if (levelIndex<int(column->levels.size()))
+    {
+        SGraphRecorderLevel& level=column->levels[levelIndex];
+        int recordSize=1;
+        if (levelIndex>0)
+            recordSize=3;
+        if (record<level.firstRecord)
+            record=level.firstRecord;
+
+        // 1. Records on disk:
+        unsigned long long int end=level.firstRecord+level.recordsOnDisk;
+        if (end>endRecord)
+            end=endRecord;
+        if (record<end)
+        {
+            std::vector<float> data((end-record)*recordSize);
+            if (_readFromDisk(level,(record-level.firstRecord)*recordSize*sizeof(float),data.size()*sizeof(float),&data[0]))
+            {
+                for (unsigned long long int i=0;i<end-record;i++)
+                {
+                    unsigned long long int j=record-firstRecord+i;
+                    minVals[j]=data[recordSize*i+0];
+                    maxVals[j]=data[recordSize*i+recordSize/2];
+                    meanVals[j]=data[recordSize*i+recordSize-1];
+                }
+            }
+            else
+                retVal=false;
+            record=end;
+        }
+
+        // 2. Buffered records:
+        end=level.firstRecord+level.recordCount;
+        if (end>endRecord)
+            end=endRecord;
+        for (;record<end;record++)
+        {
+            unsigned long long int i=(record-level.firstRecord-level.recordsOnDisk)*recordSize;
+            unsigned long long int j=record-firstRecord;
+            minVals[j]=level.buffer[i+0];
+            maxVals[j]=level.buffer[i+recordSize/2];
+            meanVals[j]=level.buffer[i+recordSize-1];
+        }
+    }
+
+    // 3. The current, incomplete record. Lower levels hold the samples that were not yet propagated:
+    unsigned long long int mask=(1ULL<<levelIndex)-1;
+    if ( (levelIndex>0)&&((nextSample&mask)!=0)&&((nextSample>>levelIndex)>=firstRecord)&&((nextSample>>levelIndex)<endRecord) )
+    {
+        float minV=0.0f;
+        float maxV=0.0f;
+        double sum=0.0;
+        unsigned long long int validCnt=0;
+        for (int l=1;(l<=levelIndex)&&(l<int(column->levels.size()));l++)
+        {
+            const SGraphRecorderLevel& level=column->levels[l];
+            if (level.accValidCount>0)
+            {
+                if ( (validCnt==0)||(level.accMin<minV) )
+                    minV=level.accMin;
+                if ( (validCnt==0)||(level.accMax>maxV) )
+                    maxV=level.accMax;
+                sum+=level.accSum;
+                validCnt+=level.accValidCount;
+            }
+        }
+        if (validCnt>0)
+        {
+            unsigned long long int j=(nextSample>>levelIndex)-firstRecord;
+            minVals[j]=minV;
+            maxVals[j]=maxV;
+            meanVals[j]=float(sum/double(validCnt));
+        }
+    }
+    return(retVal);
+}
+
+bool CGraphRecorder::_readFromDisk(SGraphRecorderLevel& level,unsigned long long int offset,unsigned long long int size,float* data)
+{ // the file stays open (and memory-mapped when possible) between reads
+    bool retVal=false;
+    try
+    {
+        if (level.readFile==nullptr)
+        {
+            level.readFile=new VFile(level.filename.c_str(),VFile::READ|VFile::SHARE_DENY_NONE);
+#ifdef SIM_WITH_QT
+            level.mappedSize=(unsigned long long int)level.readFile->getFile()->size();
+            if (level.mappedSize>0)
+                level.mapped=level.readFile->getFile()->map(0,level.mappedSize);
+#endif
+        }
+#ifdef SIM_WITH_QT
+        if ( (level.mapped!=nullptr)&&(offset+size<=level.mappedSize) )
+        {
+            memcpy(data,level.mapped+offset,size);
+            retVal=true;
+        }
+        else if (level.readFile->getFile()->seek(offset))
+            retVal=(level.readFile->getFile()->read((char*)data,size)==qint64(size));
+#else
+        level.readFile->getFile()->clear();
+        level.readFile->getFile()->seekg(offset,std::ios::beg);
+        level.readFile->getFile()->read((char*)data,size);
+        retVal=!level.readFile->getFile()->fail();
+#endif
+    }
+    catch(VFILE_EXCEPTION_TYPE e)
+    {
+    }
+    return(retVal);
+}
+
+void CGraphRecorder::_closeReadFile(SGraphRecorderLevel& level)
+{
+    if (level.readFile!=nullptr)
+    {
+#ifdef SIM_WITH_QT
+        if (level.mapped!=nullptr)
+            level.readFile->getFile()->unmap(level.mapped);
+#endif
+        delete level.readFile;
+        level.readFile=nullptr;
+    }
+    level.mapped=nullptr;
+    level.mappedSize=0;
+}
+
+bool CGraphRecorder::_getSampleTime(unsigned long long int sample,float& time)
+{ // times are in level 0 of _columns[0], which starts with the first sample
+    SGraphRecorderLevel& level=_columns[0]->levels[0];
+    if (sample>=level.recordsOnDisk)
+    {
+        time=level.buffer[sample-level.recordsOnDisk];
+        return(true);
+    }
+    return(_readFromDisk(level,sample*sizeof(float),sizeof(float),&time));
+}
+
+unsigned long long int CGraphRecorder::_findFirstSample(float time,bool strictlyAfter)
+{ // binary search in the times, directly in the file mapping. O(log(n))
+    unsigned long long int low=0;
+    unsigned long long int high=_sampleCount;
+    while (low<high)
+    {
+        unsigned long long int mid=low+(high-low)/2;
+        float t=std::numeric_limits<float>::quiet_NaN();
+        _getSampleTime(mid,t);
+        bool after=(t>=time);
+        if (strictlyAfter)
+            after=(t>time);
+        if (after)
+            high=mid;
+        else
+            low=mid+1;
+    }
+    return(low);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+class VFile;
+
+#define GRAPH_RECORDER_MAX_LEVELS 40
+#define GRAPH_RECORDER_FLUSH_SIZE 16384 // buffered floats per level, before they are appended to the file
+
+struct SGraphRecorderLevel
+{ // level 0 has one value per sample. Level l>0 has min, max and mean values for each group of 2^l samples
+    std::string filename;
+    unsigned long long int firstRecord; // global index of the first record (i.e. relative to the first sample of the recording)
+    unsigned long long int recordCount; // on disk and buffered
+    unsigned long long int recordsOnDisk;
+    std::vector<float> buffer; // records not yet on disk
+    // Read access to the records on disk. Opened (and mapped when possible) with the first read, closed before the next flush:
+    VFile* readFile;
+    unsigned char* mapped;
+    unsigned long long int mappedSize;
+    // The current, incomplete record (levels>0), built from the complete records of the level below:
+    float accMin;
+    float accMax;
+    double accSum;
+    unsigned long long int accValidCount;
+};
+
+struct SGraphRecorderColumn
+{
+    int streamId; // -1 for the times
+    unsigned long long int firstSample; // the stream might have been added after the recording started
+    std::vector<SGraphRecorderLevel> levels;
+};
+
+class CGraphRecorder
+{ // Records graph samples to disk, without limit. One file per column (times and each stream) and level. Levels hold min/max/mean
+  // values at power-of-two strides, so that a time range can be retrieved with n points in a time proportional to n.
+  // Times are expected to be increasing
+public:
+    CGraphRecorder(const char* folder,int graphHandle);
+    virtual ~CGraphRecorder(); // erases the files
+
+    void addSample(float time,const std::vector<int>& streamIds,const std::vector<float>& values); // invalid values are NaN
+    void removeStream(int streamId);
+    unsigned long long int getSampleCount() const;
+    bool getDecimatedData(const std::vector<int>& streamIds,float fromTime,float toTime,int maxPointCnt,std::vector<float>& times,std::vector<std::vector<float> >& minVals,std::vector<std::vector<float> >& maxVals,std::vector<std::vector<float> >& meanVals);
+
+private:
+    SGraphRecorderColumn* _getColumn(int streamId) const;
+    SGraphRecorderColumn* _addColumn(int streamId);
+    void _addLevel(SGraphRecorderColumn* column);
+    void _addValue(SGraphRecorderColumn* column,float value);
+    void _appendRecord(SGraphRecorderLevel& level,int levelIndex,float minV,float maxV,double sum,unsigned long long int validCnt);
+    void _flushLevel(SGraphRecorderLevel& level);
+    bool _getRecords(SGraphRecorderColumn* column,int levelIndex,unsigned long long int firstRecord,unsigned long long int recordCnt,float* minVals,float* maxVals,float* meanVals);
+    bool _readFromDisk(SGraphRecorderLevel& level,unsigned long long int offset,unsigned long long int size,float* data);
+    void _closeReadFile(SGraphRecorderLevel& level);
+    bool _getSampleTime(unsigned long long int sample,float& time);
+    unsigned long long int _findFirstSample(float time,bool strictlyAfter); // first sample with time>=time (or time>time)
+
+    std::string _filePrefix;
+    unsigned long long int _sampleCount;
+    std::vector<SGraphRecorderColumn*> _columns; // _columns[0] holds the times
+    bool _diskError;
+};
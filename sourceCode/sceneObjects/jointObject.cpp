@@ -66,6 +66,7 @@ void CJoint::_commonInit()
 
     _cumulatedForceOrTorque=0.0f;
     _cumulativeForceOrTorqueTmp=0.0f;
+    _batchControlScriptHandle=-1;
     _lastForceOrTorque_dynStep=0.0f;
     _lastForceOrTorqueValid_dynStep=false;
     _averageForceOrTorqueValid=false;
@@ -1213,7 +1214,242 @@ bool CJoint::getDynamicForceOrTorque(float& forceOrTorque,bool dynamicStepValue)
 
 void CJoint::handleDynJointControl(bool init,int loopCnt,int totalLoops,float currentPos,float effort,float dynStepSize,float errorV,float& velocity,float& forceTorque)
 {
-    bool spring=_dynamicMotorPositionControl_torqueModulation;
+    // We check if a plugin wants to handle the joint controller. The dynamics engine calls us joint by joint, so batch callbacks get a batch of 1:
+    std::vector<CJoint*> joints;
+    float inputValues[4]={currentPos,effort,dynStepSize,errorV};
+    float outputValues[2]={velocity,forceTorque};
+    int batchResult=-1;
+    if (getAllJointCtrlBatchCallbacks().size()!=0)
+    {
+        joints.push_back(this);
+        _handleDynJointControl_batchPlugins(joints,init,loopCnt,totalLoops,inputValues,outputValues,&batchResult);
+    }
+    if (batchResult!=-1)
+    {
+        velocity=outputValues[0];
+        forceTorque=outputValues[1];
+    }
+    else if (!_handleDynJointControl_plugins(init,loopCnt,totalLoops,currentPos,effort,dynStepSize,errorV,velocity,forceTorque))
+    { // The plugins didn't want to handle that joint
+        CLuaScriptObject* batchScript=_getBatchControlScript();
+        bool handled=false;
+        if (batchScript!=nullptr)
+        { // a batch of 1 too
+            joints.assign(1,this);
+            std::vector<size_t> indices(1,0);
+            handled=_handleDynJointControl_batchScript(batchScript,joints,indices,init,loopCnt,totalLoops,inputValues,outputValues);
+            if (handled)
+            {
+                velocity=outputValues[0];
+                forceTorque=outputValues[1];
+            }
+        }
+        if (!handled)
+        {
+            if (!_handleDynJointControl_scripts(init,loopCnt,totalLoops,currentPos,effort,dynStepSize,errorV,velocity,forceTorque))
+            { // there doesn't seem to be any appropriate function for joint handling in the attached child or customization scripts
+                _handleDynJointControl_builtIn(init,dynStepSize,errorV,velocity,forceTorque);
+            }
+        }
+    }
+}
+
+void CJoint::_handleDynJointControl_batchPlugins(const std::vector<CJoint*>& joints,bool init,int loopCnt,int totalLoops,const float* inputValues,float* outputValues,int* results)
+{ // results: -1 for joints no callback handled, 0 for free joints, 1 for handled joints. Others are left unchanged
+    size_t n=joints.size();
+    std::vector<jointCtrlBatchCallback>& batchCallbacks=getAllJointCtrlBatchCallbacks();
+    if (batchCallbacks.size()!=0)
+    {
+        std::vector<int> intData(2*n+2); // handles, flags (bit0: init, bit1: revolute, bit2: cyclic), passCnt, totalPasses
+        std::vector<float> floatData(1+9*n); // dynStepSize, then currentPos, targetPos, errorValue, effort, lowLimit, highLimit, targetVel, maxForce, velUpperLimit
+        std::vector<float> outData(2*n,0.0f); // forces, then velocities
+        intData[2*n+0]=loopCnt;
+        intData[2*n+1]=totalLoops;
+        floatData[0]=inputValues[2];
+        for (size_t i=0;i<n;i++)
+        {
+            CJoint* it=joints[i];
+            intData[i]=it->getObjectHandle();
+            int flags=0;
+            if (init)
+                flags|=1;
+            if (it->_jointType==sim_joint_revolute_subtype)
+                flags|=2;
+            if (it->_positionIsCyclic)
+                flags|=4;
+            intData[n+i]=flags;
+            floatData[1+0*n+i]=inputValues[4*i+0];
+            floatData[1+1*n+i]=it->_dynamicMotorPositionControl_targetPosition;
+            floatData[1+2*n+i]=inputValues[4*i+3];
+            floatData[1+3*n+i]=inputValues[4*i+1];
+            floatData[1+4*n+i]=it->_jointMinPosition;
+            floatData[1+5*n+i]=it->_jointMinPosition+it->_jointPositionRange;
+            floatData[1+6*n+i]=it->_dynamicMotorTargetVelocity;
+            floatData[1+7*n+i]=it->_dynamicMotorMaximumForce;
+            floatData[1+8*n+i]=it->_dynamicMotorUpperLimitVelocity;
+        }
+        int engine=App::currentWorld->dynamicsContainer->getDynamicEngineType(nullptr);
+        for (size_t i=0;i<batchCallbacks.size();i++) // a callback only handles joints with a result of -1
+            batchCallbacks[i](engine,int(n),&intData[0],&floatData[0],&outData[0],results);
+        for (size_t i=0;i<n;i++)
+        {
+            if (results[i]==0)
+            { // override... we don't want any control on this joint (free joint)
+                outputValues[2*i+0]=0.0f;
+                outputValues[2*i+1]=0.0f;
+            }
+            if (results[i]>0)
+            { // override... we use control values provided by the callback
+                outputValues[2*i+0]=outData[n+i];
+                outputValues[2*i+1]=outData[i];
+            }
+        }
+    }
+}
+
+void CJoint::handleDynJointControls(const std::vector<CJoint*>& joints,bool init,int loopCnt,int totalLoops,const float* inputValues,float* outputValues)
+{ // Once per dyn. substep, for all joints. inputValues: currentPos,effort,dynStepSize,errorValue for each joint. outputValues: velocity,force for each joint
+    size_t n=joints.size();
+    if (n==0)
+        return;
+    std::vector<int> results(n,-1); // -1: not yet handled, 0: free joint, 1: handled
+
+    // 1. Plugins that registered a batch callback see all joints at once (structure of arrays):
+    _handleDynJointControl_batchPlugins(joints,init,loopCnt,totalLoops,inputValues,outputValues,&results[0]);
+
+    // 2. Per-joint plugin callbacks, then we group the joints that are controlled by a same script:
+    std::map<int,std::vector<size_t> > scriptGroups;
+    for (size_t i=0;i<n;i++)
+    {
+        if (results[i]==-1)
+        {
+            CJoint* it=joints[i];
+            const float* in=inputValues+4*i;
+            float* out=outputValues+2*i;
+            if (!it->_handleDynJointControl_plugins(init,loopCnt,totalLoops,in[0],in[1],in[2],in[3],out[0],out[1]))
+            {
+                CLuaScriptObject* script=it->_getBatchControlScript();
+                if (script!=nullptr)
+                    scriptGroups[script->getScriptHandle()].push_back(i);
+                else if (!it->_handleDynJointControl_scripts(init,loopCnt,totalLoops,in[0],in[1],in[2],in[3],out[0],out[1]))
+                    it->_handleDynJointControl_builtIn(init,in[2],in[3],out[0],out[1]);
+            }
+        }
+    }
+
+    // 3. One call per script:
+    for (std::map<int,std::vector<size_t> >::iterator grp=scriptGroups.begin();grp!=scriptGroups.end();grp++)
+    {
+        CLuaScriptObject* script=App::worldContainer->getScriptFromHandle(grp->first);
+        if ( (script==nullptr)||(!_handleDynJointControl_batchScript(script,joints,grp->second,init,loopCnt,totalLoops,inputValues,outputValues)) )
+        { // the script could have been removed in the mean time, or did not return valid values
+            for (size_t j=0;j<grp->second.size();j++)
+            {
+                size_t i=grp->second[j];
+                const float* in=inputValues+4*i;
+                float* out=outputValues+2*i;
+                if (!joints[i]->_handleDynJointControl_scripts(init,loopCnt,totalLoops,in[0],in[1],in[2],in[3],out[0],out[1]))
+                    joints[i]->_handleDynJointControl_builtIn(init,in[2],in[3],out[0],out[1]);
+            }
+        }
+    }
+}
+
+void CJoint::setBatchControlScriptHandle(int scriptHandle)
+{
+    _batchControlScriptHandle=scriptHandle;
+}
+
+int CJoint::getBatchControlScriptHandle() const
+{
+    return(_batchControlScriptHandle);
+}
+
+CLuaScriptObject* CJoint::_getBatchControlScript() const
+{
+    if (_batchControlScriptHandle==-1)
+        return(nullptr);
+    CLuaScriptObject* retVal=App::worldContainer->getScriptFromHandle(_batchControlScriptHandle);
+    if ( (retVal!=nullptr)&&retVal->getScriptIsDisabled() )
+        retVal=nullptr;
+    return(retVal);
+}
+
+bool CJoint::_handleDynJointControl_batchScript(CLuaScriptObject* script,const std::vector<CJoint*>& joints,const std::vector<size_t>& indices,bool init,int loopCnt,int totalLoops,const float* inputValues,float* outputValues)
+{ // calls JOINT_BATCH_CALLBACK_FUNCTION once for all indicated joints. Returns false if the script did not return valid values
+    size_t n=indices.size();
+    std::vector<int> handles(n);
+    std::vector<int> flags(n);
+    std::vector<float> data(9*n);
+    for (size_t j=0;j<n;j++)
+    {
+        size_t i=indices[j];
+        CJoint* it=joints[i];
+        handles[j]=it->getObjectHandle();
+        flags[j]=0;
+        if (it->_jointType==sim_joint_revolute_subtype)
+            flags[j]|=1;
+        if (it->_positionIsCyclic)
+            flags[j]|=2;
+        data[0*n+j]=inputValues[4*i+0];
+        data[1*n+j]=it->_dynamicMotorPositionControl_targetPosition;
+        data[2*n+j]=inputValues[4*i+3];
+        data[3*n+j]=inputValues[4*i+1];
+        data[4*n+j]=it->_jointMinPosition;
+        data[5*n+j]=it->_jointMinPosition+it->_jointPositionRange;
+        data[6*n+j]=it->_dynamicMotorTargetVelocity;
+        data[7*n+j]=it->_dynamicMotorMaximumForce;
+        data[8*n+j]=it->_dynamicMotorUpperLimitVelocity;
+    }
+    static const char* arrayNames[9]={"currentPos","targetPos","errorValue","effort","lowLimit","highLimit","targetVel","maxForce","velUpperLimit"};
+
+    CInterfaceStack stack;
+    stack.pushTableOntoStack();
+    stack.pushStringOntoStack("first",0);
+    stack.pushBoolOntoStack(init);
+    stack.insertDataIntoStackTable();
+    stack.pushStringOntoStack("passCnt",0);
+    stack.pushNumberOntoStack(loopCnt);
+    stack.insertDataIntoStackTable();
+    stack.pushStringOntoStack("totalPasses",0);
+    stack.pushNumberOntoStack(totalLoops);
+    stack.insertDataIntoStackTable();
+    stack.pushStringOntoStack("dynStepSize",0);
+    stack.pushNumberOntoStack(inputValues[4*indices[0]+2]);
+    stack.insertDataIntoStackTable();
+    stack.pushStringOntoStack("handles",0);
+    stack.pushInt32ArrayTableOntoStack(&handles[0],int(n));
+    stack.insertDataIntoStackTable();
+    stack.pushStringOntoStack("flags",0); // bit0: revolute, bit1: cyclic
+    stack.pushInt32ArrayTableOntoStack(&flags[0],int(n));
+    stack.insertDataIntoStackTable();
+    for (size_t k=0;k<9;k++)
+    {
+        stack.pushStringOntoStack(arrayNames[k],0);
+        stack.pushFloatArrayTableOntoStack(&data[k*n],int(n));
+        stack.insertDataIntoStackTable();
+    }
+
+    if (script->callScriptFunction(JOINT_BATCH_CALLBACK_FUNCTION,&stack)!=0)
+        return(false);
+    if (stack.getStackSize()==0)
+        return(false);
+    if (stack.getStackSize()>1)
+        stack.moveStackItemToTop(0);
+    std::vector<float> forces(n);
+    std::vector<float> velocities(n);
+    if ( (!stack.getStackMapFloatArray("force",&forces[0],int(n)))||(!stack.getStackMapFloatArray("velocity",&velocities[0],int(n))) )
+        return(false);
+    for (size_t j=0;j<n;j++)
+    {
+        outputValues[2*indices[j]+0]=velocities[j];
+        outputValues[2*indices[j]+1]=forces[j];
+    }
+    return(true);
+}
+
+bool CJoint::_handleDynJointControl_plugins(bool init,int loopCnt,int totalLoops,float currentPos,float effort,float dynStepSize,float errorV,float& velocity,float& forceTorque) const
+{ // returns true if a plugin handled the joint
     bool rev=(_jointType==sim_joint_revolute_subtype);
     bool cycl=_positionIsCyclic;
     float lowL=_jointMinPosition;
@@ -1223,7 +1459,6 @@ void CJoint::handleDynJointControl(bool init,int loopCnt,int totalLoops,float cu
     float maxForce=_dynamicMotorMaximumForce;
     float upperLimitVel=_dynamicMotorUpperLimitVelocity;
 
-    // We check if a plugin wants to handle the joint controller:
     bool handleJointHere=true;
     int callbackCount=(int)getAllJointCtrlCallbacks().size();
     if (callbackCount!=0)
@@ -1270,153 +1505,170 @@ void CJoint::handleDynJointControl(bool init,int loopCnt,int totalLoops,float cu
             }
         }
     }
+    return(!handleJointHere);
+}
 
-    if (handleJointHere)
-    { // The plugins didn't want to handle that joint
-        CLuaScriptObject* script=App::currentWorld->embeddedScriptContainer->getScriptFromObjectAttachedTo_child(getObjectHandle());
+bool CJoint::_handleDynJointControl_scripts(bool init,int loopCnt,int totalLoops,float currentPos,float effort,float dynStepSize,float errorV,float& velocity,float& forceTorque) const
+{ // returns true if the attached child or customization script handled the joint (new calling method)
+    bool rev=(_jointType==sim_joint_revolute_subtype);
+    bool cycl=_positionIsCyclic;
+    float lowL=_jointMinPosition;
+    float highL=_jointMinPosition+_jointPositionRange;
+    float targetPos=_dynamicMotorPositionControl_targetPosition;
+    float targetVel=_dynamicMotorTargetVelocity;
+    float maxForce=_dynamicMotorMaximumForce;
+    float upperLimitVel=_dynamicMotorUpperLimitVelocity;
+
+    CLuaScriptObject* script=App::currentWorld->embeddedScriptContainer->getScriptFromObjectAttachedTo_child(getObjectHandle());
+    if (script!=nullptr)
+    {
+        if (!script->getContainsJointCallbackFunction())
+            script=nullptr;
+    }
+    CLuaScriptObject* cScript=App::currentWorld->embeddedScriptContainer->getScriptFromObjectAttachedTo_customization(getObjectHandle());
+    if (cScript!=nullptr)
+    {
+        if (!cScript->getContainsJointCallbackFunction())
+            cScript=nullptr;
+    }
+    if ( (script!=nullptr)||(cScript!=nullptr) )
+    { // a child or customization scripts want to handle the joint (new calling method)
+        // 1. We prepare the in/out stacks:
+        CInterfaceStack inStack;
+        inStack.pushTableOntoStack();
+        inStack.pushStringOntoStack("first",0);
+        inStack.pushBoolOntoStack(init);
+        inStack.insertDataIntoStackTable();
+        inStack.pushStringOntoStack("revolute",0);
+        inStack.pushBoolOntoStack(rev);
+        inStack.insertDataIntoStackTable();
+        inStack.pushStringOntoStack("cyclic",0);
+        inStack.pushBoolOntoStack(cycl);
+        inStack.insertDataIntoStackTable();
+        inStack.pushStringOntoStack("handle",0);
+        inStack.pushNumberOntoStack(getObjectHandle());
+        inStack.insertDataIntoStackTable();
+        inStack.pushStringOntoStack("lowLimit",0);
+        inStack.pushNumberOntoStack(lowL);
+        inStack.insertDataIntoStackTable();
+        inStack.pushStringOntoStack("highLimit",0);
+        inStack.pushNumberOntoStack(highL);
+        inStack.insertDataIntoStackTable();
+        inStack.pushStringOntoStack("passCnt",0);
+        inStack.pushNumberOntoStack(loopCnt);
+        inStack.insertDataIntoStackTable();
+        inStack.pushStringOntoStack("totalPasses",0);
+        inStack.pushNumberOntoStack(totalLoops);
+        inStack.insertDataIntoStackTable();
+        inStack.pushStringOntoStack("currentPos",0);
+        inStack.pushNumberOntoStack(currentPos);
+        inStack.insertDataIntoStackTable();
+        inStack.pushStringOntoStack("targetPos",0);
+        inStack.pushNumberOntoStack(targetPos);
+        inStack.insertDataIntoStackTable();
+        inStack.pushStringOntoStack("errorValue",0);
+        inStack.pushNumberOntoStack(errorV);
+        inStack.insertDataIntoStackTable();
+        inStack.pushStringOntoStack("effort",0);
+        inStack.pushNumberOntoStack(effort);
+        inStack.insertDataIntoStackTable();
+        inStack.pushStringOntoStack("dynStepSize",0);
+        inStack.pushNumberOntoStack(dynStepSize);
+        inStack.insertDataIntoStackTable();
+        inStack.pushStringOntoStack("targetVel",0);
+        inStack.pushNumberOntoStack(targetVel);
+        inStack.insertDataIntoStackTable();
+        inStack.pushStringOntoStack("maxForce",0);
+        inStack.pushNumberOntoStack(maxForce);
+        inStack.insertDataIntoStackTable();
+        inStack.pushStringOntoStack("velUpperLimit",0);
+        inStack.pushNumberOntoStack(upperLimitVel);
+        inStack.insertDataIntoStackTable();
+        CInterfaceStack outStack;
+
+        // 2. Call the script(s):
         if (script!=nullptr)
+            script->callChildScript(sim_syscb_jointcallback,&inStack,&outStack);
+        if ( (cScript!=nullptr)&&(outStack.getStackSize()==0) )
+            cScript->callCustomizationScript(sim_syscb_jointcallback,&inStack,&outStack);
+        // 3. Collect the return values:
+        if (outStack.getStackSize()>0)
         {
-            if (!script->getContainsJointCallbackFunction())
-                script=nullptr;
-        }
-        CLuaScriptObject* cScript=App::currentWorld->embeddedScriptContainer->getScriptFromObjectAttachedTo_customization(getObjectHandle());
-        if (cScript!=nullptr)
-        {
-            if (!cScript->getContainsJointCallbackFunction())
-                cScript=nullptr;
+            int s=outStack.getStackSize();
+            if (s>1)
+                outStack.moveStackItemToTop(0);
+            outStack.getStackMapFloatValue("force",forceTorque);
+            outStack.getStackMapFloatValue("velocity",velocity);
         }
-        if ( (script!=nullptr)||(cScript!=nullptr) )
-        { // a child or customization scripts want to handle the joint (new calling method)
-            // 1. We prepare the in/out stacks:
-            CInterfaceStack inStack;
-            inStack.pushTableOntoStack();
-            inStack.pushStringOntoStack("first",0);
-            inStack.pushBoolOntoStack(init);
-            inStack.insertDataIntoStackTable();
-            inStack.pushStringOntoStack("revolute",0);
-            inStack.pushBoolOntoStack(rev);
-            inStack.insertDataIntoStackTable();
-            inStack.pushStringOntoStack("cyclic",0);
-            inStack.pushBoolOntoStack(cycl);
-            inStack.insertDataIntoStackTable();
-            inStack.pushStringOntoStack("handle",0);
-            inStack.pushNumberOntoStack(getObjectHandle());
-            inStack.insertDataIntoStackTable();
-            inStack.pushStringOntoStack("lowLimit",0);
-            inStack.pushNumberOntoStack(lowL);
-            inStack.insertDataIntoStackTable();
-            inStack.pushStringOntoStack("highLimit",0);
-            inStack.pushNumberOntoStack(highL);
-            inStack.insertDataIntoStackTable();
-            inStack.pushStringOntoStack("passCnt",0);
-            inStack.pushNumberOntoStack(loopCnt);
-            inStack.insertDataIntoStackTable();
-            inStack.pushStringOntoStack("totalPasses",0);
-            inStack.pushNumberOntoStack(totalLoops);
-            inStack.insertDataIntoStackTable();
-            inStack.pushStringOntoStack("currentPos",0);
-            inStack.pushNumberOntoStack(currentPos);
-            inStack.insertDataIntoStackTable();
-            inStack.pushStringOntoStack("targetPos",0);
-            inStack.pushNumberOntoStack(targetPos);
-            inStack.insertDataIntoStackTable();
-            inStack.pushStringOntoStack("errorValue",0);
-            inStack.pushNumberOntoStack(errorV);
-            inStack.insertDataIntoStackTable();
-            inStack.pushStringOntoStack("effort",0);
-            inStack.pushNumberOntoStack(effort);
-            inStack.insertDataIntoStackTable();
-            inStack.pushStringOntoStack("dynStepSize",0);
-            inStack.pushNumberOntoStack(dynStepSize);
-            inStack.insertDataIntoStackTable();
-            inStack.pushStringOntoStack("targetVel",0);
-            inStack.pushNumberOntoStack(targetVel);
-            inStack.insertDataIntoStackTable();
-            inStack.pushStringOntoStack("maxForce",0);
-            inStack.pushNumberOntoStack(maxForce);
-            inStack.insertDataIntoStackTable();
-            inStack.pushStringOntoStack("velUpperLimit",0);
-            inStack.pushNumberOntoStack(upperLimitVel);
-            inStack.insertDataIntoStackTable();
-            CInterfaceStack outStack;
-
-            // 2. Call the script(s):
-            if (script!=nullptr)
-                script->callChildScript(sim_syscb_jointcallback,&inStack,&outStack);
-            if ( (cScript!=nullptr)&&(outStack.getStackSize()==0) )
-                cScript->callCustomizationScript(sim_syscb_jointcallback,&inStack,&outStack);
-            // 3. Collect the return values:
-            if (outStack.getStackSize()>0)
-            {
-                int s=outStack.getStackSize();
-                if (s>1)
-                    outStack.moveStackItemToTop(0);
-                outStack.getStackMapFloatValue("force",forceTorque);
-                outStack.getStackMapFloatValue("velocity",velocity);
-            }
-        }
-        else
-        { // there doesn't seem to be any appropriate function for joint handling in the attached child or customization scripts
-            // we have the built-in control (position PID or spring-damper KC)
-            // Following 9 new since 7/5/2014:
-            float P=_dynamicMotorPositionControl_P;
-            float I=_dynamicMotorPositionControl_I;
-            float D=_dynamicMotorPositionControl_D;
-            if (spring)
-            {
-                P=_dynamicMotorSpringControl_K/maxForce;
-                I=0.0f;
-                D=_dynamicMotorSpringControl_C/maxForce;
-            }
+        return(true);
+    }
+    return(false);
+}
 
-            if (init)
-                _dynamicMotorPIDCumulativeErrorForIntegralParameter=0.0f;
+void CJoint::_handleDynJointControl_builtIn(bool init,float dynStepSize,float errorV,float& velocity,float& forceTorque)
+{ // we have the built-in control (position PID or spring-damper KC)
+    bool spring=_dynamicMotorPositionControl_torqueModulation;
+    float targetVel=_dynamicMotorTargetVelocity;
+    float maxForce=_dynamicMotorMaximumForce;
+    float upperLimitVel=_dynamicMotorUpperLimitVelocity;
 
-            float e=errorV;
+    // Following 9 new since 7/5/2014:
+    float P=_dynamicMotorPositionControl_P;
+    float I=_dynamicMotorPositionControl_I;
+    float D=_dynamicMotorPositionControl_D;
+    if (spring)
+    {
+        P=_dynamicMotorSpringControl_K/maxForce;
+        I=0.0f;
+        D=_dynamicMotorSpringControl_C/maxForce;
+    }
 
-            // Proportional part:
-            float ctrl=e*P;
+    if (init)
+        _dynamicMotorPIDCumulativeErrorForIntegralParameter=0.0f;
 
-            // Integral part:
-            if (I!=0.0f) // so that if we turn the integral part on, we don't try to catch up all the past errors!
-                _dynamicMotorPIDCumulativeErrorForIntegralParameter+=e*dynStepSize; // '*dynStepSize'  was forgotten and added on 7/5/2014. The I term is corrected during load operation.
-            else
-                _dynamicMotorPIDCumulativeErrorForIntegralParameter=0.0f; // added on 2009/11/29
-            ctrl+=_dynamicMotorPIDCumulativeErrorForIntegralParameter*I;
+    float e=errorV;
 
-            // Derivative part:
-            if (!init) // this condition was forgotten. Added on 7/5/2014
-                ctrl+=(e-_dynamicMotorPIDLastErrorForDerivativeParameter)*D/dynStepSize; // '/dynStepSize' was forgotten and added on 7/5/2014. The D term is corrected during load operation.
-            _dynamicMotorPIDLastErrorForDerivativeParameter=e;
+    // Proportional part:
+    float ctrl=e*P;
 
-            if (spring)
-            { // "spring" mode, i.e. force modulation mode
-                float vel=fabs(targetVel);
-                if (ctrl<0.0f)
-                    vel=-vel;
+    // Integral part:
+    if (I!=0.0f) // so that if we turn the integral part on, we don't try to catch up all the past errors!
+        _dynamicMotorPIDCumulativeErrorForIntegralParameter+=e*dynStepSize; // '*dynStepSize'  was forgotten and added on 7/5/2014. The I term is corrected during load operation.
+    else
+        _dynamicMotorPIDCumulativeErrorForIntegralParameter=0.0f; // added on 2009/11/29
+    ctrl+=_dynamicMotorPIDCumulativeErrorForIntegralParameter*I;
 
-                forceTorque=fabs(ctrl)*maxForce;
+    // Derivative part:
+    if (!init) // this condition was forgotten. Added on 7/5/2014
+        ctrl+=(e-_dynamicMotorPIDLastErrorForDerivativeParameter)*D/dynStepSize; // '/dynStepSize' was forgotten and added on 7/5/2014. The D term is corrected during load operation.
+    _dynamicMotorPIDLastErrorForDerivativeParameter=e;
 
-                // Following 2 lines new since 7/5/2014:
-                if (forceTorque>maxForce)
-                    forceTorque=maxForce;
+    if (spring)
+    { // "spring" mode, i.e. force modulation mode
+        float vel=fabs(targetVel);
+        if (ctrl<0.0f)
+            vel=-vel;
 
-                velocity=vel;
-            }
-            else
-            { // regular position control (i.e. built-in PID)
-                // We calculate the velocity needed to reach the position in one time step:
-                float vel=ctrl/dynStepSize;
-                float maxVel=upperLimitVel;
-                if (vel>maxVel)
-                    vel=maxVel;
-                if (vel<-maxVel)
-                    vel=-maxVel;
-
-                forceTorque=maxForce;
-                velocity=vel;
-            }
-        }
+        forceTorque=fabs(ctrl)*maxForce;
+
+        // Following 2 lines new since 7/5/2014:
+        if (forceTorque>maxForce)
+            forceTorque=maxForce;
+
+        velocity=vel;
+    }
+    else
+    { // regular position control (i.e. built-in PID)
+        // We calculate the velocity needed to reach the position in one time step:
+        float vel=ctrl/dynStepSize;
+        float maxVel=upperLimitVel;
+        if (vel>maxVel)
+            vel=maxVel;
+        if (vel<-maxVel)
+            vel=-maxVel;
+
+        forceTorque=maxForce;
+        velocity=vel;
     }
 }
 
@@ -2,6 +2,10 @@
 
 #include "_jointObject_.h"
 
+#define JOINT_BATCH_CALLBACK_FUNCTION "sysCall_jointCallbackBatch"
+
+class CLuaScriptObject;
+
 class CJoint : public _CJoint_
 {
 public:
@@ -86,6 +90,9 @@ public:
     void getDynamicJointErrorsFull(C3Vector& linear,C3Vector& angular) const;
 
     void handleDynJointControl(bool init,int loopCnt,int totalLoops,float currentPos,float effort,float dynStepSize,float errorV,float& velocity,float& forceTorque);
+    static void handleDynJointControls(const std::vector<CJoint*>& joints,bool init,int loopCnt,int totalLoops,const float* inputValues,float* outputValues);
+    void setBatchControlScriptHandle(int scriptHandle);
+    int getBatchControlScriptHandle() const;
 
     void setDynamicMotorReflectedPosition_useOnlyFromDynamicPart(float rfp);
 
@@ -133,6 +140,12 @@ public:
 
 protected:
     void _rectifyDependentJoints(bool useTempValues);
+    bool _handleDynJointControl_plugins(bool init,int loopCnt,int totalLoops,float currentPos,float effort,float dynStepSize,float errorV,float& velocity,float& forceTorque) const;
+    bool _handleDynJointControl_scripts(bool init,int loopCnt,int totalLoops,float currentPos,float effort,float dynStepSize,float errorV,float& velocity,float& forceTorque) const;
+    void _handleDynJointControl_builtIn(bool init,float dynStepSize,float errorV,float& velocity,float& forceTorque);
+    CLuaScriptObject* _getBatchControlScript() const;
+    static void _handleDynJointControl_batchPlugins(const std::vector<CJoint*>& joints,bool init,int loopCnt,int totalLoops,const float* inputValues,float* outputValues,int* results);
+    static bool _handleDynJointControl_batchScript(CLuaScriptObject* script,const std::vector<CJoint*>& joints,const std::vector<size_t>& indices,bool init,int loopCnt,int totalLoops,const float* inputValues,float* outputValues);
 
 private:
     void _commonInit();
@@ -155,6 +168,7 @@ private:
 
     float _dynamicMotorPIDCumulativeErrorForIntegralParameter;
     float _dynamicMotorPIDLastErrorForDerivativeParameter;
+    int _batchControlScriptHandle; // not serialized. -1: the joint is not controlled via JOINT_BATCH_CALLBACK_FUNCTION
 
     std::string _dependencyJointLoadName;
 
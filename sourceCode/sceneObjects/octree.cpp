@@ -222,16 +222,21 @@ void COctree::insertPointCloud(const CPointCloud* pointCloud,unsigned int theTag
     TRACE_INTERNAL;
     if (pointCloud->getPointCloudInfo()!=nullptr)
     {
-        const std::vector<float>* _pts=pointCloud->getPoints();
         C7Vector tr(pointCloud->getFullCumulativeTransformation());
         std::vector<float> pts;
-        for (size_t i=0;i<_pts->size()/3;i++)
+        std::vector<float> buffer;
+        for (size_t i=0;i<pointCloud->getPointChunkCount();i++)
         {
-            C3Vector v(&_pts->at(3*i));
-            v*=tr;
-            pts.push_back(v(0));
-            pts.push_back(v(1));
-            pts.push_back(v(2));
+            size_t first,cnt;
+            const float* _pts=pointCloud->getPointChunk(i,buffer,first,cnt);
+            for (size_t j=0;j<cnt;j++)
+            {
+                C3Vector v(_pts+3*j);
+                v*=tr;
+                pts.push_back(v(0));
+                pts.push_back(v(1));
+                pts.push_back(v(2));
+            }
         }
         insertPoints(&pts[0],(int)pts.size()/3,false,nullptr,false,nullptr,theTag);
     }
@@ -340,16 +345,21 @@ void COctree::subtractPointCloud(const CPointCloud* pointCloud)
     TRACE_INTERNAL;
     if (pointCloud->getPointCloudInfo()!=nullptr)
     {
-        const std::vector<float>* _pts=pointCloud->getPoints();
         C7Vector tr(pointCloud->getFullCumulativeTransformation());
         std::vector<float> pts;
-        for (size_t i=0;i<_pts->size()/3;i++)
+        std::vector<float> buffer;
+        for (size_t i=0;i<pointCloud->getPointChunkCount();i++)
         {
-            C3Vector v(&_pts->at(3*i));
-            v*=tr;
-            pts.push_back(v(0));
-            pts.push_back(v(1));
-            pts.push_back(v(2));
+            size_t first,cnt;
+            const float* _pts=pointCloud->getPointChunk(i,buffer,first,cnt);
+            for (size_t j=0;j<cnt;j++)
+            {
+                C3Vector v(_pts+3*j);
+                v*=tr;
+                pts.push_back(v(0));
+                pts.push_back(v(1));
+                pts.push_back(v(2));
+            }
         }
         subtractPoints(&pts[0],(int)pts.size()/3,false);
     }
@@ -10,6 +10,7 @@
 #include "vDateTime.h"
 #include "app.h"
 #include "pointCloudRendering.h"
+#include <algorithm>
 
 CPointCloud::CPointCloud()
 {
@@ -36,6 +37,12 @@ CPointCloud::CPointCloud()
     _insertionDistanceTolerance=0.0;
     _nonEmptyCells=0;
     _pointDisplayRatio=1.0;
+    _quantizePositions=false;
+    _quantizationStep=_cellSize/POINTCLOUD_QUANTIZATION_STEPS_PER_CELL;
+    _expandedPointsAreValid=false;
+    _mirrorIsValid=true;
+    _knownPointCount=-1;
+    _displaySubsetIsValid=true;
 
     clear(); // also sets the _minDim and _maxDim values
 }
@@ -66,53 +73,290 @@ void CPointCloud::getMaxMinDims(C3Vector& ma,C3Vector& mi) const
     mi=_minDim;
 }
 
-std::vector<float>* CPointCloud::getColors()
+const std::vector<unsigned char>* CPointCloud::getColors()
 {
+    _updateMirrorIfNeeded();
     return(&_colors);
 }
 
-std::vector<float>* CPointCloud::getDisplayPoints()
+const std::vector<float>* CPointCloud::getDisplayPoints()
 {
+    _updateDisplaySubsetIfNeeded();
     return(&_displayPoints);
 }
 
-std::vector<float>* CPointCloud::getDisplayColors()
+const std::vector<unsigned char>* CPointCloud::getDisplayColors()
 {
+    _updateDisplaySubsetIfNeeded();
     return(&_displayColors);
 }
 
-void CPointCloud::_readPositionsAndColorsAndSetDimensions()
+int CPointCloud::getPointCount()
+{ // avoids reading the mirror back when the point count is known
+    if ( (!_mirrorIsValid)&&(_knownPointCount>=0) )
+        return(_knownPointCount);
+    _updateMirrorIfNeeded();
+    return(int(_getStoredPointCount()));
+}
+
+size_t CPointCloud::getPointChunkCount() const
 {
-    _displayPoints.clear();
-    _displayColors.clear();
-    if (_doNotUseOctreeStructure)
+    ((CPointCloud*)this)->_updateMirrorIfNeeded();
+    if (_quantizePositions)
+        return(_quantizedBlocks.size());
+    return((_points.size()/3+POINTCLOUD_CHUNK_SIZE-1)/POINTCLOUD_CHUNK_SIZE);
+}
+
+const float* CPointCloud::getPointChunk(size_t chunkIndex,std::vector<float>& buffer,size_t& firstPoint,size_t& pointCount) const
+{ // Positions of a chunk, relative to the point cloud. Quantized positions are expanded into buffer,
+  // so that large point clouds can be visited without a full float copy
+    if (!_quantizePositions)
     {
-        _nonEmptyCells=0;
-        if (_useRandomColors)
+        firstPoint=chunkIndex*POINTCLOUD_CHUNK_SIZE;
+        pointCount=std::min<size_t>(POINTCLOUD_CHUNK_SIZE,_points.size()/3-firstPoint);
+        return(&_points[3*firstPoint]);
+    }
+    const SPointCloudBlock& block=_quantizedBlocks[chunkIndex];
+    firstPoint=block.firstPoint;
+    if (chunkIndex+1<_quantizedBlocks.size())
+        pointCount=_quantizedBlocks[chunkIndex+1].firstPoint-firstPoint;
+    else
+        pointCount=_quantizedPoints.size()/3-firstPoint;
+    buffer.resize(pointCount*3);
+    const unsigned short* q=&_quantizedPoints[3*firstPoint];
+    for (size_t i=0;i<pointCount;i++)
+    {
+        buffer[3*i+0]=block.origin(0)+float(q[3*i+0])*_quantizationStep;
+        buffer[3*i+1]=block.origin(1)+float(q[3*i+1])*_quantizationStep;
+        buffer[3*i+2]=block.origin(2)+float(q[3*i+2])*_quantizationStep;
+    }
+    return(&buffer[0]);
+}
+
+bool CPointCloud::getQuantizePositions() const
+{
+    return(_quantizePositions);
+}
+
+void CPointCloud::setQuantizePositions(bool q)
+{
+    if (q!=_quantizePositions)
+    {
+        _updateMirrorIfNeeded();
+        std::vector<float> pts;
+        _expandStoredPoints(pts);
+        _clearStoredPoints();
+        _quantizePositions=q;
+        if (pts.size()>0)
+            _appendStoredPoints(&pts[0],pts.size()/3);
+    }
+}
+
+float CPointCloud::getQuantizationStep() const
+{ // max. quantization error is half a step
+    if (_quantizedPoints.size()>0)
+        return(_quantizationStep);
+    return(_cellSize/POINTCLOUD_QUANTIZATION_STEPS_PER_CELL);
+}
+
+size_t CPointCloud::_getStoredPointCount() const
+{
+    if (_quantizePositions)
+        return(_quantizedPoints.size()/3);
+    return(_points.size()/3);
+}
+
+void CPointCloud::_clearStoredPoints()
+{
+    _points.clear();
+    _quantizedPoints.clear();
+    _quantizedBlocks.clear();
+    _expandedPoints.clear();
+    _expandedPointsAreValid=false;
+}
+
+void CPointCloud::_appendStoredPoints(const float* pts,size_t ptsCnt)
+{ // Quantized positions are 16-bit, relative to the origin of their block. Block origins
+  // lie on the quantization grid, so that expanding and re-quantizing does not drift
+    _expandedPointsAreValid=false;
+    if (!_quantizePositions)
+    {
+        _points.insert(_points.end(),pts,pts+ptsCnt*3);
+        return;
+    }
+    if (_quantizedPoints.size()==0)
+    {
+        _quantizedBlocks.clear();
+        _quantizationStep=_cellSize/POINTCLOUD_QUANTIZATION_STEPS_PER_CELL;
+    }
+    _quantizedPoints.reserve(_quantizedPoints.size()+ptsCnt*3);
+    for (size_t i=0;i<ptsCnt;i++)
+    {
+        float q[3];
+        bool newBlock=(_quantizedBlocks.size()==0);
+        if (!newBlock)
         {
-            _colors.clear();
-            for (size_t i=0;i<_points.size()/3;i++)
+            const SPointCloudBlock& block=_quantizedBlocks[_quantizedBlocks.size()-1];
+            newBlock=(_quantizedPoints.size()/3-block.firstPoint>=POINTCLOUD_CHUNK_SIZE);
+            for (size_t j=0;j<3;j++)
             {
-                _colors.push_back(0.2f+SIM_RAND_FLOAT*0.8f);
-                _colors.push_back(0.2f+SIM_RAND_FLOAT*0.8f);
-                _colors.push_back(0.2f+SIM_RAND_FLOAT*0.8f);
-                _colors.push_back(0.0);
+                q[j]=(pts[3*i+j]-block.origin(j))/_quantizationStep+0.5f;
+                newBlock=newBlock||(q[j]<0.0f)||(q[j]>=65535.0f);
             }
         }
+        if (newBlock)
+        {
+            SPointCloudBlock block;
+            for (size_t j=0;j<3;j++)
+                block.origin(j)=(floor(pts[3*i+j]/_quantizationStep+0.5f)-32767.0f)*_quantizationStep;
+            block.firstPoint=_quantizedPoints.size()/3;
+            _quantizedBlocks.push_back(block);
+            for (size_t j=0;j<3;j++)
+                q[j]=tt::getLimitedFloat(0.0f,65535.0f,(pts[3*i+j]-block.origin(j))/_quantizationStep+0.5f);
+        }
+        _quantizedPoints.push_back((unsigned short)q[0]);
+        _quantizedPoints.push_back((unsigned short)q[1]);
+        _quantizedPoints.push_back((unsigned short)q[2]);
+    }
+}
 
-        for (size_t i=0;i<_points.size()/3;i++)
+void CPointCloud::_expandStoredPoints(std::vector<float>& pts) const
+{
+    if (!_quantizePositions)
+        pts.assign(_points.begin(),_points.end());
+    else
+    {
+        pts.clear();
+        pts.reserve(_quantizedPoints.size());
+        std::vector<float> buffer;
+        for (size_t i=0;i<_quantizedBlocks.size();i++)
         {
-            C3Vector p(&_points[3*i]);
-            if (i==0)
-            {
-                _minDim=p;
-                _maxDim=p;
-            }
+            size_t first,cnt;
+            const float* p=getPointChunk(i,buffer,first,cnt);
+            pts.insert(pts.end(),p,p+cnt*3);
+        }
+    }
+}
+
+void CPointCloud::_updateMirrorIfNeeded()
+{ // _points and _colors are only read back from the calculation structure when needed
+    if (!_mirrorIsValid)
+        _readPositionsAndColorsAndSetDimensions();
+}
+
+void CPointCloud::_updateDisplaySubsetIfNeeded()
+{
+    if (!_displaySubsetIsValid)
+    {
+        _displayPoints.clear();
+        _displayColors.clear();
+        if ( (!_doNotUseOctreeStructure)&&(_pointCloudInfo!=nullptr)&&(_pointDisplayRatio<0.99f) )
+        {
+            std::vector<float> cols;
+            CPluginContainer::geomPlugin_getPtcloudPoints(_pointCloudInfo,_displayPoints,&cols,_pointDisplayRatio);
+            if (_useRandomColors)
+                _appendRandomColors(_displayColors,_displayPoints.size()/3);
             else
-            {
-                _minDim.keepMin(p);
-                _maxDim.keepMax(p);
-            }
+                _floatToCharColors(cols,_displayColors);
+        }
+        _displaySubsetIsValid=true;
+    }
+}
+
+void CPointCloud::_appendRandomColors(std::vector<unsigned char>& colors,size_t pointCount)
+{
+    colors.reserve(colors.size()+pointCount*3);
+    for (size_t i=0;i<pointCount*3;i++)
+        colors.push_back((unsigned char)((0.2f+SIM_RAND_FLOAT*0.8f)*255.1f));
+}
+
+void CPointCloud::_appendToMirror(const float* pts,int ptsCnt,const unsigned char* optionalColors3,bool colorsAreIndividual)
+{ // pts are relative to the point cloud
+    _appendStoredPoints(pts,size_t(ptsCnt));
+    if (_useRandomColors)
+        _appendRandomColors(_colors,size_t(ptsCnt));
+    else
+    {
+        unsigned char defaultCol[3];
+        if (optionalColors3==nullptr)
+        {
+            for (size_t j=0;j<3;j++)
+                defaultCol[j]=(unsigned char)(color.getColorsPtr()[j]*255.1f);
+            optionalColors3=defaultCol;
+            colorsAreIndividual=false;
+        }
+        if (colorsAreIndividual)
+            _colors.insert(_colors.end(),optionalColors3,optionalColors3+ptsCnt*3);
+        else
+        {
+            _colors.reserve(_colors.size()+ptsCnt*3);
+            for (int i=0;i<ptsCnt;i++)
+                _colors.insert(_colors.end(),optionalColors3,optionalColors3+3);
+        }
+    }
+}
+
+void CPointCloud::_extendDimensions(const float* pts,int ptsCnt,bool wasEmpty)
+{
+    for (int i=0;i<ptsCnt;i++)
+    {
+        C3Vector p(pts+3*i);
+        if (wasEmpty&&(i==0))
+        {
+            _minDim=p;
+            _maxDim=p;
+        }
+        else
+        {
+            _minDim.keepMin(p);
+            _maxDim.keepMax(p);
+        }
+    }
+}
+
+void CPointCloud::_calculationStructureChanged(int removedPointCount)
+{ // after a removal. The dimensions stay as they are (i.e. conservative) until the mirror is read again
+    if (_pointCloudInfo==nullptr)
+        clear();
+    else
+    {
+        int previousCount=-1;
+        if (_mirrorIsValid)
+            previousCount=int(_getStoredPointCount());
+        else
+            previousCount=_knownPointCount;
+        _knownPointCount=-1;
+        _nonEmptyCells=-1;
+        if ( (previousCount>=0)&&(removedPointCount>=0)&&(removedPointCount<=previousCount) )
+            _knownPointCount=previousCount-removedPointCount;
+        _mirrorIsValid=false;
+        _displaySubsetIsValid=false;
+    }
+}
+
+void CPointCloud::_readPositionsAndColorsAndSetDimensions()
+{ // reads everything back from the calculation structure. Expensive with large point clouds
+    if (_doNotUseOctreeStructure)
+    { // _points and _colors are the reference in that case
+        _mirrorIsValid=true;
+        return;
+    }
+    _clearStoredPoints();
+    _colors.clear();
+    if (_pointCloudInfo!=nullptr)
+    {
+        _nonEmptyCells=CPluginContainer::geomPlugin_getPtcloudNonEmptyCellCount(_pointCloudInfo);
+        std::vector<float> pts;
+        std::vector<float> cols;
+        CPluginContainer::geomPlugin_getPtcloudPoints(_pointCloudInfo,pts,&cols);
+        if (_useRandomColors)
+            _appendRandomColors(_colors,pts.size()/3);
+        else
+            _floatToCharColors(cols,_colors);
+        if (pts.size()>0)
+        {
+            _extendDimensions(&pts[0],int(pts.size()/3),true);
+            _appendStoredPoints(&pts[0],pts.size()/3);
         }
         /*
         _minDim(0)-=_cellSize; // not *0.5 here! The point could lie on the other side of the cube (i.e. not centered)
@@ -122,67 +366,15 @@ void CPointCloud::_readPositionsAndColorsAndSetDimensions()
         _maxDim(1)+=_cellSize;
         _maxDim(2)+=_cellSize;
         */
+        _mirrorIsValid=true;
+        _knownPointCount=-1;
+        _displaySubsetIsValid=false;
     }
     else
-    {
-        _points.clear();
-        _colors.clear();
-        if (_pointCloudInfo!=nullptr)
-        {
-            _nonEmptyCells=CPluginContainer::geomPlugin_getPtcloudNonEmptyCellCount(_pointCloudInfo);
-
-            CPluginContainer::geomPlugin_getPtcloudPoints(_pointCloudInfo,_points,&_colors);
-            if (_pointDisplayRatio<0.99f)
-                CPluginContainer::geomPlugin_getPtcloudPoints(_pointCloudInfo,_displayPoints,&_displayColors,_pointDisplayRatio);
-            if (_useRandomColors)
-            {
-                _colors.clear();
-                for (size_t i=0;i<_points.size()/3;i++)
-                {
-                    _colors.push_back(0.2f+SIM_RAND_FLOAT*0.8f);
-                    _colors.push_back(0.2f+SIM_RAND_FLOAT*0.8f);
-                    _colors.push_back(0.2f+SIM_RAND_FLOAT*0.8f);
-                    _colors.push_back(0.0);
-                }
-                _displayColors.clear();
-                for (size_t i=0;i<_displayPoints.size()/3;i++)
-                {
-                    _displayColors.push_back(0.2f+SIM_RAND_FLOAT*0.8f);
-                    _displayColors.push_back(0.2f+SIM_RAND_FLOAT*0.8f);
-                    _displayColors.push_back(0.2f+SIM_RAND_FLOAT*0.8f);
-                    _displayColors.push_back(0.0);
-                }
-            }
-
-            for (size_t i=0;i<_points.size()/3;i++)
-            {
-                C3Vector p(&_points[3*i]);
-                if (i==0)
-                {
-                    _minDim=p;
-                    _maxDim=p;
-                }
-                else
-                {
-                    _minDim.keepMin(p);
-                    _maxDim.keepMax(p);
-                }
-            }
-            /*
-            _minDim(0)-=_cellSize; // not *0.5 here! The point could lie on the other side of the cube (i.e. not centered)
-            _minDim(1)-=_cellSize;
-            _minDim(2)-=_cellSize;
-            _maxDim(0)+=_cellSize;
-            _maxDim(1)+=_cellSize;
-            _maxDim(2)+=_cellSize;
-            */
-        }
-        else
-            clear();
-    }
+        clear();
 }
 
-void CPointCloud::_getCharRGB3Colors(const std::vector<float>& floatRGBA,std::vector<unsigned char>& charRGB)
+void CPointCloud::_floatToCharColors(const std::vector<float>& floatRGBA,std::vector<unsigned char>& charRGB)
 {
     charRGB.resize(floatRGBA.size()*3/4);
     for (size_t i=0;i<floatRGBA.size()/4;i++)
@@ -219,7 +411,8 @@ int CPointCloud::removePoints(const float* pts,int ptsCnt,bool ptsAreRelativeToP
             CPluginContainer::geomPlugin_destroyPtcloud(_pointCloudInfo);
             _pointCloudInfo=nullptr;
         }
-        _readPositionsAndColorsAndSetDimensions();
+        if ( (pointCntRemoved!=0)||(_pointCloudInfo==nullptr) )
+            _calculationStructureChanged(pointCntRemoved);
     }
     return(pointCntRemoved);
 }
@@ -263,13 +456,14 @@ void CPointCloud::subtractOctree(const void* octree2Info,const C7Vector& octree2
     TRACE_INTERNAL;
     if (_pointCloudInfo!=nullptr)
     {
-        int ptCntRemoved;
+        int ptCntRemoved=-1;
         if (CPluginContainer::geomPlugin_removeOctreeFromPtcloud(_pointCloudInfo,getFullCumulativeTransformation(),octree2Info,octree2Tr,&ptCntRemoved))
         {
             CPluginContainer::geomPlugin_destroyPtcloud(_pointCloudInfo);
             _pointCloudInfo=nullptr;
         }
-        _readPositionsAndColorsAndSetDimensions();
+        if ( (ptCntRemoved!=0)||(_pointCloudInfo==nullptr) )
+            _calculationStructureChanged(ptCntRemoved);
     }
 }
 
@@ -318,9 +512,9 @@ int CPointCloud::intersectPoints(const float* pts,int ptsCnt,bool ptsAreRelative
             CPluginContainer::geomPlugin_destroyPtcloud(_pointCloudInfo);
             _pointCloudInfo=nullptr;
         }
-        _readPositionsAndColorsAndSetDimensions();
+        _calculationStructureChanged(-1);
     }
-    return(int(_points.size()/3));
+    return(getPointCount());
 }
 
 void CPointCloud::insertPoints(const float* pts,int ptsCnt,bool ptsAreRelativeToPointCloud,const unsigned char* optionalColors3,bool colorsAreIndividual)
@@ -346,43 +540,12 @@ void CPointCloud::insertPoints(const float* pts,int ptsCnt,bool ptsAreRelativeTo
     }
     if (_doNotUseOctreeStructure)
     {
-        _points.insert(_points.end(),_pts,_pts+ptsCnt*3);
-        if (optionalColors3==nullptr)
-        {
-            for (int i=0;i<ptsCnt;i++)
-            {
-                _colors.push_back(color.getColorsPtr()[0]);
-                _colors.push_back(color.getColorsPtr()[1]);
-                _colors.push_back(color.getColorsPtr()[2]);
-                _colors.push_back(0.0);
-            }
-        }
-        else
-        {
-            if (colorsAreIndividual)
-            {
-                for (int i=0;i<ptsCnt;i++)
-                {
-                    _colors.push_back(float(optionalColors3[3*i+0])/255.1f);
-                    _colors.push_back(float(optionalColors3[3*i+1])/255.1f);
-                    _colors.push_back(float(optionalColors3[3*i+2])/255.1f);
-                    _colors.push_back(0.0);
-                }
-            }
-            else
-            {
-                for (int i=0;i<ptsCnt;i++)
-                {
-                    _colors.push_back(float(optionalColors3[0])/255.1f);
-                    _colors.push_back(float(optionalColors3[1])/255.1f);
-                    _colors.push_back(float(optionalColors3[2])/255.1f);
-                    _colors.push_back(0.0);
-                }
-            }
-        }
+        _extendDimensions(_pts,ptsCnt,_getStoredPointCount()==0);
+        _appendToMirror(_pts,ptsCnt,optionalColors3,colorsAreIndividual);
     }
     else
     {
+        bool wasEmpty=(_pointCloudInfo==nullptr);
         if (_pointCloudInfo==nullptr)
         {
             if (optionalColors3==nullptr)
@@ -413,8 +576,14 @@ void CPointCloud::insertPoints(const float* pts,int ptsCnt,bool ptsAreRelativeTo
                     CPluginContainer::geomPlugin_insertPointsIntoPtcloud(_pointCloudInfo,C7Vector::identityTransformation,_pts,ptsCnt,optionalColors3,_insertionDistanceTolerance);
             }
         }
+        // The calculation structure might have dropped points (insertion tolerance, max. point count per cell),
+        // and doesn't tell how many it kept: we read the mirror back when needed:
+        _nonEmptyCells=-1; // queried again when needed
+        _extendDimensions(_pts,ptsCnt,wasEmpty);
+        _mirrorIsValid=false;
+        _knownPointCount=-1;
+        _displaySubsetIsValid=false;
     }
-    _readPositionsAndColorsAndSetDimensions();
 }
 
 void CPointCloud::insertShape(CShape* shape)
@@ -461,24 +630,27 @@ void CPointCloud::insertDummy(const CDummy* dummy)
 void CPointCloud::insertPointCloud(const CPointCloud* pointCloud)
 {
     TRACE_INTERNAL;
-    const std::vector<float>* _pts=pointCloud->getPoints();
-    std::vector<unsigned char> _cols;
-    _cols.resize(_pts->size());
-
+    CPointCloud* other=(CPointCloud*)pointCloud;
+    const std::vector<unsigned char>* cols=other->getColors();
     C7Vector tr(pointCloud->getFullCumulativeTransformation());
     std::vector<float> pts;
-    for (size_t i=0;i<_pts->size()/3;i++)
+    std::vector<float> buffer;
+    for (size_t i=0;i<pointCloud->getPointChunkCount();i++)
     {
-        C3Vector v(&_pts->at(3*i));
-        v*=tr;
-        pts.push_back(v(0));
-        pts.push_back(v(1));
-        pts.push_back(v(2));
-        _cols[3*i+0]=(unsigned char)(pointCloud->_colors[4*i+0]*255.1f);
-        _cols[3*i+1]=(unsigned char)(pointCloud->_colors[4*i+1]*255.1f);
-        _cols[3*i+2]=(unsigned char)(pointCloud->_colors[4*i+2]*255.1f);
+        size_t first,cnt;
+        const float* p=pointCloud->getPointChunk(i,buffer,first,cnt);
+        pts.resize(cnt*3);
+        for (size_t j=0;j<cnt;j++)
+        {
+            C3Vector v(p+3*j);
+            v*=tr;
+            pts[3*j+0]=v(0);
+            pts[3*j+1]=v(1);
+            pts[3*j+2]=v(2);
+        }
+        if (cnt>0)
+            insertPoints(&pts[0],int(cnt),false,&(cols[0])[3*first],true);
     }
-    insertPoints(&pts[0],(int)pts.size()/3,false,&_cols[0],true);
 }
 
 void CPointCloud::insertObjects(const std::vector<int>& sel)
@@ -506,7 +678,7 @@ void CPointCloud::insertObject(const CSceneObject* obj)
 void CPointCloud::clear()
 {
     TRACE_INTERNAL;
-    _points.clear();
+    _clearStoredPoints();
     _colors.clear();
     _displayPoints.clear();
     _displayColors.clear();
@@ -518,18 +690,24 @@ void CPointCloud::clear()
     _minDim.set(-0.1f,-0.1f,-0.1f);
     _maxDim.set(+0.1f,+0.1f,+0.1f);
     _nonEmptyCells=0;
+    _mirrorIsValid=true;
+    _knownPointCount=-1;
+    _displaySubsetIsValid=true;
 }
 
 const std::vector<float>* CPointCloud::getPoints() const
-{
+{ // With quantized positions, returns an expanded copy that stays valid until the point cloud is modified.
+  // Prefer getPointChunk for large point clouds
     TRACE_INTERNAL;
-    return(&_points);
-}
-
-std::vector<float>* CPointCloud::getPoints()
-{
-    TRACE_INTERNAL;
-    return(&_points);
+    ((CPointCloud*)this)->_updateMirrorIfNeeded();
+    if (!_quantizePositions)
+        return(&_points);
+    if (!_expandedPointsAreValid)
+    {
+        _expandStoredPoints(_expandedPoints);
+        _expandedPointsAreValid=true;
+    }
+    return(&_expandedPoints);
 }
 
 const void* CPointCloud::getPointCloudInfo() const
@@ -598,6 +776,10 @@ void CPointCloud::scaleObject(float scalingFactor)
     _maxDim*=scalingFactor;
     for (size_t i=0;i<_points.size();i++)
         _points[i]*=scalingFactor;
+    for (size_t i=0;i<_quantizedBlocks.size();i++)
+        _quantizedBlocks[i].origin*=scalingFactor;
+    _quantizationStep*=scalingFactor;
+    _expandedPointsAreValid=false;
     for (size_t i=0;i<_displayPoints.size();i++)
         _displayPoints[i]*=scalingFactor;
     if (_pointCloudInfo!=nullptr)
@@ -617,6 +799,8 @@ void CPointCloud::removeSceneDependencies()
 
 CSceneObject* CPointCloud::copyYourself()
 {   
+    _updateMirrorIfNeeded();
+    _updateDisplaySubsetIfNeeded();
     CPointCloud* newPointcloud=(CPointCloud*)CSceneObject::copyYourself();
 
     newPointcloud->_cellSize=_cellSize;
@@ -625,7 +809,11 @@ CSceneObject* CPointCloud::copyYourself()
 
     if (_pointCloudInfo!=nullptr)
         newPointcloud->_pointCloudInfo=CPluginContainer::geomPlugin_copyPtcloud(_pointCloudInfo);
+    newPointcloud->_quantizePositions=_quantizePositions;
     newPointcloud->_points.assign(_points.begin(),_points.end());
+    newPointcloud->_quantizedPoints.assign(_quantizedPoints.begin(),_quantizedPoints.end());
+    newPointcloud->_quantizedBlocks.assign(_quantizedBlocks.begin(),_quantizedBlocks.end());
+    newPointcloud->_quantizationStep=_quantizationStep;
     newPointcloud->_colors.assign(_colors.begin(),_colors.end());
     newPointcloud->_minDim=_minDim;
     newPointcloud->_maxDim=_maxDim;
@@ -652,9 +840,10 @@ void CPointCloud::setCellSize(float theNewSize)
     if (theNewSize!=_cellSize)
     {
         _cellSize=theNewSize;
-        std::vector<float> pts(_points);
-        std::vector<unsigned char> cols;
-        _getCharRGB3Colors(_colors,cols);
+        _updateMirrorIfNeeded();
+        std::vector<float> pts;
+        _expandStoredPoints(pts);
+        std::vector<unsigned char> cols(_colors);
         clear();
         if (pts.size()>0)
             insertPoints(&pts[0],(int)pts.size()/3,true,&cols[0],true);
@@ -672,9 +861,10 @@ void CPointCloud::setMaxPointCountPerCell(int cnt)
     if (cnt!=_maxPointCountPerCell)
     {
         _maxPointCountPerCell=cnt;
-        std::vector<float> pts(_points);
-        std::vector<unsigned char> cols;
-        _getCharRGB3Colors(_colors,cols);
+        _updateMirrorIfNeeded();
+        std::vector<float> pts;
+        _expandStoredPoints(pts);
+        std::vector<unsigned char> cols(_colors);
         clear();
         if (pts.size()>0)
             insertPoints(&pts[0],(int)pts.size()/3,true,&cols[0],true);
@@ -698,9 +888,22 @@ void CPointCloud::setShowOctree(bool show)
 
 float CPointCloud::getAveragePointCountInCell()
 {
-    if ( (_points.size()==0)||_doNotUseOctreeStructure )
+    _updateMirrorIfNeeded();
+    if ( (_getStoredPointCount()==0)||_doNotUseOctreeStructure )
+        return(-1.0);
+    int cells=_getNonEmptyCellCount();
+    if (cells<=0)
         return(-1.0);
-    return(float(_points.size()/3)/float(_nonEmptyCells));
+    return(float(_getStoredPointCount())/float(cells));
+}
+
+int CPointCloud::_getNonEmptyCellCount()
+{ // -1 means unknown (e.g. after points were inserted or removed). We then ask the calculation structure
+    if ( (_nonEmptyCells<0)&&(_pointCloudInfo!=nullptr) )
+        _nonEmptyCells=CPluginContainer::geomPlugin_getPtcloudNonEmptyCellCount(_pointCloudInfo);
+    if (_nonEmptyCells<0)
+        return(0);
+    return(_nonEmptyCells);
 }
 
 int CPointCloud::getPointSize() const
@@ -752,18 +955,25 @@ void CPointCloud::setUseRandomColors(bool r)
 {
     if (r!=_useRandomColors)
     {
+        _updateMirrorIfNeeded();
         _useRandomColors=r;
         _colors.clear();
         if (r)
+            _appendRandomColors(_colors,_getStoredPointCount());
+        else
         {
-            for (size_t i=0;i<_points.size()/3;i++)
-            {
-                _colors.push_back(0.2f+SIM_RAND_FLOAT*0.8f);
-                _colors.push_back(0.2f+SIM_RAND_FLOAT*0.8f);
-                _colors.push_back(0.2f+SIM_RAND_FLOAT*0.8f);
-                _colors.push_back(0.0);
+            if (_doNotUseOctreeStructure)
+            { // the original colors are lost
+                for (size_t i=0;i<_getStoredPointCount();i++)
+                {
+                    for (size_t j=0;j<3;j++)
+                        _colors.push_back((unsigned char)(color.getColorsPtr()[j]*255.1f));
+                }
             }
+            else
+                _readPositionsAndColorsAndSetDimensions(); // the calculation structure has the original colors
         }
+        _displaySubsetIsValid=false;
     }
 }
 
@@ -796,18 +1006,13 @@ void CPointCloud::setDoNotUseCalculationStructure(bool s)
 {
     if (s!=_doNotUseOctreeStructure)
     {
+        _updateMirrorIfNeeded(); // with the old setting
         _doNotUseOctreeStructure=s;
-        if (_points.size()>0)
+        if (_getStoredPointCount()>0)
         {
-            std::vector<float> p(_points);
-            std::vector<unsigned char> c;
-            c.reserve(p.size());
-            for (size_t i=0;i<p.size()/3;i++)
-            {
-                c[3*i+0]=(unsigned char)(_colors[4*i+0]*255.1f);
-                c[3*i+1]=(unsigned char)(_colors[4*i+1]*255.1f);
-                c[3*i+2]=(unsigned char)(_colors[4*i+2]*255.1f);
-            }
+            std::vector<float> p;
+            _expandStoredPoints(p);
+            std::vector<unsigned char> c(_colors);
             clear();
             insertPoints(&p[0],(int)p.size()/3,true,&c[0],true);
         }
@@ -825,7 +1030,7 @@ void CPointCloud::setPointDisplayRatio(float r)
     if (r!=_pointDisplayRatio)
     {
         _pointDisplayRatio=r;
-        _readPositionsAndColorsAndSetDimensions();
+        _displaySubsetIsValid=false;
     }
 }
 
@@ -896,6 +1101,8 @@ void CPointCloud::simulationEnded()
 
 void CPointCloud::serialize(CSer& ar)
 {
+    if (ar.isStoring())
+        _updateMirrorIfNeeded();
     CSceneObject::serialize(ar);
     if (ar.isBinary())
     {
@@ -914,7 +1121,7 @@ void CPointCloud::serialize(CSer& ar)
             ar.flush();
 
             ar.storeDataName("Nec");
-            ar << _nonEmptyCells;
+            ar << _getNonEmptyCellCount();
             ar.flush();
 
             ar.storeDataName("Pdr");
@@ -932,6 +1139,7 @@ void CPointCloud::serialize(CSer& ar)
             SIM_SET_CLEAR_BIT(dummy,3,_saveCalculationStructure);
             SIM_SET_CLEAR_BIT(dummy,4,_doNotUseOctreeStructure);
             SIM_SET_CLEAR_BIT(dummy,5,_colorIsEmissive);
+            SIM_SET_CLEAR_BIT(dummy,6,_quantizePositions);
             ar << dummy;
             ar.flush();
 
@@ -943,18 +1151,41 @@ void CPointCloud::serialize(CSer& ar)
 
             if ( (!_saveCalculationStructure)||_doNotUseOctreeStructure )
             {
-                ar.storeDataName("Pt2");
-                ar << int(_points.size()/3);
-                for (size_t i=0;i<_points.size()/3;i++)
+                if (_quantizePositions)
+                { // the compact form is stored as is
+                    ar.storeDataName("Pt3");
+                    ar << int(_quantizedPoints.size()/3) << int(_quantizedBlocks.size()) << _quantizationStep;
+                    for (size_t i=0;i<_quantizedBlocks.size();i++)
+                    {
+                        ar << _quantizedBlocks[i].origin(0) << _quantizedBlocks[i].origin(1) << _quantizedBlocks[i].origin(2);
+                        ar << int(_quantizedBlocks[i].firstPoint);
+                    }
+                    for (size_t i=0;i<_quantizedPoints.size()/3;i++)
+                    {
+                        ar << _quantizedPoints[3*i+0];
+                        ar << _quantizedPoints[3*i+1];
+                        ar << _quantizedPoints[3*i+2];
+                        ar << _colors[3*i+0];
+                        ar << _colors[3*i+1];
+                        ar << _colors[3*i+2];
+                    }
+                    ar.flush();
+                }
+                else
                 {
-                    ar << _points[3*i+0];
-                    ar << _points[3*i+1];
-                    ar << _points[3*i+2];
-                    ar << (unsigned char)(_colors[4*i+0]*255.1f);
-                    ar << (unsigned char)(_colors[4*i+1]*255.1f);
-                    ar << (unsigned char)(_colors[4*i+2]*255.1f);
+                    ar.storeDataName("Pt2");
+                    ar << int(_points.size()/3);
+                    for (size_t i=0;i<_points.size()/3;i++)
+                    {
+                        ar << _points[3*i+0];
+                        ar << _points[3*i+1];
+                        ar << _points[3*i+2];
+                        ar << _colors[3*i+0];
+                        ar << _colors[3*i+1];
+                        ar << _colors[3*i+2];
+                    }
+                    ar.flush();
                 }
-                ar.flush();
             }
             else
             {
@@ -1053,6 +1284,45 @@ void CPointCloud::serialize(CSer& ar)
                         else
                             clear();
                     }
+                    if (theName.compare("Pt3")==0)
+                    {
+                        noHit=false;
+                        ar >> byteQuantity;
+                        int cnt,blockCnt;
+                        float step;
+                        ar >> cnt >> blockCnt >> step;
+                        std::vector<SPointCloudBlock> blocks;
+                        blocks.resize(blockCnt);
+                        for (int i=0;i<blockCnt;i++)
+                        {
+                            int first;
+                            ar >> blocks[i].origin(0) >> blocks[i].origin(1) >> blocks[i].origin(2);
+                            ar >> first;
+                            blocks[i].firstPoint=size_t(first);
+                        }
+                        std::vector<float> pts;
+                        pts.resize(cnt*3);
+                        std::vector<unsigned char> cols;
+                        cols.resize(cnt*3);
+                        int block=-1;
+                        for (int i=0;i<cnt;i++)
+                        {
+                            while ( (block+1<blockCnt)&&(blocks[block+1].firstPoint<=size_t(i)) )
+                                block++;
+                            unsigned short q[3];
+                            ar >> q[0] >> q[1] >> q[2];
+                            for (size_t j=0;j<3;j++)
+                                pts[3*i+j]=blocks[block].origin(j)+float(q[j])*step;
+                            ar >> cols[3*i+0];
+                            ar >> cols[3*i+1];
+                            ar >> cols[3*i+2];
+                        }
+                        // Now we need to rebuild the pointCloud. Block origins lie on the quantization grid, thus no drift:
+                        if (cnt>0)
+                            insertPoints(&pts[0],cnt,true,&cols[0],true);
+                        else
+                            clear();
+                    }
                     if (theName.compare("Mmd")==0)
                     {
                         noHit=false;
@@ -1072,6 +1342,7 @@ void CPointCloud::serialize(CSer& ar)
                         _saveCalculationStructure=SIM_IS_BIT_SET(dummy,3);
                         _doNotUseOctreeStructure=SIM_IS_BIT_SET(dummy,4);
                         _colorIsEmissive=SIM_IS_BIT_SET(dummy,5);
+                        _quantizePositions=SIM_IS_BIT_SET(dummy,6);
                     }
                     if (theName.compare("Col")==0)
                     {
@@ -1110,7 +1381,7 @@ void CPointCloud::serialize(CSer& ar)
             ar.xmlAddNode_int("pointSize",_pointSize);
 
             if (exhaustiveXml)
-                ar.xmlAddNode_int("occupiedCells",_nonEmptyCells);
+                ar.xmlAddNode_int("occupiedCells",_getNonEmptyCellCount());
 
             ar.xmlAddNode_int("maxPointsPerCell",_maxPointCountPerCell);
 
@@ -1121,6 +1392,7 @@ void CPointCloud::serialize(CSer& ar)
                 ar.xmlAddNode_bool("saveCalculationStructure",_saveCalculationStructure);
             ar.xmlAddNode_bool("emissiveColor",_colorIsEmissive);
             ar.xmlAddNode_bool("useOctreeStructure",!_doNotUseOctreeStructure);
+            ar.xmlAddNode_bool("quantizePositions",_quantizePositions);
             ar.xmlPopNode();
 
             ar.xmlPushNewNode("tolerances");
@@ -1143,34 +1415,26 @@ void CPointCloud::serialize(CSer& ar)
             }
             ar.xmlPopNode();
 
+            std::vector<float> pts;
+            _expandStoredPoints(pts);
             if (exhaustiveXml)
-                ar.xmlAddNode_int("pointCount",int(_points.size()/3));
+                ar.xmlAddNode_int("pointCount",int(pts.size()/3));
 
-            if (ar.xmlSaveDataInline(_points.size()*4+_colors.size()*3/4)||(!exhaustiveXml))
+            if (ar.xmlSaveDataInline(pts.size()*4+_colors.size())||(!exhaustiveXml))
             {
-                ar.xmlAddNode_floats("points",_points);
-                std::vector<int> tmp;
-                for (size_t i=0;i<_points.size()/3;i++)
-                {
-                    tmp.push_back((unsigned int)(_colors[4*i+0]*255.1f));
-                    tmp.push_back((unsigned int)(_colors[4*i+1]*255.1f));
-                    tmp.push_back((unsigned int)(_colors[4*i+2]*255.1f));
-                }
+                ar.xmlAddNode_floats("points",pts);
+                std::vector<int> tmp(_colors.begin(),_colors.end());
                 ar.xmlAddNode_ints("pointColors",tmp);
             }
             else
             {
                 CSer* w=ar.xmlAddNode_binFile("file",(std::string("ptcloud_")+_objectName).c_str());
-                w[0] << int(_points.size());
-                for (size_t i=0;i<_points.size();i++)
-                    w[0] << _points[i];
+                w[0] << int(pts.size());
+                for (size_t i=0;i<pts.size();i++)
+                    w[0] << pts[i];
 
-                for (size_t i=0;i<_points.size()/3;i++)
-                {
-                    w[0] << (unsigned char)(_colors[4*i+0]*255.1f);
-                    w[0] << (unsigned char)(_colors[4*i+1]*255.1f);
-                    w[0] << (unsigned char)(_colors[4*i+2]*255.1f);
-                }
+                for (size_t i=0;i<_colors.size();i++)
+                    w[0] << _colors[i];
                 w->flush();
                 w->writeClose();
                 delete w;
@@ -1195,6 +1459,7 @@ void CPointCloud::serialize(CSer& ar)
                 ar.xmlGetNode_bool("emissiveColor",_colorIsEmissive,exhaustiveXml);
                 if (ar.xmlGetNode_bool("useOctreeStructure",_doNotUseOctreeStructure,exhaustiveXml))
                     _doNotUseOctreeStructure=!_doNotUseOctreeStructure;
+                ar.xmlGetNode_bool("quantizePositions",_quantizePositions,false);
                 ar.xmlPopNode();
             }
 
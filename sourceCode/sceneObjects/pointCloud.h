@@ -8,6 +8,15 @@
 class CDummy;
 class COctree;
 
+#define POINTCLOUD_CHUNK_SIZE 4096 // max. number of points in a chunk/quantization block
+#define POINTCLOUD_QUANTIZATION_STEPS_PER_CELL 32.0f // a block then spans 2048 cells
+
+struct SPointCloudBlock
+{ // quantized positions of a block are relative to its origin
+    C3Vector origin;
+    size_t firstPoint;
+};
+
 class CPointCloud : public CSceneObject
 {
 public:
@@ -94,21 +103,37 @@ public:
     void setDoNotUseCalculationStructure(bool s);
     float getPointDisplayRatio() const;
     void setPointDisplayRatio(float r);
+    bool getQuantizePositions() const;
+    void setQuantizePositions(bool q);
+    float getQuantizationStep() const;
     const std::vector<float>* getPoints() const;
-    std::vector<float>* getPoints();
+    int getPointCount();
+    size_t getPointChunkCount() const;
+    const float* getPointChunk(size_t chunkIndex,std::vector<float>& buffer,size_t& firstPoint,size_t& pointCount) const;
     const void* getPointCloudInfo() const;
     void* getPointCloudInfo();
     void getTransfAndHalfSizeOfBoundingBox(C7Vector& tr,C3Vector& hs) const;
 
     CColorObject* getColor();
     void getMaxMinDims(C3Vector& ma,C3Vector& mi) const;
-    std::vector<float>* getColors();
-    std::vector<float>* getDisplayPoints();
-    std::vector<float>* getDisplayColors();
+    const std::vector<unsigned char>* getColors();
+    const std::vector<float>* getDisplayPoints();
+    const std::vector<unsigned char>* getDisplayColors();
 
 protected:
     void _readPositionsAndColorsAndSetDimensions();
-    void _getCharRGB3Colors(const std::vector<float>& floatRGBA,std::vector<unsigned char>& charRGB);
+    void _updateMirrorIfNeeded();
+    void _updateDisplaySubsetIfNeeded();
+    void _appendRandomColors(std::vector<unsigned char>& colors,size_t pointCount);
+    void _appendToMirror(const float* pts,int ptsCnt,const unsigned char* optionalColors3,bool colorsAreIndividual);
+    void _extendDimensions(const float* pts,int ptsCnt,bool wasEmpty);
+    void _calculationStructureChanged(int removedPointCount);
+    int _getNonEmptyCellCount();
+    size_t _getStoredPointCount() const;
+    void _clearStoredPoints();
+    void _appendStoredPoints(const float* pts,size_t ptsCnt);
+    void _expandStoredPoints(std::vector<float>& pts) const;
+    void _floatToCharColors(const std::vector<float>& floatRGBA,std::vector<unsigned char>& charRGB);
 
     // Variables which need to be serialized & copied
     CColorObject color;
@@ -117,19 +142,28 @@ protected:
     void* _pointCloudInfo;
     C3Vector _minDim;
     C3Vector _maxDim;
-    std::vector<float> _points;
-    std::vector<float> _colors;
+    std::vector<float> _points; // when positions are not quantized
+    std::vector<unsigned short> _quantizedPoints; // when positions are quantized
+    std::vector<SPointCloudBlock> _quantizedBlocks;
+    float _quantizationStep;
+    mutable std::vector<float> _expandedPoints; // built on demand from quantized positions (e.g. for the API)
+    mutable bool _expandedPointsAreValid;
+    std::vector<unsigned char> _colors; // RGB
     std::vector<float> _displayPoints;
-    std::vector<float> _displayColors;
+    std::vector<unsigned char> _displayColors; // RGB
     bool _showOctreeStructure;
     bool _useRandomColors;
     bool _saveCalculationStructure;
     int _pointSize;
-    int _nonEmptyCells;
+    int _nonEmptyCells; // -1 if unknown. See _getNonEmptyCellCount
     float _buildResolution;
     float _removalDistanceTolerance;
     float _insertionDistanceTolerance;
     float _pointDisplayRatio;
     bool _doNotUseOctreeStructure;
     bool _colorIsEmissive;
+    bool _quantizePositions;
+    bool _mirrorIsValid; // _points and _colors reflect the calculation structure
+    int _knownPointCount; // -1 if unknown. Only used while _mirrorIsValid is false
+    bool _displaySubsetIsValid;
 };
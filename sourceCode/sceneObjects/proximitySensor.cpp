@@ -3,6 +3,7 @@
 #include "tt.h"
 #include "proxSensorRoutine.h"
 #include "vDateTime.h"
+#include "stepProfiler.h"
 #include "ttUtil.h"
 #include "easyLock.h"
 #include "app.h"
@@ -870,6 +871,9 @@ bool CProxSensor::handleSensor(bool exceptExplicitHandling,int& detectedObjectHa
 {
     if (exceptExplicitHandling&&getExplicitHandling())
         return(false); // We don't want to handle those
+    CStepProfilerScope profilerScope("proximity sensor");
+    if (profilerScope.isActive())
+        profilerScope.setName(getObjectName().c_str());
     _sensorResultValid=false;
     _detectedPointValid=false;
     _calcTimeInMs=0;
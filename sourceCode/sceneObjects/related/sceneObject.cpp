@@ -502,6 +502,7 @@ int CSceneObject::getCumulativeModelProperty()
 void CSceneObject::incrementModelPropertyValidityNumber()
 { // static
     _modelPropertyValidityNumber++;
+    CEmbeddedScriptContainer::invalidateAllScriptExecutionOrders(); // e.g. sim_modelproperty_scripts_inactive
 }
 
 
@@ -1547,8 +1548,8 @@ int CSceneObject::getScriptsToExecute(int scriptType,int parentTraversalDirectio
     }
 
     if ((getCumulativeModelProperty()&sim_modelproperty_scripts_inactive)==0)
-    {
-        if ( (traversalDir==sim_scripttreetraversal_forward)&&(attachedScript!=nullptr)&&(!attachedScript->getScriptIsDisabled()) )
+    { // disabled scripts are also returned (the list is cached, the caller checks that flag)
+        if ( (traversalDir==sim_scripttreetraversal_forward)&&(attachedScript!=nullptr) )
         {
             cnt++;
             scripts.push_back(attachedScript);
@@ -1573,7 +1574,7 @@ int CSceneObject::getScriptsToExecute(int scriptType,int parentTraversalDirectio
                 cnt+=toHandle[i]->at(j)->getScriptsToExecute(scriptType,traversalDir,scripts,uniqueIds);
         }
 
-        if ( (traversalDir==sim_scripttreetraversal_reverse)&&(attachedScript!=nullptr)&&(!attachedScript->getScriptIsDisabled()) )
+        if ( (traversalDir==sim_scripttreetraversal_reverse)&&(attachedScript!=nullptr) )
         {
             cnt++;
             scripts.push_back(attachedScript);
@@ -3177,6 +3178,7 @@ void CSceneObject::acquireCommonPropertiesFromObject_simpleXMLLoading(const CSce
     _objectTempName=obj->_objectTempName;
 //    _objectAltName=obj->_objectAltName;
     _localTransformation=obj->_localTransformation;
+    _invalidateCumulativeTransformations();
     _hierarchyColorIndex=obj->_hierarchyColorIndex;
     _collectionSelfCollisionIndicator=obj->_collectionSelfCollisionIndicator;
     _localObjectProperty=obj->_localObjectProperty;
@@ -4050,6 +4052,8 @@ void CSceneObject::addChild(CSceneObject* child)
         _childList.clear();
     else
         _childList.push_back(child);
+    invalidateAllCumulativeTransformations();
+    CEmbeddedScriptContainer::invalidateAllScriptExecutionOrders();
 }
 
 bool CSceneObject::removeChild(const CSceneObject* child)
@@ -4060,6 +4064,8 @@ bool CSceneObject::removeChild(const CSceneObject* child)
         if (_childList[i]==child)
         {
             _childList.erase(_childList.begin()+i);
+            invalidateAllCumulativeTransformations();
+            CEmbeddedScriptContainer::invalidateAllScriptExecutionOrders();
             retVal=true;
             break;
         }
@@ -924,6 +924,7 @@ void CShape::commonInit()
     _additionalTorque.clear();
 
     _meshCalculationStructure=nullptr;
+    _calcStructJob=nullptr;
     _mesh=nullptr;
     _meshDynamicsFullRefreshFlag=true;
     _meshModificationCounter=0;
@@ -1768,6 +1769,11 @@ bool CShape::_reorientGeometry(int type)
 void CShape::removeMeshCalculationStructure()
 {
     TRACE_INTERNAL;
+    if (_calcStructJob!=nullptr)
+    { // a background build is pending. It is now obsolete
+        CCalculationStructureBuilder::abandonJob(_calcStructJob);
+        _calcStructJob=nullptr;
+    }
     if (_meshCalculationStructure!=nullptr)
     {
         CPluginContainer::geomPlugin_destroyMesh(_meshCalculationStructure);
@@ -1775,26 +1781,60 @@ void CShape::removeMeshCalculationStructure()
     }
 }
 
-bool CShape::isMeshCalculationStructureInitialized()
-{
+bool CShape::isMeshCalculationStructureInitialized() const
+{ // read-only, also called from the UI thread
     return(_meshCalculationStructure!=nullptr);
 }
 
+void CShape::adoptBuiltMeshCalculationStructure()
+{ // CALLED ONLY FROM THE MAIN SIMULATION THREAD. Takes over a finished background build, without waiting
+    if ( (_calcStructJob!=nullptr)&&CCalculationStructureBuilder::isJobDone(_calcStructJob) )
+    {
+        _meshCalculationStructure=CCalculationStructureBuilder::finishJob(_calcStructJob);
+        _calcStructJob=nullptr;
+    }
+}
+
 void CShape::initializeMeshCalculationStructureIfNeeded()
 {
+    if (_calcStructJob!=nullptr)
+    { // waits for the background build, or builds it here if not yet started
+        _meshCalculationStructure=CCalculationStructureBuilder::finishJob(_calcStructJob);
+        _calcStructJob=nullptr;
+    }
     if ((_meshCalculationStructure==nullptr)&&(_mesh!=nullptr))
     {
         std::vector<float> wvert;
         std::vector<int> wind;
         _mesh->getCumulativeMeshes(wvert,&wind,nullptr);
-        float maxTriSize=App::currentWorld->environment->getCalculationMaxTriangleSize();
-        float minTriSize=(std::max<float>(std::max<float>(_meshBoundingBoxHalfSizes(0),_meshBoundingBoxHalfSizes(1)),_meshBoundingBoxHalfSizes(2)))*2.0f*App::currentWorld->environment->getCalculationMinRelTriangleSize();
-        if (maxTriSize<minTriSize)
-            maxTriSize=minTriSize;
-        _meshCalculationStructure=CPluginContainer::geomPlugin_createMesh(&wvert[0],(int)wvert.size(),&wind[0],(int)wind.size(),nullptr,maxTriSize,App::userSettings->triCountInOBB);
+        _meshCalculationStructure=CCalculationStructureBuilder::buildMesh(wvert,wind,_getMeshCalculationStructureMaxTriSize(),App::userSettings->triCountInOBB);
+    }
+}
+
+void CShape::launchMeshCalculationStructureBuild()
+{ // builds the calculation structure on a worker thread. Only for shapes that will likely need it
+    if ( (_meshCalculationStructure==nullptr)&&(_calcStructJob==nullptr)&&(_mesh!=nullptr)&&CPluginContainer::isGeomPluginAvailable() )
+    {
+        if ((getCumulativeObjectSpecialProperty()&(sim_objectspecialproperty_collidable|sim_objectspecialproperty_measurable|sim_objectspecialproperty_detectable_all))!=0)
+        {
+            std::vector<float> wvert;
+            std::vector<int> wind;
+            _mesh->getCumulativeMeshes(wvert,&wind,nullptr);
+            if ( (wvert.size()>0)&&(wind.size()>0) )
+                _calcStructJob=CCalculationStructureBuilder::launchJob(wvert,wind,_getMeshCalculationStructureMaxTriSize(),App::userSettings->triCountInOBB);
+        }
     }
 }
 
+float CShape::_getMeshCalculationStructureMaxTriSize() const
+{
+    float maxTriSize=App::currentWorld->environment->getCalculationMaxTriangleSize();
+    float minTriSize=(std::max<float>(std::max<float>(_meshBoundingBoxHalfSizes(0),_meshBoundingBoxHalfSizes(1)),_meshBoundingBoxHalfSizes(2)))*2.0f*App::currentWorld->environment->getCalculationMinRelTriangleSize();
+    if (maxTriSize<minTriSize)
+        maxTriSize=minTriSize;
+    return(maxTriSize);
+}
+
 bool CShape::getCulling()
 {
     if (getMeshWrapper()->isMesh())
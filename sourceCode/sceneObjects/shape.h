@@ -3,6 +3,7 @@
 #include "sceneObject.h"
 #include "mesh.h"
 #include "dummy.h"
+#include "calculationStructureBuilder.h"
 
 class CShape : public CSceneObject  
 {
@@ -135,9 +136,11 @@ public:
     bool getDistanceToDummy_IfSmaller(CDummy* it,float &dist,float ray[7],int& buffer);
 
     // Collision detection functions
-    bool isMeshCalculationStructureInitialized();
+    bool isMeshCalculationStructureInitialized() const;
+    void adoptBuiltMeshCalculationStructure();
     void initializeMeshCalculationStructureIfNeeded();
     void removeMeshCalculationStructure();
+    void launchMeshCalculationStructureBuild();
     bool doesShapeCollideWithShape(CShape* collidee,std::vector<float>* intersections);
 
     // Bounding box functions
@@ -166,6 +169,7 @@ protected:
     static bool _getTubeReferenceFrame(const std::vector<float>& v,C7Vector& tr);
     static bool _getCuboidReferenceFrame(const std::vector<float>& v,const std::vector<int>& ind,C7Vector& tr);
     void _computeMeshBoundingBox();
+    float _getMeshCalculationStructureMaxTriSize() const;
 
     bool _reorientGeometry(int type); // 0=main axis, 1=world, 2=tube, 3=cuboid
 
@@ -191,6 +195,7 @@ protected:
     C3Vector _additionalTorque;
 
     bool _rigidBodyWasAlreadyPutToSleepOnce;
+    SCalculationStructureJob* _calcStructJob; // pending background build of _meshCalculationStructure
 
     C3Vector _initialInitialDynamicLinearVelocity;
     C3Vector _initialInitialDynamicAngularVelocity;
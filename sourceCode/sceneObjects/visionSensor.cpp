@@ -7,6 +7,7 @@
 #include "simStrings.h"
 #include <boost/lexical_cast.hpp>
 #include "vDateTime.h"
+#include "stepProfiler.h"
 #include "vVarious.h"
 #include "ttUtil.h"
 #include "threadPool.h"
@@ -15,6 +16,8 @@
 #include "pluginContainer.h"
 #include "visionSensorRendering.h"
 #include "interfaceStackString.h"
+#include "workerPool.h"
+#include <cstring>
 #ifdef SIM_WITH_OPENGL
 #include "rendering.h"
 #include "oGL.h"
@@ -22,6 +25,7 @@
 #endif
 
 #define DEFAULT_RENDERING_ATTRIBUTES (sim_displayattribute_renderpass|sim_displayattribute_forbidwireframe|sim_displayattribute_forbidedges|sim_displayattribute_originalcolors|sim_displayattribute_ignorelayer|sim_displayattribute_forvisionsensor)
+#define VISION_SENSOR_MIN_PIXELS_PER_CHUNK 65536 // smaller images are post-processed by the calling thread only
 #define DEFAULT_RAYTRACING_ATTRIBUTES (sim_displayattribute_renderpass|sim_displayattribute_forbidwireframe|sim_displayattribute_forbidedges|sim_displayattribute_originalcolors|sim_displayattribute_ignorelayer|sim_displayattribute_forvisionsensor)
 
 CVisionSensor::CVisionSensor()
@@ -69,7 +73,7 @@ bool CVisionSensor::isPotentiallyRenderable() const
 }
 
 float* CVisionSensor::readPortionOfImage(int posX,int posY,int sizeX,int sizeY,int rgbGreyOrDepth)
-{
+{ // the returned buffer is released by the caller (with delete[])
     if ( (posX<0)||(posY<0)||(sizeX<1)||(sizeY<1)||(posX+sizeX>_resolutionX)||(posY+sizeY>_resolutionY) )
         return(nullptr);
     float* buff;
@@ -77,101 +81,74 @@ float* CVisionSensor::readPortionOfImage(int posX,int posY,int sizeX,int sizeY,i
         buff=new float[sizeX*sizeY*3];
     else
         buff=new float[sizeX*sizeY];
-    int p=0;
-    for (int j=posY;j<posY+sizeY;j++)
-    {
-        for (int i=posX;i<posX+sizeX;i++)
+    for (int j=0;j<sizeY;j++)
+    { // row by row, without per-pixel branching
+        const unsigned char* src=_rgbBuffer+3*((posY+j)*_resolutionX+posX);
+        if (rgbGreyOrDepth==0)
+        { // RGB
+            float* dst=buff+3*j*sizeX;
+            for (int i=0;i<3*sizeX;i++)
+                dst[i]=float(src[i])/255.0f;
+        }
+        else
         {
-            if (rgbGreyOrDepth==0)
-            { // RGB
-                buff[3*p+0]=float(_rgbBuffer[3*(j*_resolutionX+i)+0])/255.0f;
-                buff[3*p+1]=float(_rgbBuffer[3*(j*_resolutionX+i)+1])/255.0f;
-                buff[3*p+2]=float(_rgbBuffer[3*(j*_resolutionX+i)+2])/255.0f;
+            float* dst=buff+j*sizeX;
+            if (rgbGreyOrDepth==1)
+            { // Greyscale
+                for (int i=0;i<sizeX;i++)
+                    dst[i]=(float(src[3*i+0])/255.0f+float(src[3*i+1])/255.0f+float(src[3*i+2])/255.0f)/3.0f;
             }
             else
-            {
-                if (rgbGreyOrDepth==1)
-                { // Greyscale
-                    buff[p]=float(_rgbBuffer[3*(j*_resolutionX+i)+0])/255.0f;
-                    buff[p]+=float(_rgbBuffer[3*(j*_resolutionX+i)+1])/255.0f;
-                    buff[p]+=float(_rgbBuffer[3*(j*_resolutionX+i)+2])/255.0f;
-                    buff[p]/=3.0f;
-                }
-                else
-                    buff[p]=_depthBuffer[j*_resolutionX+i];
-            }
-            p++;
+                memcpy(dst,_depthBuffer+(posY+j)*_resolutionX+posX,sizeX*sizeof(float));
         }
     }
     return(buff);
 }
 
 unsigned char* CVisionSensor::readPortionOfCharImage(int posX,int posY,int sizeX,int sizeY,float cutoffRgba,bool imgIsGreyScale)
-{
+{ // the returned buffer is released by the caller (with delete[])
     if ( (posX<0)||(posY<0)||(sizeX<1)||(sizeY<1)||(posX+sizeX>_resolutionX)||(posY+sizeY>_resolutionY) )
         return(nullptr);
-    unsigned char* buff=nullptr;
-    if (cutoffRgba==0.0f)
-    {
-        if (imgIsGreyScale)
-            buff=new unsigned char[sizeX*sizeY];
-        else
-            buff=new unsigned char[sizeX*sizeY*3];
-        int p=0;
-        for (int j=posY;j<posY+sizeY;j++)
+    int valPerPix=3;
+    if (imgIsGreyScale)
+        valPerPix=1;
+    if (cutoffRgba!=0.0f)
+        valPerPix++; // alpha channel
+    unsigned char* buff=new unsigned char[sizeX*sizeY*valPerPix];
+    for (int j=0;j<sizeY;j++)
+    { // row by row, without per-pixel branching
+        const unsigned char* src=_rgbBuffer+3*((posY+j)*_resolutionX+posX);
+        const float* srcDepth=_depthBuffer+(posY+j)*_resolutionX+posX;
+        unsigned char* dst=buff+j*sizeX*valPerPix;
+        if (cutoffRgba==0.0f)
         {
-            for (int i=posX;i<posX+sizeX;i++)
+            if (imgIsGreyScale)
             {
-                if (imgIsGreyScale)
-                {
-                    unsigned int v=_rgbBuffer[3*(j*_resolutionX+i)+0];
-                    v+=_rgbBuffer[3*(j*_resolutionX+i)+1];
-                    v+=_rgbBuffer[3*(j*_resolutionX+i)+2];
-                    buff[p]=(unsigned char)(v/3);
-                }
-                else
-                {
-                    buff[3*p+0]=_rgbBuffer[3*(j*_resolutionX+i)+0];
-                    buff[3*p+1]=_rgbBuffer[3*(j*_resolutionX+i)+1];
-                    buff[3*p+2]=_rgbBuffer[3*(j*_resolutionX+i)+2];
-                }
-                p++;
+                for (int i=0;i<sizeX;i++)
+                    dst[i]=(unsigned char)((unsigned int)(src[3*i+0]+src[3*i+1]+src[3*i+2])/3);
             }
+            else
+                memcpy(dst,src,sizeX*3);
         }
-    }
-    else
-    {
-        if (imgIsGreyScale)
-            buff=new unsigned char[sizeX*sizeY*2];
         else
-            buff=new unsigned char[sizeX*sizeY*4];
-        int p=0;
-        for (int j=posY;j<posY+sizeY;j++)
         {
-            for (int i=posX;i<posX+sizeX;i++)
+            if (imgIsGreyScale)
             {
-                if (imgIsGreyScale)
+                for (int i=0;i<sizeX;i++)
                 {
-                    unsigned int v=_rgbBuffer[3*(j*_resolutionX+i)+0];
-                    v+=_rgbBuffer[3*(j*_resolutionX+i)+1];
-                    v+=_rgbBuffer[3*(j*_resolutionX+i)+2];
-                    buff[2*p+0]=(unsigned char)(v/3);
-                    if (_depthBuffer[j*_resolutionX+i]>cutoffRgba)
-                        buff[2*p+1]=0;
-                    else
-                        buff[2*p+1]=255;
+                    dst[2*i+0]=(unsigned char)((unsigned int)(src[3*i+0]+src[3*i+1]+src[3*i+2])/3);
+                    dst[2*i+1]=(srcDepth[i]>cutoffRgba)?0:255;
                 }
-                else
+            }
+            else
+            {
+                for (int i=0;i<sizeX;i++)
                 {
-                    buff[4*p+0]=_rgbBuffer[3*(j*_resolutionX+i)+0];
-                    buff[4*p+1]=_rgbBuffer[3*(j*_resolutionX+i)+1];
-                    buff[4*p+2]=_rgbBuffer[3*(j*_resolutionX+i)+2];
-                    if (_depthBuffer[j*_resolutionX+i]>cutoffRgba)
-                        buff[4*p+3]=0;
-                    else
-                        buff[4*p+3]=255;
+                    dst[4*i+0]=src[3*i+0];
+                    dst[4*i+1]=src[3*i+1];
+                    dst[4*i+2]=src[3*i+2];
+                    dst[4*i+3]=(srcDepth[i]>cutoffRgba)?0:255;
                 }
-                p++;
             }
         }
     }
@@ -235,6 +212,8 @@ void CVisionSensor::commonInit()
     _ignoreRGBInfo=false;
     _ignoreDepthInfo=false;
     _computeImageBasicStats=true;
+    _pipelinedReadback=false;
+    _readbackMayBePipelined=false;
     _renderMode=sim_rendermode_opengl; // visible
     _attributesForRendering=DEFAULT_RENDERING_ATTRIBUTES;
 
@@ -557,6 +536,20 @@ bool CVisionSensor::getComputeImageBasicStats()
     return(_computeImageBasicStats);
 }
 
+void CVisionSensor::setPipelinedReadback(bool p)
+{
+    _pipelinedReadback=p;
+#ifdef SIM_WITH_OPENGL
+    if (_contextFboAndTexture!=nullptr)
+        _contextFboAndTexture->clearPipelinedReadback();
+#endif
+}
+
+bool CVisionSensor::getPipelinedReadback()
+{
+    return(_pipelinedReadback);
+}
+
 void CVisionSensor::setIgnoreDepthInfo(bool ignore)
 {
     _ignoreDepthInfo=ignore;
@@ -631,6 +624,10 @@ void CVisionSensor::resetSensor()
     }
     if (!_useExternalImage) // condition added on 2010/12/21
         _clearBuffers();
+#ifdef SIM_WITH_OPENGL
+    if (_contextFboAndTexture!=nullptr)
+        _contextFboAndTexture->clearPipelinedReadback(); // do not return an image from a previous run
+#endif
 }
 
 bool CVisionSensor::setExternalImage(const float* img,bool imgIsGreyScale,bool noProcessing)
@@ -673,16 +670,15 @@ bool CVisionSensor::setExternalCharImage(const unsigned char* img,bool imgIsGrey
         int n=_resolutionX*_resolutionY;
         for (int i=0;i<n;i++)
         {
-            _rgbBuffer[3*i+0]=img[i];
-            _rgbBuffer[3*i+1]=img[i];
-            _rgbBuffer[3*i+2]=img[i];
+            unsigned char v=img[i];
+            _rgbBuffer[3*i+0]=v;
+            _rgbBuffer[3*i+1]=v;
+            _rgbBuffer[3*i+2]=v;
         }
     }
     else
     {
-        int n=_resolutionX*_resolutionY*3;
-        for (int i=0;i<n;i++)
-            _rgbBuffer[i]=img[i];
+        memcpy(_rgbBuffer,img,_resolutionX*_resolutionY*3);
     }
     bool returnValue=false;
     if (!noProcessing)
@@ -700,14 +696,15 @@ bool CVisionSensor::setExternalCharImage(const unsigned char* img,bool imgIsGrey
 
 void CVisionSensor::setDepthBuffer(const float* img)
 {
-    int n=_resolutionX*_resolutionY;
-    for (int i=0;i<n;i++)
-        _depthBuffer[i]=img[i];
+    memcpy(_depthBuffer,img,_resolutionX*_resolutionY*sizeof(float));
 }
 
 bool CVisionSensor::handleSensor()
 {
     TRACE_INTERNAL;
+    CStepProfilerScope profilerScope("vision sensor");
+    if (profilerScope.isActive())
+        profilerScope.setName(getObjectName().c_str());
     sensorAuxiliaryResult.clear();
     sensorResult.sensorWasTriggered=false;
     sensorResult.sensorResultIsValid=false;
@@ -725,7 +722,9 @@ bool CVisionSensor::handleSensor()
     if (_useExternalImage) // those 2 lines added on 2010/12/12
         return(false);
     int stTime=VDateTime::getTimeInMs();
+    _readbackMayBePipelined=_pipelinedReadback;
     detectEntity(_detectableEntityHandle,_detectableEntityHandle==-1,false,false,false);
+    _readbackMayBePipelined=false;
 #ifdef SIM_WITH_OPENGL
     if (_contextFboAndTexture!=nullptr)
         _contextFboAndTexture->textureObject->setImage(false,false,true,_rgbBuffer); // Update the texture
@@ -754,15 +753,12 @@ bool CVisionSensor::checkSensor(int entityID,bool overrideRenderableFlagsForNonC
         cop.sensorDataIntensity[i]=sensorResult.sensorDataIntensity[i];
         cop.sensorDataDepth[i]=sensorResult.sensorDataDepth[i];
     }
-    unsigned char* copIm=new unsigned char[_resolutionX*_resolutionY*3];
-    float* copDep=new float[_resolutionX*_resolutionY];
-    for (int i=0;i<_resolutionX*_resolutionY;i++)
-    {
-        copIm[3*i+0]=_rgbBuffer[3*i+0];
-        copIm[3*i+1]=_rgbBuffer[3*i+1];
-        copIm[3*i+2]=_rgbBuffer[3*i+2];
-        copDep[i]=_depthBuffer[i];
-    }
+    std::vector<unsigned char> copIm;
+    std::vector<float> copDep;
+    copIm.swap(_savedRgbBuffer); // we reuse the sensor's buffers (they are empty if we are called recursively)
+    copDep.swap(_savedDepthBuffer);
+    copIm.assign(_rgbBuffer,_rgbBuffer+_resolutionX*_resolutionY*3);
+    copDep.assign(_depthBuffer,_depthBuffer+_resolutionX*_resolutionY);
     // 2. Do the detection:
     bool all=(entityID==-1);
     bool retVal=detectEntity(entityID,all,false,false,overrideRenderableFlagsForNonCollections); // We don't swap image buffers!
@@ -779,16 +775,14 @@ bool CVisionSensor::checkSensor(int entityID,bool overrideRenderableFlagsForNonC
         sensorResult.sensorDataIntensity[i]=cop.sensorDataIntensity[i];
         sensorResult.sensorDataDepth[i]=cop.sensorDataDepth[i];
     }
-    for (int i=0;i<_resolutionX*_resolutionY;i++)
+    if (copDep.size()==size_t(_resolutionX*_resolutionY))
     {
-        _rgbBuffer[3*i+0]=copIm[3*i+0];
-        _rgbBuffer[3*i+1]=copIm[3*i+1];
-        _rgbBuffer[3*i+2]=copIm[3*i+2];
-        _depthBuffer[i]=copDep[i];
+        memcpy(_rgbBuffer,&copIm[0],copIm.size());
+        memcpy(_depthBuffer,&copDep[0],copDep.size()*sizeof(float));
     }
-    // 4. Release memory
-    delete[] copIm;
-    delete[] copDep;
+    // 4. Give the buffers back for next time
+    copIm.swap(_savedRgbBuffer);
+    copDep.swap(_savedDepthBuffer);
 
     return(retVal);
 }
@@ -813,15 +807,12 @@ float* CVisionSensor::checkSensorEx(int entityID,bool imageBuffer,bool entityIsM
         cop.sensorDataIntensity[i]=sensorResult.sensorDataIntensity[i];
         cop.sensorDataDepth[i]=sensorResult.sensorDataDepth[i];
     }
-    unsigned char* copIm=new unsigned char[_resolutionX*_resolutionY*3];
-    float* copDep=new float[_resolutionX*_resolutionY];
-    for (int i=0;i<_resolutionX*_resolutionY;i++)
-    {
-        copIm[3*i+0]=_rgbBuffer[3*i+0];
-        copIm[3*i+1]=_rgbBuffer[3*i+1];
-        copIm[3*i+2]=_rgbBuffer[3*i+2];
-        copDep[i]=_depthBuffer[i];
-    }
+    std::vector<unsigned char> copIm;
+    std::vector<float> copDep;
+    copIm.swap(_savedRgbBuffer); // we reuse the sensor's buffers (they are empty if we are called recursively)
+    copDep.swap(_savedDepthBuffer);
+    copIm.assign(_rgbBuffer,_rgbBuffer+_resolutionX*_resolutionY*3);
+    copDep.assign(_depthBuffer,_depthBuffer+_resolutionX*_resolutionY);
     // 2. Do the detection:
     bool all=(entityID==-1);
     detectEntity(entityID,all,entityIsModelAndRenderAllVisibleModelAlsoNonRenderableObjects,hideEdgesIfModel,overrideRenderableFlagsForNonCollections); // we don't swap image buffers!
@@ -854,16 +845,14 @@ float* CVisionSensor::checkSensorEx(int entityID,bool imageBuffer,bool entityIsM
         sensorResult.sensorDataIntensity[i]=cop.sensorDataIntensity[i];
         sensorResult.sensorDataDepth[i]=cop.sensorDataDepth[i];
     }
-    for (int i=0;i<_resolutionX*_resolutionY;i++)
+    if (copDep.size()==size_t(_resolutionX*_resolutionY))
     {
-        _rgbBuffer[3*i+0]=copIm[3*i+0];
-        _rgbBuffer[3*i+1]=copIm[3*i+1];
-        _rgbBuffer[3*i+2]=copIm[3*i+2];
-        _depthBuffer[i]=copDep[i];
+        memcpy(_rgbBuffer,&copIm[0],copIm.size());
+        memcpy(_depthBuffer,&copDep[0],copDep.size()*sizeof(float));
     }
-    // 5. Release memory
-    delete[] copIm;
-    delete[] copDep;
+    // 5. Give the buffers back for next time
+    copIm.swap(_savedRgbBuffer);
+    copDep.swap(_savedDepthBuffer);
 
     return(retBuffer);
 }
@@ -944,7 +933,21 @@ void CVisionSensor::detectEntity2(int entityID,bool detectAll,bool entityIsModel
 #ifdef SIM_WITH_OPENGL
         if (!_useExternalImage)
         {
-            if (!_ignoreRGBInfo)
+            bool pipelined=false;
+            if ( _readbackMayBePipelined&&((!_ignoreRGBInfo)||(!_ignoreDepthInfo)) )
+            {
+                unsigned char* rgb=nullptr;
+                float* depth=nullptr;
+                if (!_ignoreRGBInfo)
+                    rgb=_rgbBuffer;
+                if (!_ignoreDepthInfo)
+                    depth=_depthBuffer;
+                int res=_contextFboAndTexture->readPixelsPipelined(rgb,depth); // -1 if not supported
+                pipelined=(res!=-1);
+                if (res==0)
+                    _clearBuffers(); // the first image is only available one step later
+            }
+            if ( (!_ignoreRGBInfo)&&(!pipelined) )
             {
                 glPixelStorei(GL_PACK_ALIGNMENT,1);
                 glReadPixels(0,0,_resolutionX,_resolutionY,GL_RGB,GL_UNSIGNED_BYTE,_rgbBuffer);
@@ -952,17 +955,11 @@ void CVisionSensor::detectEntity2(int entityID,bool detectAll,bool entityIsModel
             }
             if (!_ignoreDepthInfo)
             {
-                glReadPixels(0,0,_resolutionX,_resolutionY,GL_DEPTH_COMPONENT,GL_FLOAT,_depthBuffer);
+                if (!pipelined)
+                    glReadPixels(0,0,_resolutionX,_resolutionY,GL_DEPTH_COMPONENT,GL_FLOAT,_depthBuffer);
                 // Convert this depth info into values corresponding to linear depths (if perspective mode):
                 if (_perspectiveOperation)
-                {
-                    float farMinusNear= _farClippingPlane-_nearClippingPlane;
-                    float farDivFarMinusNear=_farClippingPlane/farMinusNear;
-                    float nearTimesFar=_nearClippingPlane*_farClippingPlane;
-                    int v=_resolutionX*_resolutionY;
-                    for (int i=0;i<v;i++)
-                        _depthBuffer[i]=((nearTimesFar/(farMinusNear*(farDivFarMinusNear-_depthBuffer[i])))-_nearClippingPlane)/farMinusNear;
-                }
+                    _linearizeDepthBuffer();
             }
         }
 
@@ -1830,6 +1827,7 @@ CSceneObject* CVisionSensor::copyYourself()
     newVisionSensor->_ignoreRGBInfo=_ignoreRGBInfo;
     newVisionSensor->_ignoreDepthInfo=_ignoreDepthInfo;
     newVisionSensor->_computeImageBasicStats=_computeImageBasicStats;
+    newVisionSensor->_pipelinedReadback=_pipelinedReadback;
     newVisionSensor->_renderMode=_renderMode;
     newVisionSensor->_attributesForRendering=_attributesForRendering;
 
@@ -1988,64 +1986,44 @@ bool CVisionSensor::_computeDefaultReturnValuesAndApplyFilters()
 
     if (_computeImageBasicStats&&(_renderMode!=sim_rendermode_colorcoded))
     {
-        unsigned int cumulRed=0;
-        unsigned int cumulGreen=0;
-        unsigned int cumulBlue=0;
-        unsigned int cumulIntensity=0;
-        float cumulDepth=0.0f;
-
-        // Initialize the min/max values with first element:
-        for (int i=0;i<2;i++)
-        {
-            sensorResult.sensorDataRed[i]=_rgbBuffer[0];
-            sensorResult.sensorDataGreen[i]=_rgbBuffer[1];
-            sensorResult.sensorDataBlue[i]=_rgbBuffer[2];
-            sensorResult.sensorDataIntensity[i]=(_rgbBuffer[0]+_rgbBuffer[1]+_rgbBuffer[2])/3;
-            sensorResult.sensorDataDepth[i]=_depthBuffer[0];
-        }
+        int chunkCount=_prepareImageChunks();
+        CWorkerPool::runTasks(_computeImageStatsTask,&_imageChunkPtrs[0],chunkCount);
 
-        int v=_resolutionX*_resolutionY;
-        for (int i=0;i<v;i++)
+        // Merge the partial results:
+        SVisionSensorImageChunk res=_imageChunks[0];
+        for (int i=1;i<chunkCount;i++)
         {
-            unsigned int intens=(_rgbBuffer[3*i+0]+_rgbBuffer[3*i+1]+_rgbBuffer[3*i+2])/3;
-            cumulRed+=_rgbBuffer[3*i+0];
-            cumulGreen+=_rgbBuffer[3*i+1];
-            cumulBlue+=_rgbBuffer[3*i+2];
-            cumulDepth+=_depthBuffer[i];
-            cumulIntensity+=intens;
-            // we actualize min/max values:
-            //r = (x < y) ? x : y
-            // Red
-            if (_rgbBuffer[3*i+0]<sensorResult.sensorDataRed[0])
-                sensorResult.sensorDataRed[0]=_rgbBuffer[3*i+0];
-            if (_rgbBuffer[3*i+0]>sensorResult.sensorDataRed[1])
-                sensorResult.sensorDataRed[1]=_rgbBuffer[3*i+0];
-            // Green
-            if (_rgbBuffer[3*i+1]<sensorResult.sensorDataGreen[0])
-                sensorResult.sensorDataGreen[0]=_rgbBuffer[3*i+1];
-            if (_rgbBuffer[3*i+1]>sensorResult.sensorDataGreen[1])
-                sensorResult.sensorDataGreen[1]=_rgbBuffer[3*i+1];
-            // Blue
-            if (_rgbBuffer[3*i+2]<sensorResult.sensorDataBlue[0])
-                sensorResult.sensorDataBlue[0]=_rgbBuffer[3*i+2];
-            if (_rgbBuffer[3*i+2]>sensorResult.sensorDataBlue[1])
-                sensorResult.sensorDataBlue[1]=_rgbBuffer[3*i+2];
-            // Intensity
-            if (intens<sensorResult.sensorDataIntensity[0])
-                sensorResult.sensorDataIntensity[0]=intens;
-            if (intens>sensorResult.sensorDataIntensity[1])
-                sensorResult.sensorDataIntensity[1]=intens;
-            // Depth
-            if (_depthBuffer[i]<sensorResult.sensorDataDepth[0])
-                sensorResult.sensorDataDepth[0]=_depthBuffer[i];
-            if (_depthBuffer[i]>sensorResult.sensorDataDepth[1])
-                sensorResult.sensorDataDepth[1]=_depthBuffer[i];
+            const SVisionSensorImageChunk& c=_imageChunks[i];
+            for (int j=0;j<4;j++)
+            {
+                if (c.rgbiMin[j]<res.rgbiMin[j])
+                    res.rgbiMin[j]=c.rgbiMin[j];
+                if (c.rgbiMax[j]>res.rgbiMax[j])
+                    res.rgbiMax[j]=c.rgbiMax[j];
+                res.rgbiSum[j]+=c.rgbiSum[j];
+            }
+            if (c.depthMin<res.depthMin)
+                res.depthMin=c.depthMin;
+            if (c.depthMax>res.depthMax)
+                res.depthMax=c.depthMax;
+            res.depthSum+=c.depthSum;
         }
-        unsigned char averageRed=cumulRed/v;
-        unsigned char averageGreen=cumulGreen/v;
-        unsigned char averageBlue=cumulBlue/v;
-        unsigned char averageIntensity=cumulIntensity/v;
-        float averageDepth=cumulDepth/float(v);
+        unsigned long long int v=(unsigned long long int)(_resolutionX*_resolutionY);
+        sensorResult.sensorDataRed[0]=(unsigned char)res.rgbiMin[0];
+        sensorResult.sensorDataRed[1]=(unsigned char)res.rgbiMax[0];
+        sensorResult.sensorDataGreen[0]=(unsigned char)res.rgbiMin[1];
+        sensorResult.sensorDataGreen[1]=(unsigned char)res.rgbiMax[1];
+        sensorResult.sensorDataBlue[0]=(unsigned char)res.rgbiMin[2];
+        sensorResult.sensorDataBlue[1]=(unsigned char)res.rgbiMax[2];
+        sensorResult.sensorDataIntensity[0]=(unsigned char)res.rgbiMin[3];
+        sensorResult.sensorDataIntensity[1]=(unsigned char)res.rgbiMax[3];
+        sensorResult.sensorDataDepth[0]=res.depthMin;
+        sensorResult.sensorDataDepth[1]=res.depthMax;
+        unsigned char averageRed=(unsigned char)(res.rgbiSum[0]/v);
+        unsigned char averageGreen=(unsigned char)(res.rgbiSum[1]/v);
+        unsigned char averageBlue=(unsigned char)(res.rgbiSum[2]/v);
+        unsigned char averageIntensity=(unsigned char)(res.rgbiSum[3]/v);
+        float averageDepth=float(res.depthSum/double(v));
         // We set-up average values:
         sensorResult.sensorDataRed[2]=averageRed;
         sensorResult.sensorDataGreen[2]=averageGreen;
@@ -2278,6 +2256,119 @@ bool CVisionSensor::_computeDefaultReturnValuesAndApplyFilters()
     return(trigger);
 }
 
+int CVisionSensor::_prepareImageChunks()
+{ // splits the image into pixel ranges that can be processed in parallel. Small images are not split
+    int pixelCount=_resolutionX*_resolutionY;
+    int chunkCount=pixelCount/VISION_SENSOR_MIN_PIXELS_PER_CHUNK;
+    if (chunkCount>1)
+    {
+        int maxChunkCount=CWorkerPool::getWorkerCount()+1; // the calling thread also works
+        if (chunkCount>maxChunkCount)
+            chunkCount=maxChunkCount;
+    }
+    if (chunkCount<1)
+        chunkCount=1;
+    _imageChunks.resize(chunkCount);
+    _imageChunkPtrs.resize(chunkCount);
+    for (int i=0;i<chunkCount;i++)
+    {
+        _imageChunks[i].rgb=_rgbBuffer;
+        _imageChunks[i].depth=_depthBuffer;
+        _imageChunks[i].start=int((long long int)pixelCount*i/chunkCount);
+        _imageChunks[i].end=int((long long int)pixelCount*(i+1)/chunkCount);
+        _imageChunkPtrs[i]=&_imageChunks[i];
+    }
+    return(chunkCount);
+}
+
+void CVisionSensor::_linearizeDepthBuffer()
+{ // converts the depth buffer into values corresponding to linear depths (perspective mode)
+    int chunkCount=_prepareImageChunks();
+    for (int i=0;i<chunkCount;i++)
+    {
+        _imageChunks[i].nearClippingPlane=_nearClippingPlane;
+        _imageChunks[i].farMinusNear=_farClippingPlane-_nearClippingPlane;
+        _imageChunks[i].farDivFarMinusNear=_farClippingPlane/_imageChunks[i].farMinusNear;
+        _imageChunks[i].nearTimesFar=_nearClippingPlane*_farClippingPlane;
+    }
+    CWorkerPool::runTasks(_linearizeDepthTask,&_imageChunkPtrs[0],chunkCount);
+}
+
+void CVisionSensor::_linearizeDepthTask(void* data)
+{ // can run on any thread. Params are copied locally, so that the loop has no dependency and can be vectorized
+    SVisionSensorImageChunk* chunk=(SVisionSensorImageChunk*)data;
+    float* depth=chunk->depth;
+    const float nearClippingPlane=chunk->nearClippingPlane;
+    const float farMinusNear=chunk->farMinusNear;
+    const float farDivFarMinusNear=chunk->farDivFarMinusNear;
+    const float nearTimesFar=chunk->nearTimesFar;
+    const int end=chunk->end;
+    for (int i=chunk->start;i<end;i++)
+        depth[i]=((nearTimesFar/(farMinusNear*(farDivFarMinusNear-depth[i])))-nearClippingPlane)/farMinusNear;
+}
+
+void CVisionSensor::_computeImageStatsTask(void* data)
+{ // can run on any thread. Computes min, max and sum of red, green, blue, intensity and depth, over the chunk's pixels
+    SVisionSensorImageChunk* chunk=(SVisionSensorImageChunk*)data;
+    const unsigned char* rgb=chunk->rgb;
+    const float* depth=chunk->depth;
+    const int start=chunk->start;
+    const int end=chunk->end;
+    unsigned int minR=rgb[3*start+0];
+    unsigned int minG=rgb[3*start+1];
+    unsigned int minB=rgb[3*start+2];
+    unsigned int minI=(minR+minG+minB)/3;
+    unsigned int maxR=minR;
+    unsigned int maxG=minG;
+    unsigned int maxB=minB;
+    unsigned int maxI=minI;
+    float minD=depth[start];
+    float maxD=minD;
+    unsigned long long int sumR=0;
+    unsigned long long int sumG=0;
+    unsigned long long int sumB=0;
+    unsigned long long int sumI=0;
+    double sumD=0.0;
+    for (int i=start;i<end;i++)
+    { // branch-free
+        unsigned int r=rgb[3*i+0];
+        unsigned int g=rgb[3*i+1];
+        unsigned int b=rgb[3*i+2];
+        unsigned int intens=(r+g+b)/3;
+        float d=depth[i];
+        minR=(r<minR)?r:minR;
+        maxR=(r>maxR)?r:maxR;
+        minG=(g<minG)?g:minG;
+        maxG=(g>maxG)?g:maxG;
+        minB=(b<minB)?b:minB;
+        maxB=(b>maxB)?b:maxB;
+        minI=(intens<minI)?intens:minI;
+        maxI=(intens>maxI)?intens:maxI;
+        minD=(d<minD)?d:minD;
+        maxD=(d>maxD)?d:maxD;
+        sumR+=r;
+        sumG+=g;
+        sumB+=b;
+        sumI+=intens;
+        sumD+=d;
+    }
+    chunk->rgbiMin[0]=minR;
+    chunk->rgbiMin[1]=minG;
+    chunk->rgbiMin[2]=minB;
+    chunk->rgbiMin[3]=minI;
+    chunk->rgbiMax[0]=maxR;
+    chunk->rgbiMax[1]=maxG;
+    chunk->rgbiMax[2]=maxB;
+    chunk->rgbiMax[3]=maxI;
+    chunk->rgbiSum[0]=sumR;
+    chunk->rgbiSum[1]=sumG;
+    chunk->rgbiSum[2]=sumB;
+    chunk->rgbiSum[3]=sumI;
+    chunk->depthMin=minD;
+    chunk->depthMax=maxD;
+    chunk->depthSum=sumD;
+}
+
 void CVisionSensor::serialize(CSer& ar)
 {
     CSceneObject::serialize(ar);
@@ -2334,6 +2425,7 @@ void CVisionSensor::serialize(CSer& ar)
             SIM_SET_CLEAR_BIT(nothing,2,_ignoreDepthInfo);
             // RESERVED SIM_SET_CLEAR_BIT(nothing,3,_povFocalBlurEnabled);
             SIM_SET_CLEAR_BIT(nothing,4,!_computeImageBasicStats);
+            SIM_SET_CLEAR_BIT(nothing,5,_pipelinedReadback);
             ar << nothing;
             ar.flush();
 
@@ -2457,6 +2549,7 @@ void CVisionSensor::serialize(CSer& ar)
                         _ignoreDepthInfo=SIM_IS_BIT_SET(nothing,2);
                         povFocalBlurEnabled_backwardCompatibility_3_2_2016=SIM_IS_BIT_SET(nothing,3);
                         _computeImageBasicStats=!SIM_IS_BIT_SET(nothing,4);
+                        _pipelinedReadback=SIM_IS_BIT_SET(nothing,5);
                     }
                     if (theName.compare("Pv1")==0)
                     { // Keep for backward compatibility (3/2/2016)
@@ -2570,6 +2663,7 @@ void CVisionSensor::serialize(CSer& ar)
             ar.xmlAddNode_bool("ignoreRgbInfo",_ignoreRGBInfo);
             ar.xmlAddNode_bool("ignoreDepthInfo",_ignoreDepthInfo);
             ar.xmlAddNode_bool("computeBasicStats",_computeImageBasicStats);
+            ar.xmlAddNode_bool("pipelinedReadback",_pipelinedReadback);
             ar.xmlAddNode_bool("sameBackgroundAsEnvironment",_useSameBackgroundAsEnvironment);
             ar.xmlPopNode();
 
@@ -2653,6 +2747,7 @@ void CVisionSensor::serialize(CSer& ar)
                 ar.xmlGetNode_bool("ignoreRgbInfo",_ignoreRGBInfo,exhaustiveXml);
                 ar.xmlGetNode_bool("ignoreDepthInfo",_ignoreDepthInfo,exhaustiveXml);
                 ar.xmlGetNode_bool("computeBasicStats",_computeImageBasicStats,exhaustiveXml);
+                ar.xmlGetNode_bool("pipelinedReadback",_pipelinedReadback,false);
                 ar.xmlGetNode_bool("sameBackgroundAsEnvironment",_useSameBackgroundAsEnvironment,exhaustiveXml);
                 ar.xmlPopNode();
             }
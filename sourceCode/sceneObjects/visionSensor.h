@@ -8,6 +8,10 @@
 #include "visionSensorGlStuff.h"
 #endif
 
+#ifndef sim_visionintparam_pipelined_readback
+    #define sim_visionintparam_pipelined_readback 1030 // not yet in simConst.h
+#endif
+
 struct SHandlingResult
 {
     bool sensorWasTriggered;
@@ -20,6 +24,26 @@ struct SHandlingResult
     int calcTimeInMs;
 };
 
+struct SVisionSensorImageChunk
+{ // a range of pixels of the sensor's image, processed by a worker thread
+    const unsigned char* rgb;
+    float* depth;
+    int start;
+    int end;
+    // depth linearization (perspective mode):
+    float nearClippingPlane;
+    float farMinusNear;
+    float farDivFarMinusNear;
+    float nearTimesFar;
+    // statistics (red, green, blue, intensity):
+    unsigned int rgbiMin[4];
+    unsigned int rgbiMax[4];
+    unsigned long long int rgbiSum[4];
+    float depthMin;
+    float depthMax;
+    double depthSum;
+};
+
 class CVisionSensor : public CViewableBase  
 {
 public:
@@ -96,6 +120,8 @@ public:
 
     void setComputeImageBasicStats(bool c);
     bool getComputeImageBasicStats();
+    void setPipelinedReadback(bool p);
+    bool getPipelinedReadback();
 
     unsigned char* getRgbBufferPointer();
     float* getDepthBufferPointer();
@@ -142,6 +168,10 @@ protected:
     void _clearBuffers();
 
     bool _computeDefaultReturnValuesAndApplyFilters();
+    int _prepareImageChunks();
+    void _linearizeDepthBuffer();
+    static void _linearizeDepthTask(void* data);
+    static void _computeImageStatsTask(void* data);
 
     CSceneObject* _getInfoOfWhatNeedsToBeRendered(int entityID,bool detectAll,int rendAttrib,bool entityIsModelAndRenderAllVisibleModelAlsoNonRenderableObjects,bool overrideRenderableFlagsForNonCollections,std::vector<CSceneObject*>& toRender);
 
@@ -152,6 +182,10 @@ protected:
 
     unsigned char* _rgbBuffer;
     float* _depthBuffer;
+    std::vector<unsigned char> _savedRgbBuffer; // reused by checkSensor and checkSensorEx
+    std::vector<float> _savedDepthBuffer; // reused by checkSensor and checkSensorEx
+    std::vector<SVisionSensorImageChunk> _imageChunks;
+    std::vector<void*> _imageChunkPtrs;
 
     unsigned int _rayTracingTextureName;
 
@@ -176,6 +210,8 @@ protected:
     bool _ignoreRGBInfo;
     bool _ignoreDepthInfo;
     bool _computeImageBasicStats;
+    bool _pipelinedReadback; // image read back asynchronously, and available one step later
+    bool _readbackMayBePipelined; // only when handled, not when checked
     int _renderMode; // 0=visible, 1=aux channels, 2=colorCodedID, 3=rayTracer, 4=rayTracer2, 5=extRenderer, 6=extRendererWindowed, 7=oculus, 8=oculusWindowed
     int _attributesForRendering;
     bool _inApplyFilterRoutine;
@@ -1,6 +1,8 @@
 #include "app.h"
 #include "visionSensorGlStuff.h"
 #include "glShader.h"
+#include "oglExt.h"
+#include <cstring>
 
 #ifdef USING_QOPENGLWIDGET
 CVisionSensorGlStuff::CVisionSensorGlStuff(int resX,int resY,int offscreenType,bool qtFbo,QOpenGLWidget* otherWidgetToShareResourcesWith,bool useStencilBuffer,bool destroyOffscreenContext,int majorOpenGl,int minorOpenGl) : QObject()
@@ -9,6 +11,12 @@ CVisionSensorGlStuff::CVisionSensorGlStuff(int resX,int resY,int offscreenType,b
 #endif
 {
     _destroyOffscreenContext=destroyOffscreenContext;
+    _resolution[0]=resX;
+    _resolution[1]=resY;
+    _pboSupport=-1;
+    _pbos[0][0]=0;
+    _pboWriteSlot=0;
+    clearPipelinedReadback();
 
     // 1. We need an offscreen context:
     offscreenContext=new COffscreenGlContext(offscreenType,resX,resY,otherWidgetToShareResourcesWith,majorOpenGl,minorOpenGl);
@@ -28,6 +36,8 @@ CVisionSensorGlStuff::~CVisionSensorGlStuff()
 {
     TRACE_INTERNAL;
     offscreenContext->makeCurrent();
+    if (_pbos[0][0]!=0)
+        oglExt::DeleteBuffers(4,&_pbos[0][0]);
     delete textureObject;
     delete frameBufferObject;
     offscreenContext->doneCurrent();
@@ -41,3 +51,84 @@ bool CVisionSensorGlStuff::canDeleteNow()
 {
     return(offscreenContext->canBeDeleted());
 }
+
+int CVisionSensorGlStuff::readPixelsPipelined(unsigned char* rgbBuffer,float* depthBuffer)
+{ // Context must be current and FBO bound. Starts an asynchronous readback of the current image, and
+  // returns the image started with the previous call (i.e. one step latency). Pass nullptr to ignore a buffer.
+  // Returns -1 if pixel-buffer objects are not supported, 0 if there is no previous image yet (buffers untouched), otherwise 1
+    if (_pboSupport==-1)
+        _pboSupport=oglExt::isPboAvailable();
+    if (_pboSupport==0)
+        return(-1);
+    if (_pbos[0][0]==0)
+    {
+        oglExt::GenBuffers(4,&_pbos[0][0]);
+        for (int s=0;s<2;s++)
+        {
+            oglExt::BindBuffer(GL_PIXEL_PACK_BUFFER,_pbos[s][0]);
+            oglExt::BufferData(GL_PIXEL_PACK_BUFFER,_resolution[0]*_resolution[1]*3,nullptr,GL_STREAM_READ);
+            oglExt::BindBuffer(GL_PIXEL_PACK_BUFFER,_pbos[s][1]);
+            oglExt::BufferData(GL_PIXEL_PACK_BUFFER,_resolution[0]*_resolution[1]*sizeof(float),nullptr,GL_STREAM_READ);
+        }
+    }
+    int w=_pboWriteSlot;
+    int r=1-w;
+    void* buffers[2]={rgbBuffer,depthBuffer};
+    size_t sizes[2]={size_t(_resolution[0]*_resolution[1]*3),size_t(_resolution[0]*_resolution[1])*sizeof(float)};
+    int retVal=1;
+    for (int c=0;c<2;c++)
+    {
+        if ( (buffers[c]!=nullptr)&&(!_pboFilled[r][c]) )
+            retVal=0; // first time (or a re-enabled channel). Returning the current image now would return it twice
+    }
+
+    // 1. Start the readback of the current image. glReadPixels returns immediately:
+    for (int c=0;c<2;c++)
+    {
+        if (buffers[c]!=nullptr)
+        {
+            oglExt::BindBuffer(GL_PIXEL_PACK_BUFFER,_pbos[w][c]);
+            if (c==0)
+            {
+                glPixelStorei(GL_PACK_ALIGNMENT,1);
+                glReadPixels(0,0,_resolution[0],_resolution[1],GL_RGB,GL_UNSIGNED_BYTE,nullptr);
+                glPixelStorei(GL_PACK_ALIGNMENT,4);
+            }
+            else
+                glReadPixels(0,0,_resolution[0],_resolution[1],GL_DEPTH_COMPONENT,GL_FLOAT,nullptr);
+            _pboFilled[w][c]=true;
+        }
+        else
+        { // a re-enabled channel shouldn't return an old image
+            _pboFilled[0][c]=false;
+            _pboFilled[1][c]=false;
+        }
+    }
+
+    // 2. Retrieve the previous image. That transfer is normally finished by now:
+    for (int c=0;c<2;c++)
+    {
+        if ( (retVal==1)&&(buffers[c]!=nullptr) )
+        {
+            oglExt::BindBuffer(GL_PIXEL_PACK_BUFFER,_pbos[r][c]);
+            void* p=oglExt::MapBuffer(GL_PIXEL_PACK_BUFFER,GL_READ_ONLY);
+            if (p!=nullptr)
+            {
+                memcpy(buffers[c],p,sizes[c]);
+                oglExt::UnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+        }
+    }
+    oglExt::BindBuffer(GL_PIXEL_PACK_BUFFER,0);
+    _pboWriteSlot=r;
+    return(retVal);
+}
+
+void CVisionSensorGlStuff::clearPipelinedReadback()
+{ // the next readback will not return an image
+    for (int s=0;s<2;s++)
+    {
+        _pboFilled[s][0]=false;
+        _pboFilled[s][1]=false;
+    }
+}
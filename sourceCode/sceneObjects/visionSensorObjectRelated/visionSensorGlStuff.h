@@ -17,10 +17,19 @@ public:
     virtual ~CVisionSensorGlStuff();
 
     bool canDeleteNow();
+    int readPixelsPipelined(unsigned char* rgbBuffer,float* depthBuffer);
+    void clearPipelinedReadback();
 
     COffscreenGlContext* offscreenContext;
     CFrameBufferObject* frameBufferObject;
     CTextureObject* textureObject;
 protected:
     bool _destroyOffscreenContext;
+    int _resolution[2];
+
+    // Pixel-buffer objects for pipelined readback. Double-buffered:
+    int _pboSupport; // -1: not yet checked
+    unsigned int _pbos[2][2]; // [slot][0=rgb, 1=depth]
+    bool _pboFilled[2][2];
+    int _pboWriteSlot;
 };
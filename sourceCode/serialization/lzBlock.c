@@ -0,0 +1,300 @@
+/*************************************************************************
+* Name:        lzBlock.c
+* Description: Fast LZ77 block coder/decoder implementation.
+* Reentrant:   Yes
+*
+* The compressed block is a list of sequences. Each sequence is:
+*  - a token byte: literal count (high nibble) and match length-4 (low
+*    nibble). A nibble value of 15 means that the count continues with
+*    extra bytes (each 255 adds 255, the first byte <255 ends it)
+*  - the literals
+*  - the match offset (2 bytes, little endian, 1..65535), followed by the
+*    extra match length bytes. The last sequence has no match, and ends
+*    the block
+*
+* Matches are found with a single hash table (greedy parsing), which
+* favours speed over ratio. The decoder checks all offsets and lengths,
+* and fails on corrupt input instead of reading or writing out of bounds.
+*************************************************************************/
+
+#include "lzBlock.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+/*************************************************************************
+* Constants
+*************************************************************************/
+
+#define LZB_MIN_MATCH     4
+#define LZB_MAX_OFFSET    65535
+#define LZB_HASH_BITS     14
+#define LZB_LAST_LITERALS 5  /* the last bytes are always literals */
+#define LZB_MF_LIMIT      12 /* no match starts in the last bytes */
+
+
+
+/*************************************************************************
+*                           INTERNAL FUNCTIONS                           *
+*************************************************************************/
+
+
+/*************************************************************************
+* _LzBlock_Read32() - Unaligned read of 4 bytes.
+*************************************************************************/
+
+static unsigned int _LzBlock_Read32( const unsigned char *p )
+{
+  unsigned int x;
+  memcpy( &x, p, 4 );
+  return x;
+}
+
+
+/*************************************************************************
+* _LzBlock_Hash() - Hash of 4 bytes.
+*************************************************************************/
+
+static unsigned int _LzBlock_Hash( unsigned int x )
+{
+  return (x * 2654435761U) >> (32-LZB_HASH_BITS);
+}
+
+
+/*************************************************************************
+* _LzBlock_WriteLength() - Write the extra bytes of a length >= 15.
+*************************************************************************/
+
+static unsigned char *_LzBlock_WriteLength( unsigned char *op,
+    unsigned int len )
+{
+  len -= 15;
+  while( len >= 255 )
+  {
+    *op ++ = 255;
+    len -= 255;
+  }
+  *op ++ = (unsigned char) len;
+  return op;
+}
+
+
+/*************************************************************************
+* _LzBlock_WriteSequence() - Write literals and an optional match.
+*************************************************************************/
+
+static unsigned char *_LzBlock_WriteSequence( unsigned char *op,
+    const unsigned char *literals, unsigned int litlen,
+    unsigned int offset, unsigned int matchlen )
+{
+  unsigned char *token = op ++;
+  unsigned int  ml = 0;
+
+  /* Literal count */
+  *token = (unsigned char) ((litlen < 15 ? litlen : 15) << 4);
+  if( litlen >= 15 )
+  {
+    op = _LzBlock_WriteLength( op, litlen );
+  }
+  memcpy( op, literals, litlen );
+  op += litlen;
+
+  /* Match */
+  if( matchlen > 0 )
+  {
+    *op ++ = (unsigned char) (offset & 255);
+    *op ++ = (unsigned char) (offset >> 8);
+    ml = matchlen - LZB_MIN_MATCH;
+    *token |= (unsigned char) (ml < 15 ? ml : 15);
+    if( ml >= 15 )
+    {
+      op = _LzBlock_WriteLength( op, ml );
+    }
+  }
+  return op;
+}
+
+
+/*************************************************************************
+* _LzBlock_ReadLength() - Read the extra bytes of a length. Returns 0 if
+* the input ends too early.
+*************************************************************************/
+
+static int _LzBlock_ReadLength( const unsigned char **ip,
+    const unsigned char *iend, unsigned int *len )
+{
+  unsigned int b;
+  do
+  {
+    if( *ip >= iend )
+    {
+      return 0;
+    }
+    b = *(*ip) ++;
+    *len += b;
+  }
+  while( b == 255 );
+  return 1;
+}
+
+
+
+/*************************************************************************
+*                            PUBLIC FUNCTIONS                            *
+*************************************************************************/
+
+
+/*************************************************************************
+* LzBlock_CompressBound() - Worst case size of a compressed block.
+*  insize  - Number of input bytes.
+*************************************************************************/
+
+unsigned int LzBlock_CompressBound( unsigned int insize )
+{
+  return insize + insize/255 + 16;
+}
+
+
+/*************************************************************************
+* LzBlock_Compress() - Compress a block of data.
+*  in      - Input (uncompressed) buffer.
+*  out     - Output (compressed) buffer. This buffer must be at least
+*            LzBlock_CompressBound(insize) bytes.
+*  insize  - Number of input bytes.
+* The function returns the size of the compressed data, or 0 if the
+* hash table could not be allocated.
+*************************************************************************/
+
+unsigned int LzBlock_Compress( const unsigned char *in, unsigned char *out,
+    unsigned int insize )
+{
+  unsigned int  *table;
+  unsigned int  ip, anchor, ref, h, seq, len, step;
+  unsigned char *op = out;
+
+  table = (unsigned int *) malloc( sizeof(unsigned int) << LZB_HASH_BITS );
+  if( !table )
+  {
+    return 0;
+  }
+  memset( table, 0xff, sizeof(unsigned int) << LZB_HASH_BITS );
+
+  ip = 0;
+  anchor = 0;
+  while( insize > LZB_MF_LIMIT && ip < insize - LZB_MF_LIMIT )
+  {
+    seq = _LzBlock_Read32( in + ip );
+    h = _LzBlock_Hash( seq );
+    ref = table[ h ];
+    table[ h ] = ip;
+    if( ref != 0xffffffff && ip - ref <= LZB_MAX_OFFSET &&
+        _LzBlock_Read32( in + ref ) == seq )
+    {
+      /* Extend the match forward */
+      len = LZB_MIN_MATCH;
+      while( ip + len < insize - LZB_LAST_LITERALS &&
+             in[ ref + len ] == in[ ip + len ] )
+      {
+        ++ len;
+      }
+      op = _LzBlock_WriteSequence( op, in + anchor, ip - anchor,
+                                   ip - ref, len );
+      ip += len;
+      anchor = ip;
+      if( ip < insize - LZB_MF_LIMIT )
+      {
+        table[ _LzBlock_Hash( _LzBlock_Read32( in + ip - 2 ) ) ] = ip - 2;
+      }
+    }
+    else
+    {
+      /* Skip faster over data that does not compress */
+      step = 1 + ((ip - anchor) >> 6);
+      ip += step;
+    }
+  }
+
+  /* Last literals */
+  op = _LzBlock_WriteSequence( op, in + anchor, insize - anchor, 0, 0 );
+
+  free( table );
+  return (unsigned int) (op - out);
+}
+
+
+/*************************************************************************
+* LzBlock_Uncompress() - Uncompress a block of data.
+*  in      - Input (compressed) buffer.
+*  out     - Output (uncompressed) buffer. This buffer must be large
+*            enough to hold the uncompressed data.
+*  insize  - Number of input bytes.
+*  outsize - Number of output bytes.
+* The function returns 1 on success, or 0 if the input is corrupt.
+*************************************************************************/
+
+int LzBlock_Uncompress( const unsigned char *in, unsigned char *out,
+    unsigned int insize, unsigned int outsize )
+{
+  const unsigned char *ip = in, *iend = in + insize;
+  unsigned char       *op = out, *oend = out + outsize;
+  unsigned int        token, litlen, matchlen, offset;
+  const unsigned char *match;
+
+  while( ip < iend )
+  {
+    token = *ip ++;
+
+    /* Literals */
+    litlen = token >> 4;
+    if( litlen == 15 && !_LzBlock_ReadLength( &ip, iend, &litlen ) )
+    {
+      return 0;
+    }
+    if( litlen > (unsigned int) (iend - ip) ||
+        litlen > (unsigned int) (oend - op) )
+    {
+      return 0;
+    }
+    memcpy( op, ip, litlen );
+    op += litlen;
+    ip += litlen;
+    if( ip == iend )
+    {
+      break; /* last sequence */
+    }
+
+    /* Match */
+    if( iend - ip < 2 )
+    {
+      return 0;
+    }
+    offset = ip[ 0 ] | (ip[ 1 ] << 8);
+    ip += 2;
+    matchlen = token & 15;
+    if( matchlen == 15 && !_LzBlock_ReadLength( &ip, iend, &matchlen ) )
+    {
+      return 0;
+    }
+    matchlen += LZB_MIN_MATCH;
+    if( offset == 0 || offset > (unsigned int) (op - out) ||
+        matchlen > (unsigned int) (oend - op) )
+    {
+      return 0;
+    }
+    match = op - offset;
+    if( offset >= matchlen )
+    {
+      memcpy( op, match, matchlen );
+      op += matchlen;
+    }
+    else
+    {
+      /* Overlapping copy */
+      while( matchlen -- )
+      {
+        *op ++ = *match ++;
+      }
+    }
+  }
+  return op == oend;
+}
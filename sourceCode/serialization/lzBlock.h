@@ -0,0 +1,31 @@
+/*************************************************************************
+* Name:        lzBlock.h
+* Description: Fast LZ77 block coder/decoder interface (byte-aligned,
+*              LZ4-like sequences, 64KB window).
+* Reentrant:   Yes
+*************************************************************************/
+
+#ifndef _lzBlock_h_
+#define _lzBlock_h_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*************************************************************************
+* Function prototypes
+*************************************************************************/
+
+unsigned int LzBlock_CompressBound( unsigned int insize );
+unsigned int LzBlock_Compress( const unsigned char *in, unsigned char *out,
+                               unsigned int insize );
+int LzBlock_Uncompress( const unsigned char *in, unsigned char *out,
+                        unsigned int insize, unsigned int outsize );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _lzBlock_h_ */
@@ -1,5 +1,7 @@
 #include "ser.h"
 #include "huffman.h"
+#include "lzBlock.h"
+#include "workerPool.h"
 #include "simStrings.h"
 #include "app.h"
 #include <boost/format.hpp>
@@ -9,8 +11,10 @@
 #include "imgLoaderSaver.h"
 #include "pluginContainer.h"
 #include "simFlavor.h"
+#include <cstring>
+#include <algorithm>
 
-int CSer::SER_SERIALIZATION_VERSION=22; // 9 since 2008/09/01,
+int CSer::SER_SERIALIZATION_VERSION=23; // 9 since 2008/09/01,
                                         // 10 since 2009/02/14,
                                         // 11 since 2009/05/15,
                                         // 12 since 2009/07/03,
@@ -24,8 +28,10 @@ int CSer::SER_SERIALIZATION_VERSION=22; // 9 since 2008/09/01,
                                         // 20 since 2017/03/08 (small detail)
                                         // 21 since 2017/05/26 (New API notation)
                                         // 22 since 2019/04/29 (Striped away some backward compatibility features)
+                                        // 23 since 2026/10/17 (compression method 2: independently compressed chunks)
 
 int CSer::SER_MIN_SERIALIZATION_VERSION_THAT_CAN_READ_THIS=18; // means: files written with this can be read by older CoppeliaSim with serialization THE_NUMBER
+int CSer::SER_MIN_SERIALIZATION_VERSION_THAT_CAN_READ_CHUNKS=23; // compressed files (method 2) can only be read by CoppeliaSim with serialization >=THE_NUMBER
 int CSer::SER_MIN_SERIALIZATION_VERSION_THAT_THIS_CAN_READ=18; // means: this executable can read versions >=THE_NUMBER
 int CSer::XML_XSERIALIZATION_VERSION=1;
 const bool xmlDebug=false;
@@ -72,9 +78,13 @@ void CSer::_commonInit()
     _multiPurposeCounter=0;
     _xmlUseImageAndMeshFileformats=false;
     _noHeader=false;
+    _compress=false;
+    _compressionMethod=0;
     countingMode=0;
     counter=0;
     _coutingModeDisabledExceptForExceptions=false;
+    _blockMarksEnabled=false;
+    _blockDepth=0;
     buffer.reserve(100000);
     _fileBuffer.reserve(1000000);
     _fileBuffer.clear();
@@ -159,34 +169,25 @@ void CSer::writeClose()
         if (_compress)
         { // compressed. When changing compression method, then serialization version has to be incremented and older version won't be able to read newer versions anymore!
             CSimFlavor::handleBrFile(_filetype,(char*)&_fileBuffer[0]);
-            // Hufmann:
-            unsigned char* writeBuff=new unsigned char[_fileBuffer.size()+400]; // actually 384
-            int outSize=Huffman_Compress(&_fileBuffer[0],writeBuff,(int)_fileBuffer.size());
-            if (theArchive!=nullptr)
-            {
-                for (int i=0;i<outSize;i++)
-                    (*theArchive) << writeBuff[i];
+            if (_compressionMethod==2)
+            { // independent chunks, compressed in parallel:
+                std::vector<unsigned char> writeBuff;
+                _compressChunked(writeBuff);
+                if (writeBuff.size()>0)
+                    _writeToArchive(&writeBuff[0],writeBuff.size());
             }
             else
-            {
-                for (int i=0;i<outSize;i++)
-                    (*_bufferArchive).push_back(writeBuff[i]);
+            { // Hufmann (the header, if present, does not specify compression):
+                unsigned char* writeBuff=new unsigned char[_fileBuffer.size()+400]; // actually 384
+                int outSize=Huffman_Compress(&_fileBuffer[0],writeBuff,(int)_fileBuffer.size());
+                _writeToArchive(writeBuff,outSize);
+                delete[] writeBuff;
             }
-            delete[] writeBuff;
         }
         else
         { // no compression
-            int l=int(_fileBuffer.size());
-            if (theArchive!=nullptr)
-            {
-                for (int i=0;i<l;i++)
-                    (*theArchive) << _fileBuffer[i];
-            }
-            else
-            {
-                for (int i=0;i<l;i++)
-                    (*_bufferArchive).push_back(_fileBuffer[i]);
-            }
+            if (_fileBuffer.size()>0)
+                _writeToArchive(&_fileBuffer[0],_fileBuffer.size());
         }
         _fileBuffer.clear();
     }
@@ -219,25 +220,32 @@ void CSer::_writeBinaryHeader()
         (*_bufferArchive).push_back(((char*)&SER_SERIALIZATION_VERSION)[3]);
     }
 
+    // The compression method affects the minimum sim. version that can read this:
+    char compressionMethod=0;
+    int minSerializationVersionThatCanReadThis=SER_MIN_SERIALIZATION_VERSION_THAT_CAN_READ_THIS;
+    if (_compress)
+    {
+        compressionMethod=2; // 1 for Huffman, 2 for independently compressed chunks
+        minSerializationVersionThatCanReadThis=std::max<int>(minSerializationVersionThatCanReadThis,SER_MIN_SERIALIZATION_VERSION_THAT_CAN_READ_CHUNKS);
+    }
+
     // We write the minimum sim. version that can read this:
     if (theArchive!=nullptr)
     {
-        (*theArchive) << ((char*)&SER_MIN_SERIALIZATION_VERSION_THAT_CAN_READ_THIS)[0];
-        (*theArchive) << ((char*)&SER_MIN_SERIALIZATION_VERSION_THAT_CAN_READ_THIS)[1];
-        (*theArchive) << ((char*)&SER_MIN_SERIALIZATION_VERSION_THAT_CAN_READ_THIS)[2];
-        (*theArchive) << ((char*)&SER_MIN_SERIALIZATION_VERSION_THAT_CAN_READ_THIS)[3];
+        (*theArchive) << ((char*)&minSerializationVersionThatCanReadThis)[0];
+        (*theArchive) << ((char*)&minSerializationVersionThatCanReadThis)[1];
+        (*theArchive) << ((char*)&minSerializationVersionThatCanReadThis)[2];
+        (*theArchive) << ((char*)&minSerializationVersionThatCanReadThis)[3];
     }
     else
     {
-        (*_bufferArchive).push_back(((char*)&SER_MIN_SERIALIZATION_VERSION_THAT_CAN_READ_THIS)[0]);
-        (*_bufferArchive).push_back(((char*)&SER_MIN_SERIALIZATION_VERSION_THAT_CAN_READ_THIS)[1]);
-        (*_bufferArchive).push_back(((char*)&SER_MIN_SERIALIZATION_VERSION_THAT_CAN_READ_THIS)[2]);
-        (*_bufferArchive).push_back(((char*)&SER_MIN_SERIALIZATION_VERSION_THAT_CAN_READ_THIS)[3]);
+        (*_bufferArchive).push_back(((char*)&minSerializationVersionThatCanReadThis)[0]);
+        (*_bufferArchive).push_back(((char*)&minSerializationVersionThatCanReadThis)[1]);
+        (*_bufferArchive).push_back(((char*)&minSerializationVersionThatCanReadThis)[2]);
+        (*_bufferArchive).push_back(((char*)&minSerializationVersionThatCanReadThis)[3]);
     }
     // We write the compression method:
-    char compressionMethod=0; 
-    if (_compress)
-        compressionMethod=1; // 1 for Huffman
+    _compressionMethod=compressionMethod;
     if (theArchive!=nullptr)
         (*theArchive) << char(compressionMethod); 
     else
@@ -351,6 +359,147 @@ void CSer::_writeBinaryHeader()
         _compress=true;
 }
 
+void CSer::_writeToArchive(const unsigned char* data,size_t size)
+{
+    if (theArchive!=nullptr)
+        theArchive->writeBytes(data,size);
+    else
+        (*_bufferArchive).insert((*_bufferArchive).end(),(const char*)data,(const char*)data+size);
+}
+
+void CSer::_compressChunked(std::vector<unsigned char>& out) const
+{ // Layout: chunk count, then for each chunk its uncompressed size, stored size and codec, then the chunk data.
+  // The index allows to uncompress the chunks in parallel too
+    out.clear();
+    size_t totalSize=_fileBuffer.size();
+    int chunkCnt=int((totalSize+SER_COMPRESSION_CHUNK_SIZE-1)/SER_COMPRESSION_CHUNK_SIZE);
+    unsigned int bound=LzBlock_CompressBound(SER_COMPRESSION_CHUNK_SIZE);
+    std::vector<SSerChunk> chunks(chunkCnt);
+    std::vector<void*> chunkPtrs(chunkCnt);
+    std::vector<unsigned char> compressed(size_t(chunkCnt)*bound);
+    for (int i=0;i<chunkCnt;i++)
+    {
+        size_t off=size_t(i)*SER_COMPRESSION_CHUNK_SIZE;
+        chunks[i].in=&_fileBuffer[off];
+        chunks[i].inSize=(unsigned int)std::min(totalSize-off,size_t(SER_COMPRESSION_CHUNK_SIZE));
+        chunks[i].out=&compressed[size_t(i)*bound];
+        chunks[i].outSize=bound;
+        chunks[i].ok=false;
+        chunkPtrs[i]=&chunks[i];
+    }
+    if (chunkCnt>0)
+        CWorkerPool::runTasks(_compressChunkTask,&chunkPtrs[0],chunkCnt);
+
+    size_t outSize=sizeof(int)+size_t(chunkCnt)*(2*sizeof(unsigned int)+1);
+    for (int i=0;i<chunkCnt;i++)
+        outSize+=chunks[i].outSize;
+    out.resize(outSize);
+    unsigned char* p=&out[0];
+    memcpy(p,&chunkCnt,sizeof(int));
+    p+=sizeof(int);
+    for (int i=0;i<chunkCnt;i++)
+    {
+        memcpy(p,&chunks[i].inSize,sizeof(unsigned int));
+        p+=sizeof(unsigned int);
+        memcpy(p,&chunks[i].outSize,sizeof(unsigned int));
+        p+=sizeof(unsigned int);
+        p[0]=chunks[i].codec;
+        p++;
+    }
+    for (int i=0;i<chunkCnt;i++)
+    {
+        if (chunks[i].codec==SER_CHUNK_CODEC_STORED)
+            memcpy(p,chunks[i].in,chunks[i].outSize);
+        else
+            memcpy(p,chunks[i].out,chunks[i].outSize);
+        p+=chunks[i].outSize;
+    }
+}
+
+bool CSer::_uncompressChunked(int originalDataSize)
+{ // _fileBuffer holds the data written by _compressChunked. Returns false if the data is corrupt
+    size_t inSize=_fileBuffer.size();
+    int chunkCnt=0;
+    if ( (originalDataSize<0)||(inSize<sizeof(int)) )
+        return(false);
+    memcpy(&chunkCnt,&_fileBuffer[0],sizeof(int));
+    size_t indexSize=sizeof(int)+size_t(chunkCnt)*(2*sizeof(unsigned int)+1);
+    if ( (chunkCnt<0)||(size_t(chunkCnt)>inSize)||(indexSize>inSize) )
+        return(false);
+    if (originalDataSize==0)
+    {
+        _fileBuffer.clear();
+        return(chunkCnt==0);
+    }
+    std::vector<unsigned char> uncompressed(originalDataSize);
+    std::vector<SSerChunk> chunks(chunkCnt);
+    std::vector<void*> chunkPtrs(chunkCnt);
+    const unsigned char* p=&_fileBuffer[sizeof(int)];
+    size_t inOff=indexSize;
+    size_t outOff=0;
+    for (int i=0;i<chunkCnt;i++)
+    {
+        memcpy(&chunks[i].outSize,p,sizeof(unsigned int)); // the uncompressed size
+        p+=sizeof(unsigned int);
+        memcpy(&chunks[i].inSize,p,sizeof(unsigned int));
+        p+=sizeof(unsigned int);
+        chunks[i].codec=p[0];
+        p++;
+        if ( (chunks[i].inSize>inSize-inOff)||(chunks[i].outSize>size_t(originalDataSize)-outOff) )
+            return(false);
+        chunks[i].in=&_fileBuffer[0]+inOff;
+        chunks[i].out=&uncompressed[0]+outOff;
+        chunks[i].ok=false;
+        chunkPtrs[i]=&chunks[i];
+        inOff+=chunks[i].inSize;
+        outOff+=chunks[i].outSize;
+    }
+    if (outOff!=size_t(originalDataSize))
+        return(false);
+    if (chunkCnt>0)
+        CWorkerPool::runTasks(_uncompressChunkTask,&chunkPtrs[0],chunkCnt);
+    for (int i=0;i<chunkCnt;i++)
+    {
+        if (!chunks[i].ok)
+            return(false);
+    }
+    _fileBuffer.swap(uncompressed);
+    return(true);
+}
+
+void CSer::_compressChunkTask(void* data)
+{ // runs on a worker thread. Data that does not compress is stored
+    SSerChunk* chunk=(SSerChunk*)data;
+    unsigned int s=LzBlock_Compress(chunk->in,chunk->out,chunk->inSize);
+    if ( (s>0)&&(s<chunk->inSize) )
+    {
+        chunk->codec=SER_CHUNK_CODEC_LZ;
+        chunk->outSize=s;
+    }
+    else
+    {
+        chunk->codec=SER_CHUNK_CODEC_STORED;
+        chunk->outSize=chunk->inSize;
+    }
+    chunk->ok=true;
+}
+
+void CSer::_uncompressChunkTask(void* data)
+{ // runs on a worker thread
+    SSerChunk* chunk=(SSerChunk*)data;
+    chunk->ok=false;
+    if (chunk->codec==SER_CHUNK_CODEC_STORED)
+    {
+        if (chunk->inSize==chunk->outSize)
+        {
+            memcpy(chunk->out,chunk->in,chunk->inSize);
+            chunk->ok=true;
+        }
+    }
+    if (chunk->codec==SER_CHUNK_CODEC_LZ)
+        chunk->ok=(LzBlock_Uncompress(chunk->in,chunk->out,chunk->inSize,chunk->outSize)!=0);
+}
+
 std::string CSer::getFilenamePath() const
 {
     std::string retVal;
@@ -503,12 +652,9 @@ int CSer::readOpenBinaryNoHeader()
         {
             theArchive=new VArchive(theFile,VArchive::LOAD);
             unsigned long l=(unsigned long)theArchive->getFile()->getLength();
-            char dummy;
-            for (unsigned long i=0;i<l;i++)
-            {
-                (*theArchive) >> dummy;
-                _fileBuffer.push_back(dummy);
-            }
+            _fileBuffer.resize(l);
+            if (l>0)
+                _fileBuffer.resize(theArchive->readBytes(&_fileBuffer[0],l));
             retVal=1;
         }
         else
@@ -722,32 +868,30 @@ int CSer::readOpenBinary(int& serializationVersion,unsigned short& coppeliaSimVe
     if (theArchive!=nullptr)
     {
         unsigned long l=(unsigned long)theArchive->getFile()->getLength()-alreadyReadDataCount;
-        char dummy;
-        for (unsigned long i=0;i<l;i++)
-        {
-            (*theArchive) >> dummy;
-            _fileBuffer.push_back(dummy);
-        }
+        _fileBuffer.resize(l);
+        if (l>0)
+            _fileBuffer.resize(theArchive->readBytes(&_fileBuffer[0],l));
     }
     else
-    {
-        for (unsigned long i=bufferArchivePointer;i<(*_bufferArchive).size();i++)
-            _fileBuffer.push_back((*_bufferArchive)[i]);
-    }
+        _fileBuffer.assign((*_bufferArchive).begin()+bufferArchivePointer,(*_bufferArchive).end());
 
     if (compressMethod!=0)
     { // compressed
-        if (compressMethod==1) // for now, only Huffman is supported
+        if (compressMethod==1)
         { // Huffman uncompression:
             unsigned char* uncompressedBuffer=new unsigned char[originalDataSize];
             Huffman_Uncompress(&_fileBuffer[0],uncompressedBuffer,(int)_fileBuffer.size(),originalDataSize);
-            _fileBuffer.clear();
-            for (int i=0;i<originalDataSize;i++)
-                _fileBuffer.push_back(uncompressedBuffer[i]);
+            _fileBuffer.assign(uncompressedBuffer,uncompressedBuffer+originalDataSize);
             delete[] uncompressedBuffer;
 
             return(CSimFlavor::handleReadOpenFile(_filetype,(char*)&_fileBuffer[0]));
         }
+        if (compressMethod==2)
+        { // independent chunks, uncompressed in parallel:
+            if (!_uncompressChunked(originalDataSize))
+                return(-3); // corrupt data
+            return(CSimFlavor::handleReadOpenFile(_filetype,(char*)&_fileBuffer[0]));
+        }
     }
     else
         return(1); // everything went ok!
@@ -780,8 +924,19 @@ void CSer::disableCountingModeExceptForExceptions()
     _coutingModeDisabledExceptForExceptions=true;
 }
 
+void CSer::enableBlockMarks()
+{ // used by the undo/redo functionality, to split a scene buffer into blocks (e.g. one per scene object)
+    _blockMarksEnabled=true;
+}
+
+const std::vector<size_t>* CSer::getBlockMarks() const
+{
+    return(&_blockMarks);
+}
+
 void CSer::setCountingMode(bool force)
 { // force is false by default
+    _blockDepth++;
     if ((!_coutingModeDisabledExceptForExceptions)||force)
     {
         countingMode++;
@@ -790,20 +945,19 @@ void CSer::setCountingMode(bool force)
     }
     else
     { // here we write a dummy value!!
-        for (int i=0;i<int(sizeof(counter));i++)
-            _fileBuffer.push_back(((char*)&counter)[i]);
+        _fileBuffer.insert(_fileBuffer.end(),(unsigned char*)&counter,(unsigned char*)&counter+sizeof(counter));
     }
 }
 
 bool CSer::setWritingMode(bool force)
 { // force is false by default
+    _blockDepth--;
     if ((!_coutingModeDisabledExceptForExceptions)||force)
     {
         countingMode--;
         if (countingMode==0)
         {
-            for (int i=0;i<int(sizeof(counter));i++)
-                _fileBuffer.push_back(((char*)&counter)[i]);
+            _fileBuffer.insert(_fileBuffer.end(),(unsigned char*)&counter,(unsigned char*)&counter+sizeof(counter));
             counter=0;
             return(true);
         }
@@ -843,59 +997,43 @@ std::vector<unsigned char>* CSer::getBufferPointer()
 
 CSer& CSer::operator<< (const int& v)
 {
-    buffer.push_back(((unsigned char*)&v)[0]);
-    buffer.push_back(((unsigned char*)&v)[1]);
-    buffer.push_back(((unsigned char*)&v)[2]);
-    buffer.push_back(((unsigned char*)&v)[3]);
+    _addToBuffer(&v,sizeof(v));
     return(*this);
 }
 
 CSer& CSer::operator<< (const float& v)
 {
-    buffer.push_back(((unsigned char*)&v)[0]);
-    buffer.push_back(((unsigned char*)&v)[1]);
-    buffer.push_back(((unsigned char*)&v)[2]);
-    buffer.push_back(((unsigned char*)&v)[3]);
+    _addToBuffer(&v,sizeof(v));
     return(*this);
 }
 
 CSer& CSer::operator<< (const double& v)
 {
-    unsigned char* tmp=(unsigned char*)(&v);
-    for (int i=0;i<int(sizeof(v));i++)
-        buffer.push_back(tmp[i]);
+    _addToBuffer(&v,sizeof(v));
     return(*this);
 }
 
 CSer& CSer::operator<< (const unsigned short& v)
 {
-    unsigned char* tmp=(unsigned char*)(&v);
-    for (int i=0;i<int(sizeof(v));i++)
-        buffer.push_back(tmp[i]);
+    _addToBuffer(&v,sizeof(v));
     return(*this);
 }
 
 CSer& CSer::operator<< (const unsigned int& v)
 {
-    unsigned char* tmp=(unsigned char*)(&v);
-    for (int i=0;i<int(sizeof(v));i++)
-        buffer.push_back(tmp[i]);
+    _addToBuffer(&v,sizeof(v));
     return(*this);
 }
 
 CSer& CSer::operator<< (const quint64& v)
 {
-    unsigned char* tmp=(unsigned char*)(&v);
-    for (int i=0;i<int(sizeof(v));i++)
-        buffer.push_back(tmp[i]);
+    _addToBuffer(&v,sizeof(v));
     return(*this);
 }
 
 CSer& CSer::operator<< (const long& v)
 {
-    unsigned char* tmp=(unsigned char*)(&v);
-    for (int i=0;i<int(sizeof(v));i++)
-        buffer.push_back(tmp[i]);
+    _addToBuffer(&v,sizeof(v));
     return(*this);
 }
 
@@ -914,8 +1052,7 @@ CSer& CSer::operator<< (const char& v)
 CSer& CSer::operator<< (const std::string& v)
 {
     (*this) << ((int)v.length());
-    for (int i=0;i<int(v.length());i++)
-        (*this) << ((unsigned char)v[i]);
+    _addToBuffer(v.c_str(),v.length());
     return(*this);
 }
 
@@ -936,57 +1073,43 @@ void CSer::addOffsetToFileBufferReadPointer(int off)
 
 CSer& CSer::operator>> (int& v)
 {
-    unsigned char* tmp=(unsigned char*)(&v);
-    for (int i=0;i<int(sizeof(v));i++)
-        tmp[i]=_fileBuffer[_fileBufferReadPointer++];
+    _readFromFileBuffer(&v,sizeof(v));
     return(*this);
 }
 
 CSer& CSer::operator>> (float& v)
 {
-    unsigned char* tmp=(unsigned char*)(&v);
-    for (int i=0;i<int(sizeof(v));i++)
-        tmp[i]=_fileBuffer[_fileBufferReadPointer++];
+    _readFromFileBuffer(&v,sizeof(v));
     return(*this);
 }
 
 CSer& CSer::operator>> (double& v)
 {
-    unsigned char* tmp=(unsigned char*)(&v);
-    for (int i=0;i<int(sizeof(v));i++)
-        tmp[i]=_fileBuffer[_fileBufferReadPointer++];
+    _readFromFileBuffer(&v,sizeof(v));
     return(*this);
 }
 
 CSer& CSer::operator>> (unsigned short& v)
 {
-    unsigned char* tmp=(unsigned char*)(&v);
-    for (int i=0;i<int(sizeof(v));i++)
-        tmp[i]=_fileBuffer[_fileBufferReadPointer++];
+    _readFromFileBuffer(&v,sizeof(v));
     return(*this);
 }
 
 CSer& CSer::operator>> (unsigned int& v)
 {
-    unsigned char* tmp=(unsigned char*)(&v);
-    for (int i=0;i<int(sizeof(v));i++)
-        tmp[i]=_fileBuffer[_fileBufferReadPointer++];
+    _readFromFileBuffer(&v,sizeof(v));
     return(*this);
 }
 
 CSer& CSer::operator>> (quint64& v)
 {
-    unsigned char* tmp=(unsigned char*)(&v);
-    for (int i=0;i<int(sizeof(v));i++)
-        tmp[i]=_fileBuffer[_fileBufferReadPointer++];
+    _readFromFileBuffer(&v,sizeof(v));
     return(*this);
 }
 
 CSer& CSer::operator>> (long& v)
 {
-    unsigned char* tmp=(unsigned char*)(&v);
-    for (int i=0;i<int(sizeof(v));i++)
-        tmp[i]=_fileBuffer[_fileBufferReadPointer++];
+    _readFromFileBuffer(&v,sizeof(v));
     return(*this);
 }
 
@@ -1004,15 +1127,27 @@ CSer& CSer::operator>> (char& v)
 
 CSer& CSer::operator>> (std::string& v)
 {
-    v="";
     int l;
-    for (int i=0;i<int(sizeof(l));i++)
-        ((char*)&l)[i]=_fileBuffer[_fileBufferReadPointer++];
-    for (int i=0;i<l;i++)
-        v+=_fileBuffer[_fileBufferReadPointer++];
+    _readFromFileBuffer(&l,sizeof(l));
+    v.assign((const char*)&_fileBuffer[0]+_fileBufferReadPointer,l);
+    _fileBufferReadPointer+=l;
     return(*this);
 }
 
+void CSer::_addToBuffer(const void* data,size_t size)
+{
+    size_t s=buffer.size();
+    buffer.resize(s+size);
+    if (size>0)
+        memcpy(&buffer[s],data,size);
+}
+
+void CSer::_readFromFileBuffer(void* data,size_t size)
+{
+    memcpy(data,&_fileBuffer[0]+_fileBufferReadPointer,size);
+    _fileBufferReadPointer+=int(size);
+}
+
 void CSer::flush(bool writeNbOfBytes)
 { // writeNbOfBytes is true by default
     if (countingMode==0)
@@ -1020,11 +1155,9 @@ void CSer::flush(bool writeNbOfBytes)
         if (writeNbOfBytes)
         {
             int s=(int)buffer.size();
-            for (int i=0;i<int(sizeof(s));i++)
-                _fileBuffer.push_back(((char*)&s)[i]);
+            _fileBuffer.insert(_fileBuffer.end(),(unsigned char*)&s,(unsigned char*)&s+sizeof(s));
         }
-        for (int i=0;i<int(buffer.size());i++)
-            _fileBuffer.push_back(buffer[i]);
+        _fileBuffer.insert(_fileBuffer.end(),buffer.begin(),buffer.end());
         buffer.clear();
     }
     else
@@ -1045,8 +1178,9 @@ void CSer::storeDataName(const char* name)
             counter+=3;
         else
         {
-            for (int i=0;i<3;i++)
-                _fileBuffer.push_back(name[i]);
+            if ( _blockMarksEnabled&&(_blockDepth==0) )
+                _blockMarks.push_back(_fileBuffer.size());
+            _fileBuffer.insert(_fileBuffer.end(),name,name+3);
         }
     }
 }
@@ -9,8 +9,21 @@
 #define SER_END_OF_OBJECT "EOO"
 #define SER_NEXT_STEP "NXT"
 #define SER_END_OF_FILE "EOF"
+#define SER_COMPRESSION_CHUNK_SIZE 1048576 // uncompressed bytes per chunk, with compression method 2
+#define SER_CHUNK_CODEC_STORED 0
+#define SER_CHUNK_CODEC_LZ 1
 typedef sim::tinyxml2::XMLElement xmlNode;
 
+struct SSerChunk
+{ // a part of the file buffer, compressed or uncompressed independently of the other parts
+    const unsigned char* in;
+    unsigned int inSize;
+    unsigned char* out;
+    unsigned int outSize;
+    unsigned char codec;
+    bool ok;
+};
+
 class CSer
 {
 public:
@@ -78,6 +91,8 @@ public:
     void setCountingMode(bool force=false);
     bool setWritingMode(bool force=false);
     void disableCountingModeExceptForExceptions();
+    void enableBlockMarks();
+    const std::vector<size_t>* getBlockMarks() const;
     std::vector<unsigned char>* getBufferPointer();
     std::vector<unsigned char>* getFileBuffer();
     int getFileBufferReadPointer() const;
@@ -182,11 +197,19 @@ public:
 
     static int SER_SERIALIZATION_VERSION;
     static int SER_MIN_SERIALIZATION_VERSION_THAT_CAN_READ_THIS;
+    static int SER_MIN_SERIALIZATION_VERSION_THAT_CAN_READ_CHUNKS;
     static int SER_MIN_SERIALIZATION_VERSION_THAT_THIS_CAN_READ;
 
 private:
     void _commonInit();
     void _writeBinaryHeader();
+    void _writeToArchive(const unsigned char* data,size_t size);
+    void _addToBuffer(const void* data,size_t size);
+    void _readFromFileBuffer(void* data,size_t size);
+    void _compressChunked(std::vector<unsigned char>& out) const;
+    bool _uncompressChunked(int originalDataSize);
+    static void _compressChunkTask(void* data);
+    static void _uncompressChunkTask(void* data);
     void _writeXmlHeader();
     void _writeXmlFooter();
     int _readXmlHeader(int& serializationVersion,unsigned short& coppeliaSimVersionThatWroteThis,char& revNumber);
@@ -202,6 +225,7 @@ private:
     int _multiPurposeCounter;
     bool _xmlUseImageAndMeshFileformats;
     bool _compress;
+    char _compressionMethod; // as written to the header
     bool _noHeader;
     char _filetype;
     std::string _filename;
@@ -209,6 +233,9 @@ private:
     int counter;
     int countingMode;
     bool _coutingModeDisabledExceptForExceptions;
+    bool _blockMarksEnabled;
+    int _blockDepth;
+    std::vector<size_t> _blockMarks; // file buffer offsets of top-level data names
     std::vector<unsigned char> buffer;
     std::vector<unsigned char> _fileBuffer;
     int _fileBufferReadPointer;
@@ -424,7 +424,10 @@ bool _CJoint_::setScrewPitch(float pitch)
     if (diff)
     {
         if (getObjectCanChange())
+        {
             _screwPitch=pitch;
+            _invalidateCumulativeTransformations();
+        }
         if (getObjectCanSync())
             _setScrewPitch_send(pitch);
     }
@@ -550,7 +553,10 @@ bool _CJoint_::setPosition(float pos)
     if (diff)
     {
         if (getObjectCanChange())
+        {
             _jointPosition=pos;
+            _invalidateCumulativeTransformations();
+        }
         if (getObjectCanSync())
             _setPosition_send(pos);
     }
@@ -568,7 +574,10 @@ bool _CJoint_::setSphericalTransformation(const C4Vector& tr)
     if (diff)
     {
         if (getObjectCanChange())
+        {
             _sphericalTransformation=tr;
+            _invalidateCumulativeTransformations();
+        }
         if (getObjectCanSync())
             _setSphericalTransformation_send(tr);
     }
@@ -2,11 +2,16 @@
 #include "sceneObject.h"
 #include "app.h"
 
+unsigned int _CSceneObject_::_cumulativeTransformations_generation=0;
+unsigned int _CSceneObject_::_poseChangeCounter=0;
+
 _CSceneObject_::_CSceneObject_()
 {
     _selected=false;
     _parentObject=nullptr;
     _localTransformation.setIdentity();
+    _cumulativeTransformations_cacheValid=false;
+    _cumulativeTransformations_cacheGeneration=0;
 }
 
 _CSceneObject_::~_CSceneObject_()
@@ -24,7 +29,10 @@ bool _CSceneObject_::setParent(CSceneObject* parent,bool keepObjectInPlace)
     if (diff)
     {
         if (getObjectCanChange())
+        {
             _parentObject=parent;
+            invalidateAllCumulativeTransformations();
+        }
         if (getObjectCanSync())
         {
             int h=-1;
@@ -167,17 +175,57 @@ C7Vector _CSceneObject_::getFullParentCumulativeTransformation() const
 
 C7Vector _CSceneObject_::getCumulativeTransformation() const
 {
-    C7Vector retVal;
-    if (_parentObject==nullptr)
-        retVal=getLocalTransformation();
-    else
-        retVal=getFullParentCumulativeTransformation()*getLocalTransformation();
-    return(retVal);
+    _updateCumulativeTransformationsIfNeeded();
+    return(_cumulativeTransformation_cached);
 }
 
 C7Vector _CSceneObject_::getFullCumulativeTransformation() const
 {
-    return(getFullParentCumulativeTransformation()*getFullLocalTransformation());
+    _updateCumulativeTransformationsIfNeeded();
+    return(_fullCumulativeTransformation_cached);
+}
+
+void _CSceneObject_::_updateCumulativeTransformationsIfNeeded() const
+{
+    if ( (!_cumulativeTransformations_cacheValid)||(_cumulativeTransformations_cacheGeneration!=_cumulativeTransformations_generation) )
+    {
+        if (_parentObject==nullptr)
+        {
+            _cumulativeTransformation_cached=getLocalTransformation();
+            _fullCumulativeTransformation_cached=getFullLocalTransformation();
+        }
+        else
+        {
+            C7Vector parentTr(_parentObject->getFullCumulativeTransformation());
+            _cumulativeTransformation_cached=parentTr*getLocalTransformation();
+            _fullCumulativeTransformation_cached=parentTr*getFullLocalTransformation();
+        }
+        _cumulativeTransformations_cacheValid=true;
+        _cumulativeTransformations_cacheGeneration=_cumulativeTransformations_generation;
+    }
+}
+
+void _CSceneObject_::_invalidateCumulativeTransformations()
+{ // A valid cache implies a valid parent cache, so we can stop at already invalid objects
+    _poseChangeCounter++;
+    if (_cumulativeTransformations_cacheValid)
+    {
+        _cumulativeTransformations_cacheValid=false;
+        const std::vector<CSceneObject*>* children=((CSceneObject*)this)->getChildren();
+        for (size_t i=0;i<children->size();i++)
+            ((_CSceneObject_*)children->at(i))->_invalidateCumulativeTransformations();
+    }
+}
+
+void _CSceneObject_::invalidateAllCumulativeTransformations()
+{
+    _cumulativeTransformations_generation++;
+    _poseChangeCounter++;
+}
+
+unsigned int _CSceneObject_::getPoseChangeCounter()
+{ // lets caches that depend on absolute poses of many objects detect changes
+    return(_poseChangeCounter);
 }
 
 bool _CSceneObject_::setObjectAltName(const char* newAltName,bool check)
@@ -209,7 +257,10 @@ bool _CSceneObject_::setLocalTransformation(const C7Vector& tr)
     if (diff)
     {
         if (getObjectCanChange())
+        {
             _localTransformation=tr;
+            _invalidateCumulativeTransformations();
+        }
         if (getObjectCanSync())
             _setLocalTransformation_send(tr);
     }
@@ -222,7 +273,10 @@ bool _CSceneObject_::setLocalTransformation(const C4Vector& q)
     if (diff)
     {
         if (getObjectCanChange())
+        {
             _localTransformation.Q=q;
+            _invalidateCumulativeTransformations();
+        }
         if (getObjectCanSync())
         {
             C7Vector tr(_localTransformation);
@@ -239,7 +293,10 @@ bool _CSceneObject_::setLocalTransformation(const C3Vector& x)
     if (diff)
     {
         if (getObjectCanChange())
+        {
             _localTransformation.X=x;
+            _invalidateCumulativeTransformations();
+        }
         if (getObjectCanSync())
         {
             C7Vector tr(_localTransformation);
@@ -43,6 +43,8 @@ public:
     C7Vector getCumulativeTransformation() const;
     C7Vector getFullCumulativeTransformation() const;
 
+    static void invalidateAllCumulativeTransformations();
+    static unsigned int getPoseChangeCounter();
 
     void setSelected(bool s); // doesn't generate a sync msg
 
@@ -66,6 +68,8 @@ protected:
     virtual void _setObjectAltName_send(const char* newAltName) const;
     virtual void _setLocalTransformation_send(const C7Vector& tr) const;
 
+    void _invalidateCumulativeTransformations();
+    void _updateCumulativeTransformationsIfNeeded() const;
 
     int _objectHandle;
     std::string _extensionString;
@@ -93,4 +97,13 @@ protected:
     int _localModelProperty;
     std::string _modelAcknowledgement;
 
+    // Cached absolute poses. Invalidated down the subtree when the local or parent transf. changes.
+    // Structural changes (parent or child list changes) invalidate all caches via the global generation:
+    mutable C7Vector _cumulativeTransformation_cached;
+    mutable C7Vector _fullCumulativeTransformation_cached;
+    mutable bool _cumulativeTransformations_cacheValid;
+    mutable unsigned int _cumulativeTransformations_cacheGeneration;
+    static unsigned int _cumulativeTransformations_generation;
+    static unsigned int _poseChangeCounter; // incremented with any pose or structural change, in any object
+
 };
@@ -3,6 +3,7 @@
 #include "app.h"
 #include <boost/format.hpp>
 #include "base64.h"
+#include <cstring>
 
 unsigned int CTextureObject::_textureContentUniqueId=0;
 
@@ -17,6 +18,7 @@ CTextureObject::CTextureObject()
     _providedImageWasRGBA=false;
     _changedFlag=true;
     _currentTextureContentUniqueId=_textureContentUniqueId++;
+    _contentHashUniqueId=_currentTextureContentUniqueId-1;
 }
 
 CTextureObject::CTextureObject(int sizeX,int sizeY)
@@ -30,6 +32,7 @@ CTextureObject::CTextureObject(int sizeX,int sizeY)
     _providedImageWasRGBA=false;
     _changedFlag=true;
     _currentTextureContentUniqueId=_textureContentUniqueId++;
+    _contentHashUniqueId=_currentTextureContentUniqueId-1;
 }
 
 CTextureObject::~CTextureObject()
@@ -170,12 +173,9 @@ bool CTextureObject::isSame(const CTextureObject* obj) const
     {
         if (obj->_providedImageWasRGBA!=_providedImageWasRGBA)
             return(false);
-        for (int i=0;i<4*_textureSize[0]*_textureSize[1];i++)
-        {
-            if (obj->_textureBuffer[i]!=_textureBuffer[i])
-                return(false);
-        }
-        return(true);
+        if (obj->getContentHash()!=getContentHash())
+            return(false);
+        return(memcmp(&obj->_textureBuffer[0],&_textureBuffer[0],4*_textureSize[0]*_textureSize[1])==0);
     }
     return(false);
 }
@@ -270,6 +270,29 @@ unsigned int CTextureObject::getCurrentTextureContentUniqueId() const
     return(_currentTextureContentUniqueId);
 }
 
+unsigned long long int CTextureObject::getContentHash() const
+{ // FNV-1a of size, rgba flag and buffer. Computed once per content change
+    if (_contentHashUniqueId!=_currentTextureContentUniqueId)
+    {
+        unsigned long long int h=14695981039346656037ULL;
+        int header[3]={_textureSize[0],_textureSize[1],int(_providedImageWasRGBA)};
+        const unsigned char* d=(const unsigned char*)header;
+        for (size_t i=0;i<sizeof(header);i++)
+        {
+            h^=d[i];
+            h*=1099511628211ULL;
+        }
+        for (size_t i=0;i<_textureBuffer.size();i++)
+        {
+            h^=_textureBuffer[i];
+            h*=1099511628211ULL;
+        }
+        _contentHash=h;
+        _contentHashUniqueId=_currentTextureContentUniqueId;
+    }
+    return(_contentHash);
+}
+
 void CTextureObject::setOglTextureName(unsigned int n)
 {
     _oglTextureName=n;
@@ -567,6 +590,8 @@ void CTextureObject::serialize(CSer& ar)
             _textureBuffer.resize(4*_textureSize[0]*_textureSize[1],0);
             for (size_t i=0;i<_textureSize[0]*_textureSize[1]*4;i++)
                 _textureBuffer[i]=str[i];
+            _changedFlag=true;
+            _currentTextureContentUniqueId=_textureContentUniqueId++;
         }
     }
 }
@@ -34,6 +34,7 @@ public:
     bool writePortionOfTexture(const unsigned char* rgbData,int posX,int posY,int sizeX,int sizeY,bool circular,float interpol);
 
     unsigned int getCurrentTextureContentUniqueId() const;
+    unsigned long long int getContentHash() const;
 
     void setOglTextureName(unsigned int n);
     unsigned int getOglTextureName() const;
@@ -49,6 +50,8 @@ protected:
     bool _providedImageWasRGBA;     // just needed to reduce serialization size!
     bool _changedFlag;
     unsigned int _currentTextureContentUniqueId;
+    mutable unsigned long long int _contentHash;
+    mutable unsigned int _contentHashUniqueId; // _currentTextureContentUniqueId when _contentHash was computed
 
     std::vector<int> _dependentObjects;
     std::vector<int> _dependentSubObjects;
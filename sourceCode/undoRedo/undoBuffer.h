@@ -1,25 +1,20 @@
-
 #pragma once
 
 #include "undoBufferCameras.h"
 
 class CUndoBuffer
-{
+{ // An undo point: the ordered list of blocks (see CUndoBufferBlocks) that make up the scene buffer
 public:
-    CUndoBuffer(const std::vector<char>& fullBuffer,int bufferId,CUndoBufferCameras* camBuff);
+    CUndoBuffer(const std::vector<int>& blockIds,int bufferId,CUndoBufferCameras* camBuff);
     virtual ~CUndoBuffer();
-    bool finalize(const std::vector<char>& previousFullBuffer);
-    void updateWithFullBuffer(const std::vector<char>& fullBuffer);
-    void getRestored(const std::vector<char>* previousFullBuffer,std::vector<char>& restoredBuffer);
+    bool isSameAs(const CUndoBuffer* otherBuffer) const;
+    const std::vector<int>* getBlockIds() const;
     CUndoBufferCameras* getCameraBuffers();
     int getBufferId();
 
-    std::vector<char> buffer;
-
 private:
     CUndoBufferCameras* _cameraBuffers;
 
-    int _sameCountFromBeginning;
-    int _sameCountFromEnd;
+    std::vector<int> _blockIds;
     int _bufferId;
 };
@@ -0,0 +1,88 @@
+#include "undoBufferBlocks.h"
+#include <cstring>
+
+CUndoBufferBlocks::CUndoBufferBlocks()
+{
+    _memorySize=0;
+    _nextId=0;
+}
+
+CUndoBufferBlocks::~CUndoBufferBlocks()
+{
+}
+
+unsigned long long int CUndoBufferBlocks::_getHash(const char* data,size_t size)
+{ // FNV-1a
+    unsigned long long int h=14695981039346656037ULL;
+    for (size_t i=0;i<size;i++)
+    {
+        h^=(unsigned char)data[i];
+        h*=1099511628211ULL;
+    }
+    return(h);
+}
+
+int CUndoBufferBlocks::addBlock(const char* data,size_t size)
+{ // returns the id of an identical block if there is one, otherwise a new block is created
+    unsigned long long int h=_getHash(data,size);
+    auto range=_blocksFromHash.equal_range(h);
+    for (auto it=range.first;it!=range.second;it++)
+    {
+        SUndoBufferBlock& block=_blocks[it->second];
+        if ( (block._buffer.size()==size)&&((size==0)||(memcmp(&block._buffer[0],data,size)==0)) )
+        {
+            block._refCount++;
+            return(it->second);
+        }
+    }
+    int id=_nextId++;
+    SUndoBufferBlock& block=_blocks[id];
+    block._hash=h;
+    block._buffer.assign(data,data+size);
+    block._refCount=1;
+    _blocksFromHash.insert(std::make_pair(h,id));
+    _memorySize+=size;
+    return(id);
+}
+
+void CUndoBufferBlocks::releaseBlock(int id)
+{
+    auto it=_blocks.find(id);
+    if (it!=_blocks.end())
+    {
+        it->second._refCount--;
+        if (it->second._refCount<=0)
+        {
+            auto range=_blocksFromHash.equal_range(it->second._hash);
+            for (auto it2=range.first;it2!=range.second;it2++)
+            {
+                if (it2->second==id)
+                {
+                    _blocksFromHash.erase(it2);
+                    break;
+                }
+            }
+            _memorySize-=it->second._buffer.size();
+            _blocks.erase(it);
+        }
+    }
+}
+
+void CUndoBufferBlocks::appendBlock(int id,std::vector<char>& buff) const
+{
+    auto it=_blocks.find(id);
+    if (it!=_blocks.end())
+        buff.insert(buff.end(),it->second._buffer.begin(),it->second._buffer.end());
+}
+
+void CUndoBufferBlocks::clearAll()
+{
+    _blocks.clear();
+    _blocksFromHash.clear();
+    _memorySize=0;
+}
+
+int CUndoBufferBlocks::getMemorySizeInBytes() const
+{
+    return(int(_memorySize));
+}
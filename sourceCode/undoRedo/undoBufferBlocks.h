@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+
+struct SUndoBufferBlock
+{
+    unsigned long long int _hash;
+    std::vector<char> _buffer;
+    int _refCount;
+};
+
+class CUndoBufferBlocks
+{ // Content-addressed storage of the blocks an undo point is made of (e.g. one block per scene object).
+  // Identical blocks are stored only once and shared across undo points
+public:
+    CUndoBufferBlocks();
+    virtual ~CUndoBufferBlocks();
+
+    int addBlock(const char* data,size_t size);
+    void releaseBlock(int id);
+    void appendBlock(int id,std::vector<char>& buff) const;
+
+    void clearAll();
+    int getMemorySizeInBytes() const;
+
+private:
+    static unsigned long long int _getHash(const char* data,size_t size);
+
+    std::unordered_map<int,SUndoBufferBlock> _blocks;
+    std::unordered_multimap<unsigned long long int,int> _blocksFromHash;
+    size_t _memorySize;
+    int _nextId;
+};
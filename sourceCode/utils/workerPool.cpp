@@ -0,0 +1,174 @@
+#include "workerPool.h"
+
+VMutex CWorkerPool::_mutex;
+std::deque<SWorkerPoolTask> CWorkerPool::_urgentTasks;
+std::deque<SWorkerPoolTask> CWorkerPool::_backgroundTasks;
+int CWorkerPool::_workerCount=0;
+std::atomic<int> CWorkerPool::_runningWorkers(0);
+volatile bool CWorkerPool::_quit=false;
+
+void CWorkerPool::addBackgroundTask(WORKER_POOL_TASK task,void* data,WORKER_POOL_TASK cancelTask/*=nullptr*/)
+{
+    _launchWorkersIfNeeded();
+    SWorkerPoolTask t;
+    t.task=task;
+    t.cancelTask=cancelTask;
+    t.data=data;
+    t.pendingCount=nullptr;
+    _mutex.lock_simple("CWorkerPool::addBackgroundTask");
+    if (_quit)
+    {
+        _mutex.unlock_simple();
+        _cancelTask(t); // we are shutting down
+        return;
+    }
+    _backgroundTasks.push_back(t);
+    _mutex.wakeAll_simple();
+    _mutex.unlock_simple();
+}
+
+void CWorkerPool::runTasks(WORKER_POOL_TASK task,void* const* data,int count)
+{
+    if (count<=0)
+        return;
+    _launchWorkersIfNeeded();
+    if ( (count==1)||(_workerCount==0)||_quit )
+    { // not worth it, or not possible
+        for (int i=0;i<count;i++)
+            task(data[i]);
+        return;
+    }
+    std::atomic<int> pendingCount(count);
+    _mutex.lock_simple("CWorkerPool::runTasks");
+    for (int i=1;i<count;i++)
+    {
+        SWorkerPoolTask t;
+        t.task=task;
+        t.cancelTask=nullptr;
+        t.data=data[i];
+        t.pendingCount=&pendingCount;
+        _urgentTasks.push_back(t);
+    }
+    _mutex.wakeAll_simple();
+    _mutex.unlock_simple();
+
+    // The calling thread handles the first task, then helps with the other urgent tasks:
+    task(data[0]);
+    pendingCount--;
+    SWorkerPoolTask t;
+    while (pendingCount.load()>0)
+    {
+        if (_popTask(t,true))
+            _runTask(t);
+        else
+            VThread::switchThread();
+    }
+}
+
+int CWorkerPool::getWorkerCount()
+{
+    _launchWorkersIfNeeded();
+    return(_workerCount);
+}
+
+void CWorkerPool::cleanUp()
+{
+    std::deque<SWorkerPoolTask> droppedTasks;
+    _mutex.lock_simple("CWorkerPool::cleanUp");
+    _quit=true;
+    droppedTasks.swap(_backgroundTasks);
+    _mutex.wakeAll_simple();
+    _mutex.unlock_simple();
+    while (_runningWorkers.load()>0)
+        VThread::sleep(1);
+    // Dropped tasks might own resources (e.g. a reference to their data):
+    for (size_t i=0;i<droppedTasks.size();i++)
+        _cancelTask(droppedTasks[i]);
+}
+
+void CWorkerPool::_launchWorkersIfNeeded()
+{
+    static bool launched=false;
+    _mutex.lock_simple("CWorkerPool::_launchWorkersIfNeeded");
+    if ( (!launched)&&(!_quit) )
+    {
+        launched=true;
+        _workerCount=VThread::getCoreCount()-1; // the calling thread also works in runTasks
+        if (_workerCount<1)
+            _workerCount=1;
+        for (int i=0;i<_workerCount;i++)
+        {
+            _runningWorkers++;
+            VThread::launchThread(_workerThread,false);
+        }
+    }
+    _mutex.unlock_simple();
+}
+
+bool CWorkerPool::_popTask(SWorkerPoolTask& task,bool onlyUrgent)
+{
+    bool retVal=false;
+    _mutex.lock_simple("CWorkerPool::_popTask");
+    if (_urgentTasks.size()>0)
+    {
+        task=_urgentTasks.front();
+        _urgentTasks.pop_front();
+        retVal=true;
+    }
+    else if ( (!onlyUrgent)&&(_backgroundTasks.size()>0) )
+    {
+        task=_backgroundTasks.front();
+        _backgroundTasks.pop_front();
+        retVal=true;
+    }
+    _mutex.unlock_simple();
+    return(retVal);
+}
+
+void CWorkerPool::_runTask(const SWorkerPoolTask& task)
+{
+    task.task(task.data);
+    if (task.pendingCount!=nullptr)
+        task.pendingCount[0]--;
+}
+
+void CWorkerPool::_cancelTask(const SWorkerPoolTask& task)
+{
+    if (task.cancelTask!=nullptr)
+        task.cancelTask(task.data);
+    else
+        task.task(task.data);
+}
+
+VTHREAD_RETURN_TYPE CWorkerPool::_workerThread(VTHREAD_ARGUMENT_TYPE lpData)
+{
+    while (true)
+    {
+        SWorkerPoolTask task;
+        bool haveTask=false;
+        _mutex.lock_simple("CWorkerPool::_workerThread");
+        while ( (!_quit)&&(_urgentTasks.size()==0)&&(_backgroundTasks.size()==0) )
+            _mutex.wait_simple();
+        if (_urgentTasks.size()>0)
+        {
+            task=_urgentTasks.front();
+            _urgentTasks.pop_front();
+            haveTask=true;
+        }
+        else if ( (!_quit)&&(_backgroundTasks.size()>0) )
+        {
+            task=_backgroundTasks.front();
+            _backgroundTasks.pop_front();
+            haveTask=true;
+        }
+        bool leave=_quit&&(!haveTask);
+        _mutex.unlock_simple();
+        if (leave)
+            break;
+        if (haveTask)
+            _runTask(task);
+    }
+    _runningWorkers--;
+    VThread::endThread();
+    return(VTHREAD_RETURN_VAL);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "vMutex.h"
+#include "vThread.h"
+#include <deque>
+#include <atomic>
+
+typedef void (*WORKER_POOL_TASK)(void* data);
+
+struct SWorkerPoolTask
+{
+    WORKER_POOL_TASK task;
+    WORKER_POOL_TASK cancelTask; // called instead of task if the task is dropped. nullptr to run the task anyway
+    void* data;
+    std::atomic<int>* pendingCount; // nullptr for background tasks
+};
+
+// FULLY STATIC CLASS
+class CWorkerPool
+{ // Workers are launched the first time a task is added. Tasks must not touch scene data
+public:
+    static void addBackgroundTask(WORKER_POOL_TASK task,void* data,WORKER_POOL_TASK cancelTask=nullptr);
+    static void runTasks(WORKER_POOL_TASK task,void* const* data,int count); // returns when all tasks ran. The calling thread helps
+    static int getWorkerCount();
+    static void cleanUp(); // waits until the workers ended. Background tasks not yet started are cancelled (or run if they have no cancel task)
+
+private:
+    static void _launchWorkersIfNeeded();
+    static bool _popTask(SWorkerPoolTask& task,bool onlyUrgent);
+    static void _runTask(const SWorkerPoolTask& task);
+    static void _cancelTask(const SWorkerPoolTask& task);
+    static VTHREAD_RETURN_TYPE _workerThread(VTHREAD_ARGUMENT_TYPE lpData);
+
+    static VMutex _mutex; // protects the task queues. Also used as wait condition
+    static std::deque<SWorkerPoolTask> _urgentTasks; // from runTasks
+    static std::deque<SWorkerPoolTask> _backgroundTasks;
+    static int _workerCount;
+    static std::atomic<int> _runningWorkers;
+    static volatile bool _quit;
+};
@@ -14,6 +14,9 @@
 #include "rendering.h"
 #include "simFlavor.h"
 #include "threadPool.h"
+#include "stepProfiler.h"
+#include "workerPool.h"
+#include "benchmarks.h"
 #include <sstream>
 #include <iomanip>
 #include <boost/algorithm/string/replace.hpp>
@@ -122,6 +125,8 @@ void App::simulationThreadInit()
         App::worldContainer->sandboxScript->executeScriptString(_startupScriptString.c_str(),nullptr);
         _startupScriptString.clear();
     }
+    if (App::userSettings->runBenchmarks!=0)
+        CBenchmarks::run(App::userSettings->runBenchmarks);
 }
 
 // Following simulation thread split into 'simulationThreadInit', 'simulationThreadDestroy' and 'simulationThreadLoop' is courtesy of Stephen James:
@@ -170,6 +175,7 @@ void App::simulationThreadDestroy()
 // Following simulation thread split into 'simulationThreadInit', 'simulationThreadDestroy' and 'simulationThreadLoop' is courtesy of Stephen James:
 void App::simulationThreadLoop()
 {
+    CStepProfilerScope profilerScope("loop","simulation thread loop");
     // Send the "instancePass" message to all plugins:
     int auxData[4]={App::worldContainer->getModificationFlags(true),0,0,0};
     void* replyBuffer=CPluginContainer::sendEventCallbackMessageToAllPlugins(sim_message_eventcallback_instancepass,auxData,nullptr,nullptr);
@@ -219,6 +225,7 @@ void App::simulationThreadLoop()
     #ifdef SIM_WITH_GUI
             App::currentWorld->simulation->showAndHandleEmergencyStopButton(false,""); // 10/10/2015
     #endif
+    CStepProfilerScope messagesProfilerScope("loop","messages");
     App::simThread->executeMessages(); // rendering, queued command execution, etc.
 }
 
@@ -639,6 +646,9 @@ void App::run(void(*initCallBack)(),void(*loopCallBack)(),void(*deinitCallBack)(
     while (_quitLevel==2)
         VThread::sleep(1);
 
+    // Worker tasks might still use the geom plugin:
+    CWorkerPool::cleanUp();
+
     // Ok, we unload the plugins. This happens with the UI thread!
     _runDeinitializationCallback(deinitCallBack);
 
@@ -0,0 +1,159 @@
+#include "benchmarks.h"
+#include "simInternal.h"
+#include "app.h"
+#include "apiErrors.h"
+#include "luaScriptObject.h"
+#include <cstdio>
+
+void CBenchmarks::run(int which)
+{
+    if (which&BENCHMARK_OBJECT_POSES)
+        _runObjectPoses();
+    if (which&BENCHMARK_API_CALLS)
+        _runApiCalls();
+}
+
+void CBenchmarks::_runObjectPoses()
+{ // Builds chains of dummies, then compares the cached absolute poses with the uncached parent-chain walk
+    App::logMsg(sim_verbosity_msgs,"benchmark: object poses (%i objects)...",BENCHMARK_OBJECT_POSES_OBJECT_COUNT);
+    std::vector<int> handles;
+    std::vector<int> roots;
+    for (int i=0;i<BENCHMARK_OBJECT_POSES_OBJECT_COUNT;i++)
+    {
+        int h=simCreateDummy_internal(0.01f,nullptr);
+        if (h==-1)
+            break;
+        if ((i%BENCHMARK_OBJECT_POSES_CHAIN_LENGTH)==0)
+            roots.push_back(h);
+        else
+            simSetObjectParent_internal(h,handles[handles.size()-1],false);
+        float pos[3]={0.001f,0.0f,0.0f};
+        simSetObjectPosition_internal(h,sim_handle_parent,pos);
+        handles.push_back(h);
+    }
+    std::vector<CSceneObject*> objects;
+    for (size_t i=0;i<handles.size();i++)
+        objects.push_back(App::currentWorld->sceneObjects->getObjectFromHandle(handles[i]));
+    std::vector<CSceneObject*> rootObjects;
+    for (size_t i=0;i<roots.size();i++)
+        rootObjects.push_back(App::currentWorld->sceneObjects->getObjectFromHandle(roots[i]));
+
+    if (objects.size()>0)
+    {
+        float sum=0.0f; // keeps the reads from being optimized away
+        const int passes=10;
+
+        std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+        for (int p=0;p<passes;p++)
+        {
+            for (size_t i=0;i<objects.size();i++)
+                sum+=_getCumulativeTransformationUncached(objects[i]).X(0);
+        }
+        _logResult("uncached parent-chain walk",_getElapsedNs(start),passes*int(objects.size()));
+
+        for (size_t i=0;i<objects.size();i++)
+            sum+=objects[i]->getCumulativeTransformation().X(0);
+        start=std::chrono::steady_clock::now();
+        for (int p=0;p<passes;p++)
+        {
+            for (size_t i=0;i<objects.size();i++)
+                sum+=objects[i]->getCumulativeTransformation().X(0);
+        }
+        _logResult("cached read",_getElapsedNs(start),passes*int(objects.size()));
+
+        start=std::chrono::steady_clock::now();
+        for (int p=0;p<passes;p++)
+        {
+            for (size_t i=0;i<rootObjects.size();i++)
+            {
+                C7Vector tr(rootObjects[i]->getLocalTransformation());
+                tr.X(2)=0.001f*float(p);
+                rootObjects[i]->setLocalTransformation(tr);
+            }
+            for (size_t i=0;i<objects.size();i++)
+                sum+=objects[i]->getCumulativeTransformation().X(0);
+        }
+        _logResult("read after moving all chain roots",_getElapsedNs(start),passes*int(objects.size()));
+
+        start=std::chrono::steady_clock::now();
+        for (int p=0;p<passes;p++)
+        {
+            C7Vector tr(rootObjects[0]->getLocalTransformation());
+            tr.X(2)=0.001f*float(p);
+            rootObjects[0]->setLocalTransformation(tr);
+            for (size_t i=0;i<objects.size();i++)
+                sum+=objects[i]->getCumulativeTransformation().X(0);
+        }
+        _logResult("read after moving one chain root",_getElapsedNs(start),passes*int(objects.size()));
+
+        if (sum==12345.0f)
+            App::logMsg(sim_verbosity_debug,"benchmark: checksum hit.");
+    }
+
+    for (int i=int(handles.size())-1;i>=0;i--)
+        simRemoveObject_internal(handles[i]); // children first. Removing a parent does not remove its children
+    App::logMsg(sim_verbosity_msgs,"benchmark: object poses done.");
+}
+
+void CBenchmarks::_runApiCalls()
+{ // Times the per-call overhead of the API, from C and from Lua (via the sandbox script)
+    App::logMsg(sim_verbosity_msgs,"benchmark: API calls (%i calls)...",BENCHMARK_API_CALLS_CALL_COUNT);
+    int h=simCreateDummy_internal(0.01f,nullptr);
+    if (h!=-1)
+    {
+        float sum=0.0f; // keeps the calls from being optimized away
+        float pos[3];
+
+        std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+        for (int i=0;i<BENCHMARK_API_CALLS_CALL_COUNT;i++)
+        { // what each Lua API function does before and after its work
+            CApiErrors::clearThreadBasedFirstCapiErrorAndWarning();
+            sum+=float(CApiErrors::getAndClearThreadBasedFirstCapiError().size());
+        }
+        _logResult("error/warning slot handling",_getElapsedNs(start),BENCHMARK_API_CALLS_CALL_COUNT);
+
+        start=std::chrono::steady_clock::now();
+        for (int i=0;i<BENCHMARK_API_CALLS_CALL_COUNT;i++)
+        {
+            CApiErrors::clearThreadBasedFirstCapiErrorAndWarning();
+            simGetObjectPosition_internal(h,-1,pos);
+            sum+=pos[0]+float(CApiErrors::getAndClearThreadBasedFirstCapiError().size());
+        }
+        _logResult("simGetObjectPosition from C",_getElapsedNs(start),BENCHMARK_API_CALLS_CALL_COUNT);
+
+        if (sum==12345.0f)
+            App::logMsg(sim_verbosity_debug,"benchmark: checksum hit.");
+
+        if (App::worldContainer->sandboxScript!=nullptr)
+        {
+            std::string str("local n="+std::to_string(BENCHMARK_API_CALLS_CALL_COUNT)+" local h="+std::to_string(h)+" ");
+            str+="local f=function(a,b) return a end ";
+            str+="local t=sim.getSystemTime() for i=1,n do f(h,-1) end t=sim.getSystemTime()-t ";
+            str+="sim.addLog(sim.verbosity_msgs,string.format('benchmark: empty Lua function call: %.1f ns per item',t*1e9/n)) ";
+            str+="t=sim.getSystemTime() for i=1,n do sim.getObjectPosition(h,-1) end t=sim.getSystemTime()-t ";
+            str+="sim.addLog(sim.verbosity_msgs,string.format('benchmark: sim.getObjectPosition from Lua: %.1f ns per item',t*1e9/n))";
+            App::worldContainer->sandboxScript->executeScriptString(str.c_str(),nullptr);
+        }
+        simRemoveObject_internal(h);
+    }
+    App::logMsg(sim_verbosity_msgs,"benchmark: API calls done.");
+}
+
+C7Vector CBenchmarks::_getCumulativeTransformationUncached(const CSceneObject* it)
+{ // how absolute poses were computed before they were cached
+    if (it->getParent()==nullptr)
+        return(it->getLocalTransformation());
+    return(_getCumulativeTransformationUncached(it->getParent())*it->getLocalTransformation());
+}
+
+double CBenchmarks::_getElapsedNs(const std::chrono::steady_clock::time_point& start)
+{
+    return(double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-start).count()));
+}
+
+void CBenchmarks::_logResult(const char* name,double ns,int count)
+{
+    char txt[256];
+    snprintf(txt,sizeof(txt),"benchmark: %s: %.1f ms total, %.1f ns per item (%i items)",name,ns*0.000001,ns/double(count),count);
+    App::logMsg(sim_verbosity_msgs,txt);
+}
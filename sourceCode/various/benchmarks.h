@@ -0,0 +1,24 @@
+#pragma once
+
+#include "sceneObject.h"
+#include <chrono>
+
+#define BENCHMARK_OBJECT_POSES 1
+#define BENCHMARK_API_CALLS 2
+#define BENCHMARK_OBJECT_POSES_OBJECT_COUNT 10000
+#define BENCHMARK_OBJECT_POSES_CHAIN_LENGTH 30
+#define BENCHMARK_API_CALLS_CALL_COUNT 100000
+
+// FULLY STATIC CLASS
+class CBenchmarks
+{ // Optional timings run at startup (see the 'runBenchmarks' user setting). Results are logged
+public:
+    static void run(int which);
+
+private:
+    static void _runObjectPoses();
+    static void _runApiCalls();
+    static C7Vector _getCumulativeTransformationUncached(const CSceneObject* it);
+    static double _getElapsedNs(const std::chrono::steady_clock::time_point& start);
+    static void _logResult(const char* name,double ns,int count);
+};
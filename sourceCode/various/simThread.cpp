@@ -19,6 +19,7 @@
 #include "graphingRoutines_old.h"
 #include "simStringTable_openGl.h"
 #include "simFlavor.h"
+#include <algorithm>
 #ifdef SIM_WITH_GUI
     #include "toolBarCommand.h"
     #include "vMessageBox.h"
@@ -27,6 +28,14 @@
 CSimThread::CSimThread()
 {
     _renderingAllowed=true;
+    _nextDelayedCommandSequence=0;
+    _drainingSimulationThreadCommands=false;
+    _queuedCommandCount=0;
+    _delayedCommandCount=0;
+    _maxQueuedCommandCount=0;
+    _executedCommandCount=0;
+    _lastCommandLatency=0;
+    _maxCommandLatency=0;
 }
 
 CSimThread::~CSimThread()
@@ -88,45 +97,94 @@ void CSimThread::appendSimulationThreadCommand(SSimulationThreadCommand cmd,int
     cmd.postTime=VDateTime::getTimeInMs();
     cmd.execDelay=executionDelay;
     EASYLOCK(_simulationThreadCommandsMutex);
-    _simulationThreadCommands_tmp.push_back(cmd);
+    _simulationThreadCommands_tmp.push_back(std::move(cmd));
+    int cnt=int(_simulationThreadCommands_tmp.size());
+    _queuedCommandCount=cnt;
+    if (cnt>_maxQueuedCommandCount.load())
+        _maxQueuedCommandCount=cnt; // only written under the lock
+}
+
+void CSimThread::getSimulationThreadCommandStats(int& queuedCount,int& delayedCount,int& maxQueuedCount,unsigned int& executedCount,int& lastLatencyInMs,int& maxLatencyInMs) const
+{
+    queuedCount=_queuedCommandCount.load();
+    delayedCount=_delayedCommandCount.load();
+    maxQueuedCount=_maxQueuedCommandCount.load();
+    executedCount=_executedCommandCount.load();
+    lastLatencyInMs=_lastCommandLatency.load();
+    maxLatencyInMs=_maxCommandLatency.load();
+}
+
+bool CSimThread::_isDelayedCommandDueLater(const SDelayedSimulationThreadCommand& a,const SDelayedSimulationThreadCommand& b)
+{ // used with std::push_heap/pop_heap, so that the command due first is on top
+    if (a.dueTime!=b.dueTime)
+        return(a.dueTime>b.dueTime);
+    return(a.sequence>b.sequence);
 }
 
 void CSimThread::_handleSimulationThreadCommands()
 { // CALLED ONLY FROM THE MAIN SIMULATION THREAD
     IF_C_API_SIM_OR_UI_THREAD_CAN_WRITE_DATA
     {
-        { // Keep the parenthesis!
+        std::vector<SSimulationThreadCommand> reentrantCommands;
+        std::vector<SSimulationThreadCommand>& commands=(_drainingSimulationThreadCommands?reentrantCommands:_simulationThreadCommands); // a command might handle the commands again
+        bool wasDraining=_drainingSimulationThreadCommands;
+        _drainingSimulationThreadCommands=true;
+        { // Keep the parenthesis! We only hold the lock while swapping the buffers
             EASYLOCK(_simulationThreadCommandsMutex);
-            for (unsigned int i=0;i<_simulationThreadCommands_tmp.size();i++)
-                _simulationThreadCommands.push_back(_simulationThreadCommands_tmp[i]);
-            _simulationThreadCommands_tmp.clear();
+            commands.swap(_simulationThreadCommands_tmp);
+            _queuedCommandCount=0;
         }
 
-        std::vector<SSimulationThreadCommand> delayedCommands;
-        while (_simulationThreadCommands.size()>0)
+        // First the delayed commands that are due, in due time order:
+        while (_delayedSimulationThreadCommands.size()>0)
         {
-            SSimulationThreadCommand cmd=_simulationThreadCommands[0];
-            if (cmd.execDelay!=0)
-            {
-                if (VDateTime::getTimeDiffInMs(cmd.postTime)>cmd.execDelay)
-                    cmd.execDelay=0; // delay triggered!
-            }
-            if (cmd.execDelay!=0)
+            SSimulationThreadCommand& top=_delayedSimulationThreadCommands[0].cmd;
+            if (VDateTime::getTimeDiffInMs(top.postTime)<=top.execDelay)
+                break; // the next one is not yet due
+            std::pop_heap(_delayedSimulationThreadCommands.begin(),_delayedSimulationThreadCommands.end(),_isDelayedCommandDueLater);
+            SSimulationThreadCommand cmd(std::move(_delayedSimulationThreadCommands[_delayedSimulationThreadCommands.size()-1].cmd));
+            _delayedSimulationThreadCommands.pop_back();
+            _delayedCommandCount=int(_delayedSimulationThreadCommands.size());
+            int readyTime=cmd.postTime+cmd.execDelay;
+            cmd.execDelay=0; // delay triggered!
+            _executeAndMeasureSimulationThreadCommand(cmd,readyTime);
+        }
+
+        // Then the newly posted commands, in posting order:
+        for (size_t i=0;i<commands.size();i++)
+        {
+            SSimulationThreadCommand& cmd=commands[i];
+            if ( (cmd.execDelay!=0)&&(VDateTime::getTimeDiffInMs(cmd.postTime)<=cmd.execDelay) )
             {
-                delayedCommands.push_back(cmd);
-                _simulationThreadCommands.erase(_simulationThreadCommands.begin());
+                SDelayedSimulationThreadCommand delayed;
+                delayed.dueTime=cmd.postTime+cmd.execDelay;
+                delayed.sequence=_nextDelayedCommandSequence++;
+                delayed.cmd=std::move(cmd);
+                _delayedSimulationThreadCommands.push_back(std::move(delayed));
+                std::push_heap(_delayedSimulationThreadCommands.begin(),_delayedSimulationThreadCommands.end(),_isDelayedCommandDueLater);
+                _delayedCommandCount=int(_delayedSimulationThreadCommands.size());
             }
             else
             {
-                _executeSimulationThreadCommand(cmd);
-                _simulationThreadCommands.erase(_simulationThreadCommands.begin());
+                cmd.execDelay=0;
+                _executeAndMeasureSimulationThreadCommand(cmd,cmd.postTime);
             }
         }
-        // Now append the delayed commands:
-        _simulationThreadCommands.insert(_simulationThreadCommands.end(),delayedCommands.begin(),delayedCommands.end());
+        commands.clear(); // keeps the capacity. Swapped back with the next pass
+        _drainingSimulationThreadCommands=wasDraining;
     }
 }
 
+void CSimThread::_executeAndMeasureSimulationThreadCommand(SSimulationThreadCommand& cmd,int readyTime)
+{
+    int latency=VDateTime::getTimeDiffInMs(readyTime);
+    _executeSimulationThreadCommand(std::move(cmd));
+    _executedCommandCount++;
+    _lastCommandLatency=latency;
+    if (latency>_maxCommandLatency.load())
+        _maxCommandLatency=latency; // only written by the sim thread
+}
+
 void CSimThread::_executeSimulationThreadCommand(SSimulationThreadCommand cmd)
 {
     TRACE_INTERNAL;
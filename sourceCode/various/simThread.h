@@ -5,6 +5,7 @@
 #include "7Vector.h"
 #include "vMutex.h"
 #include "vThread.h"
+#include <atomic>
 
 struct SSimulationThreadCommand
 {
@@ -26,6 +27,13 @@ struct SSimulationThreadCommand
     std::vector<std::vector<float> > floatVectorParams;
 };
 
+struct SDelayedSimulationThreadCommand
+{
+    int dueTime;
+    unsigned int sequence; // keeps posting order for identical due times
+    SSimulationThreadCommand cmd;
+};
+
 enum {  NO_COMMAND_FROMUI_TOSIM_CMD=100000, // Always start at 100000!!!!
         DELETE_SELECTED_PATH_POINTS_NON_EDIT_FROMUI_TOSIM_CMD,
 
@@ -47,15 +55,29 @@ public:
     void setRenderingAllowed(bool a);
 
     void appendSimulationThreadCommand(SSimulationThreadCommand cmd,int executionDelay=0);
+    void getSimulationThreadCommandStats(int& queuedCount,int& delayedCount,int& maxQueuedCount,unsigned int& executedCount,int& lastLatencyInMs,int& maxLatencyInMs) const; // from any thread
 
 private:
     bool _renderingAllowed;
     void _handleSimulationThreadCommands();
     void _executeSimulationThreadCommand(SSimulationThreadCommand cmd);
+    void _executeAndMeasureSimulationThreadCommand(SSimulationThreadCommand& cmd,int readyTime);
+    static bool _isDelayedCommandDueLater(const SDelayedSimulationThreadCommand& a,const SDelayedSimulationThreadCommand& b);
 
     VMutex _simulationThreadCommandsMutex;
-    std::vector<SSimulationThreadCommand> _simulationThreadCommands_tmp;
-    std::vector<SSimulationThreadCommand> _simulationThreadCommands;
+    std::vector<SSimulationThreadCommand> _simulationThreadCommands_tmp; // filled by any thread
+    std::vector<SSimulationThreadCommand> _simulationThreadCommands; // swapped with _simulationThreadCommands_tmp under the lock, then drained by the sim thread. Both keep their capacity
+    bool _drainingSimulationThreadCommands;
+    std::vector<SDelayedSimulationThreadCommand> _delayedSimulationThreadCommands; // min-heap on due time. Sim thread only
+    unsigned int _nextDelayedCommandSequence;
+
+    // Statistics. Atomic, since they are read from any thread:
+    std::atomic<int> _queuedCommandCount;
+    std::atomic<int> _delayedCommandCount;
+    std::atomic<int> _maxQueuedCommandCount;
+    std::atomic<unsigned int> _executedCommandCount;
+    std::atomic<int> _lastCommandLatency; // in ms, between a command becoming ready (posted, or delay elapsed) and its execution
+    std::atomic<int> _maxCommandLatency;
 
 #ifdef SIM_WITH_GUI
 private:
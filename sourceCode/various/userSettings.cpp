@@ -39,6 +39,10 @@
 #define _USR_ROTATION_STEP_SIZE "objectRotationStepSize"
 #define _USR_COMPRESS_FILES "compressFiles"
 #define _USR_TRIANGLE_COUNT_IN_OBB "triCountInOBB"
+#define _USR_CALC_STRUCT_PREBUILD "calcStructPrebuild"
+#define _USR_CALC_STRUCT_CACHE_FOLDER "calcStructCacheFolder"
+#define _USR_GRAPH_RECORDING_FOLDER "graphRecordingFolder"
+#define _USR_RUN_BENCHMARKS "runBenchmarks"
 #define _USR_APPROXIMATED_NORMALS "saveApproxNormals"
 #define _USR_PACK_INDICES "packIndices"
 #define _USR_UNDO_REDO_ENABLED "undoRedoEnabled"
@@ -376,6 +380,10 @@ CUserSettings::CUserSettings()
     freeServerPortRange=2000;
     _abortScriptExecutionButton=3;
     triCountInOBB=8; // gave best results in 2009/07/21
+    calcStructPrebuild=0;
+    calcStructCacheFolder="";
+    graphRecordingFolder="";
+    runBenchmarks=0;
     identicalVerticesCheck=true;
     identicalVerticesTolerance=0.0001f;
     identicalTrianglesCheck=true;
@@ -756,6 +764,10 @@ void CUserSettings::saveUserSettings()
     c.addInteger(_USR_FREE_SERVER_PORT_RANGE,freeServerPortRange,"");
     c.addInteger(_USR_ABORT_SCRIPT_EXECUTION_BUTTON,_abortScriptExecutionButton,"in seconds. Zero to disable.");
     c.addInteger(_USR_TRIANGLE_COUNT_IN_OBB,triCountInOBB,"");
+    c.addInteger(_USR_CALC_STRUCT_PREBUILD,calcStructPrebuild,"prebuild shape calculation structures in the background: 0=no (built when first needed), 1=at simulation start, 2=also after scene/model load");
+    c.addString(_USR_CALC_STRUCT_CACHE_FOLDER,calcStructCacheFolder,"folder where shape calculation structures are cached. Leave empty to disable the cache");
+    c.addString(_USR_GRAPH_RECORDING_FOLDER,graphRecordingFolder,"folder where graphs that record to disk write their data. Leave empty to use the default folder");
+    c.addInteger(_USR_RUN_BENCHMARKS,runBenchmarks,"timings logged at startup, bit-coded: 1=object poses (10000 objects), 2=API call overhead. Recommended to keep 0");
     c.addBoolean(_USR_REMOVE_IDENTICAL_VERTICES,identicalVerticesCheck,"");
     c.addFloat(_USR_IDENTICAL_VERTICES_TOLERANCE,identicalVerticesTolerance,"");
     c.addBoolean(_USR_REMOVE_IDENTICAL_TRIANGLES,identicalTrianglesCheck,"");
@@ -1068,6 +1080,10 @@ void CUserSettings::loadUserSettings()
     c.getInteger(_USR_FREE_SERVER_PORT_RANGE,freeServerPortRange);
     c.getInteger(_USR_ABORT_SCRIPT_EXECUTION_BUTTON,_abortScriptExecutionButton);
     c.getInteger(_USR_TRIANGLE_COUNT_IN_OBB,triCountInOBB);
+    c.getInteger(_USR_CALC_STRUCT_PREBUILD,calcStructPrebuild);
+    c.getString(_USR_CALC_STRUCT_CACHE_FOLDER,calcStructCacheFolder);
+    c.getString(_USR_GRAPH_RECORDING_FOLDER,graphRecordingFolder);
+    c.getInteger(_USR_RUN_BENCHMARKS,runBenchmarks);
     c.getBoolean(_USR_REMOVE_IDENTICAL_VERTICES,identicalVerticesCheck);
     c.getFloat(_USR_IDENTICAL_VERTICES_TOLERANCE,identicalVerticesTolerance);
     c.getBoolean(_USR_REMOVE_IDENTICAL_TRIANGLES,identicalTrianglesCheck);
@@ -52,6 +52,10 @@ public:
     bool identicalTrianglesWindingCheck;
     bool compressFiles;
     int triCountInOBB;
+    int calcStructPrebuild;
+    std::string calcStructCacheFolder;
+    std::string graphRecordingFolder;
+    int runBenchmarks;
     bool saveApproxNormals;
     bool packIndices;
     bool runCustomizationScripts;
@@ -12,6 +12,13 @@ PFNGLRENDERBUFFERSTORAGEEXTPROC oglExt::_glRenderbufferStorage=nullptr;
 PFNGLFRAMEBUFFERRENDERBUFFEREXTPROC oglExt::_glFramebufferRenderbuffer=nullptr;
 PFNGLCHECKFRAMEBUFFERSTATUSEXTPROC oglExt::_glCheckFramebufferStatus=nullptr;
 PFNGLGETRENDERBUFFERPARAMETERIVEXTPROC oglExt::_glGetRenderbufferParameteriv=nullptr;
+
+PFNGLGENBUFFERSPROC oglExt::_glGenBuffers=nullptr;
+PFNGLDELETEBUFFERSPROC oglExt::_glDeleteBuffers=nullptr;
+PFNGLBINDBUFFERPROC oglExt::_glBindBuffer=nullptr;
+PFNGLBUFFERDATAPROC oglExt::_glBufferData=nullptr;
+PFNGLMAPBUFFERPROC oglExt::_glMapBuffer=nullptr;
+PFNGLUNMAPBUFFERPROC oglExt::_glUnmapBuffer=nullptr;
 #endif
 
 GLenum oglExt::DEPTH24_STENCIL8=GL_DEPTH24_STENCIL8_EXT;
@@ -143,6 +150,60 @@ void oglExt::GetRenderbufferParameteriv(GLenum a,GLenum b,GLint* c)
 #endif
 }
 
+void oglExt::GenBuffers(GLsizei a,GLuint* b)
+{
+#ifndef MAC_SIM
+    _glGenBuffers(a,b);
+#else
+    glGenBuffers(a,b);
+#endif
+}
+
+void oglExt::DeleteBuffers(GLsizei a,const GLuint* b)
+{
+#ifndef MAC_SIM
+    _glDeleteBuffers(a,b);
+#else
+    glDeleteBuffers(a,b);
+#endif
+}
+
+void oglExt::BindBuffer(GLenum a,GLuint b)
+{
+#ifndef MAC_SIM
+    _glBindBuffer(a,b);
+#else
+    glBindBuffer(a,b);
+#endif
+}
+
+void oglExt::BufferData(GLenum a,GLsizeiptr b,const void* c,GLenum d)
+{
+#ifndef MAC_SIM
+    _glBufferData(a,b,c,d);
+#else
+    glBufferData(a,b,c,d);
+#endif
+}
+
+void* oglExt::MapBuffer(GLenum a,GLenum b)
+{
+#ifndef MAC_SIM
+    return(_glMapBuffer(a,b));
+#else
+    return(glMapBuffer(a,b));
+#endif
+}
+
+void oglExt::UnmapBuffer(GLenum a)
+{
+#ifndef MAC_SIM
+    _glUnmapBuffer(a);
+#else
+    glUnmapBuffer(a);
+#endif
+}
+
 void oglExt::prepareExtensionFunctions(bool forceFboToUseExt)
 {
     _usingExt=false;
@@ -181,6 +242,12 @@ void oglExt::prepareExtensionFunctions(bool forceFboToUseExt)
         COLOR_ATTACHMENT0=GL_COLOR_ATTACHMENT0;
         DEPTH_STENCIL_ATTACHMENT=GL_DEPTH_STENCIL_ATTACHMENT;
     }
+    _glGenBuffers=(PFNGLGENBUFFERSPROC)wglGetProcAddress("glGenBuffers");
+    _glDeleteBuffers=(PFNGLDELETEBUFFERSPROC)wglGetProcAddress("glDeleteBuffers");
+    _glBindBuffer=(PFNGLBINDBUFFERPROC)wglGetProcAddress("glBindBuffer");
+    _glBufferData=(PFNGLBUFFERDATAPROC)wglGetProcAddress("glBufferData");
+    _glMapBuffer=(PFNGLMAPBUFFERPROC)wglGetProcAddress("glMapBuffer");
+    _glUnmapBuffer=(PFNGLUNMAPBUFFERPROC)wglGetProcAddress("glUnmapBuffer");
 #endif
 
 #ifdef LIN_SIM
@@ -217,6 +284,12 @@ void oglExt::prepareExtensionFunctions(bool forceFboToUseExt)
         COLOR_ATTACHMENT0=GL_COLOR_ATTACHMENT0;
         DEPTH_STENCIL_ATTACHMENT=GL_DEPTH_STENCIL_ATTACHMENT;
     }
+    _glGenBuffers=(PFNGLGENBUFFERSPROC)glXGetProcAddress((GLubyte*)"glGenBuffers");
+    _glDeleteBuffers=(PFNGLDELETEBUFFERSPROC)glXGetProcAddress((GLubyte*)"glDeleteBuffers");
+    _glBindBuffer=(PFNGLBINDBUFFERPROC)glXGetProcAddress((GLubyte*)"glBindBuffer");
+    _glBufferData=(PFNGLBUFFERDATAPROC)glXGetProcAddress((GLubyte*)"glBufferData");
+    _glMapBuffer=(PFNGLMAPBUFFERPROC)glXGetProcAddress((GLubyte*)"glMapBuffer");
+    _glUnmapBuffer=(PFNGLUNMAPBUFFERPROC)glXGetProcAddress((GLubyte*)"glUnmapBuffer");
 #endif
 
 #ifdef MAC_SIM
@@ -340,6 +413,21 @@ bool oglExt::_isFboAvailable(bool& viaExt)
 #endif
 }
 
+bool oglExt::isPboAvailable()
+{ // pixel-buffer objects: OpenGL 2.1, or ARB_pixel_buffer_object. prepareExtensionFunctions() should have been called previously!
+#ifndef MAC_SIM
+    if ( (_glGenBuffers==nullptr)||(_glDeleteBuffers==nullptr)||(_glBindBuffer==nullptr)||(_glBufferData==nullptr)||(_glMapBuffer==nullptr)||(_glUnmapBuffer==nullptr) )
+        return(false);
+#endif
+    const char* gl_version=(const char*)(glGetString(GL_VERSION));
+    if (gl_version==nullptr)
+        return(false);
+    if (atof(gl_version)>=2.1)
+        return(true);
+    const char* gl_extensions=(const char*)(glGetString(GL_EXTENSIONS));
+    return( (gl_extensions!=nullptr)&&(strstr(gl_extensions,"ARB_pixel_buffer_object")!=0) );
+}
+
 bool oglExt::areNonPowerOfTwoTexturesAvailable()
 {
     std::string extString((const char*)glGetString(GL_EXTENSIONS));
@@ -47,6 +47,7 @@ public:
     static bool isFboAvailable();
     static bool _isFboAvailable(bool &viaExt);
     static bool areNonPowerOfTwoTexturesAvailable();
+    static bool isPboAvailable();
     static void initDefaultGlValues();
 
 
@@ -61,6 +62,14 @@ public:
     static void CheckFramebufferStatus(GLenum a);
     static void GetRenderbufferParameteriv(GLenum a,GLenum b,GLint* c);
 
+    // Buffer objects (for pixel-buffer objects):
+    static void GenBuffers(GLsizei a,GLuint* b);
+    static void DeleteBuffers(GLsizei a,const GLuint* b);
+    static void BindBuffer(GLenum a,GLuint b);
+    static void BufferData(GLenum a,GLsizeiptr b,const void* c,GLenum d);
+    static void* MapBuffer(GLenum a,GLenum b);
+    static void UnmapBuffer(GLenum a);
+
 #ifndef MAC_SIM
     static PFNGLGENFRAMEBUFFERSEXTPROC _glGenFramebuffers;
     static PFNGLDELETEFRAMEBUFFERSEXTPROC _glDeleteFramebuffers;
@@ -72,6 +81,13 @@ public:
     static PFNGLFRAMEBUFFERRENDERBUFFEREXTPROC _glFramebufferRenderbuffer;
     static PFNGLCHECKFRAMEBUFFERSTATUSEXTPROC _glCheckFramebufferStatus;
     static PFNGLGETRENDERBUFFERPARAMETERIVEXTPROC _glGetRenderbufferParameteriv;
+
+    static PFNGLGENBUFFERSPROC _glGenBuffers;
+    static PFNGLDELETEBUFFERSPROC _glDeleteBuffers;
+    static PFNGLBINDBUFFERPROC _glBindBuffer;
+    static PFNGLBUFFERDATAPROC _glBufferData;
+    static PFNGLMAPBUFFERPROC _glMapBuffer;
+    static PFNGLUNMAPBUFFERPROC _glUnmapBuffer;
 #endif
 
     static GLenum DEPTH24_STENCIL8;